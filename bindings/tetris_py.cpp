@@ -19,7 +19,13 @@
 //       print(p.col, p.rot)
 //   g.apply_placement(4, 0)
 //   arr = g.grid()                # (20, 10) int32 NumPy 배열 (복사본)
+//   g.observe_into(board, cur, nxt)  # 미리 할당한 float32 버퍼에 관측을 바로 쓴다
 //   h   = g.state_hash()          # C++ SimGame::StateHash()와 비트 단위로 동일
+//   blob = g.snapshot()           # 128바이트 bytes. SimGame.from_snapshot(blob) 으로 복원
+//   rs = g.reachable_placements() # tuck·T-spin 자리까지, 자리마다 최단 입력 경로(dict 리스트)
+//   f = board_features(boards)    # (N, 8) int32 — 높이·구멍·전환 등 보드 특징(FEATURE_NAMES 순서)
+//   c = ReplayCorpus("archive.trpc")  # mmap. c.inputs(i) 는 복사 없는 (T, 2) uint8 읽기 전용 뷰
+//   recs = c.decode(threads=0)        # (관측, 착수) SelfPlayRecord 구조체 배열
 //
 // 아래 docstring들은 Python 쪽 help()에 그대로 노출되므로 영어로 둔다.
 
@@ -30,9 +36,173 @@
 #include "../src/sim_game.h"
 #include "../src/sim_grid.h"
 #include "../src/sim_block.h"
+#include "../src/sim_batch.h"
+#include "../bot/placement.h"
+#include "../bot/reachability.h"
+#include "../bot/board_features.h"
+#include "../bot/beam_search.h"
+#include "../bot/transposition.h"
+#include "../bot/mcts.h"
+#include "../bot/replay_dataset.h"
+#include "../core/replay_corpus.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace py = pybind11;
 
+namespace {
+
+// 호출자가 미리 할당한 numpy 버퍼를 검사하고 포인터를 꺼낸다.
+// 인자는 noconvert 로 받으므로 dtype/연속성이 다르면 pybind 가 먼저 거절한다 —
+// 변환을 허용하면 임시 복사본에 쓰고 호출자 배열은 그대로 남는 조용한 버그가 된다.
+template <typename T>
+T* out_buffer(py::array_t<T, py::array::c_style>& arr,
+              py::ssize_t rows, py::ssize_t perRow, const char* name)
+{
+    if (arr.ndim() < 1 || arr.shape(0) != rows || arr.size() != rows * perRow)
+    {
+        throw py::value_error(std::string(name) + ": expected " +
+                              std::to_string(rows) + " rows of " +
+                              std::to_string(perRow) + " elements");
+    }
+    return arr.mutable_data();
+}
+
+// 모양과 무관하게 원소 수만 맞으면 받는다. board 는 (200,), (20, 10), (1, 20, 10)
+// 어느 쪽으로 할당해도 같은 C-order 메모리다.
+template <typename T>
+T* flat_buffer(py::array_t<T, py::array::c_style>& arr, py::ssize_t size, const char* name)
+{
+    if (arr.size() != size)
+    {
+        throw py::value_error(std::string(name) + ": expected " +
+                              std::to_string(size) + " elements");
+    }
+    return arr.mutable_data();
+}
+
+// numpy bool 은 1바이트 0/1 이라 uint8 버퍼로 그대로 쓴다.
+static_assert(sizeof(bool) == 1, "numpy bool buffers are written as uint8");
+uint8_t* bool_buffer(py::array_t<bool, py::array::c_style>& arr,
+                     py::ssize_t rows, py::ssize_t perRow, const char* name)
+{
+    return reinterpret_cast<uint8_t*>(out_buffer(arr, rows, perRow, name));
+}
+
+// bytes 를 SimSnapshot 으로 풀어 g 에 적용한다. 길이·내용이 틀리면 ValueError.
+void restore_from_bytes(SimGame& g, const py::bytes& data)
+{
+    char* ptr = nullptr;
+    py::ssize_t len = 0;
+    if (PyBytes_AsStringAndSize(data.ptr(), &ptr, &len) != 0) throw py::error_already_set();
+    if (len != static_cast<py::ssize_t>(sizeof(SimSnapshot)))
+    {
+        throw py::value_error("snapshot: expected " + std::to_string(sizeof(SimSnapshot)) +
+                              " bytes, got " + std::to_string(len));
+    }
+    SimSnapshot snap;
+    std::memcpy(&snap, ptr, sizeof(snap));
+    if (!g.Restore(snap)) throw py::value_error("snapshot: unsupported version or corrupt state");
+}
+
+py::bytes snapshot_bytes(const SimGame& g)
+{
+    const SimSnapshot snap = g.Snapshot();
+    return py::bytes(reinterpret_cast<const char*>(&snap), sizeof(snap));
+}
+
+// (N, 20, 10) / (N, 1, 20, 10) / (N, 200) 보드 묶음을 행 마스크로 바꾼다. 0 보다 큰
+// 칸을 찬 칸으로 친다(features.py 의 board > 0 과 같다). 관측(0/1)이든 grid()(블록 id)든 된다.
+std::vector<uint16_t> board_rows_from(const py::array_t<float, py::array::c_style | py::array::forcecast>& boards,
+                                      py::ssize_t& n)
+{
+    constexpr py::ssize_t kCells = bot::kBoardRows * bot::kBoardCols;
+    if (boards.ndim() < 2 || boards.size() != boards.shape(0) * kCells)
+        throw py::value_error("boards: expected shape (N, 20, 10), (N, 1, 20, 10) or (N, 200)");
+    n = boards.shape(0);
+    std::vector<uint16_t> rows(static_cast<size_t>(n) * bot::kBoardRows);
+    const float* cells = boards.data();
+    for (size_t r = 0; r < rows.size(); ++r) {
+        uint32_t mask = 0;
+        for (int c = 0; c < bot::kBoardCols; ++c)
+            mask |= static_cast<uint32_t>(cells[r * bot::kBoardCols + c] > 0.0f) << c;
+        rows[r] = static_cast<uint16_t>(mask);
+    }
+    return rows;
+}
+
+// Python callable 을 MCTS 잎 평가기로 쓴다. 탐색 스레드가 부르므로 GIL 을 잡고,
+// callable 이 던진 예외는 스레드 밖으로 못 나가니 첫 번째 것만 담아 두었다가
+// Search 가 끝난 뒤 호출 스레드에서 다시 던진다. 실패한 batch 는 균등 prior 로 채운다.
+class PyEvaluator : public bot::Evaluator
+{
+public:
+    explicit PyEvaluator(py::object fn) : fn_(std::move(fn)) {}
+
+    void Evaluate(const SimGame* const* sims, int count, bot::Evaluation* out) override
+    {
+        for (int i = 0; i < count; ++i) {
+            std::fill(out[i].logits, out[i].logits + bot::kNumPlacements, 0.0f);
+            out[i].value = 0.0f;
+        }
+        py::gil_scoped_acquire gil;
+        if (failed_) return;
+        try {
+            py::list batch(count);
+            for (int i = 0; i < count; ++i) batch[i] = py::cast(*sims[i]);
+            py::tuple res = fn_(batch);
+            auto logits = res[0].cast<py::array_t<float, py::array::c_style | py::array::forcecast>>();
+            auto values = res[1].cast<py::array_t<float, py::array::c_style | py::array::forcecast>>();
+            if (logits.ndim() != 2 || logits.shape(0) != count || logits.shape(1) != bot::kNumPlacements)
+                throw py::value_error("evaluator: logits must be shaped (B, 40)");
+            if (values.size() != count)
+                throw py::value_error("evaluator: values must have B entries");
+            for (int i = 0; i < count; ++i) {
+                std::memcpy(out[i].logits, logits.data(i, 0), sizeof(out[i].logits));
+                out[i].value = values.data()[i];
+            }
+        } catch (py::error_already_set& e) {
+            failed_ = true;
+            error_ = std::make_unique<py::error_already_set>(std::move(e));
+        } catch (const std::exception& e) {
+            failed_ = true;
+            message_ = e.what();
+        }
+    }
+
+    // 탐색 중 callable 이 실패했으면 그 예외를 던진다. GIL 을 잡은 채로 부른다.
+    void Rethrow()
+    {
+        if (error_) throw *error_;
+        if (failed_) throw std::runtime_error(message_);
+    }
+
+private:
+    py::object fn_;
+    bool failed_ = false;   // GIL 이 지킨다
+    std::unique_ptr<py::error_already_set> error_;
+    std::string message_;
+};
+
+// vector 를 넘겨받아 복사 없이 numpy 배열로 내준다. 메모리는 capsule 이 지운다.
+template <typename T>
+py::array_t<T> adopt_vector(std::vector<T>&& v)
+{
+    auto* owned = new std::vector<T>(std::move(v));
+    py::capsule free(owned, [](void* p) { delete static_cast<std::vector<T>*>(p); });
+    return py::array_t<T>(static_cast<py::ssize_t>(owned->size()), owned->data(), free);
+}
+
+}  // namespace
+
+// SelfPlayRecord 를 numpy 구조체 dtype 으로. 필드 이름은 C++ 그대로다.
+PYBIND11_NUMPY_DTYPE(bot::SelfPlayRecord, match, ply, player, action, board, current, next,
+                     pendingGarbage, linesCleared, attackSent, outcome, reserved, legalMask);
+
 PYBIND11_MODULE(tetris_py, m)
 {
     m.doc() = "Headless Tetris simulation (pybind11 wrapper around SimGame)";
@@ -80,6 +250,111 @@ PYBIND11_MODULE(tetris_py, m)
              "Apply a placement atomically (rotate -> translate -> hard drop -> "
              "lock). Returns the number of lines cleared, or -1 if the placement "
              "is illegal.")
+        // 학습 루프의 가장 안쪽이라 Placement 객체 리스트 대신 numpy 로 돌려준다.
+        .def("enumerate_placements", [](const SimGame& g) {
+            SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+            const int n = g.EnumeratePlacements(landed);
+            auto arr = py::array_t<int32_t>({n, 3});
+            auto buf = arr.mutable_unchecked<2>();
+            for (int i = 0; i < n; ++i)
+            {
+                buf(i, 0) = landed[i].col;
+                buf(i, 1) = landed[i].rot;
+                buf(i, 2) = landed[i].row;
+            }
+            return arr;
+        }, "Enumerate legal placements together with their landing row. Returns "
+           "an (N, 3) int32 array of [col, rot, row] in the same order as "
+           "legal_placements(). Landing rows come from column surfaces and "
+           "piece bottom profiles, so no drop is simulated.")
+        .def("apply_landed_placement", [](SimGame& g, int col, int rot, int row) {
+            return g.ApplyLandedPlacement({col, rot, row});
+        }, py::arg("col"), py::arg("rot"), py::arg("row"),
+           "Apply a placement from enumerate_placements() directly at its "
+           "landing row. Returns lines cleared, or -1 if (col, rot, row) is not "
+           "a legal landing for the current state.")
+        .def("legal_mask", [](const SimGame& g) {
+            SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+            const int n = g.EnumeratePlacements(landed);
+            auto arr = py::array_t<bool>(SimGame::kMaxPlacements);
+            auto buf = arr.mutable_unchecked<1>();
+            for (int i = 0; i < SimGame::kMaxPlacements; ++i) buf(i) = false;
+            // action = col * 4 + rot (python/common/action_mask.py 와 같은 규칙).
+            for (int i = 0; i < n; ++i)
+                buf(landed[i].col * SimBlock::kNumRotations + landed[i].rot) = true;
+            return arr;
+        }, "Boolean (40,) legal-action mask indexed by col * 4 + rot.")
+        // CBMPI 의 정책 개선처럼 "모든 합법 수를 한 번씩 둬 보고 점수화" 하는 루프를
+        // 통째로 C++ 에서 돈다. Python 에서는 clone/apply/grid 를 착수마다 부를 필요가 없다.
+        .def("afterstate_features", [](const SimGame& g) {
+            SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+            const int n = g.EnumeratePlacements(landed);
+            py::array_t<int32_t> actions(n), cleared(n);
+            py::array_t<int32_t> features({n, static_cast<int>(bot::kNumBoardFeatures)});
+            py::array_t<bool> over(n);
+            int32_t* a = actions.mutable_data();
+            int32_t* l = cleared.mutable_data();
+            int32_t* f = features.mutable_data();
+            bool* o = over.mutable_data();
+            {
+                py::gil_scoped_release release;
+                for (int i = 0; i < n; ++i) {
+                    SimGame child = g;
+                    a[i] = bot::encode_action(landed[i].col, landed[i].rot);
+                    l[i] = child.ApplyLandedPlacement(landed[i]);
+                    o[i] = child.IsGameOver();
+                    bot::BoardRows rows;
+                    bot::board_rows(child, rows);
+                    bot::board_features(rows, *reinterpret_cast<int32_t (*)[bot::kNumBoardFeatures]>(
+                                                  f + i * bot::kNumBoardFeatures));
+                }
+            }
+            py::dict d;
+            d["actions"] = actions;
+            d["features"] = features;
+            d["cleared"] = cleared;
+            d["game_over"] = over;
+            return d;
+        }, "Play every legal placement on a copy and extract board features of "
+           "each afterstate. Returns a dict with actions int32 (K,) (col*4+rot, "
+           "in enumerate_placements() order), features int32 (K, 8) in "
+           "FEATURE_NAMES order, cleared int32 (K,) lines cleared and game_over "
+           "bool (K,).")
+        // hard drop 만으로는 못 닿는 tuck·T-spin 자리까지 넣은 목록. 경로는 input mask
+        // 리스트라 apply_reachable() 에 넘기거나 submit_input() 으로 한 틱씩 흘려 넣는다.
+        .def("reachable_placements", [](const SimGame& g) {
+            bot::ReachableSet set;
+            const int n = bot::reachable_placements(g, set);
+            py::list out;
+            for (int i = 0; i < n; ++i)
+            {
+                const bot::ReachablePlacement& p = set.placements[i];
+                const uint8_t* path = set.Path(p);
+                py::dict d;
+                d["col"] = p.col;
+                d["rot"] = p.rot;
+                d["row"] = p.row;
+                d["tspin"] = p.tspin;
+                d["inputs"] = std::vector<int>(path, path + p.pathLength);
+                out.append(d);
+            }
+            return out;
+        }, "BFS over (row, col, rot) with the real SubmitInput movement rules "
+           "(soft drop, clockwise rotation, hard drop). Returns one dict per "
+           "distinct resting position and T-spin flag with keys col, rot, row, "
+           "tspin and inputs (shortest input-mask path ending in DROP), shortest "
+           "paths first. Includes tucks and T-spin slots that "
+           "enumerate_placements() cannot reach; col may be negative.")
+        .def("apply_reachable", [](SimGame& g, const std::vector<int>& inputs) {
+            for (int mask : inputs)
+            {
+                if (g.IsGameOver()) break;
+                g.SubmitInput(static_cast<uint8_t>(mask));
+            }
+            return g.lastLinesCleared;
+        }, py::arg("inputs"),
+           "Replay an input path from reachable_placements() via submit_input() "
+           "without gravity ticks. Returns lines cleared by the final lock.")
         .def("clone", [](const SimGame& g) {
             return SimGame(g);
         }, "Return a deep copy of the full deterministic sim state.")
@@ -118,6 +393,23 @@ PYBIND11_MODULE(tetris_py, m)
              "Single-step the current piece down by one row (locks on contact).")
 
         // --- 관측 ---
+        // 학습 루프용. bot::observe 를 그대로 불러 호출자 버퍼에 쓴다 — 게임 안
+        // ONNX 봇이 보는 관측과 구현이 하나라 비트 단위로 같고, 스텝마다 새 배열을
+        // 만들지 않는다. 버퍼는 noconvert 라 dtype 이 다르면 복사 대신 거절된다.
+        .def("observe_into", [](const SimGame& g,
+                                py::array_t<float, py::array::c_style> board,
+                                py::array_t<float, py::array::c_style> current,
+                                py::array_t<float, py::array::c_style> next) {
+            float* b = flat_buffer(board,   bot::kBoardRows * bot::kBoardCols, "board");
+            float* c = flat_buffer(current, bot::kNumPieceTypes, "current");
+            float* n = flat_buffer(next,    bot::kNumPieceTypes, "next");
+            bot::observe(g, b, c, n);
+        }, py::arg("board").noconvert(), py::arg("current").noconvert(),
+           py::arg("next").noconvert(),
+           "Write the network observation into preallocated float32 buffers: "
+           "board (200 elements, e.g. (1, 20, 10)) gets 1 for locked cells, "
+           "current/next (7,) get piece one-hots. Same encoding as the C++ "
+           "in-game bot (bot::observe), with no per-call allocation.")
         .def("grid", [](const SimGame& g) {
             // 내부 버퍼를 참조로 넘기지 않고 복사한다.
             // 참조를 넘기면 다음 착수 때 Python이 들고 있던 배열의 내용이
@@ -164,10 +456,372 @@ PYBIND11_MODULE(tetris_py, m)
              "FNV-1a 64-bit hash of the full sim state. Bitwise-identical to "
              "Game::ComputeStateHash() — this is the gate the determinism "
              "regression test checks.")
+        .def("fingerprint", &SimGame::Fingerprint,
+             "Fast 64-bit state fingerprint. Covers the same state as "
+             "state_hash() but reads an incrementally maintained Zobrist grid "
+             "hash, so it is O(1). Values differ from state_hash() and are not "
+             "stable across versions: use it for in-process caches, not for "
+             "wire/replay parity.")
         .def("rng_state", &SimGame::RngState,
              "Raw XorShift64* RNG state (for debugging cross-platform drift).")
 
+        // --- 스냅샷 ---
+        // SimSnapshot(128바이트) 을 bytes 로 주고받는다. 롤백·MCTS·분산 학습에서
+        // SimGame 을 통째로 복제하거나 pickle 하는 대신 쓴다.
+        .def("snapshot", &snapshot_bytes,
+             "Pack the full sim state into a fixed-size bytes blob "
+             "(SimGame.SNAPSHOT_BYTES long). restore() of the blob reproduces "
+             "the same state_hash() and the same future under the same inputs.")
+        .def("restore", &restore_from_bytes, py::arg("data"),
+             "Replace this game's state with a blob from snapshot(). Raises "
+             "ValueError (and leaves the state untouched) if the blob has the "
+             "wrong length, an unknown version or out-of-range fields.")
+        .def_static("from_snapshot", [](const py::bytes& data) {
+            SimGame g;
+            restore_from_bytes(g, data);
+            return g;
+        }, py::arg("data"), "Construct a SimGame directly from a snapshot() blob.")
+        .def(py::pickle(
+            [](const SimGame& g) { return snapshot_bytes(g); },
+            [](const py::bytes& data) {
+                SimGame g;
+                restore_from_bytes(g, data);
+                return g;
+            }))
+        .def_property_readonly_static("SNAPSHOT_BYTES",
+                                      [](py::object) { return sizeof(SimSnapshot); })
+
         // 관측 벡터 크기를 Python 쪽에서 하드코딩하지 않도록 노출한다.
         .def_property_readonly_static("ROWS", [](py::object) { return SimGrid::kRows; })
         .def_property_readonly_static("COLS", [](py::object) { return SimGrid::kCols; });
+
+    // 따로 들고 있는 SimGame 여러 개(예: 대전 환경의 두 보드, MCTS 의 자식들)의
+    // 관측을 한 번에 쓴다. 게임 포인터를 모은 뒤에는 GIL 을 놓는다.
+    m.def("observe_batch", [](py::sequence games,
+                              py::array_t<float, py::array::c_style> board,
+                              py::array_t<float, py::array::c_style> current,
+                              py::array_t<float, py::array::c_style> next) {
+        const py::ssize_t n = static_cast<py::ssize_t>(py::len(games));
+        std::vector<const SimGame*> sims;
+        sims.reserve(static_cast<size_t>(n));
+        for (py::handle h : games) sims.push_back(h.cast<const SimGame*>());
+        constexpr int kBoard = bot::kBoardRows * bot::kBoardCols;
+        float* b = out_buffer(board,   n, kBoard, "board");
+        float* c = out_buffer(current, n, bot::kNumPieceTypes, "current");
+        float* x = out_buffer(next,    n, bot::kNumPieceTypes, "next");
+        py::gil_scoped_release release;
+        for (py::ssize_t i = 0; i < n; ++i)
+        {
+            bot::observe(*sims[static_cast<size_t>(i)],
+                         b + i * kBoard,
+                         c + i * bot::kNumPieceTypes,
+                         x + i * bot::kNumPieceTypes);
+        }
+    }, py::arg("games"), py::arg("board").noconvert(), py::arg("current").noconvert(),
+       py::arg("next").noconvert(),
+       "Batched SimGame.observe_into: write observations of len(games) sims "
+       "into board float32 (N, 1, 20, 10) and current/next float32 (N, 7).");
+
+    // N 개 게임을 한 번에 진행하는 벡터화 환경. 버퍼는 호출자가 한 번 할당해
+    // 매 스텝 재사용한다. 계산 중에는 GIL 을 놓아 다른 Python 스레드가 돈다.
+    using FloatBuf = py::array_t<float, py::array::c_style>;
+    using BoolBuf  = py::array_t<bool,  py::array::c_style>;
+    using IntBuf   = py::array_t<int32_t, py::array::c_style>;
+    py::class_<SimGameBatch>(m, "SimGameBatch")
+        .def(py::init<int, uint64_t>(), py::arg("num_envs"), py::arg("seed") = 0,
+             "Own num_envs SimGames in contiguous storage. Per-game, per-episode "
+             "seeds are derived from `seed`, so runs are reproducible.")
+        .def_property_readonly("num_envs", &SimGameBatch::Size)
+        .def("reset", [](SimGameBatch& b, FloatBuf board, FloatBuf current,
+                         FloatBuf next, BoolBuf legal_mask) {
+            const py::ssize_t n = b.Size();
+            SimGameBatch::Buffers out;
+            out.board     = out_buffer(board,   n, SimGameBatch::kBoardSize,     "board");
+            out.current   = out_buffer(current, n, SimGameBatch::kNumPieceTypes, "current");
+            out.next      = out_buffer(next,    n, SimGameBatch::kNumPieceTypes, "next");
+            out.legalMask = bool_buffer(legal_mask, n, SimGameBatch::kNumActions, "legal_mask");
+            py::gil_scoped_release release;
+            b.Reset(out);
+        }, py::arg("board").noconvert(), py::arg("current").noconvert(),
+           py::arg("next").noconvert(), py::arg("legal_mask").noconvert(),
+           "Restart every game at episode 0 and write observations in place. "
+           "Buffers: board float32 (N,1,20,10), current/next float32 (N,7), "
+           "legal_mask bool (N,40).")
+        .def("step", [](SimGameBatch& b, IntBuf actions, FloatBuf board,
+                        FloatBuf current, FloatBuf next, BoolBuf legal_mask,
+                        FloatBuf reward, BoolBuf done) {
+            const py::ssize_t n = b.Size();
+            if (actions.ndim() != 1 || actions.shape(0) != n)
+                throw py::value_error("actions: expected shape (num_envs,)");
+            const int32_t* acts = actions.data();
+            SimGameBatch::Buffers out;
+            out.board     = out_buffer(board,   n, SimGameBatch::kBoardSize,     "board");
+            out.current   = out_buffer(current, n, SimGameBatch::kNumPieceTypes, "current");
+            out.next      = out_buffer(next,    n, SimGameBatch::kNumPieceTypes, "next");
+            out.legalMask = bool_buffer(legal_mask, n, SimGameBatch::kNumActions, "legal_mask");
+            out.reward    = out_buffer(reward,  n, 1, "reward");
+            out.done      = bool_buffer(done,   n, 1, "done");
+            py::gil_scoped_release release;
+            b.Step(acts, out);
+        }, py::arg("actions").noconvert(), py::arg("board").noconvert(),
+           py::arg("current").noconvert(), py::arg("next").noconvert(),
+           py::arg("legal_mask").noconvert(), py::arg("reward").noconvert(),
+           py::arg("done").noconvert(),
+           "Apply actions (int32 (N,), col*4+rot) to every game and write the "
+           "post-step observation, legal mask, reward (lines cleared) and done "
+           "flag in place. Finished games auto-reset with a fresh derived seed, "
+           "so a done slot already holds the next episode's first observation.")
+        .def("game", [](const SimGameBatch& b, int index) {
+            if (index < 0 || index >= b.Size()) throw py::index_error();
+            return b.Game(index);
+        }, py::arg("index"), "Copy of game `index` (for debugging / hashing).");
+
+    // 봇 탐색 전치표. 여러 Python 스레드의 beam_placement 가 하나를 나눠 써도 된다.
+    py::class_<bot::TranspositionTable>(m, "TranspositionTable")
+        .def(py::init<size_t>(), py::arg("megabytes") = 16,
+             "Lock-free search cache of roughly `megabytes` MB (rounded down to a "
+             "power-of-two entry count).")
+        .def_property_readonly("entries", &bot::TranspositionTable::Entries)
+        .def("stats", [](const bot::TranspositionTable& t) {
+            const bot::TTStats s = t.Stats();
+            py::dict d;
+            d["probes"] = s.probes;
+            d["hits"] = s.hits;
+            d["stores"] = s.stores;
+            d["overwrites"] = s.overwrites;
+            d["entries"] = s.entries;
+            d["occupancy"] = s.occupancy;
+            d["hit_rate"] = s.hitRate();
+            return d;
+        }, "Counters for sizing: probes, hits, hit_rate, stores, overwrites "
+           "(stores that evicted a live entry) and sampled occupancy.")
+        .def("reset_stats", &bot::TranspositionTable::ResetStats)
+        .def("new_generation", &bot::TranspositionTable::NewGeneration,
+             "Age existing entries so they are replaced first.")
+        .def("clear", &bot::TranspositionTable::Clear,
+             "Drop every entry and reset the counters. Not safe while searching.");
+
+    // 보드 특징 추출(bot/board_features.h). CEM/CBMPI 가 후보 보드 전체를 한 번에 점수화한다.
+    py::tuple featureNames(bot::kNumBoardFeatures);
+    for (int i = 0; i < bot::kNumBoardFeatures; ++i) featureNames[i] = bot::kBoardFeatureNames[i];
+    m.attr("FEATURE_NAMES") = featureNames;
+
+    using BoardsIn = py::array_t<float, py::array::c_style | py::array::forcecast>;
+    m.def("board_features", [](const BoardsIn& boards) {
+        py::ssize_t n = 0;
+        const std::vector<uint16_t> rows = board_rows_from(boards, n);
+        py::array_t<int32_t> out({n, static_cast<py::ssize_t>(bot::kNumBoardFeatures)});
+        int32_t* dst = out.mutable_data();
+        {
+            py::gil_scoped_release release;
+            bot::board_features_batch(rows.data(), static_cast<int>(n), dst);
+        }
+        return out;
+    }, py::arg("boards"),
+       "Extract board features for a batch of boards shaped (N, 20, 10), "
+       "(N, 1, 20, 10) or (N, 200); cells > 0 count as filled. Returns int32 "
+       "(N, 8) in FEATURE_NAMES order: aggregate_height, max_height, bumpiness, "
+       "holes, wells, row_transitions, col_transitions, covered_cells.");
+    m.def("bcts_scores", [](const BoardsIn& boards,
+                            const py::array_t<int32_t, py::array::c_style | py::array::forcecast>& lines) {
+        py::ssize_t n = 0;
+        const std::vector<uint16_t> rows = board_rows_from(boards, n);
+        if (lines.size() != n) throw py::value_error("lines: expected N entries");
+        const int32_t* cleared = lines.data();
+        py::array_t<double> out(n);
+        double* dst = out.mutable_data();
+        {
+            py::gil_scoped_release release;
+            for (py::ssize_t i = 0; i < n; ++i) {
+                int32_t f[bot::kNumBoardFeatures];
+                bot::board_features(*reinterpret_cast<const bot::BoardRows*>(
+                                        &rows[static_cast<size_t>(i) * bot::kBoardRows]), f);
+                dst[i] = bot::bcts_score(f, cleared[i]);
+            }
+        }
+        return out;
+    }, py::arg("boards"), py::arg("lines"),
+       "Vectorized common.features.bcts_score: float64 (N,) scores for boards "
+       "shaped like board_features() input and lines cleared int (N,).");
+
+    // 미리보기 큐까지 읽는 beam search 착수. 탐색 중에는 GIL 을 놓는다.
+    m.def("beam_placement", [](const SimGame& g, int width, int depth, double budget_ms,
+                               bot::TranspositionTable* table) -> py::object {
+        bot::BeamConfig config;
+        config.width = width;
+        config.depth = depth;
+        config.budgetMs = budget_ms;
+        config.table = table;
+        int col = 0, rot = 0;
+        bool ok;
+        {
+            py::gil_scoped_release release;
+            ok = bot::beam_placement(g, config, col, rot);
+        }
+        if (!ok) return py::none();
+        return py::make_tuple(col, rot);
+    }, py::arg("sim"), py::arg("width") = 24, py::arg("depth") = 1 + SimGame::kNextPreviewCount,
+       py::arg("budget_ms") = 0.0, py::arg("table") = nullptr,
+       "Beam-search placement over the current piece and the visible preview. "
+       "Returns (col, rot) or None if there is no legal move. budget_ms <= 0 "
+       "searches the full depth and is deterministic. An optional "
+       "TranspositionTable caches evaluations across calls without changing the result.");
+
+    // C++ MCTS. evaluator 가 None 이면 heuristic 평가기, 아니면 Python callable 이다.
+    // 탐색 중에는 GIL 을 놓고, callable 을 부를 때만 PyEvaluator 가 다시 잡는다.
+    m.def("mcts_search", [](const SimGame& g, py::object evaluator, int simulations,
+                            int threads, int leaf_batch, double pb_c_base, double pb_c_init,
+                            double discount, int virtual_loss, double dirichlet_alpha,
+                            double dirichlet_frac, uint64_t seed, double budget_ms) {
+        bot::MctsConfig config;
+        config.simulations = simulations;
+        config.threads = threads;
+        config.leafBatch = leaf_batch;
+        config.pbCBase = pb_c_base;
+        config.pbCInit = pb_c_init;
+        config.discount = discount;
+        config.virtualLoss = virtual_loss;
+        config.dirichletAlpha = dirichlet_alpha;
+        config.dirichletFrac = dirichlet_frac;
+        config.seed = seed;
+        config.budgetMs = budget_ms;
+
+        bot::HeuristicEvaluator heuristic;
+        std::unique_ptr<PyEvaluator> callable;
+        bot::Evaluator* eval = &heuristic;
+        if (!evaluator.is_none()) {
+            callable = std::make_unique<PyEvaluator>(std::move(evaluator));
+            eval = callable.get();
+        }
+        bot::MctsResult r;
+        {
+            py::gil_scoped_release release;
+            bot::Mcts mcts(*eval, config);
+            r = mcts.Search(g);
+        }
+        if (callable) callable->Rethrow();
+
+        py::array_t<float> visits(bot::kNumPlacements), prior(bot::kNumPlacements);
+        std::memcpy(visits.mutable_data(), r.visits, sizeof(r.visits));
+        std::memcpy(prior.mutable_data(), r.prior, sizeof(r.prior));
+        py::dict d;
+        d["action"] = r.action;
+        d["visits"] = visits;
+        d["prior"] = prior;
+        d["root_value"] = r.rootValue;
+        d["simulations"] = r.simulations;
+        d["nodes"] = r.nodes;
+        d["max_depth"] = r.maxDepth;
+        d["collisions"] = r.collisions;
+        d["elapsed_ms"] = r.elapsedMs;
+        return d;
+    }, py::arg("sim"), py::arg("evaluator") = py::none(), py::arg("simulations") = 200,
+       py::arg("threads") = 1, py::arg("leaf_batch") = 8, py::arg("pb_c_base") = 19652.0,
+       py::arg("pb_c_init") = 1.25, py::arg("discount") = 0.99, py::arg("virtual_loss") = 1,
+       py::arg("dirichlet_alpha") = 0.0, py::arg("dirichlet_frac") = 0.25,
+       py::arg("seed") = 1, py::arg("budget_ms") = 0.0,
+       "PUCT Monte-Carlo tree search over placements, expanding real SimGame "
+       "copies. evaluator=None uses the built-in heuristic (prior from one-ply "
+       "board scores, value from board shape). Otherwise evaluator(sims) gets a "
+       "list of up to leaf_batch SimGame copies and returns (logits, values) "
+       "shaped (B, 40) and (B,); rewards are lines cleared, like the placement "
+       "env. Returns a dict with action (col*4+rot, -1 if no legal move), "
+       "visits and prior float32 (40,), root_value, simulations, nodes, "
+       "max_depth, collisions and elapsed_ms. threads=1 and leaf_batch=1 make "
+       "the result a function of (state, seed).");
+
+    // 리플레이 코퍼스(core/replay_corpus.h). 입력 뷰는 매핑을 가리키므로 코퍼스 객체를
+    // base 로 잡아 둔다 — 뷰가 살아 있는 동안 매핑이 풀리지 않는다.
+    py::class_<ReplayCorpusWriter>(m, "ReplayCorpusWriter")
+        .def(py::init([](const std::string& path) {
+            auto w = std::make_unique<ReplayCorpusWriter>(path);
+            if (!w->Ok()) throw py::value_error("cannot create corpus: " + path);
+            return w;
+        }), py::arg("path"))
+        .def("add", [](ReplayCorpusWriter& w, uint64_t seed,
+                       const py::array_t<uint8_t, py::array::c_style | py::array::forcecast>& inputs) {
+            if (inputs.ndim() != 2 || inputs.shape(1) != 2)
+                throw py::value_error("inputs: expected shape (ticks, 2) uint8 (p1, p2)");
+            if (!w.Add(seed, reinterpret_cast<const FrameInputs*>(inputs.data()),
+                       static_cast<size_t>(inputs.shape(0))))
+                throw py::value_error("corpus write failed");
+        }, py::arg("seed"), py::arg("inputs"),
+           "Append one match: seed and (ticks, 2) uint8 inputs (p1, p2 masks).")
+        .def("add_file", [](ReplayCorpusWriter& w, const std::string& path) {
+            ReplayData rp;
+            if (!ReplayIO::Load(path, rp)) throw py::value_error("cannot read replay: " + path);
+            if (!w.Add(rp)) throw py::value_error("corpus write failed");
+        }, py::arg("path"), "Append a .trpl (or legacy text) replay file.")
+        .def("finish", [](ReplayCorpusWriter& w) {
+            if (!w.Finish()) throw py::value_error("corpus write failed");
+        }, "Write the index and header. The file is unreadable until this runs.")
+        .def("__len__", &ReplayCorpusWriter::Count);
+
+    py::class_<ReplayCorpus>(m, "ReplayCorpus")
+        .def(py::init([](const std::string& path) {
+            auto c = std::make_unique<ReplayCorpus>();
+            std::string error;
+            if (!c->Open(path, &error)) throw py::value_error(path + ": " + error);
+            return c;
+        }), py::arg("path"),
+           "Memory-map a corpus file. Only the header and index are checked up front.")
+        .def("__len__", &ReplayCorpus::Size)
+        .def_property_readonly("nbytes", &ReplayCorpus::Bytes)
+        .def("seed", [](const ReplayCorpus& c, size_t i) {
+            if (i >= c.Size()) throw py::index_error();
+            return c.Seed(i);
+        }, py::arg("index"))
+        .def("ticks", [](const ReplayCorpus& c, size_t i) {
+            if (i >= c.Size()) throw py::index_error();
+            return c.Ticks(i);
+        }, py::arg("index"))
+        .def("inputs", [](py::object self, size_t i) {
+            const ReplayCorpus& c = self.cast<const ReplayCorpus&>();
+            if (i >= c.Size()) throw py::index_error();
+            const auto ticks = static_cast<py::ssize_t>(c.Ticks(i));
+            py::array_t<uint8_t> view({ticks, py::ssize_t{2}}, {py::ssize_t{2}, py::ssize_t{1}},
+                                      reinterpret_cast<const uint8_t*>(c.Inputs(i)), self);
+            // 매핑은 PROT_READ 라 쓰면 프로세스가 죽는다. numpy 쪽에서 막는다.
+            view.attr("flags").attr("writeable") = false;
+            return view;
+        }, py::arg("index"),
+           "Zero-copy read-only (ticks, 2) uint8 view of match `index` inputs "
+           "(columns p1, p2). The view keeps the corpus mapped.")
+        .def("verify", [](const ReplayCorpus& c, size_t i) {
+            if (i >= c.Size()) throw py::index_error();
+            py::gil_scoped_release release;
+            return c.Verify(i);
+        }, py::arg("index"), "Check match `index` inputs against the index checksum.")
+        .def("decode", [](const ReplayCorpus& c, size_t first, py::ssize_t count, int threads,
+                          uint8_t players, bool skip_idle) {
+            bot::ReplayDecodeConfig config;
+            config.threads = threads;
+            config.players = players;
+            config.skipIdle = skip_idle;
+            const size_t n = count < 0 ? c.Size() : static_cast<size_t>(count);
+            bot::ReplayDecodeResult r;
+            {
+                py::gil_scoped_release release;
+                r = bot::decode_corpus(c, first, n, config);
+            }
+            py::dict d;
+            d["records"] = adopt_vector(std::move(r.records));
+            d["placements"] = r.placements;
+            d["skipped"] = r.skipped;
+            d["ticks"] = r.ticks;
+            d["replays"] = r.replays;
+            d["threads"] = r.threads;
+            d["seconds"] = r.seconds;
+            return d;
+        }, py::arg("first") = 0, py::arg("count") = -1, py::arg("threads") = 0,
+           py::arg("players") = 3, py::arg("skip_idle") = true,
+           "Resimulate matches [first, first+count) across `threads` workers "
+           "(0 = all cores) into one record per piece lock: the observation when "
+           "the piece spawned and its placement (action = col*4+rot). Returns a "
+           "dict with `records`, a structured array in the self-play record "
+           "layout (match, ply, player, action, board uint16[20] row bits, "
+           "current, next, pendingGarbage, linesCleared, attackSent, outcome, "
+           "legalMask), plus counters. players is a bitmask of boards to record; "
+           "skip_idle drops pieces that fell without any input. Output does not "
+           "depend on the thread count.");
 }
@@ -0,0 +1,162 @@
+#include "arena.h"
+#include "placement.h"
+#include "../core/constants.h"
+#include "../core/input.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace bot {
+
+double ArenaResult::ScoreA() const
+{
+    const int n = winsA + winsB + draws;
+    return n > 0 ? (winsA + 0.5 * draws) / n : 0.0;
+}
+
+double ArenaResult::AttackPerMinute(int player) const
+{
+    const double minutes = static_cast<double>(ticks) / (60.0 * TICKS_PER_SECOND);
+    return minutes > 0.0 ? static_cast<double>(attack[player]) / minutes : 0.0;
+}
+
+TickDriver::TickDriver(PlacementPolicy policy, int inputIntervalTicks)
+    : policy_(std::move(policy)), interval_(std::max(1, inputIntervalTicks))
+{
+}
+
+uint8_t TickDriver::NextInput(const SimGame& live)
+{
+    if (live.IsGameOver()) return INPUT_NONE;
+
+    const uint64_t key = piece_key(live);
+    if (!havePiece_ || key != pieceKey_) {
+        // 새 블록. 입력 간격이 길면 드롭 전에 중력으로 lock 될 수 있으니 남은 입력은 버린다.
+        havePiece_ = true;
+        pieceKey_ = key;
+        queue_.clear();
+        ++pieces_;
+        int col = 0, rot = 0;
+        if (policy_(live, col, rot) || fallback_placement(live, col, rot)) {
+            for (uint8_t m : expand_placement(live.CurrentCol(), live.CurrentRotation(), col, rot))
+                queue_.push_back(m);
+        }
+    }
+
+    if (cooldown_ > 0) {
+        --cooldown_;
+        return INPUT_NONE;
+    }
+    if (queue_.empty()) return INPUT_NONE;
+    const uint8_t mask = queue_.front();
+    queue_.pop_front();
+    cooldown_ = interval_ - 1;
+    return mask;
+}
+
+ArenaMatchResult play_arena_match(uint64_t seed, PlacementPolicy (&policy)[2],
+                                  const ArenaConfig& config)
+{
+    SimGame board[2] = {SimGame(seed), SimGame(seed)};
+    TickDriver driver[2] = {TickDriver(policy[0], config.inputIntervalTicks[0]),
+                            TickDriver(policy[1], config.inputIntervalTicks[1])};
+    int lastAttack[2] = {0, 0};
+
+    ArenaMatchResult r;
+    while (!board[0].IsGameOver() && !board[1].IsGameOver() && r.ticks < config.maxTicks) {
+        // main.cpp lockstep 과 같은 순서: 양쪽 입력 → 양쪽 Tick → 공격 델타 교환.
+        const uint8_t in0 = driver[0].NextInput(board[0]);
+        const uint8_t in1 = driver[1].NextInput(board[1]);
+        board[0].SubmitInput(in0);
+        board[1].SubmitInput(in1);
+        board[0].Tick();
+        board[1].Tick();
+        for (int p = 0; p < 2; ++p) {
+            const int att = board[p].AttackLinesSent() - lastAttack[p];
+            if (att > 0) board[1 - p].AddPendingGarbage(att);
+            lastAttack[p] = board[p].AttackLinesSent();
+        }
+        ++r.ticks;
+    }
+
+    const bool deadA = board[0].IsGameOver();
+    const bool deadB = board[1].IsGameOver();
+    r.winner = deadA == deadB ? -1 : (deadA ? 1 : 0);
+    for (int p = 0; p < 2; ++p) {
+        r.attack[p] = board[p].AttackLinesSent();
+        r.lines[p] = board[p].totalLinesCleared;
+        r.pieces[p] = driver[p].Pieces();
+    }
+    return r;
+}
+
+ArenaResult run_arena(const ArenaConfig& config, const PolicyFactory& policies)
+{
+    const int matches = std::max(0, config.matches);
+    int threads = config.threads > 0 ? config.threads
+                                     : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    if (matches > 0 && threads > matches) threads = matches;
+
+    ArenaResult result;
+    result.matches.resize(matches);
+    result.threads = threads;
+    const auto started = std::chrono::steady_clock::now();
+
+    // 틱 단위 매치는 길이가 고르지 않아도 한 판이 짧으므로 다음 번호를 하나씩
+    // 집어 가는 것으로 충분하다.
+    std::atomic<int> next{0};
+    auto worker = [&](int w) {
+        PlacementPolicy policy[2] = {policies(w, 0), policies(w, 1)};
+        for (;;) {
+            const int m = next.fetch_add(1);
+            if (m >= matches) break;
+            result.matches[m] = play_arena_match(
+                match_seed(config.seed, static_cast<uint64_t>(m), 0), policy, config);
+        }
+    };
+
+    if (threads == 1) {
+        worker(0);
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int w = 0; w < threads; ++w) pool.emplace_back(worker, w);
+        for (auto& t : pool) t.join();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    for (const ArenaMatchResult& r : result.matches) {
+        if (r.winner == 0)      ++result.winsA;
+        else if (r.winner == 1) ++result.winsB;
+        else                    ++result.draws;
+        result.ticks += r.ticks;
+        for (int p = 0; p < 2; ++p) {
+            result.attack[p] += r.attack[p];
+            result.lines[p] += r.lines[p];
+            result.pieces[p] += r.pieces[p];
+        }
+    }
+    return result;
+}
+
+void wilson_interval(double successes, int n, double z, double& lo, double& hi)
+{
+    if (n <= 0) {
+        lo = 0.0;
+        hi = 1.0;
+        return;
+    }
+    const double p = successes / n;
+    const double z2 = z * z;
+    const double denom = 1.0 + z2 / n;
+    const double centre = (p + z2 / (2.0 * n)) / denom;
+    const double half = z * std::sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / denom;
+    lo = std::max(0.0, centre - half);
+    hi = std::min(1.0, centre + half);
+}
+
+}  // namespace bot
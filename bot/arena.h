@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "../src/sim_game.h"
+#include "selfplay.h"
+
+// 헤드리스 봇 대 봇 토너먼트.
+//
+// self-play(bot/selfplay.h)는 착수 단위로 번갈아 둔다. 모델을 내보내기 전에 재는
+// 승률은 실제 대전과 같은 조건이어야 하므로 여기서는 main.cpp 의 lockstep 루프를
+// 틱 단위로 그대로 흉내 낸다:
+//   - 두 보드는 같은 시드로 만든다(같은 블록 순서, BotSingle·Net 과 같다).
+//   - 봇은 블록마다 (col, rot) 를 고르고 expand_placement 로 펼친 입력을
+//     inputIntervalTicks 마다 하나씩 SubmitInput 한다(bots.cfg 의 속도).
+//   - 매 틱 양쪽 SubmitInput → Tick 뒤 누적 공격의 델타를 상대 AddPendingGarbage 로.
+// 그래서 attack/min 은 60Hz 게임 시간 기준이다.
+//
+// 매치는 워커 스레드들이 원자 카운터로 하나씩 집는다. 결과는 매치 번호 자리에
+// 쓰므로 스레드 수와 무관하게 같다(정책이 결정론적일 때).
+
+namespace bot {
+
+struct ArenaConfig
+{
+    int      threads  = 0;              // 0 이면 std::thread::hardware_concurrency()
+    int      matches  = 256;
+    uint64_t seed     = 1;
+    int      maxTicks = 60 * 60 * 10;   // 게임 시간 10분. 넘으면 무승부
+    int      inputIntervalTicks[2] = {1, 1};   // 플레이어별 입력 간격(틱)
+};
+
+struct ArenaMatchResult
+{
+    int     winner = -1;                // 0=A, 1=B, -1=무승부(동시 탑아웃 또는 maxTicks)
+    int     ticks = 0;
+    int     attack[2] = {0, 0};         // 보낸 공격 줄 수
+    int     lines[2] = {0, 0};
+    int     pieces[2] = {0, 0};         // 정책을 부른 블록 수
+};
+
+struct ArenaResult
+{
+    std::vector<ArenaMatchResult> matches;   // 매치 번호 순
+    int     winsA = 0, winsB = 0, draws = 0;
+    int64_t ticks = 0;
+    int64_t attack[2] = {0, 0};
+    int64_t lines[2] = {0, 0};
+    int64_t pieces[2] = {0, 0};
+    int     threads = 0;
+    double  seconds = 0.0;
+
+    // A 의 점수율. 무승부는 반 승.
+    double ScoreA() const;
+    // 플레이어 하나의 게임 시간 1분당 공격.
+    double AttackPerMinute(int player) const;
+};
+
+// 정책 하나를 lockstep 틱 루프에 붙이는 드라이버. main.cpp 의 BotSingle 봇 입력과
+// 같은 규칙이되 탐색은 그 틱 안에서 동기로 끝낸다(결정론).
+class TickDriver
+{
+public:
+    TickDriver(PlacementPolicy policy, int inputIntervalTicks);
+
+    // 이번 틱에 SubmitInput 할 마스크. 새 블록이면 정책을 부른다.
+    uint8_t NextInput(const SimGame& live);
+    int Pieces() const { return pieces_; }
+
+private:
+    PlacementPolicy policy_;
+    int interval_;
+    bool havePiece_ = false;
+    uint64_t pieceKey_ = 0;
+    int cooldown_ = 0;
+    int pieces_ = 0;
+    std::deque<uint8_t> queue_;
+};
+
+// 한 판. 두 보드 모두 seed 로 만든다.
+ArenaMatchResult play_arena_match(uint64_t seed, PlacementPolicy (&policy)[2],
+                                  const ArenaConfig& config);
+
+ArenaResult run_arena(const ArenaConfig& config, const PolicyFactory& policies);
+
+// 성공 비율 p̂ = successes / n 의 Wilson 점수 구간. z = 1.96 이면 95%.
+void wilson_interval(double successes, int n, double z, double& lo, double& hi);
+
+}  // namespace bot
@@ -0,0 +1,181 @@
+#include "async_bot.h"
+#include "placement.h"
+#include "../core/input.h"
+
+#include <chrono>
+
+namespace bot {
+
+AsyncBot::AsyncBot(Planner planner, const AsyncBotConfig& config)
+    : planner_(std::move(planner)), config_(config)
+{
+    worker_ = std::thread([this] { Run(); });
+}
+
+AsyncBot::~AsyncBot()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        job_.reset();
+    }
+    cancel_.store(true);
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+uint8_t AsyncBot::NextInput(const SimGame& live)
+{
+    if (live.IsGameOver()) return INPUT_NONE;
+
+    const uint64_t key = piece_key(live);
+    if (!havePiece_ || key != pieceKey_) {
+        // 새 블록. 옛 블록 입력이 남았으면(드롭 전에 lock 됐다) 버리고 다시 생각한다.
+        havePiece_ = true;
+        planned_ = false;
+        pieceKey_ = key;
+        waitTicks_ = 0;
+        queue_.clear();
+        Submit(live);
+    }
+
+    if (!planned_) {
+        int col = 0, rot = 0;
+        bool ok = false;
+        if (TakeResult(col, rot, ok)) {
+            if (!ok) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++stats_.failures;
+            }
+            Plan(live, col, rot, ok);
+        } else if (config_.maxWaitTicks > 0 && ++waitTicks_ > config_.maxWaitTicks) {
+            // 블록이 바닥에 닿도록 답이 없으면 아무 수라도 둔다. 늦게 온 답은 낡은 답이 된다.
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                cancel_.store(true);
+                ++generation_;
+                job_.reset();
+                ++stats_.timeouts;
+            }
+            Plan(live, 0, 0, false);
+        }
+    }
+
+    if (cooldown_ > 0) {
+        --cooldown_;
+        return INPUT_NONE;
+    }
+    if (queue_.empty()) return INPUT_NONE;
+    const uint8_t mask = queue_.front();
+    queue_.pop_front();
+    cooldown_ = config_.inputIntervalTicks - 1;
+    return mask;
+}
+
+void AsyncBot::Plan(const SimGame& live, int col, int rot, bool ok)
+{
+    planned_ = true;
+    if (!ok) ok = fallback_placement(live, col, rot);
+    if (!ok) return;   // 둘 곳이 없다 — 게임 오버 직전. 중력에 맡긴다
+    // 답을 기다리는 동안 중력만 받았으므로 열·회전은 스폰 때 그대로다.
+    for (uint8_t m : expand_placement(live.CurrentCol(), live.CurrentRotation(), col, rot))
+        queue_.push_back(m);
+}
+
+void AsyncBot::Submit(const SimGame& live)
+{
+    std::unique_ptr<SimGame> copy(new SimGame(live));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // 돌고 있는 탐색이 있으면 그것은 이제 낡았다. 새 요청을 올리기 전에, 잠금 안에서
+        // 올린다 — 잠금 밖에서 올리면 스레드가 그 틈에 새 요청을 집어 cancel 을 내린 뒤
+        // 늦게 온 이 store 가 새 탐색을 끊고, 세대가 맞는 잘린 답이 그대로 쓰인다.
+        cancel_.store(true);
+        ++generation_;
+        job_ = std::move(copy);
+    }
+    cv_.notify_one();
+}
+
+bool AsyncBot::TakeResult(int& col, int& rot, bool& ok)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!resultReady_ || resultGeneration_ != generation_) return false;
+    resultReady_ = false;
+    col = resultCol_;
+    rot = resultRot_;
+    ok = resultOk_;
+    return true;
+}
+
+void AsyncBot::Reset()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    cancel_.store(true);
+    ++generation_;
+    job_.reset();
+    resultReady_ = false;
+    cv_.wait(lock, [this] { return !busy_; });
+    lock.unlock();
+
+    havePiece_ = false;
+    planned_ = false;
+    waitTicks_ = 0;
+    cooldown_ = 0;
+    queue_.clear();
+}
+
+AsyncBotStats AsyncBot::Stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void AsyncBot::ResetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = AsyncBotStats{};
+}
+
+void AsyncBot::Run()
+{
+    using Clock = std::chrono::steady_clock;
+    for (;;) {
+        std::unique_ptr<SimGame> sim;
+        uint64_t generation;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            busy_ = false;
+            cv_.notify_all();   // Reset 이 기다린다
+            cv_.wait(lock, [this] { return stopping_ || job_; });
+            if (stopping_) return;
+            sim = std::move(job_);
+            generation = generation_;
+            busy_ = true;
+            // cancel 을 올리는 쪽(Submit·타임아웃·Reset)도 모두 이 잠금 안에서 올리므로,
+            // 여기서 내린 뒤에 오른 cancel 은 이 탐색을 낡게 만든 요청의 것뿐이다.
+            cancel_.store(false);
+        }
+
+        int col = 0, rot = 0;
+        const auto start = Clock::now();
+        const bool ok = planner_(*sim, cancel_, col, rot);
+        const uint64_t ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.searches;
+        stats_.thinkNs.Record(ns);
+        if (generation != generation_) {
+            ++stats_.stale;
+            continue;
+        }
+        resultReady_ = true;
+        resultGeneration_ = generation;
+        resultOk_ = ok;
+        resultCol_ = col;
+        resultRot_ = rot;
+    }
+}
+
+}  // namespace bot
@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "../src/sim_game.h"
+#include "latency_histogram.h"
+
+// 게임 스레드 밖에서 착수를 고르는 봇 컨트롤러.
+//
+// 예전에는 블록이 나올 때마다 게임 루프가 봇(heuristic/beam/MCTS/ONNX)을 직접
+// 불렀다. 탐색이 길어지면 그 틱 동안 렌더와 lockstep 틱이 같이 멈춘다.
+//
+// AsyncBot 은 전담 스레드 하나를 둔다. 게임 스레드는 매 틱 NextInput 만 부른다.
+//   - 새 블록이 보이면 봇 보드를 통째로 복사해 스레드에 넘기고 곧바로 돌아온다.
+//   - 답이 오기 전까지는 INPUT_NONE 을 낸다(블록은 중력대로 떨어진다).
+//   - 답이 오면 expand_placement 로 펼친 입력을 inputIntervalTicks 마다 하나씩 낸다.
+//   - 블록이 바뀌었는데 옛 탐색이 아직 돌고 있으면 cancel 신호를 올리고 그 답은 버린다.
+// 스레드에는 가장 최근 요청 하나만 쌓이므로 낡은 탐색이 줄을 서는 일은 없다.
+//
+// planner 는 그 스레드에서만 불린다. planner 가 쓰는 객체(BotOnnx, Mcts, 전치표)를
+// 게임 스레드에서 만지려면(모델 교체, 지연 통계 읽기) 먼저 Reset 으로 스레드를 쉬게 한다.
+
+namespace bot {
+
+struct AsyncBotConfig
+{
+    int inputIntervalTicks = 1;   // 입력 하나마다 걸리는 틱 수(bots.cfg 둘째 칸). 1 = 매 틱
+    int maxWaitTicks = 30;        // 답을 기다리는 최대 틱 수. 넘기면 fallback_placement. 0 이하면 끝까지 기다린다
+};
+
+struct AsyncBotStats
+{
+    uint64_t searches = 0;        // 스레드가 끝낸 탐색 수
+    uint64_t stale = 0;           // 끝났지만 블록이 이미 바뀌어 버린 답
+    uint64_t timeouts = 0;        // maxWaitTicks 를 넘겨 fallback 으로 둔 블록
+    uint64_t failures = 0;        // planner 가 false 를 내 fallback 으로 둔 블록
+    LatencyHistogram thinkNs;     // 탐색 한 번의 벽시계 시간
+};
+
+class AsyncBot
+{
+public:
+    // sim 에서 둘 (col, rot) 를 고른다. cancel 이 true 가 되면 답이 버려지므로 되도록
+    // 빨리 돌아오면 된다(BeamConfig::cancel / MctsConfig::cancel 로 넘기면 된다).
+    using Planner = std::function<bool(const SimGame& sim, const std::atomic<bool>& cancel,
+                                       int& col_out, int& rot_out)>;
+
+    explicit AsyncBot(Planner planner, const AsyncBotConfig& config = AsyncBotConfig{});
+    ~AsyncBot();
+
+    AsyncBot(const AsyncBot&) = delete;
+    AsyncBot& operator=(const AsyncBot&) = delete;
+
+    // 게임 스레드에서 틱마다 한 번. live 는 봇 보드이고, 돌려준 마스크를 그 틱에
+    // SubmitInput 하면 된다. 봇 스레드를 기다리지 않는다.
+    uint8_t NextInput(const SimGame& live);
+
+    // 돌고 있는 탐색에 cancel 을 올리고 끝날 때까지 기다린 뒤 입력 큐를 비운다.
+    // 판이 끝났을 때, 봇을 바꾸기 전에 부른다.
+    void Reset();
+
+    // 게임 스레드에서만 읽으므로 언제 바꿔도 된다. 다음 입력부터 적용.
+    void SetConfig(const AsyncBotConfig& config)
+    {
+        config_ = config;
+        if (cooldown_ >= config_.inputIntervalTicks) cooldown_ = config_.inputIntervalTicks - 1;
+    }
+    const AsyncBotConfig& Config() const { return config_; }
+
+    // 지금 블록의 답을 기다리는 중이면 true.
+    bool Thinking() const { return havePiece_ && !planned_; }
+
+    AsyncBotStats Stats() const;
+    void ResetStats();
+
+private:
+    void Submit(const SimGame& live);
+    bool TakeResult(int& col, int& rot, bool& ok);
+    void Plan(const SimGame& live, int col, int rot, bool ok);
+    void Run();
+
+    Planner planner_;
+    AsyncBotConfig config_;
+
+    // 게임 스레드만 만진다.
+    bool havePiece_ = false;
+    bool planned_ = false;
+    uint64_t pieceKey_ = 0;
+    int waitTicks_ = 0;
+    int cooldown_ = 0;
+    std::deque<uint8_t> queue_;
+
+    // 아래는 mutex_ 가 지킨다.
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<SimGame> job_;     // 아직 시작 안 한 가장 최근 요청
+    uint64_t generation_ = 0;          // 요청마다 +1. 답의 세대가 다르면 낡은 답이다
+    bool busy_ = false;
+    bool stopping_ = false;
+    bool resultReady_ = false;
+    uint64_t resultGeneration_ = 0;
+    bool resultOk_ = false;
+    int resultCol_ = 0, resultRot_ = 0;
+    AsyncBotStats stats_;
+
+    std::atomic<bool> cancel_{false};  // 돌고 있는 탐색이 낡았다
+    std::thread worker_;
+};
+
+}  // namespace bot
@@ -0,0 +1,208 @@
+#include "beam_search.h"
+#include "placement.h"
+#include "../core/rng.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <vector>
+
+namespace bot {
+
+namespace {
+
+// 펼친 자식 하나. 보드 자체는 저장하지 않는다 — 상위 width 개로 고른 뒤에만
+// 부모 복사 + 착수로 다시 만든다. 후보는 깊이마다 width*40 개까지 나오는데
+// 그중 대부분은 버려지므로 SimGame(1.3KB) 을 후보마다 들고 있을 이유가 없다.
+struct Candidate
+{
+    double score;
+    int parent;              // 이전 깊이 beam 의 인덱스
+    SimGame::LandedPlacement move;
+    int rootAction;          // 깊이 0 의 encode_action(col, rot)
+    int lines;               // 수순 전체에서 지운 줄 수
+};
+
+struct Node
+{
+    SimGame sim;
+    uint64_t key;            // sim.PositionKey()
+    int rootAction;
+    int lines;
+};
+
+// 점수 내림차순. 동점은 (부모, 회전, 열) 순이라 같은 입력이면 항상 같은 수를 고른다.
+bool better(const Candidate& a, const Candidate& b)
+{
+    if (a.score != b.score) return a.score > b.score;
+    if (a.parent != b.parent) return a.parent < b.parent;
+    if (a.move.rot != b.move.rot) return a.move.rot < b.move.rot;
+    return a.move.col < b.move.col;
+}
+
+// 전치표 키는 세 가지다. 보드 모양 점수는 그 판의 PositionKey 그대로. 착수 결과는
+// (착수 전 위치, 수)로 정해지므로 그 쌍으로도 담는다 — 적중하면 자식을 만들 필요도
+// 없다. 루트 답은 (위치, width, depth) 마다 다르다. 키 공간이 섞이지 않게 서로 다른
+// 상수로 섞는다.
+uint64_t edge_key(uint64_t positionKey, int action)
+{
+    return splitmix64(positionKey ^ 0x5EA4C4EDull ^ static_cast<uint64_t>(action + 1) << 40);
+}
+
+uint64_t root_key(uint64_t positionKey, int width, int depth)
+{
+    return splitmix64(positionKey ^ 0xB3A4C0DEull
+                      ^ static_cast<uint64_t>(width) << 32 ^ static_cast<uint64_t>(depth) << 48);
+}
+
+// 자식 평가 엔트리의 aux: [0..2] 지운 줄 수, [3] 게임 오버.
+constexpr uint16_t kEdgeGameOver = 1u << 3;
+
+// 보드 모양 점수. 다른 순서로 같은 판에 온 자식은 PositionKey 로 찾아 다시 쓴다.
+double shape_of(const SimGame& child, TranspositionTable* table, BeamStats& st)
+{
+    if (!table) return eval_shape(child);
+    const uint64_t key = child.PositionKey();
+    TTEntry cached;
+    if (table->Probe(key, cached)) {
+        ++st.tableHits;
+        return cached.value;
+    }
+    TTEntry entry;
+    entry.value = eval_shape(child);
+    table->Store(key, entry);
+    return entry.value;
+}
+
+}  // namespace
+
+bool beam_placement(const SimGame& sim, const BeamConfig& config,
+                    int& col_out, int& rot_out, BeamStats* stats)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    const int width = std::max(1, config.width);
+    const int depth = std::max(1, std::min(config.depth, 1 + SimGame::kNextPreviewCount));
+
+    BeamStats local;
+    BeamStats& st = stats ? *stats : local;
+    st = BeamStats{};
+
+    TranspositionTable* table = config.table;
+    const uint64_t rootPosition = sim.PositionKey();
+    const uint64_t rootKey = root_key(rootPosition, width, depth);
+    if (table) {
+        TTEntry hit;
+        if (table->Probe(rootKey, hit) && hit.depth >= depth && hit.bestAction != TTEntry::kNoAction) {
+            decode_action(hit.bestAction, col_out, rot_out);
+            st.rootHit = true;
+            st.depthReached = hit.depth;
+            st.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            return true;
+        }
+    }
+
+    std::vector<Node> beam;
+    beam.reserve(static_cast<size_t>(width));
+    beam.push_back({sim, rootPosition, -1, 0});
+    std::vector<Candidate> candidates;
+    candidates.reserve(static_cast<size_t>(width) * SimGame::kMaxPlacements);
+
+    int bestAction = -1;
+    double bestScore = 0.0;
+    for (int d = 0; d < depth; ++d) {
+        if (d > 0 && config.cancel && config.cancel->load(std::memory_order_relaxed)) {
+            st.timedOut = true;
+            break;
+        }
+        if (d > 0 && config.budgetMs > 0) {
+            const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (ms >= config.budgetMs) { st.timedOut = true; break; }
+        }
+
+        candidates.clear();
+        for (int i = 0; i < static_cast<int>(beam.size()); ++i) {
+            const Node& node = beam[i];
+            SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+            // 대칭 중복은 같은 자식 보드라 빼도 beam 이 같다(better 는 rot 가 작은 쪽을 남긴다).
+            const int n = node.sim.EnumerateDistinctPlacements(landed);
+            uint64_t keys[SimGame::kMaxPlacements];
+            if (table) {
+                for (int k = 0; k < n; ++k) {
+                    keys[k] = edge_key(node.key, encode_action(landed[k].col, landed[k].rot));
+                    table->Prefetch(keys[k]);
+                }
+            }
+            for (int k = 0; k < n; ++k) {
+                const int action = encode_action(landed[k].col, landed[k].rot);
+                int cleared;
+                bool over;
+                double shape = 0.0;
+                TTEntry cached;
+                const uint64_t key = table ? keys[k] : 0;
+                if (table && table->Probe(key, cached)) {
+                    cleared = cached.aux & 7;
+                    over = (cached.aux & kEdgeGameOver) != 0;
+                    shape = cached.value;
+                    ++st.tableHits;
+                } else {
+                    SimGame child = node.sim;
+                    cleared = child.ApplyLandedPlacement(landed[k]);
+                    if (cleared < 0) continue;
+                    over = child.IsGameOver();
+                    if (!over) shape = shape_of(child, table, st);
+                    if (table) {
+                        TTEntry entry;
+                        entry.value = shape;
+                        entry.aux = static_cast<uint16_t>(cleared | (over ? kEdgeGameOver : 0));
+                        table->Store(key, entry);
+                    }
+                }
+                ++st.nodes;
+                const int lines = node.lines + cleared;
+                const double score = over ? -std::numeric_limits<double>::infinity()
+                                          : shape + eval_lines(lines);  // == eval_board(grid, lines)
+                const int rootAction = d == 0 ? action : node.rootAction;
+                candidates.push_back({score, i, landed[k], rootAction, lines});
+            }
+        }
+        if (candidates.empty()) break;  // 모든 beam 보드가 막혔다 — 이전 깊이의 답을 쓴다
+
+        std::sort(candidates.begin(), candidates.end(), better);
+        bestAction = candidates.front().rootAction;
+        bestScore = candidates.front().score;
+        st.depthReached = d + 1;
+        if (d + 1 == depth) break;
+
+        // 상위 width 개의 서로 다른 보드로 다음 beam 을 만든다. 같은 판인지는 만든
+        // 뒤의 PositionKey 로 본다 — 후보 단계에서는 보드가 없을 수 있다.
+        std::vector<Node> next;
+        next.reserve(static_cast<size_t>(width));
+        for (const Candidate& c : candidates) {
+            if (static_cast<int>(next.size()) == width) break;
+            if (c.score == -std::numeric_limits<double>::infinity()) break;
+            Node child{beam[c.parent].sim, 0, c.rootAction, c.lines};
+            child.sim.ApplyLandedPlacement(c.move);
+            child.key = child.sim.PositionKey();
+            const bool seen = std::any_of(next.begin(), next.end(),
+                                          [&](const Node& other) { return other.key == child.key; });
+            if (!seen) next.push_back(child);
+        }
+        if (next.empty()) break;
+        beam.swap(next);
+    }
+
+    st.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (bestAction < 0) return false;
+    if (table) {
+        TTEntry entry;
+        entry.value = bestScore;
+        entry.bestAction = static_cast<uint8_t>(bestAction);
+        entry.depth = static_cast<uint8_t>(st.depthReached);
+        table->Store(rootKey, entry);
+    }
+    decode_action(bestAction, col_out, rot_out);
+    return true;
+}
+
+}  // namespace bot
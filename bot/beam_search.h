@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "../src/sim_game.h"
+#include "transposition.h"
+
+// 미리보기 큐를 읽는 beam search 착수 엔진.
+//
+// heuristic_placement 는 지금 블록 한 수만 둬 보고 고른다. 여기서는 지금 블록과
+// 미리보기(SimGame::kNextPreviewCount 개)까지 차례로 둬 보며 수순을 넓힌다.
+//
+//   깊이 0: 지금 블록의 합법 수 전부 → 자식 보드
+//   깊이 d: 살아남은 보드마다 그 보드의 지금 블록(= 루트의 미리보기 d-1) 합법 수 전부
+//   각 깊이에서 점수 상위 width 개만 남긴다(beam). 같은 보드로 이어지는 수순은
+//   Fingerprint 로 하나만 남긴다.
+//
+// 점수는 eval_board(잎 보드, 수순 전체에서 지운 줄 수) 다. heuristic_placement 와
+// 같은 평가 함수라 depth=1 이면 같은 수를 고른다(게임 오버로 끝나는 수를 맨 뒤로
+// 미는 것만 다르다). 고른 수는 점수가 가장 높은 잎의 첫 수다.
+//
+// 보이는 블록만 쓴다. 깊이는 1 + kNextPreviewCount 를 넘지 않으므로 아직 가방에서
+// 뽑히지 않은 블록(복사본 SimGame 은 알고 있다)을 엿보지 않는다. 단, 받을 가비지의
+// 구멍 열은 복사본의 garbageRng 로 정해지므로 그만큼은 실제 게임보다 더 안다.
+//
+// 시간 예산: budgetMs > 0 이면 깊이마다 시계를 보고, 예산을 넘으면 더 내려가지
+// 않고 마지막으로 끝낸 깊이의 최선 수를 낸다. 깊이 0 은 항상 끝내므로 답이 없는
+// 일은 없다. 예산이 걸리면 결과가 기계 속도에 따라 달라지므로, 재현이 필요한
+// 곳(self-play, 테스트)은 budgetMs = 0 으로 깊이만으로 제한한다.
+//
+// 전치표(table): 주면 두 가지를 담는다. 자식 보드의 모양 점수(eval_shape)를
+// PositionKey 로 담아, 다른 순서로 같은 판에 오거나 다음 수의 탐색이 같은 판을 다시
+// 펼칠 때 평가를 건너뛴다. 또 루트 위치 + (width, depth) 로 고른 수를 담아 같은
+// 위치를 다시 물으면 탐색 없이 답한다. 담는 값은 키로 정해지는 값뿐이라 표가 있든
+// 없든, 여러 스레드가 나눠 쓰든 고르는 수는 같다.
+
+namespace bot {
+
+struct BeamConfig
+{
+    int width = 24;          // 깊이마다 남길 보드 수
+    int depth = 1 + SimGame::kNextPreviewCount;  // 둬 볼 블록 수 (1..4)
+    double budgetMs = 4.0;   // 한 수 시간 예산. 0 이하면 무제한
+    TranspositionTable* table = nullptr;  // 공유 전치표(소유하지 않음). nullptr 이면 안 쓴다
+    // 밖에서 멈추라는 신호(bot/async_bot.h 가 낡은 탐색을 버릴 때). true 가 되면
+    // 예산이 다 된 것처럼 다음 깊이로 내려가지 않는다. nullptr 이면 안 본다.
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+struct BeamStats
+{
+    int nodes = 0;           // 평가한 자식 보드 수
+    int depthReached = 0;    // 끝까지 펼친 깊이 수
+    bool timedOut = false;   // 예산(또는 cancel) 때문에 depth 전에 멈췄다
+    bool rootHit = false;    // 전치표에 있던 루트 답을 그대로 냈다
+    int tableHits = 0;       // 전치표에서 가져온 자식 평가 수
+    double elapsedMs = 0.0;
+};
+
+// 지금 블록을 어디에 둘지 고른다. 합법 수가 없으면 false.
+bool beam_placement(const SimGame& sim, const BeamConfig& config,
+                    int& col_out, int& rot_out, BeamStats* stats = nullptr);
+
+}  // namespace bot
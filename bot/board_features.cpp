@@ -0,0 +1,163 @@
+// 보드 특징 추출. 정의는 board_features.h.
+#include "board_features.h"
+
+#include "../src/sim_game.h"
+
+namespace bot {
+
+const char* const kBoardFeatureNames[kNumBoardFeatures] = {
+    "aggregate_height", "max_height", "bumpiness", "holes",
+    "wells", "row_transitions", "col_transitions", "covered_cells",
+};
+
+namespace {
+
+constexpr uint32_t kFullRow = (1u << kBoardCols) - 1;
+// 행을 한 칸 올려 좌우에 벽 비트를 붙인 12비트 lane. 이웃 비트끼리 XOR 하면
+// 벽-열0, 열0-열1, ..., 열9-벽 의 11쌍이 한 번에 나온다.
+constexpr uint32_t kWalls = 1u | (1u << (kBoardCols + 1));
+constexpr uint32_t kPairs = (1u << (kBoardCols + 1)) - 1;
+
+// 세는 마스크 넷(구멍, 행 전환, 열 전환, 덮인 칸)을 64비트 하나의 16비트 칸에
+// 나란히 담아 한꺼번에 센다. popcount 를 바이트 단위까지만 접어 두면(바이트당
+// 최대 8) 20행을 더해도 바이트당 160 이라 넘치지 않으므로, 행마다 접기 세 단계와
+// 덧셈 하나로 네 값이 동시에 쌓인다. 마지막에 칸마다 두 바이트를 합친다.
+constexpr int kLaneHoles = 0, kLaneRowTrans = 16, kLaneColTrans = 32, kLaneCovered = 48;
+
+inline uint64_t byte_popcounts(uint64_t v)
+{
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+    return (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+}
+
+inline int lane_count(uint64_t acc, int lane)
+{
+    return static_cast<int>(((acc >> lane) & 0xFF) + ((acc >> (lane + 8)) & 0xFF));
+}
+
+inline int lowest_bit(uint32_t v)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(v);
+#endif
+}
+
+}  // namespace
+
+void board_rows(const SimGame& sim, BoardRows& out)
+{
+    for (int r = 0; r < kBoardRows; ++r) out[r] = sim.RowMask(r);
+}
+
+void board_rows(const int (&grid)[kBoardRows][kBoardCols], BoardRows& out)
+{
+    for (int r = 0; r < kBoardRows; ++r) {
+        uint32_t mask = 0;
+        for (int c = 0; c < kBoardCols; ++c) {
+            const int v = grid[r][c];
+            mask |= static_cast<uint32_t>(v > 0 && v != 8) << c;
+        }
+        out[r] = static_cast<uint16_t>(mask);
+    }
+}
+
+int board_surface(const BoardRows& rows, int32_t (&heights)[kBoardCols])
+{
+    for (int c = 0; c < kBoardCols; ++c) heights[c] = 0;
+    uint32_t above = 0;
+    uint64_t counts = 0;
+    for (int r = 0; r < kBoardRows; ++r) {
+        const uint32_t row = rows[r];
+        for (uint32_t fresh = row & ~above; fresh; fresh &= fresh - 1)
+            heights[lowest_bit(fresh)] = kBoardRows - r;
+        above |= row;
+        counts += byte_popcounts(above & ~row);
+    }
+    return lane_count(counts, 0);
+}
+
+void board_features(const BoardRows& rows, int32_t (&out)[kNumBoardFeatures], int32_t* heights_out)
+{
+    int32_t heights[kBoardCols] = {0};
+    uint32_t holeRows[kBoardRows];
+    uint32_t above = 0;   // 지금 행까지 한 번이라도 찬 열들 = 높이가 정해진 열들
+    uint32_t prev = 0;    // 바로 윗행. 맨 위 바깥은 빈 칸으로 친다
+    uint64_t counts = 0;  // kLane* 칸별 바이트 popcount 누적
+
+    // 위에서 아래로: 열이 처음 차는 행에서 높이가 정해지고, 그 아래 빈 칸은 전부 구멍이다.
+    for (int r = 0; r < kBoardRows; ++r) {
+        const uint32_t row = rows[r];
+        for (uint32_t fresh = row & ~above; fresh; fresh &= fresh - 1)
+            heights[lowest_bit(fresh)] = kBoardRows - r;
+        above |= row;
+        holeRows[r] = above & ~row;
+        const uint32_t lane = (row << 1) | kWalls;
+        counts += byte_popcounts(static_cast<uint64_t>(holeRows[r]) << kLaneHoles
+                               | static_cast<uint64_t>((lane ^ (lane >> 1)) & kPairs) << kLaneRowTrans
+                               | static_cast<uint64_t>(prev ^ row) << kLaneColTrans);
+        prev = row;
+    }
+    counts += byte_popcounts(static_cast<uint64_t>(prev ^ kFullRow) << kLaneColTrans);
+
+    // 아래에서 위로: 자기보다 아래에 구멍이 있는 열의 찬 칸이 구멍을 덮는 칸이다.
+    uint32_t holesBelow = 0;
+    for (int r = kBoardRows - 1; r >= 0; --r) {
+        counts += byte_popcounts(static_cast<uint64_t>(rows[r] & holesBelow) << kLaneCovered);
+        holesBelow |= holeRows[r];
+    }
+
+    int agg = 0, maxH = 0, bump = 0, wells = 0;
+    for (int c = 0; c < kBoardCols; ++c) {
+        const int h = heights[c];
+        agg += h;
+        if (h > maxH) maxH = h;
+        if (c + 1 < kBoardCols) {
+            const int d = h - heights[c + 1];
+            bump += d < 0 ? -d : d;
+        }
+        const int left = c > 0 ? heights[c - 1] : kBoardRows;
+        const int right = c + 1 < kBoardCols ? heights[c + 1] : kBoardRows;
+        const int depth = (left < right ? left : right) - h;
+        if (depth > 0) wells += depth * (depth + 1) / 2;
+    }
+
+    out[kFeatAggHeight] = agg;
+    out[kFeatMaxHeight] = maxH;
+    out[kFeatBumpiness] = bump;
+    out[kFeatHoles] = lane_count(counts, kLaneHoles);
+    out[kFeatWells] = wells;
+    out[kFeatRowTransitions] = lane_count(counts, kLaneRowTrans);
+    out[kFeatColTransitions] = lane_count(counts, kLaneColTrans);
+    out[kFeatCoveredCells] = lane_count(counts, kLaneCovered);
+    if (heights_out)
+        for (int c = 0; c < kBoardCols; ++c) heights_out[c] = heights[c];
+}
+
+void board_features_batch(const uint16_t* rows, int n, int32_t* out)
+{
+    for (int i = 0; i < n; ++i) {
+        const BoardRows& board = *reinterpret_cast<const BoardRows*>(rows + i * kBoardRows);
+        int32_t (&dst)[kNumBoardFeatures] =
+            *reinterpret_cast<int32_t (*)[kNumBoardFeatures]>(out + i * kNumBoardFeatures);
+        board_features(board, dst);
+    }
+}
+
+double bcts_score(const int32_t (&f)[kNumBoardFeatures], int lines_cleared)
+{
+    // features.py 의 BCTS_WEIGHTS 를 그쪽 dict 순서대로 더한다(max_height 는 가중치 0).
+    double s = 0.0;
+    s += -0.510066 * f[kFeatAggHeight];
+    s += -0.184483 * f[kFeatBumpiness];
+    s += -0.35663 * f[kFeatHoles];
+    s += 0.760666 * lines_cleared;
+    s += -0.1 * f[kFeatWells];
+    return s;
+}
+
+}  // namespace bot
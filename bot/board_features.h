@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+#include "placement.h"
+
+// 보드 특징(feature) 추출기. 휴리스틱 봇과 CEM/CBMPI 학습이 후보 보드를 잔뜩
+// 점수화할 때 쓴다.
+//
+// 보드를 칸 200개가 아니라 행 비트마스크 20개(SimGrid::rowMask 와 같은 꼴, 비트
+// c = 열 c)로 받아서, 한 행의 10열을 정수 연산 한 번에 처리한다(SWAR). 위에서
+// 아래로 한 번, 아래에서 위로 한 번 훑으면 특징 8개가 다 나온다 — 열마다 칸을 하나씩
+// 보던 이중 루프가 없다. 마스크는 SimGame::RowMask 에서 그대로 읽으므로 변환도 없다.
+//
+// 특징 정의는 python/common/features.py 와 같다(그쪽에 없는 셋은 Dellacherie 정의).
+//   AggHeight      열 높이 합. 높이 = 20 - 맨 위 찬 칸의 행, 빈 열은 0
+//   MaxHeight      가장 높은 열
+//   Bumpiness      이웃한 두 열 높이 차의 합
+//   Holes          위에 찬 칸이 하나라도 있는 빈 칸 수
+//   Wells          열마다 d = min(왼쪽, 오른쪽 높이) - 높이 (벽은 20) 가 양수면 d(d+1)/2
+//   RowTransitions 행 안에서 찬 칸·빈 칸이 바뀌는 횟수. 좌우 벽은 찬 칸, 빈 행은 2
+//   ColTransitions 열 안에서 위아래로 바뀌는 횟수. 바닥은 찬 칸
+//   CoveredCells   아래 어딘가에 구멍이 있는 찬 칸 수(구멍을 덮고 있는 칸)
+
+class SimGame;
+
+namespace bot {
+
+enum BoardFeature : int {
+    kFeatAggHeight = 0,
+    kFeatMaxHeight,
+    kFeatBumpiness,
+    kFeatHoles,
+    kFeatWells,
+    kFeatRowTransitions,
+    kFeatColTransitions,
+    kFeatCoveredCells,
+    kNumBoardFeatures
+};
+
+// Python 쪽 이름(snake_case). pybind 의 FEATURE_NAMES 가 이 순서 그대로다.
+extern const char* const kBoardFeatureNames[kNumBoardFeatures];
+
+using BoardRows = uint16_t[kBoardRows];
+
+// 보드 → 행 마스크. 굳은 칸 판정은 observe / SimGrid 와 같다(0 과 ghost(8) 는 빈 칸).
+void board_rows(const SimGame& sim, BoardRows& out);
+void board_rows(const int (&grid)[kBoardRows][kBoardCols], BoardRows& out);
+
+// 한 보드의 특징. heights_out 을 주면 열 높이 10개도 쓴다.
+void board_features(const BoardRows& rows, int32_t (&out)[kNumBoardFeatures],
+                    int32_t* heights_out = nullptr);
+
+// 열 높이만 채우고 구멍 수를 돌려준다. eval_shape 처럼 높이·구멍·요철만 쓰는 곳은
+// 전환·덮인 칸을 세지 않는 이쪽이 더 싸다.
+int board_surface(const BoardRows& rows, int32_t (&heights)[kBoardCols]);
+
+// n 개 보드를 한 번에. rows 는 보드마다 kBoardRows 개씩 이어 붙인 것, out 은
+// n * kNumBoardFeatures 칸이다. 보드끼리 독립이라 호출자가 나눠서 여러 스레드로 돌려도 된다.
+void board_features_batch(const uint16_t* rows, int n, int32_t* out);
+
+// python/common/features.py 의 bcts_score 와 같은 가중치(웰 -0.1 포함)로 점수화한다.
+// eval_board 는 웰 항이 없는 3항 가중치라 값이 다르다.
+double bcts_score(const int32_t (&features)[kNumBoardFeatures], int lines_cleared);
+
+}  // namespace bot
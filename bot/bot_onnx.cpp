@@ -11,12 +11,16 @@
 #include "placement.h"
 #include "../src/sim_game.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
 #include <cstring>
 #include <filesystem>
 #include <limits>
+#include <sstream>
 
 #if defined(TETRIS_HAS_ONNXRUNTIME)
     #include <onnxruntime_cxx_api.h>
@@ -24,23 +28,97 @@
 
 namespace bot {
 
+bool parse_onnx_options(const std::string& text, OnnxSessionOptions& out, std::string* err_out)
+{
+    OnnxSessionOptions parsed = out;
+    std::istringstream in(text);
+    std::string token;
+    while (in >> token) {
+        const size_t eq = token.find('=');
+        const std::string key = token.substr(0, eq);
+        const std::string val = eq == std::string::npos ? std::string() : token.substr(eq + 1);
+        auto bad = [&] {
+            if (err_out) *err_out = "bad onnx option '" + token + "'";
+            return false;
+        };
+        if (key == "intra_threads" || key == "inter_threads") {
+            char* end = nullptr;
+            const long n = std::strtol(val.c_str(), &end, 10);
+            if (val.empty() || *end != '\0' || n < 0 || n > 64) return bad();
+            (key == "intra_threads" ? parsed.intraOpThreads : parsed.interOpThreads) = static_cast<int>(n);
+        } else if (key == "graph_opt") {
+            if (val == "disable")       parsed.graphOpt = OnnxSessionOptions::GraphOpt::Disable;
+            else if (val == "basic")    parsed.graphOpt = OnnxSessionOptions::GraphOpt::Basic;
+            else if (val == "extended") parsed.graphOpt = OnnxSessionOptions::GraphOpt::Extended;
+            else if (val == "all")      parsed.graphOpt = OnnxSessionOptions::GraphOpt::All;
+            else return bad();
+        } else {
+            return bad();
+        }
+    }
+    out = parsed;
+    return true;
+}
+
 #if defined(TETRIS_HAS_ONNXRUNTIME)
 
+namespace {
+
+uint64_t elapsed_ns(std::chrono::steady_clock::time_point start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+}  // namespace
+
 struct BotOnnx::Impl {
     Ort::Env     env{ORT_LOGGING_LEVEL_WARNING, "tetris_bot"};
-    Ort::SessionOptions sessOpts{};
     std::unique_ptr<Ort::Session> session;
     Ort::MemoryInfo memInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+    Ort::RunOptions runOpts{nullptr};
 
     // 이 이름들은 export_onnx.py가 박아 넣은 것과 한 글자도 달라선 안 된다.
     std::array<const char*, 3> inputNames  = {"board", "current", "next"};
     std::array<const char*, 2> outputNames = {"policy_logits", "value"};
 
-    bool LoadModel(const std::string& path, std::string* err_out)
+    // 한 판 추론용 고정 버퍼와 IoBinding. 로드할 때 텐서를 이 버퍼 위에 한 번 만들어
+    // 세션에 이름으로 묶어 두므로, 수마다 하는 일은 observe 로 입력 버퍼를 덮어쓰고
+    // Run 을 부르는 것뿐이다 — 힙 할당도, 이름 조회도, 출력 텐서 생성도 없다.
+    // 묶기에 실패한 모델(출력 shape 이 계약과 다른 등)은 RunRaw 경로로 돈다.
+    struct Bound {
+        std::array<float, kBoardRows * kBoardCols> board{};
+        std::array<float, kNumPieceTypes> current{};
+        std::array<float, kNumPieceTypes> next{};
+        std::array<float, kNumPlacements> logits{};
+        std::vector<float> value;
+        std::vector<Ort::Value> tensors;   // 위 버퍼를 가리키는 텐서. binding 보다 오래 산다
+        std::unique_ptr<Ort::IoBinding> binding;
+    } bound;
+
+    LatencyHistogram latency;
+
+    static GraphOptimizationLevel ToOrt(OnnxSessionOptions::GraphOpt g)
+    {
+        switch (g) {
+        case OnnxSessionOptions::GraphOpt::Disable:  return GraphOptimizationLevel::ORT_DISABLE_ALL;
+        case OnnxSessionOptions::GraphOpt::Basic:    return GraphOptimizationLevel::ORT_ENABLE_BASIC;
+        case OnnxSessionOptions::GraphOpt::Extended: return GraphOptimizationLevel::ORT_ENABLE_EXTENDED;
+        case OnnxSessionOptions::GraphOpt::All:      break;
+        }
+        return GraphOptimizationLevel::ORT_ENABLE_ALL;
+    }
+
+    bool LoadModel(const std::string& path, const OnnxSessionOptions& options, std::string* err_out)
     {
+        bound.binding.reset();
+        bound.tensors.clear();
+        session.reset();
         try {
-            sessOpts.SetIntraOpNumThreads(1);
-            sessOpts.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+            Ort::SessionOptions sessOpts;
+            sessOpts.SetIntraOpNumThreads(options.intraOpThreads);
+            sessOpts.SetInterOpNumThreads(options.interOpThreads);
+            sessOpts.SetGraphOptimizationLevel(ToOrt(options.graphOpt));
         #if defined(_WIN32)
             // 경로는 UTF-8로 들어온다. u8path를 거치지 않으면 Windows에서
             // 한글 사용자 폴더 같은 경로가 현재 C 로캘 기준으로 잘못 해석돼
@@ -50,6 +128,8 @@ struct BotOnnx::Impl {
         #else
             session = std::make_unique<Ort::Session>(env, path.c_str(), sessOpts);
         #endif
+            ReadBatchDim();
+            BindSingle();
         } catch (const Ort::Exception& e) {
             if (err_out) *err_out = std::string("Ort::Exception: ") + e.what();
             session.reset();
@@ -62,26 +142,97 @@ struct BotOnnx::Impl {
         return true;
     }
 
-    bool InferOnce(const SimGame& sim, int& col_out, int& rot_out)
+    // 입력 0 의 batch 차원. export_onnx.py 가 가변 batch 로 내보냈으면 -1 이다.
+    int64_t batchDim = 1;
+
+    void ReadBatchDim()
     {
-        if (!session) return false;
+        batchDim = 1;
+        try {
+            const auto shape = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+            if (!shape.empty()) batchDim = shape[0];
+        } catch (const Ort::Exception&) {
+        }
+    }
+
+    // 출력 i 의 원소 수. 가변 차원(-1)은 batch 1 로 본다.
+    size_t OutputElements(size_t i)
+    {
+        const auto shape = session->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape();
+        size_t count = 1;
+        for (int64_t d : shape) count *= static_cast<size_t>(d < 0 ? 1 : d);
+        return count;
+    }
+
+    void BindSingle()
+    {
+        try {
+            if (OutputElements(0) != static_cast<size_t>(kNumPlacements)) return;
+            const size_t valueCount = OutputElements(1);
+            if (valueCount == 0) return;
+            bound.value.assign(valueCount, 0.0f);
 
-        float board[kBoardRows * kBoardCols];   // flatten (1, 1, 20, 10)
-        float current[kNumPieceTypes];          // (1, 7)
-        float nxt[kNumPieceTypes];              // (1, 7)
-        observe(sim, board, current, nxt);
+            const std::array<int64_t, 4> boardShape = {1, 1, kBoardRows, kBoardCols};
+            const std::array<int64_t, 2> pieceShape = {1, kNumPieceTypes};
+            const std::array<int64_t, 2> logitShape = {1, kNumPlacements};
+            const auto valueShape = session->GetOutputTypeInfo(1).GetTensorTypeAndShapeInfo().GetShape();
+            std::vector<int64_t> valueDims(valueShape.size());
+            for (size_t k = 0; k < valueShape.size(); ++k) valueDims[k] = valueShape[k] < 0 ? 1 : valueShape[k];
+
+            auto& t = bound.tensors;
+            t.push_back(Ort::Value::CreateTensor<float>(memInfo, bound.board.data(), bound.board.size(),
+                                                        boardShape.data(), boardShape.size()));
+            t.push_back(Ort::Value::CreateTensor<float>(memInfo, bound.current.data(), bound.current.size(),
+                                                        pieceShape.data(), pieceShape.size()));
+            t.push_back(Ort::Value::CreateTensor<float>(memInfo, bound.next.data(), bound.next.size(),
+                                                        pieceShape.data(), pieceShape.size()));
+            t.push_back(Ort::Value::CreateTensor<float>(memInfo, bound.logits.data(), bound.logits.size(),
+                                                        logitShape.data(), logitShape.size()));
+            t.push_back(Ort::Value::CreateTensor<float>(memInfo, bound.value.data(), bound.value.size(),
+                                                        valueDims.data(), valueDims.size()));
+
+            auto binding = std::make_unique<Ort::IoBinding>(*session);
+            for (size_t k = 0; k < inputNames.size(); ++k) binding->BindInput(inputNames[k], t[k]);
+            binding->BindOutput(outputNames[0], t[3]);
+            binding->BindOutput(outputNames[1], t[4]);
+            bound.binding = std::move(binding);
+        } catch (const Ort::Exception&) {
+            bound.binding.reset();
+            bound.tensors.clear();
+        }
+    }
+
+    // 묶어 둔 버퍼로 한 판을 돈다. 입력은 bound.board/current/next 에 이미 있다.
+    bool RunBound(float* logits_out, float* value_out)
+    {
+        try {
+            session->Run(runOpts, *bound.binding);
+        } catch (const Ort::Exception&) {
+            return false;
+        }
+        std::memcpy(logits_out, bound.logits.data(), sizeof(float) * kNumPlacements);
+        if (value_out) *value_out = bound.value[0];
+        return true;
+    }
 
-        std::array<int64_t, 4> boardShape = {1, 1, kBoardRows, kBoardCols};
-        std::array<int64_t, 2> pieceShape = {1, kNumPieceTypes};
+    // n 판을 한 번의 Run 으로 돌린다. 입력은 export_onnx.py 계약을 n 개 이어 붙인 것.
+    bool RunRaw(const float* board, const float* current, const float* nxt, int n,
+                float* logits_out, float* values_out)
+    {
+        std::array<int64_t, 4> boardShape = {n, 1, kBoardRows, kBoardCols};
+        std::array<int64_t, 2> pieceShape = {n, kNumPieceTypes};
+        const size_t cells = static_cast<size_t>(n) * kBoardRows * kBoardCols;
+        const size_t pieces = static_cast<size_t>(n) * kNumPieceTypes;
 
+        // CreateTensor 는 버퍼를 읽기만 한다. const 를 떼는 것은 API 모양 때문이다.
         Ort::Value boardT = Ort::Value::CreateTensor<float>(
-            memInfo, board, sizeof(board) / sizeof(float),
+            memInfo, const_cast<float*>(board), cells,
             boardShape.data(), boardShape.size());
         Ort::Value curT = Ort::Value::CreateTensor<float>(
-            memInfo, current, kNumPieceTypes,
+            memInfo, const_cast<float*>(current), pieces,
             pieceShape.data(), pieceShape.size());
         Ort::Value nxtT = Ort::Value::CreateTensor<float>(
-            memInfo, nxt, kNumPieceTypes,
+            memInfo, const_cast<float*>(nxt), pieces,
             pieceShape.data(), pieceShape.size());
 
         Ort::Value inputs[3] = {std::move(boardT), std::move(curT), std::move(nxtT)};
@@ -89,7 +240,7 @@ struct BotOnnx::Impl {
         std::vector<Ort::Value> outs;
         try {
             outs = session->Run(
-                Ort::RunOptions{nullptr},
+                runOpts,
                 inputNames.data(), inputs, 3,
                 outputNames.data(), outputNames.size());
         } catch (const Ort::Exception&) {
@@ -99,65 +250,119 @@ struct BotOnnx::Impl {
 
         // 잘못 export된 모델은 shape을 물어보는 것만으로도 예외를 던진다.
         // 그래서 검증과 데이터 접근을 통째로 try 안에 둔다.
-        const float* logits = nullptr;
         try {
             if (!outs[0].IsTensor()) return false;
             const auto info = outs[0].GetTensorTypeAndShapeInfo();
             if (info.GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT ||
-                info.GetElementCount() < static_cast<size_t>(kNumPlacements)) {
+                info.GetElementCount() < static_cast<size_t>(n) * kNumPlacements) {
                 return false;
             }
-            logits = outs[0].GetTensorData<float>();
+            // 출력은 판마다 40개(10열 x 4회전)여야 한다.
+            std::memcpy(logits_out, outs[0].GetTensorData<float>(),
+                        sizeof(float) * kNumPlacements * static_cast<size_t>(n));
+
+            if (values_out) {
+                std::fill(values_out, values_out + n, 0.0f);
+                if (outs.size() > 1 && outs[1].IsTensor()) {
+                    const auto vinfo = outs[1].GetTensorTypeAndShapeInfo();
+                    if (vinfo.GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT &&
+                        vinfo.GetElementCount() >= static_cast<size_t>(n)) {
+                        std::memcpy(values_out, outs[1].GetTensorData<float>(),
+                                    sizeof(float) * static_cast<size_t>(n));
+                    }
+                }
+            }
         } catch (const Ort::Exception&) {
             return false;
         }
-        // 출력은 항상 40개(10열 x 4회전)여야 한다.
-
-        // 규칙상 둘 수 있는 자리만 남긴다. 모델이 뭘 내놓든 불법 수는 못 고른다.
-        auto placements = sim.LegalPlacements();
-        if (placements.empty()) return false;
-
-        bool legal[kNumPlacements] = {false};
-        for (const auto& p : placements) {
-            int a = encode_action(p.col, p.rot);
-            if (a >= 0 && a < kNumPlacements) legal[a] = true;
-        }
+        return true;
+    }
 
-        // 남은 것 중 점수가 제일 높은 자리를 고른다 (greedy).
-        int   bestIdx = -1;
-        float bestVal = -std::numeric_limits<float>::infinity();
-        for (int i = 0; i < kNumPlacements; ++i) {
-            if (!legal[i]) continue;
-            if (logits[i] > bestVal) {
-                bestVal = logits[i];
-                bestIdx = i;
-            }
-        }
-        if (bestIdx < 0) {
-            // 합법 수는 있는데 전부 -inf인 경우. 모델이 NaN을 뱉으면 이렇게 된다.
-            // 게임이 멈추는 것보다는 아무 수나 두는 편이 낫다.
-            return fallback_placement(sim, col_out, rot_out);
+    bool RunBatch(const float* board, const float* current, const float* nxt, int n,
+                  float* logits_out, float* values_out)
+    {
+        if (!session || n <= 0) return false;
+        if (batchDim < 0) return RunRaw(board, current, nxt, n, logits_out, values_out);
+        // batch 1 로 고정된 예전 모델. 한 판씩 돈다.
+        constexpr int kCells = kBoardRows * kBoardCols;
+        for (int i = 0; i < n; ++i) {
+            if (!RunRaw(board + i * kCells, current + i * kNumPieceTypes, nxt + i * kNumPieceTypes,
+                        1, logits_out + i * kNumPlacements, values_out ? values_out + i : nullptr))
+                return false;
         }
-        decode_action(bestIdx, col_out, rot_out);
         return true;
     }
+
+    // 한 판을 돌려 logits(40)와 value 를 복사해 낸다.
+    bool Run(const SimGame& sim, float* logits_out, float* value_out)
+    {
+        if (!session) return false;
+        // observe 가 묶인 입력 버퍼에 바로 쓴다. 묶기에 실패한 모델도 같은 버퍼를 쓴다.
+        observe(sim, bound.board.data(), bound.current.data(), bound.next.data());
+        if (bound.binding) return RunBound(logits_out, value_out);
+        return RunRaw(bound.board.data(), bound.current.data(), bound.next.data(), 1,
+                      logits_out, value_out);
+    }
+
+    bool InferOnce(const SimGame& sim, int& col_out, int& rot_out)
+    {
+        float logits[kNumPlacements];
+        float value = 0.0f;
+        if (!Run(sim, logits, &value)) return false;
+        // 규칙상 둘 수 있는 자리 중 점수가 제일 높은 곳 (greedy).
+        return best_legal_placement(sim, logits, col_out, rot_out);
+    }
 };
 
 BotOnnx::BotOnnx() : impl_(std::make_unique<Impl>()) {}
 BotOnnx::~BotOnnx() = default;
 
-bool BotOnnx::Load(const std::string& onnx_path, std::string* err_out)
+bool BotOnnx::Load(const std::string& onnx_path, std::string* err_out,
+                   const OnnxSessionOptions& options)
 {
     if (!impl_) impl_ = std::make_unique<Impl>();
-    return impl_->LoadModel(onnx_path, err_out);
+    impl_->latency.Reset();
+    return impl_->LoadModel(onnx_path, options, err_out);
 }
 
 bool BotOnnx::Infer(const SimGame& sim, int& col_out, int& rot_out)
 {
     if (!impl_ || !impl_->session) return false;
-    return impl_->InferOnce(sim, col_out, rot_out);
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = impl_->InferOnce(sim, col_out, rot_out);
+    impl_->latency.Record(elapsed_ns(start));
+    return ok;
+}
+
+bool BotOnnx::Evaluate(const SimGame& sim, float* logits_out, float* value_out)
+{
+    if (!impl_ || !impl_->session) return false;
+    const auto start = std::chrono::steady_clock::now();
+    const bool ok = impl_->Run(sim, logits_out, value_out);
+    impl_->latency.Record(elapsed_ns(start));
+    return ok;
 }
 
+bool BotOnnx::EvaluateBatch(const float* board, const float* current, const float* next, int n,
+                            float* logits_out, float* values_out)
+{
+    if (!impl_ || !impl_->session) return false;
+    return impl_->RunBatch(board, current, next, n, logits_out, values_out);
+}
+
+bool BotOnnx::HasDynamicBatch() const
+{
+    return impl_ && impl_->session && impl_->batchDim < 0;
+}
+
+bool BotOnnx::UsesIoBinding() const
+{
+    return impl_ && impl_->session && impl_->bound.binding != nullptr;
+}
+
+const LatencyHistogram& BotOnnx::Latency() const { return impl_->latency; }
+void BotOnnx::ResetLatency() { impl_->latency.Reset(); }
+
 bool BotOnnx::IsLoaded() const
 {
     return impl_ && impl_->session != nullptr;
@@ -167,12 +372,12 @@ bool BotOnnx::IsLoaded() const
 
 // ONNX Runtime이 없을 때 쓰는 stub. Load는 언제나 실패하고,
 // 호출자가 IsLoaded()로 걸러 주므로 Infer까지 오지 않는다.
-struct BotOnnx::Impl { bool loaded = false; };
+struct BotOnnx::Impl { LatencyHistogram latency; };
 
 BotOnnx::BotOnnx() : impl_(std::make_unique<Impl>()) {}
 BotOnnx::~BotOnnx() = default;
 
-bool BotOnnx::Load(const std::string& onnx_path, std::string* err_out)
+bool BotOnnx::Load(const std::string& onnx_path, std::string* err_out, const OnnxSessionOptions&)
 {
     (void)onnx_path;
     if (err_out) *err_out = "onnxruntime not vendored — rebuild with TETRIS_HAS_ONNXRUNTIME";
@@ -180,6 +385,12 @@ bool BotOnnx::Load(const std::string& onnx_path, std::string* err_out)
 }
 
 bool BotOnnx::Infer(const SimGame&, int&, int&) { return false; }
+bool BotOnnx::Evaluate(const SimGame&, float*, float*) { return false; }
+bool BotOnnx::EvaluateBatch(const float*, const float*, const float*, int, float*, float*) { return false; }
+bool BotOnnx::HasDynamicBatch() const { return false; }
+bool BotOnnx::UsesIoBinding() const { return false; }
+const LatencyHistogram& BotOnnx::Latency() const { return impl_->latency; }
+void BotOnnx::ResetLatency() { impl_->latency.Reset(); }
 bool BotOnnx::IsLoaded() const { return false; }
 
 #endif  // TETRIS_HAS_ONNXRUNTIME
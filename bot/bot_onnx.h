@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "latency_histogram.h"
+
 // 학습한 정책을 게임 안에서 돌리기 위한 ONNX Runtime wrapper.
 //
 // 학습은 Colab에서 PyTorch로 하고, 그 결과를 export_onnx.py로 .onnx 파일에
@@ -11,11 +13,14 @@
 // 배포 머신에 필요한 것은 onnxruntime 공유 라이브러리 하나뿐이다.
 //
 // 학습 쪽과 맞춰야 하는 입출력 계약:
-//   입력  "board"   (1, 1, 20, 10) float32 — 칸이 차 있으면 1
-//         "current" (1, 7)         float32 — 현재 블록 one-hot
-//         "next"    (1, 7)         float32 — 다음 블록 one-hot
-//   출력  "policy_logits" (1, 40)  float32 — 40가지 placement의 점수
-//         "value"         (1,)     float32 — 학습에만 쓰고 여기선 무시
+//   입력  "board"   (N, 1, 20, 10) float32 — 칸이 차 있으면 1
+//         "current" (N, 7)         float32 — 현재 블록 one-hot
+//         "next"    (N, 7)         float32 — 다음 블록 one-hot
+//   출력  "policy_logits" (N, 40)  float32 — 40가지 placement의 점수
+//         "value"         (N,)     float32 — Infer 는 무시하고 Evaluate(MCTS)만 쓴다
+//
+// N 은 예전 모델은 1 로 고정이고, export_onnx.py 가 지금 내보내는 모델은 가변이다.
+// 고정 모델에 EvaluateBatch 를 부르면 한 판씩 나눠 돈다.
 //
 // 이름과 shape이 어긋나면 로드는 되고 추론에서 터진다. 바꿀 일이 있으면
 // python/netbot/export_onnx.py의 INPUT_NAMES/OUTPUT_NAMES도 같이 고친다.
@@ -24,6 +29,23 @@ class SimGame;
 
 namespace bot {
 
+// 세션 설정. model/bots.cfg 의 넷째 칸에 "intra_threads=1 inter_threads=1
+// graph_opt=all" 꼴로 적는다(경로가 * 인 줄은 모든 모델의 기본값).
+// 기본값은 게임 스레드 옆에서 렌더와 코어를 다투지 않도록 스레드 하나다.
+struct OnnxSessionOptions {
+    enum class GraphOpt { Disable, Basic, Extended, All };
+
+    int intraOpThreads = 1;     // 연산 하나를 나눠 도는 스레드. 0 = ORT 기본(코어 수)
+    int interOpThreads = 1;     // 독립 노드를 같이 도는 스레드. 0 = ORT 기본
+    GraphOpt graphOpt = GraphOpt::All;
+};
+
+// 공백으로 나눈 key=value 를 out 위에 덮어쓴다. 키는 intra_threads, inter_threads,
+// graph_opt(disable|basic|extended|all). 모르는 키나 값이 있으면 out 을 건드리지
+// 않고 false.
+bool parse_onnx_options(const std::string& text, OnnxSessionOptions& out,
+                        std::string* err_out = nullptr);
+
 class BotOnnx {
 public:
     BotOnnx();
@@ -36,7 +58,8 @@ public:
     // 다르면 false. 이 경우 err_out에 화면에 그대로 띄울 수 있는 사유가 담긴다.
     // 실패해도 예외를 던지지 않는다 — 모델이 없는 것은 정상 상황이고
     // 호출자는 heuristic bot으로 넘어가면 된다.
-    bool Load(const std::string& onnx_path, std::string* err_out = nullptr);
+    bool Load(const std::string& onnx_path, std::string* err_out = nullptr,
+              const OnnxSessionOptions& options = {});
 
     // 현재 판을 보고 둘 곳을 정한다.
     // 불법 수의 logit을 -inf로 눌러 놓고 최댓값을 고르므로, 모델이 이상한
@@ -44,6 +67,28 @@ public:
     // 둘 곳이 아예 없으면(게임 오버 직전) false.
     bool Infer(const SimGame& sim, int& col_out, int& rot_out);
 
+    // 모델 출력을 그대로 돌려준다. logits_out 은 40개, value_out 은 하나.
+    // 합법 수로 거르지 않는다 — 탐색(bot/mcts.h)이 자기 방식으로 가린다.
+    bool Evaluate(const SimGame& sim, float* logits_out, float* value_out);
+
+    // n 판을 한 번에 돌린다. 입력은 observe() 결과를 판 순서대로 이어 붙인 것
+    // (board n*200, current/next n*7), 출력은 logits_out n*40, values_out n
+    // (nullptr 이면 value 는 버린다). 여러 봇의 요청을 모으는 쪽은
+    // bot/inference_server.h.
+    bool EvaluateBatch(const float* board, const float* current, const float* next, int n,
+                       float* logits_out, float* values_out);
+
+    // 모델의 batch 차원이 가변이면 true. false 면 EvaluateBatch 가 한 판씩 돈다.
+    bool HasDynamicBatch() const;
+
+    // Infer/Evaluate 가 로드 때 묶어 둔 버퍼(IoBinding)로 도는지. 출력 shape 이
+    // 계약과 달라 묶지 못한 모델은 false 이고, 수마다 텐서를 만드는 경로로 돈다.
+    bool UsesIoBinding() const;
+
+    // Infer/Evaluate 한 번의 지연(관측 변환 + 세션 실행 + 수 고르기). Load 때 비운다.
+    const LatencyHistogram& Latency() const;
+    void ResetLatency();
+
     bool IsLoaded() const;
 
 private:
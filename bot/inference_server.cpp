@@ -0,0 +1,159 @@
+#include "inference_server.h"
+#include "bot_onnx.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bot {
+
+namespace {
+
+constexpr int kCells = kBoardRows * kBoardCols;
+
+}  // namespace
+
+InferenceServer::InferenceServer(Backend backend, const InferenceServerConfig& config)
+    : backend_(std::move(backend)), config_(config)
+{
+    config_.maxBatch = std::max(1, config_.maxBatch);
+    config_.maxLatencyUs = std::max(0, config_.maxLatencyUs);
+    worker_ = std::thread([this] { Run(); });
+}
+
+InferenceServer::InferenceServer(BotOnnx& model, const InferenceServerConfig& config)
+    : InferenceServer(
+          [&model](const float* board, const float* current, const float* next, int n,
+                   float* logits, float* values) {
+              return model.EvaluateBatch(board, current, next, n, logits, values);
+          },
+          config)
+{
+}
+
+InferenceServer::~InferenceServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) worker_.join();
+}
+
+std::future<InferenceResult> InferenceServer::Submit(const SimGame& sim)
+{
+    Request req;
+    observe(sim, req.board, req.current, req.next);
+    req.queued = std::chrono::steady_clock::now();
+    std::future<InferenceResult> result = req.promise.get_future();
+
+    bool wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            req.promise.set_value(InferenceResult{});
+            return result;
+        }
+        queue_.push_back(std::move(req));
+        // 서버가 깨어나야 하는 때는 둘뿐이다 — 첫 요청(마감 시각을 정한다)과 batch 가 찬 때.
+        const size_t size = queue_.size();
+        wake = size == 1 || size == static_cast<size_t>(config_.maxBatch);
+    }
+    if (wake) cv_.notify_one();
+    return result;
+}
+
+InferenceServerStats InferenceServer::Stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void InferenceServer::Run()
+{
+    const int maxBatch = config_.maxBatch;
+    const size_t maxSize = static_cast<size_t>(maxBatch);
+    // 이어 붙인 입력·출력 버퍼. 한 번 잡아 두고 batch 마다 재사용한다.
+    std::vector<float> board(maxSize * kCells);
+    std::vector<float> current(maxSize * kNumPieceTypes);
+    std::vector<float> next(maxSize * kNumPieceTypes);
+    std::vector<float> logits(maxSize * kNumPlacements);
+    std::vector<float> values(maxSize);
+    std::vector<std::promise<InferenceResult>> promises;
+    promises.reserve(maxSize);
+
+    for (;;) {
+        int n = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // 멈추는 중이고 남은 요청도 없다
+
+            const auto deadline = queue_.front().queued
+                                + std::chrono::microseconds(config_.maxLatencyUs);
+            cv_.wait_until(lock, deadline,
+                           [&] { return stopping_ || queue_.size() >= maxSize; });
+
+            n = static_cast<int>(std::min(queue_.size(), maxSize));
+            for (int i = 0; i < n; ++i) {
+                Request& req = queue_.front();
+                std::memcpy(&board[i * kCells], req.board, sizeof(req.board));
+                std::memcpy(&current[i * kNumPieceTypes], req.current, sizeof(req.current));
+                std::memcpy(&next[i * kNumPieceTypes], req.next, sizeof(req.next));
+                promises.push_back(std::move(req.promise));
+                queue_.pop_front();
+            }
+            stats_.requests += static_cast<uint64_t>(n);
+            ++stats_.batches;
+            if (n == maxBatch) ++stats_.fullBatches;
+            stats_.largestBatch = std::max(stats_.largestBatch, n);
+        }
+
+        // backend 는 잠금 밖에서 돈다. 그동안 들어온 요청은 다음 batch 로 모인다.
+        const bool ok = backend_(board.data(), current.data(), next.data(), n,
+                                 logits.data(), values.data());
+        for (int i = 0; i < n; ++i) {
+            InferenceResult r;
+            r.ok = ok;
+            if (ok) {
+                std::memcpy(r.eval.logits, &logits[i * kNumPlacements], sizeof(r.eval.logits));
+                r.eval.value = values[i];
+            }
+            promises[i].set_value(r);
+        }
+        promises.clear();
+        if (!ok) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.failedBatches;
+        }
+    }
+}
+
+void ServerEvaluator::Evaluate(const SimGame* const* sims, int count, Evaluation* out)
+{
+    // 먼저 전부 넣고 기다려야 이 호출의 잎들이 한 batch 에 들어간다.
+    std::future<InferenceResult> pending[kMaxLeafBatch];
+    for (int base = 0; base < count; base += kMaxLeafBatch) {
+        const int n = std::min(kMaxLeafBatch, count - base);
+        for (int i = 0; i < n; ++i) pending[i] = server_.Submit(*sims[base + i]);
+        for (int i = 0; i < n; ++i) {
+            const InferenceResult r = pending[i].get();
+            Evaluation& e = out[base + i];
+            if (r.ok) {
+                e = r.eval;
+            } else {
+                std::fill(std::begin(e.logits), std::end(e.logits), 0.0f);
+                e.value = 0.0f;
+            }
+        }
+    }
+}
+
+bool server_placement(InferenceServer& server, const SimGame& sim, int& col_out, int& rot_out)
+{
+    const InferenceResult r = server.Submit(sim).get();
+    if (!r.ok) return false;
+    return best_legal_placement(sim, r.eval.logits, col_out, rot_out);
+}
+
+}  // namespace bot
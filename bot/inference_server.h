@@ -0,0 +1,127 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../src/sim_game.h"
+#include "mcts.h"
+#include "placement.h"
+
+// 여러 봇의 추론 요청을 모아 한 번의 (N, ...) batch 로 돌리는 앞단.
+//
+// BotOnnx::Infer 는 판 하나마다 세션 호출을 한 번 한다. 모델이 작아서 호출 한 번의
+// 고정 비용(입력 검증, 스레드 풀 깨우기, 출력 할당)이 연산보다 크고, 봇 매치를
+// 여러 개 띄우거나 MCTS 가 잎을 평가하면 CPU 대부분이 그 고정 비용에 쓰인다.
+//
+// Submit 은 판을 곧바로 관측(observe)으로 바꿔 큐에 넣고 future 를 돌려준다.
+// 전담 스레드 하나가 큐를 보다가
+//   - 요청이 maxBatch 개 모이거나
+//   - 가장 오래 기다린 요청이 maxLatencyUs 를 넘기면
+// 모인 것을 이어 붙여 backend 를 한 번 부르고 결과를 각 future 에 나눠 준다.
+// 입출력은 export_onnx.py 계약 그대로다 — board (N,1,20,10), current/next (N,7)
+// 를 넣고 policy_logits (N,40), value (N,) 를 받는다.
+//
+// 지연 상한은 "첫 요청이 들어온 뒤 이만큼은 더 기다려 본다"는 뜻이다. 요청이 드문
+// 때(사람 대 봇 한 판)는 한 판씩 maxLatencyUs 늦게 돌고, 많을 때는 batch 가 차서
+// 기다림 없이 돈다. 0 이면 기다리지 않고 그때까지 모인 만큼만 돌린다.
+
+namespace bot {
+
+class BotOnnx;
+
+struct InferenceResult
+{
+    bool       ok = false;     // backend 가 실패했거나 서버가 멈췄으면 false
+    Evaluation eval{};
+};
+
+struct InferenceServerConfig
+{
+    int maxBatch = 32;           // 한 번에 돌릴 최대 판 수
+    int maxLatencyUs = 1000;     // 첫 요청부터 batch 를 채우려고 기다리는 상한
+};
+
+struct InferenceServerStats
+{
+    uint64_t requests = 0;
+    uint64_t batches = 0;
+    uint64_t fullBatches = 0;     // maxBatch 가 차서 돈 batch
+    uint64_t failedBatches = 0;
+    int      largestBatch = 0;
+
+    double meanBatch() const { return batches ? static_cast<double>(requests) / batches : 0.0; }
+};
+
+class InferenceServer
+{
+public:
+    // 이어 붙인 입력 n 판을 돌려 logits_out (n*40), values_out (n) 에 쓴다.
+    // 전담 스레드 하나에서만 불리므로 thread-safe 일 필요는 없다.
+    using Backend = std::function<bool(const float* board, const float* current,
+                                       const float* next, int n,
+                                       float* logits_out, float* values_out)>;
+
+    InferenceServer(Backend backend, const InferenceServerConfig& config);
+    // model.EvaluateBatch 를 backend 로 쓴다. model 은 서버보다 오래 살아야 한다.
+    InferenceServer(BotOnnx& model, const InferenceServerConfig& config);
+    // 남은 요청을 마저 돌리고 스레드를 멈춘다.
+    ~InferenceServer();
+
+    InferenceServer(const InferenceServer&) = delete;
+    InferenceServer& operator=(const InferenceServer&) = delete;
+
+    // 아무 스레드에서나 부른다. sim 은 호출 중에만 읽으므로 바로 바뀌어도 된다.
+    std::future<InferenceResult> Submit(const SimGame& sim);
+
+    InferenceServerStats Stats() const;
+    const InferenceServerConfig& Config() const { return config_; }
+
+private:
+    struct Request
+    {
+        float board[kBoardRows * kBoardCols];
+        float current[kNumPieceTypes];
+        float next[kNumPieceTypes];
+        std::chrono::steady_clock::time_point queued;
+        std::promise<InferenceResult> promise;
+    };
+
+    void Run();
+
+    Backend backend_;
+    InferenceServerConfig config_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Request> queue_;
+    bool stopping_ = false;
+    InferenceServerStats stats_;
+
+    std::thread worker_;
+};
+
+// MCTS 잎 평가기. 잎을 서버에 넣고 기다리므로 여러 탐색 스레드(또는 여러 Mcts)의
+// 잎이 한 batch 로 묶인다. 실패한 잎은 균등 prior, value 0 으로 채운다.
+class ServerEvaluator : public Evaluator
+{
+public:
+    explicit ServerEvaluator(InferenceServer& server) : server_(server) {}
+
+    void Evaluate(const SimGame* const* sims, int count, Evaluation* out) override;
+
+private:
+    static constexpr int kMaxLeafBatch = 64;   // 한 번에 넣고 기다리는 잎 수
+    InferenceServer& server_;
+};
+
+// 서버로 한 판을 추론해 합법 수 중 가장 좋은 착수를 고른다(BotOnnx::Infer 와 같은 규칙).
+// 추론이 실패하면 false — 호출자가 fallback 을 정한다.
+bool server_placement(InferenceServer& server, const SimGame& sim, int& col_out, int& rot_out);
+
+}  // namespace bot
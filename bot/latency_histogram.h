@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+// 추론 한 번의 지연(ns)을 모으는 고정 크기 히스토그램.
+//
+// 값을 다 들고 있지 않고 로그 구간에 센다. 2의 거듭제곱 구간 하나를 8칸으로
+// 나누므로(HDR histogram 과 같은 꼴) 어느 값이든 구간 폭이 값의 1/8 이하다 —
+// 백분위의 상대 오차가 12.5% 를 넘지 않는다. 칸은 496개(4KB) 고정이라 Record 는
+// 할당도 분기 예측 실패도 거의 없이 끝나서 hot path 에 그대로 둘 수 있다.
+//
+// 한 스레드가 쓴다(BotOnnx 인스턴스가 스레드 하나의 것이듯). 여러 워커의 것을
+// 합칠 때는 Merge.
+
+namespace bot {
+
+class LatencyHistogram
+{
+public:
+    void Record(uint64_t ns)
+    {
+        ++counts_[Index(ns)];
+        ++count_;
+        sum_ += ns;
+        max_ = std::max(max_, ns);
+    }
+
+    void Merge(const LatencyHistogram& other)
+    {
+        for (int i = 0; i < kBuckets; ++i) counts_[i] += other.counts_[i];
+        count_ += other.count_;
+        sum_ += other.sum_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    void Reset() { *this = LatencyHistogram{}; }
+
+    uint64_t Count() const { return count_; }
+    uint64_t MaxNs() const { return max_; }
+    double   MeanNs() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+    // p (0..1) 백분위. 그 값이 든 칸의 위쪽 경계를 돌려주므로 실제보다 작게
+    // 나오지 않는다 — "이 안에 들어온다" 를 확인하는 용도에 맞는 쪽으로 틀린다.
+    uint64_t PercentileNs(double p) const
+    {
+        if (count_ == 0) return 0;
+        p = std::min(1.0, std::max(0.0, p));
+        uint64_t rank = static_cast<uint64_t>(p * static_cast<double>(count_) + 0.5);
+        rank = std::max<uint64_t>(1, std::min(rank, count_));
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(UpperBound(i), max_);
+        }
+        return max_;
+    }
+
+    // limitNs 를 넘긴 기록 수(칸 단위라 경계 칸은 넘긴 쪽으로 센다).
+    uint64_t CountAbove(uint64_t limitNs) const
+    {
+        uint64_t n = 0;
+        for (int i = Index(limitNs); i < kBuckets; ++i)
+            if (UpperBound(i) > limitNs) n += counts_[i];
+        return n;
+    }
+
+    // "n=.. mean=..us p50=..us p90=..us p99=..us max=..us" 한 줄.
+    int Format(char* buf, size_t size) const
+    {
+        return std::snprintf(buf, size,
+                             "n=%llu mean=%.1fus p50=%.1fus p90=%.1fus p99=%.1fus max=%.1fus",
+                             static_cast<unsigned long long>(count_), MeanNs() / 1e3,
+                             PercentileNs(0.50) / 1e3, PercentileNs(0.90) / 1e3,
+                             PercentileNs(0.99) / 1e3, max_ / 1e3);
+    }
+
+    static constexpr int kSubBits = 3;
+    static constexpr int kSub = 1 << kSubBits;
+    static constexpr int kBuckets = kSub + (64 - kSubBits) * kSub;
+
+    // ns 가 들어가는 칸. kSub 미만은 값 그대로, 그 위는 (최상위 비트, 다음 kSubBits 비트).
+    static int Index(uint64_t ns)
+    {
+        if (ns < static_cast<uint64_t>(kSub)) return static_cast<int>(ns);
+        const int msb = 63 - Clz(ns);
+        const int shift = msb - kSubBits;
+        return kSub + shift * kSub + static_cast<int>((ns >> shift) & (kSub - 1));
+    }
+
+    // 칸 i 에 들어가는 가장 큰 값.
+    static uint64_t UpperBound(int i)
+    {
+        if (i < kSub) return static_cast<uint64_t>(i);
+        const int shift = (i - kSub) / kSub;
+        const uint64_t sub = static_cast<uint64_t>((i - kSub) % kSub);
+        const uint64_t lower = (static_cast<uint64_t>(kSub) + sub) << shift;
+        return lower + ((uint64_t{1} << shift) - 1);
+    }
+
+private:
+    static int Clz(uint64_t v)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(v);
+#else
+        int n = 0;
+        for (uint64_t bit = uint64_t{1} << 63; !(v & bit); bit >>= 1) ++n;
+        return n;
+#endif
+    }
+
+    uint64_t counts_[kBuckets] = {};
+    uint64_t count_ = 0;
+    uint64_t sum_ = 0;
+    uint64_t max_ = 0;
+};
+
+}  // namespace bot
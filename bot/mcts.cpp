@@ -0,0 +1,469 @@
+#include "mcts.h"
+#include "bot_onnx.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace bot {
+
+// ---- 평가기 ----
+
+void HeuristicEvaluator::Evaluate(const SimGame* const* sims, int count, Evaluation* out)
+{
+    for (int i = 0; i < count; ++i) {
+        const SimGame& sim = *sims[i];
+        Evaluation& e = out[i];
+        std::fill(std::begin(e.logits), std::end(e.logits), 0.0f);
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        const int n = sim.EnumeratePlacements(landed);
+        for (int k = 0; k < n; ++k) {
+            SimGame child = sim;
+            const int cleared = child.ApplyLandedPlacement(landed[k]);
+            const double score = cleared < 0 || child.IsGameOver()
+                ? kTopOutReward
+                : eval_board(child, cleared);
+            e.logits[encode_action(landed[k].col, landed[k].rot)] =
+                static_cast<float>(score / temperature_);
+        }
+        e.value = static_cast<float>(eval_shape(sim));
+    }
+}
+
+double HeuristicEvaluator::Reward(int linesCleared, bool toppedOut) const
+{
+    return toppedOut ? kTopOutReward : eval_lines(linesCleared);
+}
+
+void OnnxEvaluator::Evaluate(const SimGame* const* sims, int count, Evaluation* out)
+{
+    constexpr int kCells = kBoardRows * kBoardCols;
+    std::lock_guard<std::mutex> lock(mutex_);
+    board_.resize(static_cast<size_t>(count) * kCells);
+    current_.resize(static_cast<size_t>(count) * kNumPieceTypes);
+    next_.resize(static_cast<size_t>(count) * kNumPieceTypes);
+    logits_.resize(static_cast<size_t>(count) * kNumPlacements);
+    values_.resize(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i)
+        observe(*sims[i], &board_[i * kCells], &current_[i * kNumPieceTypes], &next_[i * kNumPieceTypes]);
+
+    const bool ok = model_.EvaluateBatch(board_.data(), current_.data(), next_.data(), count,
+                                         logits_.data(), values_.data());
+    for (int i = 0; i < count; ++i) {
+        if (ok) {
+            std::copy_n(&logits_[i * kNumPlacements], kNumPlacements, out[i].logits);
+            out[i].value = values_[i];
+        } else {
+            // 추론 실패: 균등 prior, value 0. 탐색은 계속된다.
+            std::fill(std::begin(out[i].logits), std::end(out[i].logits), 0.0f);
+            out[i].value = 0.0f;
+        }
+    }
+}
+
+// ---- 트리 ----
+
+namespace {
+
+// 노드 하나의 간선 통계를 지키는 잠금. 잡는 구간이 수십 ns 라 mutex 보다 싸다.
+class SpinLock
+{
+public:
+    void lock()
+    {
+        for (int spins = 0; flag_.exchange(true, std::memory_order_acquire); ++spins)
+            if (spins > 64) std::this_thread::yield();
+    }
+    void unlock() { flag_.store(false, std::memory_order_release); }
+
+private:
+    std::atomic<bool> flag_{false};
+};
+
+enum NodeState : int { kNew = 0, kExpanded = 1, kTerminal = 2 };
+
+struct Edge
+{
+    SimGame::LandedPlacement move;
+    int    action;
+    float  prior;
+    int    visits;      // 끝난 방문
+    int    inFlight;    // 잎 평가를 기다리는 방문
+    double valueSum;    // 끝난 방문의 할인 누적 보상 합
+    double reward;      // 이 착수의 보상 (자식을 만들 때 정해진다)
+    int    child;       // 노드 인덱스, 아직 안 만들었으면 -1
+};
+
+struct Node
+{
+    SimGame sim;
+    std::atomic<int> state{kNew};
+    SpinLock lock;
+    int firstEdge = 0;
+    int numEdges = 0;
+    int depth = 0;
+};
+
+struct Step
+{
+    int node;
+    int edge;   // node 의 간선 순번
+};
+
+void atomic_min(std::atomic<double>& a, double v)
+{
+    double cur = a.load(std::memory_order_relaxed);
+    while (v < cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+void atomic_max(std::atomic<double>& a, double v)
+{
+    double cur = a.load(std::memory_order_relaxed);
+    while (v > cur && !a.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+}
+
+}  // namespace
+
+struct Mcts::Tree
+{
+    std::unique_ptr<Node[]> nodes;
+    int nodeCapacity = 0;
+    std::atomic<int> nodeCount{0};
+    std::unique_ptr<Edge[]> edges;
+    int edgeCapacity = 0;
+    std::atomic<int> edgeCount{0};
+
+    // 정규화용 Q 범위. 아직 본 값이 없으면 min > max 다.
+    std::atomic<double> minQ{0.0};
+    std::atomic<double> maxQ{0.0};
+
+    std::atomic<int> started{0};    // 시작한(잎까지 내려간) 시뮬레이션
+    std::atomic<int> finished{0};
+    std::atomic<int> collisions{0};
+    std::atomic<int> maxDepth{0};
+    std::atomic<bool> stop{false};
+
+    void Reset(int wantNodes)
+    {
+        if (wantNodes > nodeCapacity) {
+            nodes.reset(new Node[static_cast<size_t>(wantNodes)]);
+            nodeCapacity = wantNodes;
+            edges.reset(new Edge[static_cast<size_t>(wantNodes) * SimGame::kMaxPlacements]);
+            edgeCapacity = wantNodes * SimGame::kMaxPlacements;
+        }
+        nodeCount.store(0);
+        edgeCount.store(0);
+        minQ.store(std::numeric_limits<double>::infinity());
+        maxQ.store(-std::numeric_limits<double>::infinity());
+        started.store(0);
+        finished.store(0);
+        collisions.store(0);
+        maxDepth.store(0);
+        stop.store(false);
+    }
+
+    // 새 노드를 잡는다. 풀이 다 찼으면 -1.
+    int NewNode(const SimGame& sim, int depth, NodeState state)
+    {
+        const int index = nodeCount.fetch_add(1);
+        if (index >= nodeCapacity) return -1;
+        Node& n = nodes[index];
+        n.sim = sim;
+        n.firstEdge = 0;
+        n.numEdges = 0;
+        n.depth = depth;
+        n.state.store(state, std::memory_order_release);
+        return index;
+    }
+
+    double Normalize(double q) const
+    {
+        const double lo = minQ.load(std::memory_order_relaxed);
+        const double hi = maxQ.load(std::memory_order_relaxed);
+        if (!(hi > lo)) return 0.5;
+        return (q - lo) / (hi - lo);
+    }
+
+    // 잎을 평가 결과로 펼친다. 합법 수가 없으면 종단 노드가 된다.
+    void Expand(int index, const Evaluation& eval)
+    {
+        Node& n = nodes[index];
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        const int count = n.sim.EnumeratePlacements(landed);
+        const int first = count > 0 ? edgeCount.fetch_add(count) : 0;
+        if (count == 0 || first + count > edgeCapacity) {
+            n.state.store(kTerminal, std::memory_order_release);
+            return;
+        }
+
+        // 합법 수만으로 softmax. logits 가 NaN/inf 면 균등 prior.
+        float maxLogit = -std::numeric_limits<float>::infinity();
+        for (int k = 0; k < count; ++k)
+            maxLogit = std::max(maxLogit, eval.logits[encode_action(landed[k].col, landed[k].rot)]);
+        double priors[SimGame::kMaxPlacements];
+        double sum = 0.0;
+        for (int k = 0; k < count; ++k) {
+            const float logit = eval.logits[encode_action(landed[k].col, landed[k].rot)];
+            priors[k] = std::exp(static_cast<double>(logit - maxLogit));
+            sum += priors[k];
+        }
+        const bool uniform = !(sum > 0.0) || !std::isfinite(sum);
+
+        for (int k = 0; k < count; ++k) {
+            Edge& e = edges[first + k];
+            e.move = landed[k];
+            e.action = encode_action(landed[k].col, landed[k].rot);
+            e.prior = static_cast<float>(uniform ? 1.0 / count : priors[k] / sum);
+            e.visits = 0;
+            e.inFlight = 0;
+            e.valueSum = 0.0;
+            e.reward = 0.0;
+            e.child = -1;
+        }
+        n.firstEdge = first;
+        n.numEdges = count;
+        n.state.store(kExpanded, std::memory_order_release);
+    }
+};
+
+Mcts::Mcts(Evaluator& evaluator, const MctsConfig& config)
+    : evaluator_(evaluator), config_(config), tree_(std::make_unique<Tree>())
+{
+    config_.simulations = std::max(1, config_.simulations);
+    config_.threads = std::max(1, config_.threads);
+    config_.leafBatch = std::max(1, config_.leafBatch);
+    config_.virtualLoss = std::max(0, config_.virtualLoss);
+}
+
+Mcts::~Mcts() = default;
+
+MctsResult Mcts::Search(const SimGame& root)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    Tree& t = *tree_;
+    const MctsConfig& c = config_;
+    t.Reset(c.simulations + c.threads * c.leafBatch + 1);
+
+    MctsResult result;
+    if (root.IsGameOver()) return result;
+    const int rootIndex = t.NewNode(root, 0, kNew);
+    {
+        const SimGame* sims[1] = {&t.nodes[rootIndex].sim};
+        Evaluation eval;
+        evaluator_.Evaluate(sims, 1, &eval);
+        t.Expand(rootIndex, eval);
+    }
+    Node& rootNode = t.nodes[rootIndex];
+    if (rootNode.numEdges == 0) return result;
+
+    if (c.dirichletAlpha > 0.0 && c.dirichletFrac > 0.0) {
+        std::mt19937_64 rng(c.seed ^ root.Fingerprint());
+        std::gamma_distribution<double> gamma(c.dirichletAlpha, 1.0);
+        double noise[SimGame::kMaxPlacements];
+        double sum = 0.0;
+        for (int k = 0; k < rootNode.numEdges; ++k) sum += noise[k] = gamma(rng);
+        if (sum > 0.0) {
+            for (int k = 0; k < rootNode.numEdges; ++k) {
+                Edge& e = t.edges[rootNode.firstEdge + k];
+                e.prior = static_cast<float>((1.0 - c.dirichletFrac) * e.prior
+                                             + c.dirichletFrac * noise[k] / sum);
+            }
+        }
+    }
+
+    enum class Outcome { Leaf, Terminal, Collision, Full };
+
+    // 루트에서 PUCT 로 내려간다. 지나간 간선에는 inFlight 를 건다.
+    auto descend = [&](std::vector<Step>& path, int& leaf) -> Outcome {
+        path.clear();
+        int index = rootIndex;
+        for (;;) {
+            Node& n = t.nodes[index];
+            const int state = n.state.load(std::memory_order_acquire);
+            if (state == kTerminal) return Outcome::Terminal;
+            if (state == kNew) return Outcome::Collision;   // 다른 잎 평가가 끝나기를 기다리는 노드
+
+            n.lock.lock();
+            Edge* first = &t.edges[n.firstEdge];
+            int total = 0;
+            for (int k = 0; k < n.numEdges; ++k)
+                total += first[k].visits + first[k].inFlight * c.virtualLoss;
+            const double parent = std::max(total, 1);
+            const double pbC = (std::log((parent + c.pbCBase + 1.0) / c.pbCBase) + c.pbCInit)
+                             * std::sqrt(parent);
+            int best = 0;
+            double bestScore = -std::numeric_limits<double>::infinity();
+            for (int k = 0; k < n.numEdges; ++k) {
+                const Edge& e = first[k];
+                const int seen = e.visits + e.inFlight * c.virtualLoss;
+                // 평가 중인 방문은 정규화 Q = 0 인 방문으로 친다.
+                const double q = e.visits > 0
+                    ? t.Normalize(e.valueSum / e.visits) * e.visits / seen : 0.0;
+                const double score = q + pbC * e.prior / (1.0 + seen);
+                if (score > bestScore) { bestScore = score; best = k; }
+            }
+            Edge& e = first[best];
+            ++e.inFlight;
+            int child = e.child;
+            bool created = false;
+            if (child < 0) {
+                SimGame next = n.sim;
+                const int cleared = next.ApplyLandedPlacement(e.move);
+                const bool over = cleared < 0 || next.IsGameOver();
+                child = t.NewNode(next, n.depth + 1, over ? kTerminal : kNew);
+                if (child < 0) {
+                    --e.inFlight;
+                    n.lock.unlock();
+                    return Outcome::Full;
+                }
+                e.reward = evaluator_.Reward(std::max(cleared, 0), over);
+                e.child = child;
+                created = true;
+            }
+            n.lock.unlock();
+            path.push_back({index, best});
+
+            if (created) {
+                leaf = child;
+                return t.nodes[child].state.load(std::memory_order_relaxed) == kTerminal
+                    ? Outcome::Terminal : Outcome::Leaf;
+            }
+            index = child;
+        }
+    };
+
+    auto backup = [&](const std::vector<Step>& path, double value) {
+        double g = value;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            Node& n = t.nodes[it->node];
+            Edge& e = t.edges[n.firstEdge + it->edge];
+            n.lock.lock();
+            g = e.reward + c.discount * g;
+            --e.inFlight;
+            ++e.visits;
+            e.valueSum += g;
+            const double q = e.valueSum / e.visits;
+            n.lock.unlock();
+            atomic_min(t.minQ, q);
+            atomic_max(t.maxQ, q);
+        }
+    };
+
+    auto revert = [&](const std::vector<Step>& path) {
+        for (const Step& s : path) {
+            Node& n = t.nodes[s.node];
+            n.lock.lock();
+            --t.edges[n.firstEdge + s.edge].inFlight;
+            n.lock.unlock();
+        }
+    };
+
+    auto worker = [&]() {
+        std::vector<std::vector<Step>> paths(static_cast<size_t>(c.leafBatch));
+        std::vector<int> leaves(static_cast<size_t>(c.leafBatch));
+        std::vector<const SimGame*> sims(static_cast<size_t>(c.leafBatch));
+        std::vector<Evaluation> evals(static_cast<size_t>(c.leafBatch));
+        std::vector<Step> scratch;
+
+        while (!t.stop.load(std::memory_order_relaxed)) {
+            int batch = 0;
+            int misses = 0;
+            while (batch < c.leafBatch && misses < c.leafBatch) {
+                if (t.started.fetch_add(1) >= c.simulations) {
+                    t.started.fetch_sub(1);
+                    break;
+                }
+                int leaf = -1;
+                const Outcome outcome = descend(scratch, leaf);
+                if (outcome == Outcome::Leaf) {
+                    paths[batch].swap(scratch);
+                    leaves[batch] = leaf;
+                    sims[batch] = &t.nodes[leaf].sim;
+                    ++batch;
+                } else if (outcome == Outcome::Terminal) {
+                    backup(scratch, 0.0);
+                    t.finished.fetch_add(1);
+                    int depth = static_cast<int>(scratch.size());
+                    int prev = t.maxDepth.load(std::memory_order_relaxed);
+                    while (depth > prev && !t.maxDepth.compare_exchange_weak(prev, depth)) {}
+                } else {
+                    revert(scratch);
+                    t.started.fetch_sub(1);
+                    ++misses;
+                    if (outcome == Outcome::Full) {
+                        t.stop.store(true);
+                        break;
+                    }
+                    t.collisions.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+
+            if (batch == 0) {
+                if (t.started.load() >= c.simulations) break;
+                std::this_thread::yield();   // 남의 잎 평가가 끝나야 내려갈 수 있다
+                continue;
+            }
+
+            evaluator_.Evaluate(sims.data(), batch, evals.data());
+            for (int i = 0; i < batch; ++i) {
+                t.Expand(leaves[i], evals[i]);
+                backup(paths[i], evals[i].value);
+                const int depth = static_cast<int>(paths[i].size());
+                int prev = t.maxDepth.load(std::memory_order_relaxed);
+                while (depth > prev && !t.maxDepth.compare_exchange_weak(prev, depth)) {}
+            }
+            t.finished.fetch_add(batch);
+
+            if (c.budgetMs > 0.0) {
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                if (ms >= c.budgetMs) t.stop.store(true);
+            }
+            if (c.cancel && c.cancel->load(std::memory_order_relaxed)) t.stop.store(true);
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (int i = 1; i < c.threads; ++i) helpers.emplace_back(worker);
+    worker();
+    for (std::thread& th : helpers) th.join();
+
+    double visitSum = 0.0, valueSum = 0.0;
+    int bestVisits = -1;
+    float bestPrior = -1.0f;
+    for (int k = 0; k < rootNode.numEdges; ++k) {
+        const Edge& e = t.edges[rootNode.firstEdge + k];
+        result.visits[e.action] = static_cast<float>(e.visits);
+        result.prior[e.action] = e.prior;
+        visitSum += e.visits;
+        valueSum += e.valueSum;
+        if (e.visits > bestVisits || (e.visits == bestVisits && e.prior > bestPrior)) {
+            bestVisits = e.visits;
+            bestPrior = e.prior;
+            result.action = e.action;
+        }
+    }
+    result.rootValue = visitSum > 0.0 ? static_cast<float>(valueSum / visitSum) : 0.0f;
+    result.simulations = t.finished.load();
+    result.nodes = std::min(t.nodeCount.load(), t.nodeCapacity);
+    result.maxDepth = t.maxDepth.load();
+    result.collisions = t.collisions.load();
+    result.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return result;
+}
+
+bool mcts_placement(Mcts& mcts, const SimGame& sim, int& col_out, int& rot_out, MctsResult* result)
+{
+    MctsResult local;
+    MctsResult& r = result ? *result : local;
+    r = mcts.Search(sim);
+    if (r.action < 0) return false;
+    decode_action(r.action, col_out, rot_out);
+    return true;
+}
+
+}  // namespace bot
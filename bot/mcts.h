@@ -0,0 +1,154 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../src/sim_game.h"
+#include "placement.h"
+
+// 착수(placement) 행동 공간 위의 MCTS.
+//
+// python/train/muzero_tetris.py 의 탐색을 C++ 로 옮긴 것이되, 학습된 dynamics 대신
+// 실제 SimGame 으로 전개한다(AlphaZero 식). 노드는 SimGame 복사본을 들고 있고,
+// 간선은 EnumeratePlacements 가 준 합법 수뿐이라 불법 수는 트리에 들어오지 않는다.
+//
+//   선택: PUCT. 탐색 상수는 MuZero 의 pb_c = log((N+base+1)/base) + init 이고,
+//         Q 는 트리에서 본 최솟값·최댓값으로 [0, 1] 에 정규화한다(보상 단위가
+//         평가기마다 달라도 같은 상수가 통한다). 안 가 본 간선의 Q 는 0.
+//   보상: 간선마다 Evaluator::Reward(지운 줄, 게임 오버), 할인율 discount.
+//   잎:   Evaluator 가 policy logits(40) 와 value 를 준다. 게임 오버 잎의 value 는 0.
+//
+// 병렬: 스레드 여러 개가 트리 하나를 같이 탄다. 노드마다 작은 spin lock 이
+// 그 노드의 간선 통계를 지키고, 내려가는 동안 지나간 간선에 virtual loss 를 건다 —
+// 아직 평가가 끝나지 않은 방문을 virtualLoss 번의 "정규화 Q = 0" 방문으로 쳐서 다른
+// 스레드가 같은 수순으로 몰리지 않게 한다. 스레드마다 잎을 leafBatch 개까지 모아
+// Evaluate 를 한 번에 부르므로 신경망 평가기는 batch 로 돈다. 남이 평가 중인 잎에
+// 닿으면(collision) 그 수순은 virtual loss 를 되돌리고 버린다.
+//
+// 재현성: threads = 1, leafBatch = 1 이면 결과는 (상태, seed) 로만 정해진다.
+// 스레드가 여럿이면 방문 순서가 스케줄에 달려 있어 방문 수가 조금씩 달라진다.
+
+namespace bot {
+
+struct Evaluation
+{
+    float logits[kNumPlacements];   // 불법 수 자리는 무시된다
+    float value;                    // 이 판 이후 받을 할인 보상의 추정
+};
+
+// 잎 평가기. 여러 탐색 스레드가 동시에 부르므로 thread-safe 여야 한다.
+class Evaluator
+{
+public:
+    virtual ~Evaluator() = default;
+
+    // sims[i] 를 평가해 out[i] 에 쓴다. count 는 1..MctsConfig::leafBatch.
+    virtual void Evaluate(const SimGame* const* sims, int count, Evaluation* out) = 0;
+
+    // 착수 한 번의 보상. 기본은 placement env(python/common/env.py)와 같은 지운 줄 수다.
+    virtual double Reward(int linesCleared, bool toppedOut) const
+    {
+        (void)toppedOut;
+        return static_cast<double>(linesCleared);
+    }
+};
+
+// 신경망 없이 쓰는 평가기. prior 는 한 수 둬 본 eval_board 의 softmax, value 는
+// 보드 모양 점수(eval_shape)다. 보상을 eval_lines 로 주므로 할인 없는 수순의 누적
+// 값이 beam search 의 잎 점수(eval_board)와 같은 척도가 된다.
+class HeuristicEvaluator : public Evaluator
+{
+public:
+    // prior 온도. 작을수록 greedy 한 수에 prior 가 몰린다.
+    explicit HeuristicEvaluator(double temperature = 1.0) : temperature_(temperature) {}
+
+    void Evaluate(const SimGame* const* sims, int count, Evaluation* out) override;
+    double Reward(int linesCleared, bool toppedOut) const override;
+
+    // 게임 오버 착수의 보상. 보드 모양 점수보다 충분히 나빠야 한다.
+    static constexpr double kTopOutReward = -100.0;
+
+private:
+    double temperature_;
+};
+
+class BotOnnx;
+
+// BotOnnx 의 policy_logits / value 출력을 쓰는 평가기. 잎 batch 를 EvaluateBatch
+// 한 번으로 돌린다(batch 1 로 고정된 예전 모델이면 BotOnnx 가 한 판씩 나눈다).
+// 세션 하나를 여러 스레드가 나눠 쓰지 않게 호출을 직렬화한다. 탐색 스레드끼리의
+// 잎까지 한 batch 로 묶으려면 bot/inference_server.h 의 ServerEvaluator 를 쓴다.
+class OnnxEvaluator : public Evaluator
+{
+public:
+    explicit OnnxEvaluator(BotOnnx& model) : model_(model) {}
+
+    void Evaluate(const SimGame* const* sims, int count, Evaluation* out) override;
+
+private:
+    BotOnnx& model_;
+    std::mutex mutex_;
+    std::vector<float> board_, current_, next_, logits_, values_;   // mutex_ 가 지킨다
+};
+
+struct MctsConfig
+{
+    int    simulations = 200;
+    int    threads = 1;            // 트리를 같이 타는 스레드 수 (호출 스레드 포함)
+    int    leafBatch = 8;          // 스레드마다 한 번에 평가하는 잎 수
+    double pbCBase = 19652.0;      // muzero_tetris.py --pb-c-base
+    double pbCInit = 1.25;         // muzero_tetris.py --pb-c-init
+    double discount = 0.99;        // muzero_tetris.py --gamma
+    int    virtualLoss = 1;        // 평가 중인 방문 하나를 몇 번의 최악 방문으로 칠지
+    double dirichletAlpha = 0.0;   // 루트 prior 잡음. 0 이면 끈다 (self-play 학습용)
+    double dirichletFrac = 0.25;
+    uint64_t seed = 1;             // 잡음 시드. 실제 시드는 (seed, 루트 Fingerprint)
+    double budgetMs = 0.0;         // 0 보다 크면 시간이 다 되면 simulations 전에 멈춘다
+    // 밖에서 멈추라는 신호. true 가 되면 예산이 다 된 것처럼 그때까지의 방문으로 답한다.
+    const std::atomic<bool>* cancel = nullptr;
+};
+
+struct MctsResult
+{
+    int   action = -1;                      // 방문이 가장 많은 수. 합법 수가 없으면 -1
+    float visits[kNumPlacements] = {};      // 루트 간선 방문 수
+    float prior[kNumPlacements] = {};       // 루트 prior (잡음 포함)
+    float rootValue = 0.0f;                 // 루트 간선 Q 의 방문 가중 평균
+    int   simulations = 0;                  // 끝낸 시뮬레이션 수
+    int   nodes = 0;
+    int   maxDepth = 0;
+    int   collisions = 0;
+    double elapsedMs = 0.0;
+};
+
+class Mcts
+{
+public:
+    Mcts(Evaluator& evaluator, const MctsConfig& config);
+    ~Mcts();
+
+    Mcts(const Mcts&) = delete;
+    Mcts& operator=(const Mcts&) = delete;
+
+    // root 에서 탐색한다. 트리는 호출마다 새로 만든다(노드 풀은 재사용).
+    // 한 Mcts 객체로 Search 를 동시에 부르지 않는다.
+    MctsResult Search(const SimGame& root);
+
+    const MctsConfig& Config() const { return config_; }
+    // config.cancel 만 바꾼다. Search 와 동시에 부르지 않는다.
+    void SetCancel(const std::atomic<bool>* cancel) { config_.cancel = cancel; }
+
+private:
+    struct Tree;
+    Evaluator& evaluator_;
+    MctsConfig config_;
+    std::unique_ptr<Tree> tree_;
+};
+
+// Search 한 번으로 착수를 고른다. 둘 곳이 없으면 false.
+bool mcts_placement(Mcts& mcts, const SimGame& sim, int& col_out, int& rot_out,
+                    MctsResult* result = nullptr);
+
+}  // namespace bot
@@ -1,10 +1,13 @@
 // placement 계산과 관측 변환의 구현. Python 쪽과 맞춰야 하는 계약은 .h에 적어 뒀다.
 #include "placement.h"
+#include "board_features.h"
 
 #include "../src/sim_game.h"
 #include "../core/input.h"
+#include "../core/rng.h"
 
 #include <algorithm>
+#include <limits>
 
 namespace bot {
 
@@ -36,6 +39,18 @@ std::vector<uint8_t> expand_placement(int cur_col,
     return seq;
 }
 
+uint64_t piece_key(const SimGame& sim)
+{
+    uint64_t preview = static_cast<uint64_t>(static_cast<uint8_t>(sim.CurrentBlockId()));
+    int shift = 8;
+    for (const SimBlock& b : sim.NextBlocks()) {
+        preview |= static_cast<uint64_t>(static_cast<uint8_t>(b.id)) << shift;
+        shift += 8;
+    }
+    const uint64_t h = splitmix64(sim.GridFingerprint() ^ preview);
+    return splitmix64(h ^ sim.RngState());
+}
+
 bool fallback_placement(const SimGame& sim, int& col_out, int& rot_out)
 {
     auto placements = sim.LegalPlacements();
@@ -53,13 +68,40 @@ bool fallback_placement(const SimGame& sim, int& col_out, int& rot_out)
     return true;
 }
 
+bool best_legal_placement(const SimGame& sim, const float* logits, int& col_out, int& rot_out)
+{
+    SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+    const int n = sim.EnumeratePlacements(landed);
+    if (n == 0) return false;
+
+    bool legal[kNumPlacements] = {false};
+    for (int k = 0; k < n; ++k) legal[encode_action(landed[k].col, landed[k].rot)] = true;
+
+    // 동점이면 action 번호가 작은 쪽. 열거 순서와 무관하게 같은 수를 고른다.
+    int   bestIdx = -1;
+    float bestVal = -std::numeric_limits<float>::infinity();
+    for (int a = 0; a < kNumPlacements; ++a) {
+        if (legal[a] && logits[a] > bestVal) {
+            bestVal = logits[a];
+            bestIdx = a;
+        }
+    }
+    if (bestIdx < 0) {
+        // 합법 수는 있는데 전부 -inf 인 경우. 모델이 NaN 을 뱉으면 이렇게 된다.
+        // 게임이 멈추는 것보다는 아무 수나 두는 편이 낫다.
+        return fallback_placement(sim, col_out, rot_out);
+    }
+    decode_action(bestIdx, col_out, rot_out);
+    return true;
+}
+
 void observe(const SimGame& sim,
              float* board_out,
              float* current_out,
              float* next_out)
 {
     // 굳은 블록만 1로 친다. ghost(8)는 화면에만 있는 것이라 0이다.
-    // python/common/obs.py의 (grid > 0) & (grid != 8)과 같은 조건이다.
+    // python/common/obs.py의 reference_observation과 같은 조건이다.
     const auto& grid = sim.Grid();
     for (int r = 0; r < kBoardRows; ++r) {
         for (int c = 0; c < kBoardCols; ++c) {
@@ -81,49 +123,62 @@ void observe(const SimGame& sim,
 }
 
 namespace {
-// 굳은 블록인지 판정한다. observe와 같은 규칙을 써야 평가와 관측이 어긋나지 않는다.
-inline bool is_locked(int v) { return v > 0 && v != 8; }
-
-// 보드를 한 숫자로 점수화한다. 클수록 좋은 판이다.
-//   score = -0.51*총높이 + 0.76*삭제줄 - 0.36*구멍 - 0.18*요철
-// 널리 쓰이는 Tetris 휴리스틱 가중치다. 구멍(위가 막힌 빈칸)에 큰 벌점을 주는
-// 것이 핵심이고, 나머지는 판을 낮고 평평하게 유지하라는 뜻이다.
-double eval_board(const int (&grid)[kBoardRows][kBoardCols], int lines_cleared)
+// 행 마스크의 보드 모양 점수. 높이·구멍은 board_surface 가 한 번에 센다.
+double shape_score(const BoardRows& rows)
 {
-    int heights[kBoardCols] = {0};
-    int holes = 0;
-    for (int c = 0; c < kBoardCols; ++c) {
-        int top = -1;
-        for (int r = 0; r < kBoardRows; ++r)
-            if (is_locked(grid[r][c])) { top = r; break; }
-        if (top < 0) continue;                 // 빈 컬럼
-        heights[c] = kBoardRows - top;
-        for (int r = top; r < kBoardRows; ++r)
-            if (!is_locked(grid[r][c])) ++holes;
-    }
+    int32_t heights[kBoardCols];
+    const int holes = board_surface(rows, heights);
     int agg_height = 0, bumpiness = 0;
     for (int c = 0; c < kBoardCols; ++c) agg_height += heights[c];
     for (int c = 0; c + 1 < kBoardCols; ++c) {
         int d = heights[c] - heights[c + 1];
         bumpiness += (d < 0 ? -d : d);
     }
-    return -0.510066 * agg_height + 0.760666 * lines_cleared
-           - 0.356630 * holes - 0.184483 * bumpiness;
+    return -0.510066 * agg_height - 0.356630 * holes - 0.184483 * bumpiness;
 }
 }  // namespace
 
+// 가중치 설명은 placement.h.
+double eval_board(const int (&grid)[kBoardRows][kBoardCols], int lines_cleared)
+{
+    return eval_shape(grid) + eval_lines(lines_cleared);
+}
+
+double eval_board(const SimGame& sim, int lines_cleared)
+{
+    return eval_shape(sim) + eval_lines(lines_cleared);
+}
+
+double eval_shape(const int (&grid)[kBoardRows][kBoardCols])
+{
+    BoardRows rows;
+    board_rows(grid, rows);
+    return shape_score(rows);
+}
+
+double eval_shape(const SimGame& sim)
+{
+    BoardRows rows;
+    board_rows(sim, rows);
+    return shape_score(rows);
+}
+
 bool heuristic_placement(const SimGame& sim, int& col_out, int& rot_out)
 {
-    auto placements = sim.LegalPlacements();
-    if (placements.empty()) return false;
+    // 회전 대칭으로 같은 칸에 떨어지는 수는 점수도 같고, 동점이면 먼저 본(rot 가 작은)
+    // 수를 고르므로 대칭 중복을 빼고 봐도 답은 같다.
+    SimGame::LandedPlacement placements[SimGame::kMaxPlacements];
+    const int n = sim.EnumerateDistinctPlacements(placements);
+    if (n == 0) return false;
 
     bool   found = false;
     double best  = 0.0;
-    for (const auto& p : placements) {
+    for (int k = 0; k < n; ++k) {
+        const SimGame::LandedPlacement& p = placements[k];
         SimGame trial = sim;                   // 값 복사 — 실제 sim 은 불변
-        int cleared = trial.ApplyPlacement(p.col, p.rot);
+        int cleared = trial.ApplyLandedPlacement(p);
         if (cleared < 0) continue;             // 비합법(이론상 없음)
-        double s = eval_board(trial.Grid(), cleared);
+        double s = eval_board(trial, cleared);
         if (!found || s > best) {
             best = s; col_out = p.col; rot_out = p.rot; found = true;
         }
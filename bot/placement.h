@@ -18,6 +18,7 @@
 //
 //   fallback_placement — 추론이 실패했을 때 쓰는 최후 수단.
 //   heuristic_placement — ONNX 모델이 없을 때 쓰는 규칙 기반 bot.
+//                         미리보기까지 읽는 더 강한 버전은 bot/beam_search.h.
 
 class SimGame;
 
@@ -41,11 +42,36 @@ std::vector<uint8_t> expand_placement(int cur_col,
                                       int tgt_col,
                                       int tgt_rot);
 
+// 같은 블록이 떠 있는 동안 변하지 않는 키. 틱마다 봇 입력을 내는 쪽(bot/async_bot.h,
+// bot/arena.h)이 새 블록이 나왔는지 이것으로 안다. 중력으로 내려가는 행과 입력으로
+// 바뀌는 열·회전은 빼고, lock 때마다 바뀌는 그리드 지문·가방 RNG·미리보기를 섞는다.
+uint64_t piece_key(const SimGame& sim);
+
 // 아무 합법 수나 하나 고른다. (col, rot) 오름차순의 첫 번째.
 // 좋은 수를 두려는 게 아니라 bot이 멈춰버리는 것을 막는 안전장치다.
 // 합법 수가 하나도 없으면(= 게임 오버 직전) false.
 bool fallback_placement(const SimGame& sim, int& col_out, int& rot_out);
 
+// 정책 logits(40) 중 합법 수만 보고 가장 큰 자리를 고른다. 모델이 이상한 값을
+// 내도 규칙에 어긋난 수는 나오지 않고, 합법 logit 이 전부 NaN/-inf 면
+// fallback_placement 로 물러선다. 합법 수가 없으면 false.
+bool best_legal_placement(const SimGame& sim, const float* logits, int& col_out, int& rot_out);
+
+// 보드를 한 숫자로 점수화한다. 클수록 좋은 판이다.
+//   score = (-0.51*총높이 - 0.36*구멍 - 0.18*요철) + 0.76*삭제줄
+// 널리 쓰이는 Tetris 휴리스틱 가중치다. 구멍(위가 막힌 빈칸)에 큰 벌점을 주는
+// 것이 핵심이고, 나머지는 판을 낮고 평평하게 유지하라는 뜻이다.
+// heuristic_placement 와 beam_placement(bot/beam_search.h)가 같이 쓴다.
+double eval_board(const int (&grid)[kBoardRows][kBoardCols], int lines_cleared);
+// eval_board 에서 삭제줄 항을 뺀 보드 모양 점수. 보드에만 달린 값이라 전치표에
+// 담아 둘 수 있다. eval_board(g, l) == eval_shape(g) + eval_lines(l) 가 비트 단위로 같다.
+double eval_shape(const int (&grid)[kBoardRows][kBoardCols]);
+// 같은 점수를 SimGame 의 행 마스크에서 바로 구한다(칸을 다시 훑지 않는다).
+// 탐색 안쪽 루프는 이쪽을 쓴다. 특징 추출 자체는 bot/board_features.h.
+double eval_board(const SimGame& sim, int lines_cleared);
+double eval_shape(const SimGame& sim);
+inline double eval_lines(int lines_cleared) { return 0.760666 * lines_cleared; }
+
 // 1수 앞만 보는 greedy policy. 합법 수를 전부 SimGame 복사본에 둬 보고
 // 결과 보드를 점수화해 제일 나은 것을 고른다.
 // 평가 항목은 총 높이, 지운 줄 수, 구멍 수, 요철 네 가지다.
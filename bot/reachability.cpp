@@ -0,0 +1,260 @@
+// 닿을 수 있는 자리 BFS 와 그 캐시. 전이 규칙은 reachability.h 에 적어 뒀다.
+#include "reachability.h"
+
+#include "../src/sim_game.h"
+#include "../src/sim_shapes.h"
+#include "../core/input.h"
+#include "../core/rng.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bot {
+
+namespace {
+
+// columnOffset 은 SimGrid::Fits 처럼 -kColPad..kCols, rowOffset 은 -kRowPad..kRows-1.
+constexpr int kColPad  = 4;
+constexpr int kRowPad  = 4;
+constexpr int kColSpan = SimGrid::kCols + kColPad + 1;   // 15
+constexpr int kRowSpan = SimGrid::kRows + kRowPad;       // 24
+constexpr uint32_t kWallLane = ((1u << kColPad) - 1) | (~0u << (SimGrid::kCols + kColPad));
+
+// 상태 인덱스: lastRotate(1) | downHeld(1) | rot(2) | col(4) | row(5). 나눗셈 없이 푼다.
+//   downHeld   — 직전 틱이 움직인 DOWN. 이번 DOWN 은 움직이지 않는다
+//   lastRotate — lastMoveWasRotate. T 가 아니면 늘 0 으로 접는다
+constexpr int kRotShift  = 2;
+constexpr int kColShift  = 4;
+constexpr int kRowShift  = 8;
+constexpr int kStates    = kRowSpan << kRowShift;
+static_assert(kColSpan <= 16 && kStates <= 32767, "state index must fit int16_t");
+
+constexpr int encode(int row, int col, int rot, int downHeld, int lastRotate)
+{
+    return ((row + kRowPad) << kRowShift) | ((col + kColPad) << kColShift)
+         | (rot << kRotShift) | (downHeld << 1) | lastRotate;
+}
+
+// 행마다 벽 비트를 붙인 lane. SimGrid::Fits 와 같은 검사를 SimGame 밖에서 한다.
+struct Lanes
+{
+    uint32_t lane[SimGrid::kRows];
+
+    explicit Lanes(const SimGame& sim)
+    {
+        for (int r = 0; r < SimGrid::kRows; ++r)
+            lane[r] = (static_cast<uint32_t>(sim.RowMask(r)) << kColPad) | kWallLane;
+    }
+
+    bool Fits(int shape, int rot, int row, int col) const
+    {
+        if (col < -kColPad || col > SimGrid::kCols) return false;
+        const uint16_t (&rows)[4] = sim_shapes::kRowMasks.rows[shape][rot];
+        for (int i = 0; i < 4; ++i) {
+            if (rows[i] == 0) continue;
+            const int r = row + i;
+            if (r < 0 || r >= SimGrid::kRows) return false;
+            if (lane[r] & (static_cast<uint32_t>(rows[i]) << (col + kColPad))) return false;
+        }
+        return true;
+    }
+
+    bool Blocked(int row, int col) const
+    {
+        if (row < 0 || row >= SimGrid::kRows || col < 0 || col >= SimGrid::kCols) return true;
+        return (lane[row] >> (col + kColPad)) & 1u;
+    }
+
+    // SimGame::IsTSpinLock 의 모서리 검사.
+    bool TSpinCorners(int row, int col) const
+    {
+        const int pr = row + 1, pc = col + 1;
+        const int blocked = Blocked(pr - 1, pc - 1) + Blocked(pr - 1, pc + 1)
+                          + Blocked(pr + 1, pc - 1) + Blocked(pr + 1, pc + 1);
+        return blocked >= 3;
+    }
+};
+
+// (rot, col) 마다 블록이 들어가는 행을 비트로 모은 표(비트 row + kRowPad).
+// BFS 의 충돌 검사는 전부 비트 하나를 보는 것이고, hard drop 착지 행은
+// 지금 행 위로 처음 비는 비트 바로 앞이다.
+struct FitTable
+{
+    uint32_t rows[sim_shapes::kNumRotations][kColSpan];
+
+    FitTable(const Lanes& lanes, int shape)
+    {
+        for (int rot = 0; rot < sim_shapes::kNumRotations; ++rot)
+            for (int c = 0; c < kColSpan; ++c) {
+                uint32_t bits = 0;
+                for (int r = 0; r < kRowSpan; ++r)
+                    if (lanes.Fits(shape, rot, r - kRowPad, c - kColPad)) bits |= 1u << r;
+                rows[rot][c] = bits;
+            }
+    }
+
+    // 인덱스는 패딩을 더한 값. 범위 밖 열·행은 들어가지 않는다.
+    bool Fits(int rot, int c, int r) const
+    {
+        return c >= 0 && c < kColSpan && r < kRowSpan && ((rows[rot][c] >> r) & 1u);
+    }
+
+    // r 에 들어가는 블록을 hard drop 했을 때의 행 인덱스.
+    int Land(int rot, int c, int r) const
+    {
+        // 비트 0 은 r 자신이라 늘 들어간다. 표 위쪽 빈 비트는 바닥 밖이라 막힌 것으로 읽힌다.
+        return r + SimGrid::LowestSetBit(~(rows[rot][c] >> r)) - 1;
+    }
+};
+
+constexpr int kTShape = 6;
+
+}  // namespace
+
+int reachable_placements(const SimGame& sim, ReachableSet& out)
+{
+    out.Clear();
+    if (sim.IsGameOver()) return 0;
+    const int shape = sim.CurrentBlockId();
+    if (shape < 1 || shape >= sim_shapes::kNumShapes) return 0;
+
+    const Lanes lanes(sim);
+    const bool isT = shape == kTShape;
+    if (!lanes.Fits(shape, sim.CurrentRotation(), sim.CurrentRow(), sim.CurrentCol())) return 0;
+    const FitTable fits(lanes, shape);
+
+    // parent == -1 이면 아직 안 간 상태. 시작 상태는 자기 자신을 부모로 둔다.
+    int16_t parent[kStates];
+    uint8_t action[kStates];
+    int16_t queue[kStates];
+    std::memset(parent, 0xFF, sizeof(parent));
+    // 최종 자리: 대표 rotation 기준 (row, col, rot, tspin).
+    bool landed[kRowSpan][kColSpan][sim_shapes::kNumRotations][2];
+    std::memset(landed, 0, sizeof(landed));
+
+    int head = 0, tail = 0;
+    const int startIndex = encode(sim.CurrentRow(), sim.CurrentCol(), sim.CurrentRotation(),
+                                  sim.SoftDropCounterTicks() > 0 ? 1 : 0,
+                                  isT && sim.LastMoveWasRotate() ? 1 : 0);
+    parent[startIndex] = static_cast<int16_t>(startIndex);
+    queue[tail++] = static_cast<int16_t>(startIndex);
+
+    auto visit = [&](int from, int index, uint8_t mask) {
+        if (parent[index] >= 0) return;
+        parent[index] = static_cast<int16_t>(from);
+        action[index] = mask;
+        queue[tail++] = static_cast<int16_t>(index);
+    };
+
+    while (head < tail) {
+        const int index = queue[head++];
+        const int r = index >> kRowShift;                     // 패딩을 더한 인덱스
+        const int c = (index >> kColShift) & 0xF;
+        const int rot = (index >> kRotShift) & 0x3;
+        const bool downHeld = (index & 2) != 0;
+        const int lastRotate = index & 1;
+
+        // DROP: 착지 행까지 떨어뜨려 lock. 처음 닿은 자리가 가장 짧은 경로다.
+        const int landR = fits.Land(rot, c, r);
+        const int row = landR - kRowPad;
+        const int col = c - kColPad;
+        const bool tspin = lastRotate && lanes.TSpinCorners(row, col);
+        const int canon = sim_shapes::kSymmetries.canon[shape][rot];
+        bool& seen = landed[landR + sim_shapes::kSymmetries.dRow[shape][rot]]
+                           [c + sim_shapes::kSymmetries.dCol[shape][rot]][canon][tspin ? 1 : 0];
+        if (!seen) {
+            seen = true;
+            ReachablePlacement p;
+            p.col = col;
+            p.rot = rot;
+            p.row = row;
+            p.tspin = tspin;
+            p.pathOffset = static_cast<uint16_t>(out.inputs.size());
+            // 부모를 거슬러 올라가며 거꾸로 쌓은 뒤 뒤집는다.
+            for (int at = index; parent[at] != at; at = parent[at]) out.inputs.push_back(action[at]);
+            std::reverse(out.inputs.begin() + p.pathOffset, out.inputs.end());
+            out.inputs.push_back(INPUT_DROP);
+            p.pathLength = static_cast<uint16_t>(out.inputs.size() - p.pathOffset);
+            out.placements.push_back(p);
+        }
+
+        // 막힌 이동은 제자리에 소프트 드롭 카운터만 푸는 것이라 NONE 과 같다. 넣지 않는다.
+        const int moved = index & ~((0xF << kColShift) | 3);   // 열과 두 플래그를 비운 인덱스
+        if (fits.Fits(rot, c - 1, r)) visit(index, moved | ((c - 1) << kColShift), INPUT_LEFT);
+        if (fits.Fits(rot, c + 1, r)) visit(index, moved | ((c + 1) << kColShift), INPUT_RIGHT);
+        const int rotated = (rot + 1) & 0x3;
+        if (fits.Fits(rotated, c, r))
+            visit(index, (index & ~((0x3 << kRotShift) | 3)) | (rotated << kRotShift) | (isT ? 1 : 0),
+                  INPUT_ROTATE);
+        if (!downHeld && fits.Fits(rot, c, r + 1))
+            visit(index, ((index & ~1) + (1 << kRowShift)) | 2, INPUT_DOWN);
+        if (downHeld) visit(index, index & ~2, INPUT_NONE);
+    }
+    return static_cast<int>(out.placements.size());
+}
+
+int apply_reachable(SimGame& sim, const ReachableSet& set, int index)
+{
+    if (index < 0 || index >= static_cast<int>(set.placements.size())) return -1;
+    const ReachablePlacement& p = set.placements[index];
+    if (p.pathLength == 0 || sim.IsGameOver()) return -1;
+
+    const uint8_t* path = set.Path(p);
+    const uint64_t grid = sim.GridFingerprint();
+    for (int i = 0; i + 1 < p.pathLength; ++i) sim.SubmitInput(path[i]);
+    // 마지막 DROP 직전: 아직 lock 하지 않았고 블록이 그 자리 위에 있어야 한다.
+    if (sim.IsGameOver() || sim.GridFingerprint() != grid || sim.CurrentCol() != p.col ||
+        sim.CurrentRotation() != p.rot)
+        return -1;
+    const Lanes lanes(sim);
+    int row = sim.CurrentRow();
+    while (lanes.Fits(sim.CurrentBlockId(), p.rot, row + 1, p.col)) ++row;
+    if (row != p.row) return -1;
+    sim.SubmitInput(path[p.pathLength - 1]);
+    if ((sim.lastTSpinLines >= 0) != p.tspin) return -1;
+    return sim.lastLinesCleared;
+}
+
+ReachabilityCache::ReachabilityCache(size_t entries)
+{
+    size_t n = 1;
+    while (n < entries) n <<= 1;
+    slots_.reset(new Slot[n]);
+    mask_ = n - 1;
+}
+
+const ReachableSet& ReachabilityCache::Get(const SimGame& sim)
+{
+    // 결과를 정하는 것은 굳은 칸과 블록의 프레임 상태뿐이다(미리보기·RNG 는 무관).
+    uint64_t piece = static_cast<uint64_t>(static_cast<uint8_t>(sim.CurrentBlockId()));
+    piece |= static_cast<uint64_t>(static_cast<uint8_t>(sim.CurrentRow())) << 8;
+    piece |= static_cast<uint64_t>(static_cast<uint8_t>(sim.CurrentCol())) << 16;
+    piece |= static_cast<uint64_t>(sim.CurrentRotation()) << 24;
+    piece |= static_cast<uint64_t>(sim.SoftDropCounterTicks() > 0) << 32;
+    piece |= static_cast<uint64_t>(sim.LastMoveWasRotate()) << 33;
+    piece |= static_cast<uint64_t>(sim.IsGameOver()) << 34;
+    const uint64_t key = splitmix64(sim.GridFingerprint() ^ splitmix64(piece));
+
+    Slot& slot = slots_[key & mask_];
+    if (slot.valid && slot.key == key) {
+        ++hits_;
+        return slot.set;
+    }
+    ++misses_;
+    reachable_placements(sim, slot.set);
+    slot.key = key;
+    slot.valid = true;
+    return slot.set;
+}
+
+void ReachabilityCache::Clear()
+{
+    for (size_t i = 0; i <= mask_; ++i) {
+        slots_[i].valid = false;
+        slots_[i].set.Clear();
+    }
+    hits_ = 0;
+    misses_ = 0;
+}
+
+}  // namespace bot
@@ -0,0 +1,97 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// 입력으로 닿을 수 있는 모든 착지 자리와 그 최단 입력 경로.
+//
+// SimGame::EnumeratePlacements 는 "회전 → 좌우 이동 → hard drop" 만 센다. 블록을
+// 내린 뒤 옆으로 밀어 넣는 tuck 이나, 바닥에서 회전해 들어가는 T-spin 자리는 그
+// 목록에 없어서 봇이 IsTSpinLock 의 큰 공격(2/4/6 줄)을 노릴 수 없었다.
+//
+// 여기서는 (row, col, rot) 위에서 BFS 를 한다. 한 걸음이 한 틱의 입력 하나이고
+// 전이는 SimGame::SubmitInput 과 같다.
+//   LEFT / RIGHT   — 한 칸. 막히면 제자리. 성공하면 lastMoveWasRotate 를 내린다
+//   ROTATE         — 시계 방향, kick 없음. 막히면 제자리. 성공하면 lastMoveWasRotate
+//   DOWN           — 한 칸. 소프트 드롭 카운터 때문에 DOWN 을 연달아 두 틱 누르면
+//                    두 번째는 움직이지 않는다 — DOWN 사이에 다른 입력(또는 NONE)이 낀다
+//   DROP           — 끝. 착지 행까지 떨어져 lock, T 면 lastMoveWasRotate 와 네 모서리로
+//                    T-spin 여부가 정해진다
+// 바닥에서 DOWN 으로 lock 하는 수는 같은 자리에 DROP 으로 닿는 수와 길이가 같아 뺀다.
+//
+// 결과는 서로 다른 최종 칸 집합(회전 대칭은 sim_shapes::kSymmetries 로 합친다)과
+// T-spin 여부마다 하나씩이고, 경로는 BFS 순서라 틱 수가 가장 짧다. 벽에 붙은 세로 I
+// (columnOffset < 0)처럼 (col, rot) 액션 공간 밖의 자리도 나온다.
+//
+// 중력은 모델링하지 않는다. 경로를 SubmitInput 만으로 재생하면(apply_reachable)
+// 정확히 그 자리에 lock 한다. 실제 게임에서 틱마다 흘려 넣을 때는 경로가
+// dropIntervalTicks 보다 길면 도중에 중력으로 한 칸씩 내려올 수 있다.
+//
+// 한 번의 BFS 는 상태 수천 개(행 24 × 열 15 × 회전 4 × 소프트 드롭 × 회전 플래그)
+// 안에서 끝나고 할당이 없다(결과 버퍼는 호출자가 재사용). 같은 보드·같은 블록 상태를
+// 되풀이해 묻는 탐색·학습 루프는 ReachabilityCache 로 결과를 외워 둔다.
+
+class SimGame;
+
+namespace bot {
+
+struct ReachablePlacement
+{
+    int  col;          // lock 시 columnOffset. 음수일 수 있다
+    int  rot;
+    int  row;          // lock 시 rowOffset
+    bool tspin;        // 이 자리에 lock 하면 IsTSpinLock 이 참
+    uint16_t pathOffset;   // ReachableSet::inputs 안의 경로 시작
+    uint16_t pathLength;   // 마지막 DROP 포함 틱 수
+};
+
+struct ReachableSet
+{
+    std::vector<ReachablePlacement> placements;   // 경로가 짧은 순
+    std::vector<uint8_t> inputs;                  // 모든 경로를 이어 붙인 INPUT_* 마스크
+
+    const uint8_t* Path(const ReachablePlacement& p) const { return inputs.data() + p.pathOffset; }
+    void Clear() { placements.clear(); inputs.clear(); }
+};
+
+// sim 의 지금 블록에서 닿는 자리를 out 에 채우고 개수를 돌려준다. out 의 용량은
+// 재사용한다. 게임이 끝났으면 0.
+int reachable_placements(const SimGame& sim, ReachableSet& out);
+
+// set 의 index 번 경로를 SubmitInput 으로 재생한다(Tick 없음). 반환값은 지운 줄 수,
+// 경로가 그 자리에 lock 하지 않으면(다른 상태에서 얻은 set 등) -1 이고 sim 은
+// 재생하다 만 상태로 남는다.
+int apply_reachable(SimGame& sim, const ReachableSet& set, int index);
+
+// reachable_placements 결과를 (그리드 지문, 블록 상태) 로 외워 두는 direct-mapped 캐시.
+// 새 키가 같은 칸의 옛 결과를 밀어낸다. 스레드마다 하나씩 둔다(잠금 없음).
+class ReachabilityCache
+{
+public:
+    // entries 는 2의 거듭제곱으로 올린다.
+    explicit ReachabilityCache(size_t entries = 1024);
+
+    // sim 의 결과. 돌려준 참조는 다음 Get/Clear 까지만 유효하다.
+    const ReachableSet& Get(const SimGame& sim);
+    void Clear();
+
+    uint64_t Hits() const { return hits_; }
+    uint64_t Misses() const { return misses_; }
+    size_t Entries() const { return mask_ + 1; }
+
+private:
+    struct Slot
+    {
+        uint64_t key = 0;
+        bool valid = false;
+        ReachableSet set;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+}  // namespace bot
@@ -0,0 +1,182 @@
+#include "replay_dataset.h"
+#include "placement.h"
+#include "../src/sim_replay.h"
+#include "../core/input.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace bot {
+
+namespace {
+
+constexpr uint8_t kBeforeDown = INPUT_LEFT | INPUT_RIGHT;
+constexpr uint8_t kThroughDown = INPUT_LEFT | INPUT_RIGHT | INPUT_DOWN;
+
+// 보드 하나에서 지금 떨어지고 있는 블록의 기록.
+struct BoardTrack
+{
+    SelfPlayRecord spawn{};     // 블록이 나온 순간의 관측
+    bool touched = false;       // 나온 뒤 입력이 있었다
+    uint16_t ply = 0;
+};
+
+struct Decoder
+{
+    uint32_t match;
+    const ReplayDecodeConfig& config;
+    std::vector<SelfPlayRecord>& out;
+    int64_t locks = 0;
+    int64_t skipped = 0;
+    size_t first = 0;
+
+    // before 의 블록이 lock 되어 after 가 되었다.
+    void Lock(int player, BoardTrack& track, const SimGame& before, const SimGame& after)
+    {
+        ++locks;
+        const int col = before.CurrentCol();
+        const bool record = (config.players >> player) & 1;
+        if (record && (track.touched || !config.skipIdle) && col >= 0 && col < kNumCols) {
+            SelfPlayRecord rec = track.spawn;
+            rec.match = match;
+            rec.ply = track.ply;
+            rec.player = static_cast<uint8_t>(player);
+            rec.action = static_cast<uint8_t>(encode_action(col, before.CurrentRotation()));
+            rec.linesCleared = static_cast<uint8_t>(std::clamp(after.lastLinesCleared, 0, 255));
+            rec.attackSent = static_cast<uint8_t>(
+                std::clamp(after.AttackLinesSent() - before.AttackLinesSent(), 0, 255));
+            out.push_back(rec);
+        } else if (record) {
+            ++skipped;
+        }
+        ++track.ply;
+        track.touched = false;
+        capture_observation(after, track.spawn);
+    }
+
+    // pre 에서 mask 로 한 틱 진행해 post 가 되었다. post 는 가비지 교환까지 끝난 상태다.
+    void Tick(int player, BoardTrack& track, const SimGame& pre, uint8_t mask, const SimGame& post)
+    {
+        if (pre.IsGameOver()) return;
+        track.touched = track.touched || (mask & kThroughDown) != 0;
+        // lock 은 늘 칸을 쓰므로(줄이 지워져도 윗줄이 내려온다) 그리드 지문이 바뀐다.
+        if (post.GridFingerprint() == pre.GridFingerprint()) {
+            track.touched = track.touched || mask != 0;
+            return;
+        }
+        SimGame beforeDown = pre, afterDown = pre;
+        if (mask & INPUT_DOWN) {
+            beforeDown.SubmitInput(mask & kBeforeDown);
+            afterDown.SubmitInput(mask & kThroughDown);
+            if (afterDown.GridFingerprint() != beforeDown.GridFingerprint())
+                Lock(player, track, beforeDown, afterDown);
+        }
+        track.touched = track.touched || (mask & (INPUT_ROTATE | INPUT_DROP)) != 0;
+        SimGame submitted = pre;
+        submitted.SubmitInput(mask);
+        if (mask & INPUT_DROP) {
+            SimGame beforeDrop = pre;
+            beforeDrop.SubmitInput(mask & ~INPUT_DROP);
+            if (submitted.GridFingerprint() != beforeDrop.GridFingerprint())
+                Lock(player, track, beforeDrop, submitted);
+        }
+        if (post.GridFingerprint() != submitted.GridFingerprint()) Lock(player, track, submitted, post);
+    }
+};
+
+}  // namespace
+
+int64_t decode_replay(uint32_t match, uint64_t seed, const FrameInputs* frames, size_t ticks,
+                      const ReplayDecodeConfig& config, std::vector<SelfPlayRecord>& out,
+                      int64_t* skipped)
+{
+    Decoder d{match, config, out};
+    d.first = out.size();
+    ReplaySim sim(seed);
+    BoardTrack track[2];
+    for (int p = 0; p < 2; ++p) capture_observation(sim.Board(p), track[p].spawn);
+
+    for (size_t t = 0; t < ticks; ++t) {
+        if (sim.Board(0).IsGameOver() && sim.Board(1).IsGameOver()) break;
+        const SimGame pre[2] = {sim.Board(0), sim.Board(1)};
+        sim.Step(frames[t]);
+        d.Tick(0, track[0], pre[0], frames[t].p1, sim.Board(0));
+        d.Tick(1, track[1], pre[1], frames[t].p2, sim.Board(1));
+    }
+
+    // 리플레이 끝에서 혼자 살아남은 쪽이 이긴 것으로 친다.
+    const bool dead0 = sim.Board(0).IsGameOver();
+    const bool dead1 = sim.Board(1).IsGameOver();
+    const int winner = dead0 == dead1 ? -1 : (dead0 ? 1 : 0);
+    for (size_t i = d.first; i < out.size(); ++i) {
+        SelfPlayRecord& rec = out[i];
+        rec.outcome = static_cast<int8_t>(winner < 0 ? 0 : (rec.player == winner ? 1 : -1));
+    }
+    if (skipped) *skipped += d.skipped;
+    return d.locks;
+}
+
+ReplayDecodeResult decode_corpus(const ReplayCorpus& corpus, size_t first, size_t count,
+                                 const ReplayDecodeConfig& config)
+{
+    first = std::min(first, corpus.Size());
+    count = std::min(count, corpus.Size() - first);
+    const int replays = static_cast<int>(count);
+    int threads = config.threads > 0 ? config.threads
+                                     : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    if (replays > 0 && threads > replays) threads = replays;
+
+    ReplayDecodeResult result;
+    result.replays = replays;
+    result.threads = threads;
+    const auto started = std::chrono::steady_clock::now();
+
+    // 판마다 따로 쌓고 끝에 번호 순으로 잇는다. 워커가 어떤 판을 집었는지 새지 않게.
+    struct Slot
+    {
+        std::vector<SelfPlayRecord> records;
+        int64_t locks = 0;
+        int64_t skipped = 0;
+    };
+    std::vector<Slot> slots(count);
+    std::atomic<int> next{0};
+    auto worker = [&] {
+        for (;;) {
+            const int i = next.fetch_add(1);
+            if (i >= replays) break;
+            const size_t index = first + static_cast<size_t>(i);
+            Slot& slot = slots[i];
+            slot.locks = decode_replay(static_cast<uint32_t>(index), corpus.Seed(index),
+                                       corpus.Inputs(index), corpus.Ticks(index), config,
+                                       slot.records, &slot.skipped);
+        }
+    };
+
+    if (threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int w = 0; w < threads; ++w) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+    }
+
+    size_t total = 0;
+    for (const Slot& s : slots) total += s.records.size();
+    result.records.reserve(total);
+    for (size_t i = 0; i < count; ++i) {
+        Slot& s = slots[i];
+        result.placements += s.locks;
+        result.skipped += s.skipped;
+        result.ticks += corpus.Ticks(first + i);
+        result.records.insert(result.records.end(), s.records.begin(), s.records.end());
+        std::vector<SelfPlayRecord>().swap(s.records);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    return result;
+}
+
+}  // namespace bot
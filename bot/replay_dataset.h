@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "../core/replay.h"
+#include "../core/replay_corpus.h"
+#include "selfplay.h"
+
+// 리플레이 → (관측, 착수) 학습 튜플.
+//
+// 리플레이는 틱 입력만 담으므로 src/sim_replay.h 의 lockstep 배선으로 다시 굴리면서
+// 블록이 lock 될 때마다 기록을 하나 낸다. 관측은 그 블록이 나온 순간의 상태,
+// 착수는 lock 직전 블록의 (columnOffset, rotation) 을 encode_action 한 것이다.
+// 기록 형식은 self-play 와 같은 SelfPlayRecord 라 학습 쪽 로더가 둘을 구분 없이 읽는다
+// (match = 코퍼스 안의 판 번호, outcome = 리플레이 끝의 생존 여부).
+//
+// 한 틱에 lock 이 둘 이상 날 수 있다(DOWN 으로 lock 뒤 새 블록을 DROP 등). 그래서
+// lock 이 난 틱만 lock 직전 상태를 다시 만든다 — SubmitInput 은 LEFT·RIGHT → DOWN →
+// ROTATE → DROP 순서라 입력 마스크의 앞부분만 준 복사본이 그 단계의 상태와 같다.
+//
+// 주의: 사람의 착수는 tuck·T-spin 처럼 hard drop 으로 닿지 않는 자리일 수 있다.
+// 그런 기록은 legalMask 에 action 비트가 없다. 필요하면 학습 쪽에서 거른다.
+// columnOffset 이 0..9 밖이라 액션 공간에 없는 착수는 기록하지 않는다.
+
+namespace bot {
+
+struct ReplayDecodeConfig
+{
+    int     threads   = 0;      // 0 이면 std::thread::hardware_concurrency()
+    uint8_t players   = 0x3;    // 비트 p = 보드 p 를 기록. main.cpp 녹화는 p2 입력이 0 이다
+    bool    skipIdle  = true;   // 나온 뒤 입력 없이 중력으로만 떨어진 블록은 결정이 아니다
+};
+
+struct ReplayDecodeResult
+{
+    std::vector<SelfPlayRecord> records;   // (match, 틱 순서) 순
+    int64_t  placements = 0;               // lock 수 (기록하지 않은 것 포함)
+    int64_t  skipped    = 0;               // skipIdle·액션 공간 밖으로 뺀 lock
+    uint64_t ticks      = 0;
+    int      replays    = 0;
+    int      threads    = 0;
+    double   seconds    = 0.0;
+};
+
+// 판 하나. 기록은 out 뒤에 붙인다. 반환값은 그 판의 lock 수.
+int64_t decode_replay(uint32_t match, uint64_t seed, const FrameInputs* frames, size_t ticks,
+                      const ReplayDecodeConfig& config, std::vector<SelfPlayRecord>& out,
+                      int64_t* skipped = nullptr);
+
+// 코퍼스의 [first, first + count) 판을 워커 스레드로 나눠 푼다. 결과는 스레드 수와
+// 무관하게 같다. 코퍼스 전체는 메모리에 다 안 들어갈 수 있어 구간 단위로 부른다.
+ReplayDecodeResult decode_corpus(const ReplayCorpus& corpus, size_t first, size_t count,
+                                 const ReplayDecodeConfig& config);
+
+}  // namespace bot
@@ -0,0 +1,316 @@
+#include "selfplay.h"
+#include "placement.h"
+#include "../core/rng.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace bot {
+
+PlacementPolicy heuristic_policy()
+{
+    return [](const SimGame& sim, int& col, int& rot) {
+        return heuristic_placement(sim, col, rot);
+    };
+}
+
+PlacementPolicy beam_policy(const BeamConfig& config)
+{
+    return [config](const SimGame& sim, int& col, int& rot) {
+        return beam_placement(sim, config, col, rot);
+    };
+}
+
+PlacementPolicy mcts_policy(const MctsConfig& config)
+{
+    struct State
+    {
+        explicit State(const MctsConfig& c) : search(evaluator, c) {}
+        HeuristicEvaluator evaluator;
+        Mcts search;
+    };
+    auto state = std::make_shared<State>(config);
+    return [state](const SimGame& sim, int& col, int& rot) {
+        return mcts_placement(state->search, sim, col, rot);
+    };
+}
+
+PlacementPolicy random_policy(uint64_t seed)
+{
+    // 난수를 상태 지문에서 뽑는다. 워커가 어떤 매치를 집든 같은 판에선 같은 수를
+    // 두므로 스레드 수가 달라도 결과가 같다.
+    return [seed](const SimGame& sim, int& col, int& rot) {
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        const int count = sim.EnumeratePlacements(landed);
+        if (count == 0) return false;
+        XorShift64Star rng(splitmix64(seed ^ sim.Fingerprint()));
+        const SimGame::LandedPlacement& p = landed[rng.nextUInt(static_cast<uint32_t>(count))];
+        col = p.col;
+        rot = p.rot;
+        return true;
+    };
+}
+
+int VersusMatch::Place(int player, int col, int rot, int* attackOut)
+{
+    SimGame& self = board[player];
+    const int cleared = self.ApplyPlacement(col, rot);
+    int attack = 0;
+    if (cleared >= 0)
+    {
+        ++pieces;
+        attack = self.AttackLinesSent() - lastAttack[player];
+        lastAttack[player] = self.AttackLinesSent();
+        board[1 - player].AddPendingGarbage(attack);
+    }
+    if (attackOut) *attackOut = attack;
+    return cleared;
+}
+
+int VersusMatch::Winner() const
+{
+    const bool deadA = board[0].IsGameOver();
+    const bool deadB = board[1].IsGameOver();
+    if (deadA == deadB) return -1;
+    return deadA ? 1 : 0;
+}
+
+uint64_t match_seed(uint64_t seed, uint64_t match, int player)
+{
+    const uint64_t z = splitmix64(seed
+                                  + 0x9E3779B97F4A7C15ull * (match + 1)
+                                  + 0xD1B54A32D192ED03ull * static_cast<uint64_t>(player + 1));
+    // 0 은 SimGame 이 고정 기본 시드로 바꿔 버리므로 피한다.
+    return z ? z : 1;
+}
+
+// 보드 비트는 observe 와 같은 조건(v>0 && v!=8).
+void capture_observation(const SimGame& sim, SelfPlayRecord& rec)
+{
+    const auto& grid = sim.Grid();
+    for (int r = 0; r < kBoardRows; ++r)
+    {
+        uint16_t bits = 0;
+        for (int c = 0; c < kBoardCols; ++c)
+        {
+            const int v = grid[r][c];
+            if (v > 0 && v != 8) bits = static_cast<uint16_t>(bits | (1u << c));
+        }
+        rec.board[r] = bits;
+    }
+    rec.current = static_cast<uint8_t>(sim.CurrentBlockId());
+    rec.next = static_cast<uint8_t>(sim.NextBlockId());
+    rec.pendingGarbage = static_cast<uint8_t>(std::clamp(sim.PendingGarbage(), 0, 255));
+
+    SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+    const int count = sim.EnumeratePlacements(landed);
+    uint64_t mask = 0;
+    for (int k = 0; k < count; ++k)
+    {
+        mask |= 1ull << encode_action(landed[k].col, landed[k].rot);
+    }
+    rec.legalMask = mask;
+}
+
+namespace {
+
+uint8_t saturate_u8(int v)
+{
+    return static_cast<uint8_t>(std::clamp(v, 0, 255));
+}
+
+// 매치 한 판을 끝까지 둔다. 기록은 out 뒤에 붙이고 승자(-1 = 무승부)를 돌려준다.
+int play_match(uint32_t matchIndex, const SelfPlayConfig& config,
+               PlacementPolicy (&policy)[2], std::vector<SelfPlayRecord>* out,
+               int64_t& placements)
+{
+    VersusMatch match(match_seed(config.seed, matchIndex, 0),
+                      match_seed(config.seed, matchIndex, 1));
+    const size_t first = out ? out->size() : 0;
+    uint16_t ply[2] = {0, 0};
+
+    while (!match.Over() && match.pieces < config.maxPieces)
+    {
+        // env_versus 와 같은 라운드: A 가 두고, B 가 아직 살아 있으면 B 가 둔다.
+        for (int player = 0; player < 2; ++player)
+        {
+            if (match.board[player].IsGameOver()) break;
+            const SimGame& sim = match.board[player];
+
+            SelfPlayRecord rec{};
+            if (out) capture_observation(sim, rec);
+
+            int col = 0, rot = 0;
+            if (!policy[player](sim, col, rot) && !fallback_placement(sim, col, rot))
+            {
+                // 둘 곳이 없는 보드. SimGame 은 스폰 충돌로만 끝나므로 여기 올 일은
+                // 거의 없지만, 무한 루프를 막으려면 패배로 친다.
+                match.board[player].gameOver = true;
+                break;
+            }
+            int attack = 0;
+            int cleared = match.Place(player, col, rot, &attack);
+            if (cleared < 0)
+            {
+                // 정책이 불법 수를 냈다. 판을 멈추지 않고 안전장치로 대신 둔다.
+                if (!fallback_placement(sim, col, rot))
+                {
+                    match.board[player].gameOver = true;
+                    break;
+                }
+                cleared = match.Place(player, col, rot, &attack);
+            }
+            ++placements;
+
+            if (out)
+            {
+                rec.match = matchIndex;
+                rec.ply = ply[player];
+                rec.player = static_cast<uint8_t>(player);
+                rec.action = static_cast<uint8_t>(encode_action(col, rot));
+                rec.linesCleared = saturate_u8(cleared);
+                rec.attackSent = saturate_u8(attack);
+                out->push_back(rec);
+            }
+            ++ply[player];
+        }
+    }
+
+    const int winner = match.Winner();
+    if (out)
+    {
+        for (size_t i = first; i < out->size(); ++i)
+        {
+            SelfPlayRecord& rec = (*out)[i];
+            rec.outcome = winner < 0 ? 0 : (rec.player == winner ? 1 : -1);
+        }
+    }
+    return winner;
+}
+
+// 워커별 매치 큐. 주인은 앞에서 꺼내고 도둑은 뒤에서 훔친다 — 양끝이 갈라져 있어
+// 주인이 막 꺼내려던 매치를 도둑이 채 가는 경합이 드물다.
+struct WorkQueue
+{
+    std::mutex mutex;
+    std::deque<uint32_t> matches;
+
+    bool PopFront(uint32_t& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (matches.empty()) return false;
+        out = matches.front();
+        matches.pop_front();
+        return true;
+    }
+
+    bool StealBack(uint32_t& out)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (matches.empty()) return false;
+        out = matches.back();
+        matches.pop_back();
+        return true;
+    }
+};
+
+struct WorkerTally
+{
+    std::vector<SelfPlayRecord> records;
+    int64_t placements = 0;
+    int winsA = 0, winsB = 0, draws = 0;
+    uint64_t steals = 0;
+};
+
+}  // namespace
+
+SelfPlayResult run_selfplay(const SelfPlayConfig& config, const PolicyFactory& policies)
+{
+    SelfPlayConfig cfg = config;
+    if (cfg.matches < 0) cfg.matches = 0;
+    // ply 는 uint16_t 라 한 보드가 65535 수를 넘지 않게 묶는다.
+    cfg.maxPieces = std::clamp(cfg.maxPieces, 1, 2 * 65535);
+    int threads = cfg.threads > 0 ? cfg.threads
+                                  : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1) threads = 1;
+    if (cfg.matches > 0 && threads > cfg.matches) threads = cfg.matches;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    queues.reserve(threads);
+    for (int w = 0; w < threads; ++w) queues.push_back(std::make_unique<WorkQueue>());
+    for (int m = 0; m < cfg.matches; ++m)
+    {
+        queues[m % threads]->matches.push_back(static_cast<uint32_t>(m));
+    }
+
+    std::vector<WorkerTally> tallies(threads);
+    const auto started = std::chrono::steady_clock::now();
+
+    auto worker = [&](int w) {
+        WorkerTally& tally = tallies[w];
+        PlacementPolicy policy[2] = {policies(w, 0), policies(w, 1)};
+        std::vector<SelfPlayRecord>* out = cfg.record ? &tally.records : nullptr;
+
+        for (;;)
+        {
+            uint32_t matchIndex = 0;
+            bool found = queues[w]->PopFront(matchIndex);
+            // 자기 큐가 비면 이웃부터 한 바퀴 돌며 훔친다. 매치는 처음에 다 배분되고
+            // 새로 생기지 않으므로, 한 바퀴 다 비어 있으면 남은 일이 없다.
+            for (int k = 1; !found && k < threads; ++k)
+            {
+                found = queues[(w + k) % threads]->StealBack(matchIndex);
+                if (found) ++tally.steals;
+            }
+            if (!found) break;
+
+            const int winner = play_match(matchIndex, cfg, policy, out, tally.placements);
+            if (winner == 0)      ++tally.winsA;
+            else if (winner == 1) ++tally.winsB;
+            else                  ++tally.draws;
+        }
+    };
+
+    if (threads == 1)
+    {
+        worker(0);
+    }
+    else
+    {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int w = 0; w < threads; ++w) pool.emplace_back(worker, w);
+        for (auto& t : pool) t.join();
+    }
+
+    SelfPlayResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    result.threads = threads;
+    result.matches = cfg.matches;
+    size_t total = 0;
+    for (const WorkerTally& t : tallies) total += t.records.size();
+    result.records.reserve(total);
+    for (WorkerTally& t : tallies)
+    {
+        result.placements += t.placements;
+        result.winsA += t.winsA;
+        result.winsB += t.winsB;
+        result.draws += t.draws;
+        result.steals += t.steals;
+        result.records.insert(result.records.end(), t.records.begin(), t.records.end());
+    }
+    // 워커가 매치를 어떤 순서로 집었는지가 출력에 새지 않게 한다.
+    std::sort(result.records.begin(), result.records.end(),
+              [](const SelfPlayRecord& a, const SelfPlayRecord& b) {
+                  if (a.match != b.match) return a.match < b.match;
+                  if (a.ply != b.ply) return a.ply < b.ply;
+                  return a.player < b.player;
+              });
+    return result;
+}
+
+}  // namespace bot
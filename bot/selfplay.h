@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "../src/sim_game.h"
+#include "beam_search.h"
+#include "mcts.h"
+
+// 멀티스레드 self-play rollout 엔진.
+//
+// 학습 데이터를 만들려고 Python 이 SimGame 을 하나씩 돌리면 코어 하나도 다 못 쓴다.
+// 여기서는 대전(versus) 매치 여러 개를 워커 스레드에 나눠 C++ 안에서 끝까지 둔다.
+// 배선은 python/common/env_versus.py 와 같다 — A 가 한 수 두고 공격 델타를
+// B 에 넘기고, B 가 살아 있으면 한 수 두고 공격을 A 에 넘긴다. 가비지는 받는
+// 보드의 다음 lock 에서 올라온다(SimGame::LockBlock). main.cpp 의 lockstep 루프와
+// 같은 "누적 공격의 델타를 상대 AddPendingGarbage 로" 규칙이다.
+//
+// 부하 분산은 work-stealing 이다. 매치는 처음에 워커별 큐로 고르게 나누지만
+// 매치 길이는 수십 수에서 수천 수까지 제각각이라, 자기 큐가 빈 워커는 남의 큐
+// 뒤쪽에서 매치를 훔쳐 온다. 일찍 끝난 워커가 놀지 않는다.
+//
+// 결과는 스레드 수와 무관하게 같다. 매치 시드는 (seed, 매치 번호)로만 정해지고,
+// 기록은 끝난 뒤 (매치, 수순)으로 정렬한다. 정책이 결정론적이면 1 스레드와
+// 32 스레드의 출력이 바이트 단위로 같다.
+
+namespace bot {
+
+// 한 보드의 다음 착수를 정한다. 둘 곳이 없으면 false.
+// 워커마다 따로 만들므로 내부 상태(ONNX 세션, 탐색 버퍼 등)를 가져도 된다.
+using PlacementPolicy = std::function<bool(const SimGame& sim, int& col_out, int& rot_out)>;
+
+// worker 번째 워커의 player(0=A, 1=B)용 정책을 만든다. 워커 시작 시 그 워커
+// 스레드에서 한 번 불리므로 여러 스레드가 동시에 부를 수 있다.
+using PolicyFactory = std::function<PlacementPolicy(int worker, int player)>;
+
+// 내장 정책. heuristic_placement / beam_placement 를 PlacementPolicy 로 감싼다.
+PlacementPolicy heuristic_policy();
+// beam_placement. 재현이 필요하면 config.budgetMs 를 0 으로 둔다(beam_search.h).
+PlacementPolicy beam_policy(const BeamConfig& config);
+// HeuristicEvaluator 를 쓰는 mcts_placement. 정책마다 Mcts 를 하나 들고 있으므로
+// 돌려받은 정책을 여러 스레드에서 동시에 부르지 않는다. 재현이 필요하면
+// config.threads = 1, leafBatch = 1, budgetMs = 0 으로 둔다(mcts.h).
+PlacementPolicy mcts_policy(const MctsConfig& config);
+// (seed, 상태)로 정해지는 무작위 합법 수. 스크립트 상대·스모크 테스트용.
+PlacementPolicy random_policy(uint64_t seed);
+
+// 두 보드 대전 한 판. self-play 와 헤드리스 대전 도구가 같이 쓴다.
+struct VersusMatch
+{
+    SimGame board[2];
+    int lastAttack[2] = {0, 0};
+    int pieces = 0;         // 둔 수 (양쪽 합)
+
+    VersusMatch(uint64_t seedA, uint64_t seedB) : board{SimGame(seedA), SimGame(seedB)} {}
+
+    // player 가 (col, rot) 에 두고, 그 수로 보낸 공격을 상대 보드에 쌓는다.
+    // 반환값은 지운 줄 수, 불법 수면 -1 (판은 그대로). attackOut 에 보낸 공격.
+    int Place(int player, int col, int rot, int* attackOut = nullptr);
+
+    bool Over() const { return board[0].IsGameOver() || board[1].IsGameOver(); }
+    // 혼자 살아남은 쪽. 둘 다 죽었거나 아직 진행 중이면 -1.
+    int Winner() const;
+};
+
+// 매치 번호 → 양쪽 보드 시드. env_versus 처럼 두 보드의 블록 순서는 다르다.
+uint64_t match_seed(uint64_t seed, uint64_t match, int player);
+
+// 한 번의 착수 결정. 관측은 bot::observe 와 같은 규칙으로 압축해 둔다.
+struct SelfPlayRecord
+{
+    uint32_t match;
+    uint16_t ply;           // 그 매치에서 이 보드가 둔 수의 순번
+    uint8_t  player;        // 0=A, 1=B
+    uint8_t  action;        // encode_action(col, rot)
+    uint16_t board[20];     // 행별 점유 비트(비트 c = 열 c). observe 의 board 와 같은 조건
+    uint8_t  current;       // 블록 ID 1..7
+    uint8_t  next;
+    uint8_t  pendingGarbage;// 이 수를 두기 직전 쌓여 있던 가비지(255 에서 포화)
+    uint8_t  linesCleared;
+    uint8_t  attackSent;
+    int8_t   outcome;       // 매치 결과(이 보드 기준): +1 승, -1 패, 0 무승부/중단
+    uint8_t  reserved[2];   // 0. 패딩을 명시해 레코드를 바이트 단위로 비교·저장할 수 있게 한다
+    uint64_t legalMask;     // 비트 a = action a 합법
+};
+static_assert(sizeof(SelfPlayRecord) == 64, "SelfPlayRecord is written to disk as-is");
+
+// 착수 직전 상태를 rec 의 관측 필드(board, current, next, pendingGarbage, legalMask)에
+// 채운다. 리플레이 디코더(bot/replay_dataset.h)도 같은 인코딩을 쓴다.
+void capture_observation(const SimGame& sim, SelfPlayRecord& rec);
+
+struct SelfPlayConfig
+{
+    int      threads   = 0;      // 0 이면 std::thread::hardware_concurrency()
+    int      matches   = 64;
+    uint64_t seed      = 1;
+    int      maxPieces = 2000;   // 양쪽 합. 넘으면 무승부로 중단 (env_versus.max_pieces)
+    bool     record    = true;   // false 면 처리량 측정만
+};
+
+struct SelfPlayResult
+{
+    std::vector<SelfPlayRecord> records;    // (match, ply, player) 순
+    int64_t  placements = 0;
+    int      matches    = 0;
+    int      winsA = 0, winsB = 0, draws = 0;
+    int      threads    = 0;
+    uint64_t steals     = 0;                // 다른 워커 큐에서 가져온 매치 수
+    double   seconds    = 0.0;
+};
+
+SelfPlayResult run_selfplay(const SelfPlayConfig& config, const PolicyFactory& policies);
+
+}  // namespace bot
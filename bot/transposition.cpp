@@ -0,0 +1,174 @@
+#include "transposition.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bot {
+
+namespace {
+
+// meta 워드: [0..7] bestAction, [8..15] depth, [16..31] aux, [32..39] 세대, [40] 사용 중.
+constexpr uint64_t kUsedBit = 1ull << 40;
+
+uint64_t pack_meta(const TTEntry& e, uint8_t generation)
+{
+    return static_cast<uint64_t>(e.bestAction)
+         | static_cast<uint64_t>(e.depth) << 8
+         | static_cast<uint64_t>(e.aux) << 16
+         | static_cast<uint64_t>(generation) << 32
+         | kUsedBit;
+}
+
+uint8_t meta_generation(uint64_t meta) { return static_cast<uint8_t>(meta >> 32); }
+uint8_t meta_depth(uint64_t meta) { return static_cast<uint8_t>(meta >> 8); }
+
+uint64_t double_bits(double v)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof bits);
+    return bits;
+}
+
+double bits_double(uint64_t bits)
+{
+    double v;
+    std::memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+constexpr auto kRelaxed = std::memory_order_relaxed;
+
+}  // namespace
+
+TranspositionTable::TranspositionTable(size_t megabytes)
+{
+    const size_t bytes = std::max<size_t>(megabytes, 1) << 20;
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes) count *= 2;
+    bucketCount_ = count;
+    mask_ = count - 1;
+    buckets_.reset(new Bucket[count]);
+}
+
+TranspositionTable::~TranspositionTable() = default;
+
+TranspositionTable::Counters& TranspositionTable::stripe()
+{
+    // 스레드마다 처음 한 번 줄무늬 칸을 정한다. 워커 수가 kStripes 이하이면 서로 겹치지 않는다.
+    static std::atomic<unsigned> nextStripe{0};
+    thread_local const unsigned index = nextStripe.fetch_add(1, kRelaxed) % kStripes;
+    return counters_[index];
+}
+
+bool TranspositionTable::Probe(uint64_t key, TTEntry& out)
+{
+    Counters& c = stripe();
+    c.probes.fetch_add(1, kRelaxed);
+    const Bucket& bucket = buckets_[key & mask_];
+    for (const Slot& slot : bucket.slots) {
+        const uint64_t meta = slot.meta.load(kRelaxed);
+        if (!(meta & kUsedBit)) continue;
+        const uint64_t value = slot.value.load(kRelaxed);
+        if ((slot.check.load(kRelaxed) ^ value ^ meta) != key) continue;
+        out.value = bits_double(value);
+        out.bestAction = static_cast<uint8_t>(meta);
+        out.depth = meta_depth(meta);
+        out.aux = static_cast<uint16_t>(meta >> 16);
+        c.hits.fetch_add(1, kRelaxed);
+        return true;
+    }
+    return false;
+}
+
+void TranspositionTable::Store(uint64_t key, const TTEntry& entry)
+{
+    Counters& c = stripe();
+    c.stores.fetch_add(1, kRelaxed);
+    const uint8_t generation = generation_.load(kRelaxed);
+    Bucket& bucket = buckets_[key & mask_];
+
+    // 같은 키 → 빈 칸 → (이전 세대, 얕은 depth) 가 가장 싼 칸.
+    Slot* sameKey = nullptr;
+    Slot* empty = nullptr;
+    Slot* victim = nullptr;
+    int cheapest = 0;
+    for (Slot& slot : bucket.slots) {
+        const uint64_t meta = slot.meta.load(kRelaxed);
+        if (!(meta & kUsedBit)) {
+            if (!empty) empty = &slot;
+            continue;
+        }
+        const uint64_t value = slot.value.load(kRelaxed);
+        if ((slot.check.load(kRelaxed) ^ value ^ meta) == key) {
+            sameKey = &slot;
+            break;
+        }
+        const int cost = (meta_generation(meta) == generation ? 256 : 0) + meta_depth(meta);
+        if (!victim || cost < cheapest) {
+            victim = &slot;
+            cheapest = cost;
+        }
+    }
+    Slot* target = sameKey ? sameKey : empty ? empty : victim;
+    if (target == victim) c.overwrites.fetch_add(1, kRelaxed);
+
+    const uint64_t meta = pack_meta(entry, generation);
+    const uint64_t value = double_bits(entry.value);
+    target->meta.store(meta, kRelaxed);
+    target->value.store(value, kRelaxed);
+    target->check.store(key ^ value ^ meta, kRelaxed);
+}
+
+void TranspositionTable::NewGeneration()
+{
+    generation_.fetch_add(1, kRelaxed);
+}
+
+void TranspositionTable::Clear()
+{
+    for (size_t i = 0; i < bucketCount_; ++i) {
+        for (Slot& slot : buckets_[i].slots) {
+            slot.check.store(0, kRelaxed);
+            slot.value.store(0, kRelaxed);
+            slot.meta.store(0, kRelaxed);
+        }
+    }
+    ResetStats();
+}
+
+TTStats TranspositionTable::Stats() const
+{
+    TTStats s;
+    for (const Counters& c : counters_) {
+        s.probes += c.probes.load(kRelaxed);
+        s.hits += c.hits.load(kRelaxed);
+        s.stores += c.stores.load(kRelaxed);
+        s.overwrites += c.overwrites.load(kRelaxed);
+    }
+    s.entries = Entries();
+
+    // 앞쪽 bucket 최대 1024 개를 표본으로 이번 세대가 쓴 칸을 센다.
+    const uint8_t generation = generation_.load(kRelaxed);
+    const size_t sample = std::min<size_t>(bucketCount_, 1024);
+    size_t used = 0;
+    for (size_t i = 0; i < sample; ++i) {
+        for (const Slot& slot : buckets_[i].slots) {
+            const uint64_t meta = slot.meta.load(kRelaxed);
+            if ((meta & kUsedBit) && meta_generation(meta) == generation) ++used;
+        }
+    }
+    s.occupancy = static_cast<double>(used) / static_cast<double>(sample * kBucketEntries);
+    return s;
+}
+
+void TranspositionTable::ResetStats()
+{
+    for (Counters& c : counters_) {
+        c.probes.store(0, kRelaxed);
+        c.hits.store(0, kRelaxed);
+        c.stores.store(0, kRelaxed);
+        c.overwrites.store(0, kRelaxed);
+    }
+}
+
+}  // namespace bot
@@ -0,0 +1,118 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// 봇 탐색용 고정 크기 전치표(transposition table).
+//
+// 다수(多手) 탐색에서는 다른 착수 순서가 같은 판에 자주 닿고, 한 수 뒤의 탐색은
+// 직전 탐색이 이미 펼친 판을 다시 펼친다. 그런 판의 평가값과 최선 수를
+// SimGame::PositionKey() 를 키로 담아 둔다.
+//
+// 잠금 없음: 엔트리는 원자 워드 세 개(check, value, meta)이고 check = key ^ value
+// ^ meta 로 쓴다(Hyatt 의 XOR 기법). 두 스레드가 같은 칸에 동시에 쓰거나 읽는
+// 도중에 덮여 워드가 섞이면 check 가 맞지 않아 그냥 miss 로 본다. 읽는 쪽이 찢어진
+// 값을 돌려받는 일은 없다(64비트 키 충돌 확률은 무시한다). 워드 접근은 relaxed
+// 원자 연산이라 데이터 레이스도 아니다. 그래서 self-play 워커 전부가 표 하나를
+// 나눠 써도 된다.
+//
+// 칸은 캐시 라인 하나(64바이트)에 엔트리 두 개씩 묶은 bucket 이다. 교체는 같은
+// 키 → 빈 칸 → 이전 세대 → 얕은 depth 순으로 고른다.
+//
+// 적중률 카운터: probe/hit/store/overwrite 를 센다. 워커마다 같은 원자 변수를
+// 두드리면 그 캐시 라인이 코어 사이를 오가므로, 스레드별로 정해지는 줄무늬
+// (stripe) 칸에 나눠 세고 Stats() 에서 합친다. overwrite 가 store 에 비해
+// 많아지면(다른 키를 밀어낸 저장) 표가 작다는 뜻이다.
+
+namespace bot {
+
+struct TTEntry
+{
+    double   value = 0.0;
+    uint8_t  bestAction = kNoAction;   // encode_action(col, rot), 없으면 kNoAction
+    uint8_t  depth = 0;                // 이 값을 얻은 탐색 깊이. 교체 우선순위
+    uint16_t aux = 0;                  // 호출자 몫(방문 수 등)
+
+    static constexpr uint8_t kNoAction = 0xFF;
+};
+
+struct TTStats
+{
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t stores = 0;
+    uint64_t overwrites = 0;   // 살아 있는 다른 키를 밀어낸 저장
+    size_t   entries = 0;      // 표 크기(엔트리 수)
+    double   occupancy = 0.0;  // 이번 세대가 쓴 칸 비율(표본 추정)
+
+    double hitRate() const { return probes ? static_cast<double>(hits) / probes : 0.0; }
+};
+
+class TranspositionTable
+{
+public:
+    // 대략 megabytes 크기의 표. 엔트리 수는 2의 거듭제곱으로 내림한다(최소 bucket 하나).
+    explicit TranspositionTable(size_t megabytes);
+    ~TranspositionTable();
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // key 가 있으면 out 에 채우고 true.
+    bool Probe(uint64_t key, TTEntry& out);
+    void Store(uint64_t key, const TTEntry& entry);
+    // key 의 bucket 을 캐시로 미리 당긴다. 곧 probe 할 키들을 먼저 훑어 두면
+    // 메모리 지연이 겹쳐 숨는다. 표 크기가 캐시보다 크면 이 차이가 probe 비용의 대부분이다.
+    void Prefetch(uint64_t key) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&buckets_[key & mask_]);
+#else
+        (void)key;
+#endif
+    }
+
+    // 세대를 올린다. 이전 세대 엔트리는 지우지 않고 교체 우선순위만 낮아진다.
+    // 한 판(또는 한 batch) 이 끝날 때 부르면 지난 판의 판들이 먼저 밀려난다.
+    void NewGeneration();
+    // 모든 엔트리와 카운터를 비운다. 다른 스레드가 쓰는 중에 부르지 않는다.
+    void Clear();
+
+    TTStats Stats() const;
+    void ResetStats();
+    size_t Entries() const { return bucketCount_ * kBucketEntries; }
+
+private:
+    static constexpr int kBucketEntries = 2;
+    static constexpr int kStripes = 16;
+
+    struct Slot
+    {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> value{0};
+        std::atomic<uint64_t> meta{0};
+        uint64_t pad = 0;
+    };
+    struct alignas(64) Bucket
+    {
+        Slot slots[kBucketEntries];
+    };
+    struct alignas(64) Counters
+    {
+        std::atomic<uint64_t> probes{0};
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> stores{0};
+        std::atomic<uint64_t> overwrites{0};
+    };
+
+    Counters& stripe();
+
+    std::unique_ptr<Bucket[]> buckets_;
+    size_t bucketCount_ = 0;
+    size_t mask_ = 0;
+    std::atomic<uint8_t> generation_{1};
+    Counters counters_[kStripes];
+};
+
+}  // namespace bot
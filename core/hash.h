@@ -1,6 +1,7 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 
 // FNV-1a 64-bit hash for quick state checksums
 inline uint64_t fnv1a64(const void* data, size_t len, uint64_t seed = 14695981039346656037ull) {
@@ -18,3 +19,99 @@ inline uint64_t fnv1a64_value(const T& v, uint64_t seed = 14695981039346656037ul
     return fnv1a64(&v, sizeof(T), seed);
 }
 
+// 워드 단위 해시 (xxHash64 계열 구조, 값은 XXH64 와 호환되지 않음).
+//
+// FNV-1a 는 바이트마다 곱셈 하나가 직렬로 물려 있어 곱셈 지연이 곧 처리량이다.
+// 여기서는 8바이트씩 읽고, 32바이트 이상이면 독립된 lane 4개를 돌려 곱셈을
+// 겹친다. 바이트 순서는 리틀엔디안으로 고정해 플랫폼과 무관하게 같은 값이 나오므로
+// wire 체크섬(net::ChecksumKind::Word32)으로 쓸 수 있다. 알고리즘을 바꾸면 wire
+// 호환이 깨진다 — 새 ChecksumKind 를 추가할 것.
+namespace hash_detail {
+
+constexpr uint64_t kP1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kP2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kP3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kP4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kP5 = 0x27D4EB2F165667C5ull;
+
+inline uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t load_le64(const uint8_t* p) {
+    uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+inline uint64_t round64(uint64_t acc, uint64_t input) {
+    acc += input * kP2;
+    acc = rotl64(acc, 31);
+    return acc * kP1;
+}
+
+inline uint64_t merge64(uint64_t acc, uint64_t lane) {
+    acc ^= round64(0, lane);
+    return acc * kP1 + kP4;
+}
+
+}  // namespace hash_detail
+
+inline uint64_t hash64_words(const void* data, size_t len, uint64_t seed = 0) {
+    using namespace hash_detail;
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    const uint8_t* const end = p + len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + kP1 + kP2;
+        uint64_t v2 = seed + kP2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - kP1;
+        const uint8_t* const limit = end - 32;
+        do {
+            v1 = round64(v1, load_le64(p));
+            v2 = round64(v2, load_le64(p + 8));
+            v3 = round64(v3, load_le64(p + 16));
+            v4 = round64(v4, load_le64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = merge64(h, v1);
+        h = merge64(h, v2);
+        h = merge64(h, v3);
+        h = merge64(h, v4);
+    } else {
+        h = seed + kP5;
+    }
+    h += static_cast<uint64_t>(len);
+
+    while (end - p >= 8) {
+        h ^= round64(0, load_le64(p));
+        h = rotl64(h, 27) * kP1 + kP4;
+        p += 8;
+    }
+    if (p < end) {
+        // 남은 1..7 바이트를 리틀엔디안 워드 하나로 모아 한 번에 섞는다.
+        uint64_t tail = 0;
+        for (int shift = 0; p < end; ++p, shift += 8) {
+            tail |= static_cast<uint64_t>(*p) << shift;
+        }
+        h ^= tail * kP5;
+        h = rotl64(h, 11) * kP1;
+    }
+
+    h ^= h >> 33;
+    h *= kP2;
+    h ^= h >> 29;
+    h *= kP3;
+    h ^= h >> 32;
+    return h;
+}
+
+// 32비트 체크섬이 필요한 곳(프레임 CHECKSUM 필드)용 접기.
+inline uint32_t hash32_words(const void* data, size_t len, uint64_t seed = 0) {
+    const uint64_t h = hash64_words(data, len, seed);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+}
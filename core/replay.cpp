@@ -1,8 +1,511 @@
 #include "replay.h"
+#include "hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <sstream>
 
 namespace ReplayIO {
+    namespace {
+        constexpr char kMagic[4] = {'T', 'R', 'P', 'L'};
+        constexpr size_t kHeaderBytes = 14;
+        constexpr uint8_t kChunkInputs = 'I';
+        constexpr uint8_t kChunkKeyframe = 'K';
+        constexpr uint8_t kChunkIndex = 'X';
+        constexpr uint8_t kChunkEnd = 'E';
+        // 한 청크 payload 상한. 손상된 길이 varint 로 거대한 할당을 하지 않게 막는다.
+        constexpr uint64_t kMaxChunkBytes = 1u << 24;
+
+        void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+            while (v >= 0x80) {
+                out.push_back(static_cast<uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+            v = 0;
+            for (int shift = 0; shift < 64 && p < end; shift += 7) {
+                const uint8_t b = *p++;
+                v |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) return true;
+            }
+            return false;
+        }
+
+        uint32_t chunk_checksum(uint8_t type, const uint8_t* data, size_t size) {
+            return hash32_words(data, size, type);
+        }
+
+        uint32_t load_le32(const uint8_t* p) {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+                 | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        void put_le64(std::vector<uint8_t>& out, uint64_t v) {
+            for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+        }
+
+        uint64_t load_le64(const uint8_t* p) {
+            uint64_t v = 0;
+            for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+            return v;
+        }
+
+        // 메모리 위 청크 하나. pos 는 다음 청크로 옮겨 간다. 잘렸으면 false.
+        struct ChunkView {
+            uint8_t type;
+            const uint8_t* body;
+            size_t len;
+            size_t offset;   // type 바이트의 파일 offset
+            uint32_t checksum;
+        };
+
+        bool next_chunk(const uint8_t* data, size_t size, size_t& pos, ChunkView& c) {
+            if (pos >= size) return false;
+            c.offset = pos;
+            const uint8_t* p = data + pos;
+            const uint8_t* end = data + size;
+            c.type = *p++;
+            uint64_t len = 0;
+            if (!get_varint(p, end, len) || len > static_cast<uint64_t>(end - p) ||
+                static_cast<uint64_t>(end - p) - len < 4)
+                return false;
+            c.body = p;
+            c.len = static_cast<size_t>(len);
+            c.checksum = load_le32(p + len);
+            pos = static_cast<size_t>(p + len + 4 - data);
+            return true;
+        }
+
+        bool chunk_ok(const ChunkView& c) {
+            return c.checksum == hash32_words(c.body, c.len, c.type);
+        }
+
+        // 청크 하나를 out 뒤에 붙인다. 스트림 writer 와 Recover 가 같은 바이트를 쓴다.
+        void encode_chunk(std::vector<uint8_t>& out, uint8_t type, const std::vector<uint8_t>& payload) {
+            out.push_back(type);
+            put_varint(out, payload.size());
+            out.insert(out.end(), payload.begin(), payload.end());
+            const uint32_t sum = chunk_checksum(type, payload.data(), payload.size());
+            for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(sum >> (8 * i)));
+        }
+
+        std::vector<uint8_t> encode_index(const std::vector<uint64_t>& ticks, const std::vector<uint64_t>& offsets) {
+            std::vector<uint8_t> index;
+            put_varint(index, ticks.size());
+            for (size_t i = 0; i < ticks.size(); ++i) {
+                put_varint(index, ticks[i] - (i ? ticks[i - 1] : 0));
+                put_varint(index, offsets[i] - (i ? offsets[i - 1] : 0));
+            }
+            return index;
+        }
+
+        bool decode_keyframe(const uint8_t* p, const uint8_t* end, ReplayKeyframe& k) {
+            if (!get_varint(p, end, k.tick) || end - p < 16) return false;
+            k.hash[0] = load_le64(p);
+            k.hash[1] = load_le64(p + 8);
+            k.state.assign(p + 16, end);
+            return true;
+        }
+
+        bool decode_index(const uint8_t* p, const uint8_t* end, std::vector<KeyframeIndexEntry>& out) {
+            uint64_t count = 0;
+            if (!get_varint(p, end, count) || count > static_cast<uint64_t>(end - p)) return false;
+            out.clear();
+            uint64_t tick = 0, offset = 0;
+            for (uint64_t i = 0; i < count; ++i) {
+                uint64_t dt = 0, doff = 0;
+                if (!get_varint(p, end, dt) || !get_varint(p, end, doff)) return false;
+                tick += dt;
+                offset += doff;
+                out.push_back({tick, offset});
+            }
+            return p == end;
+        }
+
+        // 입력 청크 payload 를 틱으로 푼다. firstTick 이 지금까지 읽은 틱 수와 달라도 실패.
+        // expectFirst 가 곧 앞 청크들의 누적 틱이라, 청크 상한과 파일 상한을 함께 여기서 건다.
+        bool decode_inputs(const uint8_t* p, const uint8_t* end, uint64_t expectFirst,
+                           std::vector<FrameInputs>& out) {
+            uint64_t first = 0;
+            if (!get_varint(p, end, first) || first != expectFirst) return false;
+            if (expectFirst > kMaxReplayTicks) return false;
+            const uint64_t limit = std::min<uint64_t>(kMaxChunkTicks, kMaxReplayTicks - expectFirst);
+            uint64_t ticks = 0;
+            while (p < end) {
+                uint64_t head = 0;
+                if (!get_varint(p, end, head)) return false;
+                const uint64_t run = head >> 2;
+                const unsigned kind = static_cast<unsigned>(head & 3);
+                FrameInputs f{};
+                if (kind & 1) { if (p >= end) return false; f.p1 = *p++; }
+                if (kind & 2) { if (p >= end) return false; f.p2 = *p++; }
+                if (run == 0 || run > limit - ticks) return false;
+                ticks += run;
+                out.insert(out.end(), static_cast<size_t>(run), f);
+            }
+            return true;
+        }
+
+        bool is_binary(const uint8_t* data, size_t size) {
+            return size >= sizeof(kMagic) && std::memcmp(data, kMagic, sizeof(kMagic)) == 0;
+        }
+
+        bool parse_header(const uint8_t* h, uint64_t& seed, std::string& error) {
+            if (!is_binary(h, kHeaderBytes)) { error = "not a binary replay"; return false; }
+            if (h[4] != kBinaryVersion) { error = "unsupported replay version"; return false; }
+            seed = 0;
+            for (int i = 0; i < 8; ++i) seed |= static_cast<uint64_t>(h[6 + i]) << (8 * i);
+            return true;
+        }
+
+        bool load_text(std::istream& f, ReplayData& out) {
+            std::string key; size_t ticks = 0; uint64_t seed = 0;
+            if (!(f >> key >> seed)) return false;
+            if (key != "seed") return false;
+            if (!(f >> key >> ticks)) return false;
+            if (key != "ticks" || ticks > kMaxReplayTicks) return false;
+            out.seed = seed;
+            out.frames.clear();
+            out.frames.resize(ticks);
+            size_t idx; unsigned p1, p2;
+            for (size_t i = 0; i < ticks && (f >> idx >> p1 >> p2); ++i) {
+                if (idx >= ticks) break;
+                out.frames[idx].p1 = static_cast<uint8_t>(p1 & 0xFFu);
+                out.frames[idx].p2 = static_cast<uint8_t>(p2 & 0xFFu);
+            }
+            return true;
+        }
+    }
+
+    BinaryWriter::BinaryWriter(std::ostream& os, uint64_t seed, uint32_t chunkTicks)
+        : os_(os), chunkTicks_(chunkTicks > 0 ? std::min(chunkTicks, kMaxChunkTicks) : kDefaultChunkTicks) {
+        uint8_t h[kHeaderBytes] = {};
+        std::memcpy(h, kMagic, sizeof(kMagic));
+        h[4] = kBinaryVersion;
+        for (int i = 0; i < 8; ++i) h[6 + i] = static_cast<uint8_t>(seed >> (8 * i));
+        os_.write(reinterpret_cast<const char*>(h), sizeof(h));
+        bytes_ += sizeof(h);
+        put_varint(payload_, 0);
+    }
+
+    void BinaryWriter::Push(const FrameInputs& f) {
+        if (finished_) return;
+        if (runLength_ > 0 && f != run_) FlushRun();
+        run_ = f;
+        ++runLength_;
+        ++ticks_;
+        if (ticks_ - chunkFirstTick_ >= chunkTicks_) FlushChunk();
+    }
+
+    void BinaryWriter::FlushRun() {
+        if (runLength_ == 0) return;
+        const unsigned kind = (run_.p1 ? 1u : 0u) | (run_.p2 ? 2u : 0u);
+        put_varint(payload_, (runLength_ << 2) | kind);
+        if (kind & 1) payload_.push_back(run_.p1);
+        if (kind & 2) payload_.push_back(run_.p2);
+        runLength_ = 0;
+    }
+
+    void BinaryWriter::FlushChunk() {
+        FlushRun();
+        if (ticks_ > chunkFirstTick_) WriteChunk(kChunkInputs, payload_);
+        chunkFirstTick_ = ticks_;
+        payload_.clear();
+        put_varint(payload_, chunkFirstTick_);
+    }
+
+    void BinaryWriter::WriteChunk(uint8_t type, const std::vector<uint8_t>& payload) {
+        chunk_.clear();
+        encode_chunk(chunk_, type, payload);
+        os_.write(reinterpret_cast<const char*>(chunk_.data()), static_cast<std::streamsize>(chunk_.size()));
+        bytes_ += chunk_.size();
+    }
+
+    bool BinaryWriter::PushKeyframe(const ReplayKeyframe& k) {
+        if (finished_ || k.tick != ticks_) return false;
+        FlushChunk();
+        std::vector<uint8_t> payload;
+        payload.reserve(k.state.size() + 26);
+        put_varint(payload, k.tick);
+        put_le64(payload, k.hash[0]);
+        put_le64(payload, k.hash[1]);
+        payload.insert(payload.end(), k.state.begin(), k.state.end());
+        keyTicks_.push_back(k.tick);
+        keyOffsets_.push_back(bytes_);
+        WriteChunk(kChunkKeyframe, payload);
+        return true;
+    }
+
+    bool BinaryWriter::Flush() {
+        if (!finished_) {
+            FlushChunk();
+            os_.flush();
+        }
+        return static_cast<bool>(os_);
+    }
+
+    bool BinaryWriter::Finish() {
+        if (!finished_) {
+            FlushChunk();
+            if (!keyTicks_.empty()) WriteChunk(kChunkIndex, encode_index(keyTicks_, keyOffsets_));
+            std::vector<uint8_t> end;
+            put_varint(end, ticks_);
+            WriteChunk(kChunkEnd, end);
+            os_.flush();
+            finished_ = true;
+        }
+        return static_cast<bool>(os_);
+    }
+
+    BinaryReader::BinaryReader(std::istream& is) : is_(is) {
+        uint8_t h[kHeaderBytes];
+        if (!is_.read(reinterpret_cast<char*>(h), sizeof(h))) {
+            error_ = "truncated header";
+            return;
+        }
+        ok_ = parse_header(h, seed_, error_);
+        done_ = !ok_;
+    }
+
+    bool BinaryReader::Fail(const char* why) {
+        error_ = why;
+        done_ = true;
+        return false;
+    }
+
+    bool BinaryReader::ReadChunk() {
+        for (;;) {
+            int type = is_.get();
+            if (type == std::char_traits<char>::eof()) return Fail("truncated: missing end chunk");
+            uint64_t len = 0;
+            for (int shift = 0;; shift += 7) {
+                const int b = is_.get();
+                if (b == std::char_traits<char>::eof() || shift >= 64) return Fail("truncated chunk header");
+                len |= static_cast<uint64_t>(b & 0x7F) << shift;
+                if (!(b & 0x80)) break;
+            }
+            if (len > kMaxChunkBytes) return Fail("chunk too large");
+            payload_.resize(static_cast<size_t>(len) + 4);
+            if (!is_.read(reinterpret_cast<char*>(payload_.data()), static_cast<std::streamsize>(payload_.size())))
+                return Fail("truncated chunk");
+            const uint8_t* p = payload_.data();
+            const uint8_t* end = p + len;
+            if (load_le32(end) != chunk_checksum(static_cast<uint8_t>(type), p, static_cast<size_t>(len)))
+                return Fail("chunk checksum mismatch");
+
+            if (type == kChunkInputs) {
+                frames_.clear();
+                next_ = 0;
+                if (!decode_inputs(p, end, ticks_, frames_)) return Fail("corrupt input chunk");
+                if (frames_.empty()) continue;
+                return true;
+            }
+            if (type == kChunkEnd) {
+                uint64_t total = 0;
+                if (!get_varint(p, end, total) || total != ticks_) return Fail("tick count mismatch");
+                complete_ = true;
+                done_ = true;
+                return false;
+            }
+            // 'K'·'X' 와 모르는 선택 청크는 건너뛴다.
+        }
+    }
+
+    bool BinaryReader::Next(FrameInputs& out) {
+        if (next_ >= frames_.size()) {
+            if (done_ || !ReadChunk()) return false;
+        }
+        out = frames_[next_++];
+        ++ticks_;
+        return true;
+    }
+
+    namespace {
+        // 입력 사이에 keyframe 을 tick 자리에 끼워 쓴다. 순서가 어긋난 keyframe 은 버린다.
+        bool write_binary(std::ostream& os, const ReplayData& rp, uint32_t chunkTicks) {
+            BinaryWriter w(os, rp.seed, chunkTicks);
+            size_t k = 0;
+            for (size_t i = 0; i <= rp.frames.size(); ++i) {
+                for (; k < rp.keyframes.size() && rp.keyframes[k].tick <= i; ++k) w.PushKeyframe(rp.keyframes[k]);
+                if (i < rp.frames.size()) w.Push(rp.frames[i]);
+            }
+            return w.Finish();
+        }
+    }
+
+    std::vector<uint8_t> Encode(const ReplayData& rp, uint32_t chunkTicks) {
+        std::ostringstream os;
+        write_binary(os, rp, chunkTicks);
+        const std::string s = os.str();
+        return std::vector<uint8_t>(s.begin(), s.end());
+    }
+
+    bool Decode(const uint8_t* data, size_t size, ReplayData& out, std::string* error) {
+        std::string why;
+        out.frames.clear();
+        out.keyframes.clear();
+        std::vector<KeyframeIndexEntry> seen;
+        if (size < kHeaderBytes) why = "truncated header";
+        else if (parse_header(data, out.seed, why)) {
+            size_t pos = kHeaderBytes;
+            for (;;) {
+                ChunkView c;
+                if (pos >= size) { why = "truncated: missing end chunk"; break; }
+                if (!next_chunk(data, size, pos, c)) { why = "truncated chunk"; break; }
+                if (!chunk_ok(c)) { why = "chunk checksum mismatch"; break; }
+                const uint8_t* body = c.body;
+                const uint8_t* bodyEnd = c.body + c.len;
+                if (c.type == kChunkInputs) {
+                    if (!decode_inputs(body, bodyEnd, out.frames.size(), out.frames)) {
+                        why = "corrupt input chunk";
+                        break;
+                    }
+                } else if (c.type == kChunkKeyframe) {
+                    ReplayKeyframe k;
+                    if (!decode_keyframe(body, bodyEnd, k) || k.tick != out.frames.size()) {
+                        why = "corrupt keyframe chunk";
+                        break;
+                    }
+                    seen.push_back({k.tick, c.offset});
+                    out.keyframes.push_back(std::move(k));
+                } else if (c.type == kChunkIndex) {
+                    std::vector<KeyframeIndexEntry> index;
+                    bool same = decode_index(body, bodyEnd, index) && index.size() == seen.size();
+                    for (size_t i = 0; same && i < index.size(); ++i)
+                        same = index[i].tick == seen[i].tick && index[i].offset == seen[i].offset;
+                    if (!same) { why = "keyframe index mismatch"; break; }
+                } else if (c.type == kChunkEnd) {
+                    const uint8_t* q = body;
+                    uint64_t total = 0;
+                    if (!get_varint(q, bodyEnd, total) || total != out.frames.size()) {
+                        why = "tick count mismatch";
+                        break;
+                    }
+                    return true;
+                }
+            }
+        }
+        if (error) *error = why;
+        return false;
+    }
+
+    bool ReadKeyframeIndex(const uint8_t* data, size_t size, std::vector<KeyframeIndexEntry>& out) {
+        out.clear();
+        uint64_t seed = 0;
+        std::string why;
+        if (size < kHeaderBytes || !parse_header(data, seed, why)) return false;
+        size_t pos = kHeaderBytes;
+        ChunkView c;
+        while (next_chunk(data, size, pos, c)) {
+            if (c.type == kChunkIndex) return chunk_ok(c) && decode_index(c.body, c.body + c.len, out);
+            if (c.type == kChunkEnd) break;
+        }
+        return false;
+    }
+
+    bool ReadKeyframeAt(const uint8_t* data, size_t size, uint64_t offset, ReplayKeyframe& out) {
+        if (offset < kHeaderBytes || offset >= size) return false;
+        size_t pos = static_cast<size_t>(offset);
+        ChunkView c;
+        return next_chunk(data, size, pos, c) && c.type == kChunkKeyframe && chunk_ok(c) &&
+               decode_keyframe(c.body, c.body + c.len, out);
+    }
+
     bool Save(const std::string& path, const ReplayData& rp) {
+        std::ofstream f(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!f) return false;
+        return write_binary(f, rp, kDefaultChunkTicks);
+    }
+
+    bool Load(const std::string& path, ReplayData& out) {
+        std::ifstream f(path, std::ios::in | std::ios::binary);
+        if (!f) return false;
+        char magic[sizeof(kMagic)] = {};
+        f.read(magic, sizeof(magic));
+        const bool binary = f.gcount() == sizeof(magic) &&
+                            is_binary(reinterpret_cast<const uint8_t*>(magic), sizeof(magic));
+        f.clear();
+        f.seekg(0);
+        if (!binary) return load_text(f, out);
+
+        // keyframe 까지 담으려면 파일 전체가 필요하다. 입력은 분당 수백 바이트라 작다.
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        return Decode(bytes.data(), bytes.size(), out);
+    }
+
+    bool Recover(const std::string& path, ReplayData* out, std::string* error) {
+        std::string why;
+        std::vector<uint8_t> bytes;
+        {
+            std::ifstream f(path, std::ios::in | std::ios::binary);
+            if (f) bytes.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+            else why = "cannot open replay";
+        }
+        uint64_t seed = 0;
+        if (why.empty() && bytes.size() < kHeaderBytes) why = "truncated header";
+        if (why.empty() && parse_header(bytes.data(), seed, why)) {
+            ReplayData rp;
+            if (Decode(bytes.data(), bytes.size(), rp)) {
+                if (out) *out = std::move(rp);
+                return true;
+            }
+            // 앞에서부터 체크섬과 틱 번호가 맞는 청크까지만 남긴다. 'X'·'E' 는 다시 쓴다.
+            size_t pos = kHeaderBytes, keep = kHeaderBytes;
+            uint64_t ticks = 0;
+            std::vector<FrameInputs> scratch;
+            std::vector<uint64_t> keyTicks, keyOffsets;
+            ChunkView c;
+            while (next_chunk(bytes.data(), bytes.size(), pos, c) && chunk_ok(c)) {
+                const uint8_t* bodyEnd = c.body + c.len;
+                if (c.type == kChunkInputs) {
+                    scratch.clear();
+                    if (!decode_inputs(c.body, bodyEnd, ticks, scratch)) break;
+                    ticks += scratch.size();
+                } else if (c.type == kChunkKeyframe) {
+                    ReplayKeyframe k;
+                    if (!decode_keyframe(c.body, bodyEnd, k) || k.tick != ticks) break;
+                    keyTicks.push_back(k.tick);
+                    keyOffsets.push_back(c.offset);
+                } else if (c.type == kChunkIndex || c.type == kChunkEnd) {
+                    break;
+                }
+                keep = pos;
+            }
+
+            std::vector<uint8_t> tail;
+            if (!keyTicks.empty()) encode_chunk(tail, kChunkIndex, encode_index(keyTicks, keyOffsets));
+            std::vector<uint8_t> end;
+            put_varint(end, ticks);
+            encode_chunk(tail, kChunkEnd, end);
+
+            std::error_code ec;
+            std::filesystem::resize_file(path, keep, ec);
+            if (!ec) {
+                std::ofstream f(path, std::ios::out | std::ios::binary | std::ios::app);
+                f.write(reinterpret_cast<const char*>(tail.data()), static_cast<std::streamsize>(tail.size()));
+                f.flush();
+                if (f) {
+                    if (out) {
+                        bytes.resize(keep);
+                        bytes.insert(bytes.end(), tail.begin(), tail.end());
+                        Decode(bytes.data(), bytes.size(), *out);
+                    }
+                    return true;
+                }
+            }
+            why = "cannot rewrite replay";
+        }
+        if (error) *error = why;
+        return false;
+    }
+
+    bool ExportText(const std::string& path, const ReplayData& rp) {
         std::ofstream f(path, std::ios::out | std::ios::trunc);
         if (!f) return false;
         f << "seed " << rp.seed << "\n";
@@ -13,25 +516,4 @@ namespace ReplayIO {
         }
         return true;
     }
-
-    bool Load(const std::string& path, ReplayData& out) {
-        std::ifstream f(path);
-        if (!f) return false;
-        std::string key; size_t ticks = 0; uint64_t seed = 0;
-        if (!(f >> key >> seed)) return false;
-        if (key != "seed") return false;
-        if (!(f >> key >> ticks)) return false;
-        if (key != "ticks") return false;
-        out.seed = seed;
-        out.frames.clear();
-        out.frames.resize(ticks);
-        size_t idx; unsigned p1, p2;
-        for (size_t i = 0; i < ticks && (f >> idx >> p1 >> p2); ++i) {
-            if (idx >= ticks) break;
-            out.frames[idx].p1 = static_cast<uint8_t>(p1 & 0xFFu);
-            out.frames[idx].p2 = static_cast<uint8_t>(p2 & 0xFFu);
-        }
-        return true;
-    }
 }
-
@@ -1,22 +1,157 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include <iosfwd>
 #include <string>
 
-// [NET] 간단한 리플레이 포맷: 세션 시드 + 틱별 입력(p1,p2)
+// [NET] 리플레이: 세션 시드 + 틱별 입력(p1,p2)
 struct FrameInputs {
     uint8_t p1{0};
     uint8_t p2{0};
 };
 
+inline bool operator==(const FrameInputs& a, const FrameInputs& b) { return a.p1 == b.p1 && a.p2 == b.p2; }
+inline bool operator!=(const FrameInputs& a, const FrameInputs& b) { return !(a == b); }
+
+// 되감기용 keyframe. tick 틱을 진행한 직후 두 보드의 상태다. 상태 바이트는 이 층에서는
+// 불투명하고 src/sim_replay.h 가 만들고 푼다(SimSnapshot 두 개). hash 는 그때 두 보드의
+// StateHash 로, 재시뮬레이션 결과와 대조해 포맷 버그를 잡는다.
+struct ReplayKeyframe {
+    uint64_t tick{0};
+    uint64_t hash[2]{0, 0};
+    std::vector<uint8_t> state;
+};
+
 struct ReplayData {
     uint64_t seed{0};
     std::vector<FrameInputs> frames;
+    std::vector<ReplayKeyframe> keyframes;   // tick 오름차순. 없어도 된다
 };
 
-// 매우 단순한 텍스트 포맷으로 저장/로드(의존성 최소화)
+// 바이너리 포맷 (.trpl, 버전 1). 정수는 리틀엔디안, varint 는 LEB128.
+//
+//   헤더   "TRPL" u8 version u8 reserved u64 seed                  (14바이트)
+//   청크   u8 type, varint len, payload[len], u32 hash32_words(payload, seed=type)
+//     'I'  입력: varint firstTick, 그 뒤로 run 레코드가 payload 끝까지
+//     'K'  keyframe(선택): varint tick, u64 hash×2, 상태 바이트. 앞 청크까지의 틱 수가 tick
+//     'X'  keyframe 색인(선택, 'E' 바로 앞): varint count, (varint Δtick, varint Δoffset)×count.
+//          offset 은 파일 처음부터 'K' 청크 type 바이트까지
+//     'E'  끝:  varint totalTicks. 이것이 없으면 잘린 파일이다
+//   모르는 type 의 청크는 길이만큼 건너뛴다(뒤 버전이 선택 청크를 더할 자리).
+//   스트림 reader 는 입력만 내고 'K'·'X' 는 건너뛴다. keyframe 은 Decode·Load 가 채운다.
+//
+// run 레코드: varint (runLength << 2 | kind) 뒤에 kind 에 따라 마스크 바이트.
+//   kind 0 — 두 입력 모두 0 (마스크 바이트 없음). 입력 없는 틱이 대부분이라
+//            긴 대기 구간이 varint 하나로 접힌다
+//   kind 1 — p1 만 (1바이트)   kind 2 — p2 만 (1바이트)   kind 3 — 둘 다 (2바이트)
+// run 은 청크를 넘지 않는다. 청크마다 체크섬이 있어 손상된 곳 앞까지는 읽을 수 있다.
+//
+// 텍스트 포맷(seed / ticks / 틱당 "idx p1 p2")은 디버깅용 내보내기로 남는다.
+// Load 는 첫 4바이트로 둘을 가려 어느 쪽이든 읽는다.
 namespace ReplayIO {
+    constexpr uint8_t  kBinaryVersion = 1;
+    constexpr uint32_t kDefaultChunkTicks = 3600;   // 60Hz 로 1분
+    // 'I' 청크 하나가 풀어낼 수 있는 틱 수 상한(60Hz 로 약 4.9시간). run 길이는 varint 라
+    // 몇 바이트짜리 청크가 수십억 틱을 선언할 수 있으므로, 읽는 쪽은 청크마다 run 을 더해
+    // 이 값을 넘으면 손상으로 본다. writer 도 chunkTicks 를 여기까지로 자른다.
+    constexpr uint32_t kMaxChunkTicks = 1u << 20;
+    // 파일 하나가 풀어낼 수 있는 전체 틱 수 상한(60Hz 로 약 77시간, 입력 메모리 32MiB).
+    // 청크 상한만으로는 15바이트 남짓한 청크를 이어 붙여 1MB 파일이 수백억 틱으로 부풀 수
+    // 있으므로, 읽는 쪽(Decode·Recover·BinaryReader·텍스트 Load)은 누적 틱이 이 값을 넘으면
+    // 손상으로 본다.
+    constexpr uint32_t kMaxReplayTicks = 1u << 24;
+    static_assert(kMaxChunkTicks <= kMaxReplayTicks, "청크 하나가 파일 상한을 넘을 수 없다");
+
+    // 입력을 한 틱씩 받아 청크 단위로 os 에 쓴다. 메모리는 청크 하나분이다.
+    class BinaryWriter {
+    public:
+        BinaryWriter(std::ostream& os, uint64_t seed, uint32_t chunkTicks = kDefaultChunkTicks);
+
+        void Push(const FrameInputs& f);
+        // 지금까지 Push 한 틱 수가 k.tick 이어야 한다(아니면 무시하고 false).
+        // 진행 중인 입력 청크를 닫고 'K' 청크를 쓴다. 색인은 Finish 가 쓴다.
+        bool PushKeyframe(const ReplayKeyframe& k);
+        // 진행 중인 입력 청크를 닫고 os 를 flush 한다. 여기까지 쓴 것은 파일이 뒤에서
+        // 잘려도 Recover 로 살아난다. 청크가 짧아지는 만큼 run 이 끊기므로 자주 부르지 않는다.
+        bool Flush();
+        // 남은 run 과 끝 청크를 쓴다. 이후 Push 는 무시된다. 스트림 상태를 돌려준다.
+        bool Finish();
+
+        uint64_t Ticks() const { return ticks_; }
+        uint64_t BytesWritten() const { return bytes_; }
+
+    private:
+        void FlushRun();
+        void FlushChunk();
+        void WriteChunk(uint8_t type, const std::vector<uint8_t>& payload);
+
+        std::ostream& os_;
+        uint32_t chunkTicks_;
+        uint64_t ticks_ = 0;
+        uint64_t chunkFirstTick_ = 0;
+        uint64_t bytes_ = 0;
+        FrameInputs run_{};
+        uint64_t runLength_ = 0;
+        std::vector<uint8_t> payload_;
+        std::vector<uint8_t> chunk_;   // WriteChunk 가 다시 쓰는 버퍼
+        bool finished_ = false;
+        std::vector<uint64_t> keyTicks_;
+        std::vector<uint64_t> keyOffsets_;
+    };
+
+    // is 에서 청크를 하나씩 읽어 틱 단위로 돌려준다. 메모리는 청크 하나분이다.
+    class BinaryReader {
+    public:
+        explicit BinaryReader(std::istream& is);
+
+        // 헤더가 맞으면 true. 아니면 Error() 에 이유.
+        bool Ok() const { return ok_; }
+        uint64_t Seed() const { return seed_; }
+        // 다음 틱. 끝 청크에 닿았거나 손상·잘림을 만나면 false.
+        bool Next(FrameInputs& out);
+        // 끝 청크까지 읽었고 틱 수가 맞으면 true. Next 가 false 를 돌려준 뒤에 본다.
+        bool Complete() const { return complete_; }
+        uint64_t Ticks() const { return ticks_; }
+        const std::string& Error() const { return error_; }
+
+    private:
+        bool ReadChunk();
+        bool Fail(const char* why);
+
+        std::istream& is_;
+        bool ok_ = false;
+        bool done_ = false;
+        bool complete_ = false;
+        uint64_t seed_ = 0;
+        uint64_t ticks_ = 0;
+        std::vector<uint8_t> payload_;
+        std::vector<FrameInputs> frames_;
+        size_t next_ = 0;
+        std::string error_;
+    };
+
+    // 바이너리로 저장한다.
     bool Save(const std::string& path, const ReplayData& rp);
+    // 바이너리·텍스트 어느 쪽이든 읽는다. 잘린 바이너리는 false(읽은 데까지는 out 에 남는다).
     bool Load(const std::string& path, ReplayData& out);
-}
+    // 끝 청크 없이 끊긴 바이너리 파일(녹화 중 강제 종료)을 마지막 온전한 청크까지 자르고
+    // 'X'·'E' 를 다시 붙여 완전한 파일로 만든다. 체크섬이 깨진 청크부터 뒤는 버린다.
+    // 이미 완전하면 건드리지 않는다. out 에는 남은 내용을 준다.
+    // 헤더부터 읽을 수 없으면 false 이고 파일은 그대로다.
+    bool Recover(const std::string& path, ReplayData* out = nullptr, std::string* error = nullptr);
+    // 디버깅용 텍스트 내보내기 (예전 Save 포맷).
+    bool ExportText(const std::string& path, const ReplayData& rp);
 
+    // 메모리 버퍼 인코딩/디코딩. 스트림 API 와 같은 바이트열이다. keyframe 도 담는다.
+    // Decode 는 'X' 색인이 실제 'K' 청크 위치와 다르면 실패한다.
+    std::vector<uint8_t> Encode(const ReplayData& rp, uint32_t chunkTicks = kDefaultChunkTicks);
+    bool Decode(const uint8_t* data, size_t size, ReplayData& out, std::string* error = nullptr);
+
+    // 입력을 풀지 않고 keyframe 하나만 꺼내는 경로. 청크 헤더만 건너뛰며 'X' 를 찾는다.
+    struct KeyframeIndexEntry {
+        uint64_t tick;
+        uint64_t offset;
+    };
+    bool ReadKeyframeIndex(const uint8_t* data, size_t size, std::vector<KeyframeIndexEntry>& out);
+    bool ReadKeyframeAt(const uint8_t* data, size_t size, uint64_t offset, ReplayKeyframe& out);
+}
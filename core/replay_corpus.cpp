@@ -0,0 +1,221 @@
+#include "replay_corpus.h"
+#include "hash.h"
+
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX 1
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+    constexpr char kMagic[4] = {'T', 'R', 'P', 'C'};
+    constexpr size_t kHeaderBytes = 32;
+
+    struct Header {
+        char magic[4];
+        uint8_t version;
+        uint8_t reserved[3];
+        uint64_t count;
+        uint64_t indexOffset;
+        uint32_t indexChecksum;
+        uint32_t reserved2;
+    };
+    static_assert(sizeof(Header) == kHeaderBytes, "corpus header size");
+
+    uint64_t align8(uint64_t v) { return (v + 7) & ~uint64_t{7}; }
+
+    bool fail(std::string* error, const char* why) {
+        if (error) *error = why;
+        return false;
+    }
+}
+
+ReplayCorpusWriter::ReplayCorpusWriter(const std::string& path)
+    : file_(path, std::ios::out | std::ios::binary | std::ios::trunc)
+{
+    // 헤더 자리는 0 으로 비워 둔다. Finish 전에 죽으면 열리지 않는 파일이 된다.
+    const char zeros[kHeaderBytes] = {};
+    file_.write(zeros, sizeof(zeros));
+    offset_ = kHeaderBytes;
+}
+
+bool ReplayCorpusWriter::Add(uint64_t seed, const FrameInputs* frames, size_t ticks)
+{
+    if (finished_ || !file_) return false;
+    const size_t bytes = ticks * sizeof(FrameInputs);
+    ReplayCorpusEntry e{};
+    e.seed = seed;
+    e.offset = offset_;
+    e.ticks = ticks;
+    e.checksum = hash32_words(frames, bytes);
+    file_.write(reinterpret_cast<const char*>(frames), static_cast<std::streamsize>(bytes));
+    const char pad[8] = {};
+    const uint64_t padded = align8(offset_ + bytes);
+    file_.write(pad, static_cast<std::streamsize>(padded - offset_ - bytes));
+    offset_ = padded;
+    entries_.push_back(e);
+    return static_cast<bool>(file_);
+}
+
+bool ReplayCorpusWriter::Finish()
+{
+    if (finished_) return static_cast<bool>(file_);
+    finished_ = true;
+    const size_t indexBytes = entries_.size() * sizeof(ReplayCorpusEntry);
+    file_.write(reinterpret_cast<const char*>(entries_.data()), static_cast<std::streamsize>(indexBytes));
+
+    Header h{};
+    std::memcpy(h.magic, kMagic, sizeof(kMagic));
+    h.version = kVersion;
+    h.count = entries_.size();
+    h.indexOffset = offset_;
+    h.indexChecksum = hash32_words(entries_.data(), indexBytes);
+    file_.seekp(0);
+    file_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file_.flush();
+    return static_cast<bool>(file_);
+}
+
+ReplayCorpus::ReplayCorpus(ReplayCorpus&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+ReplayCorpus& ReplayCorpus::operator=(ReplayCorpus&& other) noexcept
+{
+    if (this != &other) {
+        Close();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(count_, other.count_);
+        std::swap(indexOffset_, other.indexOffset_);
+#ifdef _WIN32
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+    return *this;
+}
+
+bool ReplayCorpus::Open(const std::string& path, std::string* error)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return fail(error, "cannot open corpus");
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length) || length.QuadPart < static_cast<LONGLONG>(kHeaderBytes)) {
+        CloseHandle(file);
+        return fail(error, "truncated header");
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        return fail(error, "mmap failed");
+    }
+    file_ = file;
+    mapping_ = mapping;
+    size_ = static_cast<size_t>(length.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(error, "cannot open corpus");
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(kHeaderBytes)) {
+        ::close(fd);
+        return fail(error, "truncated header");
+    }
+    void* view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);   // 매핑은 fd 가 닫혀도 남는다
+    if (view == MAP_FAILED) return fail(error, "mmap failed");
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    data_ = static_cast<const uint8_t*>(view);
+
+    Header h;
+    std::memcpy(&h, data_, sizeof(h));
+    const char* why = nullptr;
+    if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0) why = "not a replay corpus";
+    else if (h.version != ReplayCorpusWriter::kVersion) why = "unsupported corpus version";
+    else if (h.indexOffset < kHeaderBytes || h.indexOffset > size_ ||
+             h.count > (size_ - h.indexOffset) / sizeof(ReplayCorpusEntry))
+        why = "truncated index";
+    else if (hash32_words(data_ + h.indexOffset, h.count * sizeof(ReplayCorpusEntry)) != h.indexChecksum)
+        why = "index checksum mismatch";
+    if (!why) {
+        count_ = static_cast<size_t>(h.count);
+        indexOffset_ = h.indexOffset;
+        // 항목마다 본문 범위를 본다. 이후 Inputs 는 검사 없이 포인터만 더한다.
+        for (size_t i = 0; i < count_ && !why; ++i) {
+            const ReplayCorpusEntry e = Entry(i);
+            if (e.offset < kHeaderBytes || e.offset % 8 != 0 || e.offset > indexOffset_ ||
+                e.ticks > (indexOffset_ - e.offset) / sizeof(FrameInputs))
+                why = "corrupt index entry";
+        }
+    }
+    if (why) {
+        Close();
+        return fail(error, why);
+    }
+    return true;
+}
+
+void ReplayCorpus::Close()
+{
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(static_cast<HANDLE>(mapping_));
+        CloseHandle(static_cast<HANDLE>(file_));
+        mapping_ = nullptr;
+        file_ = nullptr;
+#else
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    count_ = 0;
+    indexOffset_ = 0;
+}
+
+ReplayCorpusEntry ReplayCorpus::Entry(size_t i) const
+{
+    ReplayCorpusEntry e;
+    std::memcpy(&e, data_ + indexOffset_ + i * sizeof(ReplayCorpusEntry), sizeof(e));
+    return e;
+}
+
+const FrameInputs* ReplayCorpus::Inputs(size_t i) const
+{
+    return reinterpret_cast<const FrameInputs*>(data_ + Entry(i).offset);
+}
+
+bool ReplayCorpus::Verify(size_t i) const
+{
+    if (i >= count_) return false;
+    const ReplayCorpusEntry e = Entry(i);
+    return hash32_words(data_ + e.offset, e.ticks * sizeof(FrameInputs)) == e.checksum;
+}
+
+bool ReplayCorpus::Load(size_t i, ReplayData& out) const
+{
+    if (i >= count_) return false;
+    const ReplayCorpusEntry e = Entry(i);
+    const FrameInputs* frames = Inputs(i);
+    out.seed = e.seed;
+    out.frames.assign(frames, frames + e.ticks);
+    out.keyframes.clear();
+    return true;
+}
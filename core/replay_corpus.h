@@ -0,0 +1,96 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "replay.h"
+
+// [RL] 리플레이 코퍼스: 대국 수십만 판을 파일 하나에 담고 mmap 으로 읽는다.
+//
+// 모방·오프라인 RL 학습은 같은 기록을 에폭마다 다시 훑는다. .trpl 을 한 판씩 Load 하면
+// 파일 열기와 varint 풀기가 매번 따라붙으므로, 코퍼스는 입력을 푼 채(틱당 FrameInputs
+// 2바이트)로 이어 붙이고 끝에 색인을 둔다. 리더는 파일을 통째로 매핑해 색인만 확인하고,
+// 판 하나의 입력은 매핑 위의 포인터로 바로 내준다(복사 없음, 페이지는 닿을 때 읽힌다).
+// 10분 대국이 72KB 라 .trpl 보다 크지만, 디스크보다 디코딩이 비싼 쪽이라 이렇게 둔다.
+//
+//   헤더  "TRPC" u8 version u8[3] 0  u64 count  u64 indexOffset  u32 indexChecksum  u32 0   (32바이트)
+//   본문  판마다 FrameInputs[ticks], 8바이트 경계로 0 패딩
+//   색인  indexOffset 에서 ReplayCorpusEntry[count]. indexChecksum = hash32_words(색인)
+// 정수는 리틀엔디안(지원 플랫폼의 호스트 순서라 색인은 그대로 memcpy 한다).
+// 헤더는 Finish 가 마지막에 채우므로, 쓰다가 죽은 파일은 헤더가 0 이라 열리지 않는다.
+// keyframe 은 담지 않는다 — 코퍼스를 읽는 쪽은 어차피 시드부터 다시 굴린다.
+struct ReplayCorpusEntry
+{
+    uint64_t seed;
+    uint64_t offset;      // 파일 처음부터 입력 배열까지
+    uint64_t ticks;
+    uint32_t checksum;    // hash32_words(입력 배열). 열 때는 보지 않고 Verify 가 본다
+    uint32_t reserved;
+};
+static_assert(sizeof(ReplayCorpusEntry) == 32, "ReplayCorpusEntry is written to disk as-is");
+static_assert(sizeof(FrameInputs) == 2, "corpus input streams are FrameInputs arrays");
+
+class ReplayCorpusWriter
+{
+public:
+    static constexpr uint8_t kVersion = 1;
+
+    explicit ReplayCorpusWriter(const std::string& path);
+
+    bool Ok() const { return static_cast<bool>(file_); }
+    // 한 판을 덧붙인다. keyframe 은 버린다.
+    bool Add(const ReplayData& rp) { return Add(rp.seed, rp.frames.data(), rp.frames.size()); }
+    bool Add(uint64_t seed, const FrameInputs* frames, size_t ticks);
+    // 색인과 헤더를 쓴다. 이후 Add 는 실패한다.
+    bool Finish();
+
+    size_t Count() const { return entries_.size(); }
+
+private:
+    std::ofstream file_;
+    uint64_t offset_ = 0;
+    std::vector<ReplayCorpusEntry> entries_;
+    bool finished_ = false;
+};
+
+// 읽기 전용 매핑. 이동만 된다. 돌려주는 포인터는 Close 나 소멸 전까지 유효하다.
+class ReplayCorpus
+{
+public:
+    ReplayCorpus() = default;
+    ~ReplayCorpus() { Close(); }
+    ReplayCorpus(ReplayCorpus&& other) noexcept;
+    ReplayCorpus& operator=(ReplayCorpus&& other) noexcept;
+    ReplayCorpus(const ReplayCorpus&) = delete;
+    ReplayCorpus& operator=(const ReplayCorpus&) = delete;
+
+    // 헤더·색인 체크섬·각 항목의 범위를 본다. 입력 본문은 읽지 않는다.
+    bool Open(const std::string& path, std::string* error = nullptr);
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    size_t Size() const { return count_; }
+    size_t Bytes() const { return size_; }
+
+    ReplayCorpusEntry Entry(size_t i) const;
+    uint64_t Seed(size_t i) const { return Entry(i).seed; }
+    uint64_t Ticks(size_t i) const { return Entry(i).ticks; }
+    const FrameInputs* Inputs(size_t i) const;
+
+    // 입력 체크섬을 본다. 본문 페이지를 전부 건드린다.
+    bool Verify(size_t i) const;
+    // 복사해 ReplayData 로 꺼낸다(ReplayIO 쪽 도구에 넘길 때).
+    bool Load(size_t i, ReplayData& out) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    size_t count_ = 0;
+    uint64_t indexOffset_ = 0;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
@@ -29,3 +29,12 @@ public:
 private:
     uint64_t state;
 };
+
+// splitmix64 finalizer. 시드 하나에서 서로 상관이 약한 파생 시드를 뽑을 때 쓴다
+// (게임·에피소드·매치별 시드, Zobrist 키). 순수 정수 연산이라 플랫폼과 무관하게 같다.
+constexpr uint64_t splitmix64(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
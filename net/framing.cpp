@@ -1,4 +1,5 @@
 #include "framing.h"
+#include "../core/hash.h"
 #include <cstring>
 
 // 한계/필드 크기 상수는 framing.h 의 공개 상수(kMaxPayloadBytes 등)를 쓴다.
@@ -13,6 +14,15 @@ uint32_t fnv1a32(const uint8_t* data, size_t len, uint32_t seed) {
     return h;
 }
 
+uint32_t frame_checksum(ChecksumKind kind, const uint8_t* payload, size_t len) {
+    if (len == 0) return 0u;
+    return kind == ChecksumKind::Word32 ? hash32_words(payload, len) : fnv1a32(payload, len);
+}
+
+bool checksum_matches(ChecksumKind kind, const uint8_t* payload, size_t len, uint32_t chk) {
+    return frame_checksum(kind, payload, len) == chk;
+}
+
 void le_write_u16(std::vector<uint8_t>& v, uint16_t x) {
     v.push_back((uint8_t)(x & 0xFF)); v.push_back((uint8_t)((x>>8)&0xFF));
 }
@@ -29,7 +39,7 @@ uint64_t le_read_u64(const uint8_t* p) {
     uint64_t x=0; for (int i=7;i>=0;--i){ x = (x<<8) | p[i]; } return x;
 }
 
-std::vector<uint8_t> build_frame(MsgType t, const std::vector<uint8_t>& payload) {
+std::vector<uint8_t> build_frame(MsgType t, const std::vector<uint8_t>& payload, ChecksumKind kind) {
     // 발신 측에서도 페이로드 상한을 검사 — 초과 시 빈 벡터로 실패.
     if (payload.size() > kMaxPayloadBytes) return {};
     // LEN = TYPE(1) + PAYLOAD(N)
@@ -38,13 +48,13 @@ std::vector<uint8_t> build_frame(MsgType t, const std::vector<uint8_t>& payload)
     le_write_u16(out, len);
     out.push_back(static_cast<uint8_t>(t));
     out.insert(out.end(), payload.begin(), payload.end());
-    // CHK = FNV-1a32(PAYLOAD)
-    const uint32_t chk = payload.empty() ? 0u : fnv1a32(payload.data(), payload.size());
+    // CHK = kind(PAYLOAD)
+    const uint32_t chk = frame_checksum(kind, payload.data(), payload.size());
     le_write_u32(out, chk);
     return out;
 }
 
-bool parse_frames(std::vector<uint8_t>& streamBuf, std::vector<Frame>& out) {
+bool parse_frames(std::vector<uint8_t>& streamBuf, std::vector<Frame>& out, RxChecksum* rx) {
     size_t offset = 0;
     while (true) {
         // Addition avoids unsigned underflow in a subtraction check.
@@ -71,9 +81,10 @@ bool parse_frames(std::vector<uint8_t>& streamBuf, std::vector<Frame>& out) {
 
         const size_t chkPos = offset + kFrameLenBytes + static_cast<size_t>(len);
         const uint32_t chk = le_read_u32(&streamBuf[chkPos]);
-        const uint32_t calc = (payloadLen == 0) ? 0u : fnv1a32(payload, payloadLen);
 
-        if (chk == calc) {
+        const ChecksumKind kind = rx ? rx->expected(type) : ChecksumKind::Fnv1a32;
+        if (checksum_matches(kind, payload, payloadLen, chk)) {
+            if (rx) rx->observe(type, payload, payloadLen);
             Frame f; f.type = static_cast<MsgType>(type);
             f.payload.assign(payload, payload + payloadLen);
             out.push_back(std::move(f));
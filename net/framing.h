@@ -21,7 +21,35 @@ namespace net {
 constexpr std::size_t kMaxPayloadBytes    = 4096;  // PAYLOAD 상한 (바이트)
 constexpr std::size_t kFrameLenBytes      = 2;     // LEN 필드 (u16 LE)
 constexpr std::size_t kFrameTypeBytes     = 1;     // TYPE 필드 (u8)
-constexpr std::size_t kFrameChecksumBytes = 4;     // CHECKSUM 필드 (u32 LE, FNV-1a)
+constexpr std::size_t kFrameChecksumBytes = 4;     // CHECKSUM 필드 (u32 LE, ChecksumKind)
+
+// 프레임 CHECKSUM 알고리즘. 값은 wire 규약이므로 재번호 금지.
+//
+// Fnv1a32 — 원래 규약. 바이트마다 곱셈 하나라 INPUT/HASH 처럼 매 틱 오가는
+//           프레임에서 CPU 를 먹는다.
+// Word32  — core/hash.h 의 hash32_words(payload, seed=0). 8바이트 단위로 읽는다.
+//
+// 협상: 프레임에 알고리즘 표시는 없고, 수신 쪽은 세션에서 정해진 하나만 검사한다.
+//   · 두 피어가 연결(직결·릴레이 매치 모두) 직후 HELLO 를 보낸다. 새 클라이언트는
+//     version 을 kProtocolVersionWordChecksum 으로 올린다.
+//   · HELLO 를 받은 쪽은 HELLO_ACK [version:1] 로 답한다. 상대 HELLO 가 2 이상이면
+//     2 를 싣고, 그 HELLO_ACK 바로 뒤의 락스텝 프레임(is_lockstep_type)부터 Word32 로
+//     만든다. 송신 큐 순서가 곧 전환점이다.
+//   · 수신 쪽(RxChecksum)은 스트림에서 HELLO_ACK 2 를 본 순간부터 락스텝 타입만 Word32
+//     로, 나머지는 계속 FNV 로 검사한다. 구버전 피어는 HELLO_ACK 1 을 보내므로 FNV 로 남는다.
+// 프레임마다 한 번만 해시하고, 우연히 통과하는 손상 확률도 2^-32 그대로다.
+//
+// 릴레이는 매치 중 프레임을 원본 바이트 그대로 넘기므로 구버전 릴레이 경유여도
+// 된다. 릴레이가 직접 검사하는 타입(READY, QUEUE_CANCEL, MATCH_SUMMARY)은 락스텝
+// 타입이 아니라 클라이언트가 항상 Fnv1a32 로 보내고, 릴레이도 FNV 로만 검사한다.
+enum class ChecksumKind : uint8_t {
+    Fnv1a32 = 0,
+    Word32  = 1,
+};
+
+// HELLO 페이로드 [version:2 LE]. 1 = FNV 만, 2 = Word32 수신 가능.
+constexpr uint16_t kProtocolVersionFnvOnly      = 1;
+constexpr uint16_t kProtocolVersionWordChecksum = 2;
 
 // 메시지 타입
 enum class MsgType : uint8_t {
@@ -137,6 +165,33 @@ enum class RejectReason : uint8_t {
     AuthBacklog      = 5,  // 대기 중인 meta 인증 왕복 상한
 };
 
+// 협상 뒤 Word32 로 오가는 타입 — 매 틱 오가는 프레임만.
+constexpr bool is_lockstep_type(uint8_t type) {
+    return type == static_cast<uint8_t>(MsgType::INPUT) ||
+           type == static_cast<uint8_t>(MsgType::HASH)  ||
+           type == static_cast<uint8_t>(MsgType::ACK)   ||
+           type == static_cast<uint8_t>(MsgType::PING)  ||
+           type == static_cast<uint8_t>(MsgType::PONG);
+}
+
+// 수신 방향 하나의 체크섬 상태. 세션(연결)마다 하나 두고 parse_frames 에 넘긴다.
+// 상대가 보낸 HELLO_ACK 의 version 이 kProtocolVersionWordChecksum 이상이면 그 뒤의
+// 락스텝 타입을 Word32 로 검사한다. 되돌아가지 않는다(새 연결에서 Reset).
+struct RxChecksum {
+    bool word = false;
+
+    ChecksumKind expected(uint8_t type) const {
+        return word && is_lockstep_type(type) ? ChecksumKind::Word32 : ChecksumKind::Fnv1a32;
+    }
+    // 검사를 통과한 프레임마다 부른다. parse_frames 가 알아서 부른다.
+    void observe(uint8_t type, const uint8_t* payload, size_t len) {
+        if (type == static_cast<uint8_t>(MsgType::HELLO_ACK) && len >= 1 &&
+            payload[0] >= kProtocolVersionWordChecksum)
+            word = true;
+    }
+    void Reset() { word = false; }
+};
+
 // 파싱된 메시지 프레임
 struct Frame {
     MsgType type;
@@ -146,11 +201,21 @@ struct Frame {
 // FNV-1a 32-bit 해시 (체크섬용)
 uint32_t fnv1a32(const uint8_t* data, size_t len, uint32_t seed=2166136261u);
 
+// kind 알고리즘의 프레임 체크섬. 빈 페이로드는 어느 쪽이든 0.
+uint32_t frame_checksum(ChecksumKind kind, const uint8_t* payload, size_t len);
+
+// 수신 검사: chk 가 kind 알고리즘의 체크섬이면 true.
+bool checksum_matches(ChecksumKind kind, const uint8_t* payload, size_t len, uint32_t chk);
+
 // 스트림 파싱: 누적 버퍼에서 완성된 프레임들 추출 (부분 수신 처리)
-bool parse_frames(std::vector<uint8_t>& streamBuf, std::vector<Frame>& out);
+// rx 가 없으면 전부 FNV 로 검사한다(서버·로비처럼 HELLO 협상 밖의 경로).
+bool parse_frames(std::vector<uint8_t>& streamBuf, std::vector<Frame>& out,
+                  RxChecksum* rx = nullptr);
 
 // 메시지 직렬화: TYPE + PAYLOAD → 프레임 바이트 배열
-std::vector<uint8_t> build_frame(MsgType t, const std::vector<uint8_t>& payload);
+// kind 는 상대가 Word32 를 받는다고 밝힌 뒤에만 바꾼다 (위 ChecksumKind 참고).
+std::vector<uint8_t> build_frame(MsgType t, const std::vector<uint8_t>& payload,
+                                 ChecksumKind kind = ChecksumKind::Fnv1a32);
 
 // 리틀엔디안 직렬화/역직렬화
 void le_write_u16(std::vector<uint8_t>& v, uint16_t x);
@@ -71,8 +71,9 @@ bool Session::Host(uint16_t port, const SeedParams& sp) {
     lastRemoteTick = 0;
     lastLocalTick = 0;
     recvBuf.clear();
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
 
     { std::lock_guard<std::mutex> lk(seedMu); seedParams = sp; }
     listening = true;
@@ -96,8 +97,9 @@ bool Session::Connect(const std::string& host, uint16_t port) {
     lastRemoteTick = 0;
     lastLocalTick = 0;
     recvBuf.clear();
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
 
     TcpSocket connectedSock = tcp_connect(host, port);
     if (!connectedSock.valid()) {
@@ -116,15 +118,16 @@ bool Session::Connect(const std::string& host, uint16_t port) {
     NET_TRACE("[NET] Connected to " << host << ":" << port);
     connected = true;
     th = std::thread(&Session::ioThread, this);
-    {
-        std::vector<uint8_t> pl; le_write_u16(pl, 1);
-        auto fr = build_frame(MsgType::HELLO, pl);
-        pushSend(std::move(fr));
-        NET_TRACE("[NET] Sent HELLO message");
-    }
+    queueHello();
     return true;
 }
 
+void Session::queueHello() {
+    std::vector<uint8_t> pl; le_write_u16(pl, kProtocolVersionWordChecksum);
+    pushSend(build_frame(MsgType::HELLO, pl));
+    NET_TRACE("[NET] Queued HELLO message");
+}
+
 void Session::SendInput(uint32_t tick, uint8_t mask) {
     // 메인 스레드 활성 시각 갱신 — ioThread 의 스톨 감지 (창 드래그 대응) 이 이 값
     // 을 기준으로 동작한다.
@@ -132,14 +135,12 @@ void Session::SendInput(uint32_t tick, uint8_t mask) {
     auto cur = lastLocalTick.load();
     if (tick > cur) lastLocalTick.store(tick);
     std::vector<uint8_t> pl; le_write_u32(pl, tick); le_write_u16(pl, 1); pl.push_back(mask);
-    auto fr = build_frame(MsgType::INPUT, pl);
-    pushSend(std::move(fr));
+    pushLockstep(MsgType::INPUT, pl);
 }
 
 void Session::SendHash(uint32_t tick, uint64_t hash) {
     std::vector<uint8_t> pl; le_write_u32(pl, tick); le_write_u64(pl, hash);
-    auto fr = build_frame(MsgType::HASH, pl);
-    pushSend(std::move(fr));
+    pushLockstep(MsgType::HASH, pl);
 }
 
 void Session::SendGameOverChoice(GameOverChoice choice) {
@@ -233,6 +234,10 @@ constexpr size_t kMaxSendQueue = 4096;   // 60Hz 기준 약 68초치 INPUT
 
 void Session::pushSend(std::vector<uint8_t>&& fr) {
     std::lock_guard<std::mutex> lk(sendMu);
+    pushSendLocked(std::move(fr));
+}
+
+void Session::pushSendLocked(std::vector<uint8_t>&& fr) {
     if (sendQ.size() >= kMaxSendQueue) {
         NET_WARN("[NET] sendQ overflow (" << sendQ.size()
                  << " frames) - treating peer as disconnected");
@@ -243,6 +248,13 @@ void Session::pushSend(std::vector<uint8_t>&& fr) {
     sendQ.push_back(std::move(fr));
 }
 
+void Session::pushLockstep(MsgType type, const std::vector<uint8_t>& payload) {
+    // 체크섬 종류를 읽는 것과 큐에 넣는 것을 한 잠금 안에서 — HELLO_ACK 와의
+    // 순서가 어긋나면 상대가 Word32 프레임을 FNV 로 검증해 버린다.
+    std::lock_guard<std::mutex> lk(sendMu);
+    pushSendLocked(build_frame(type, payload, sendChecksum_));
+}
+
 void Session::Close() {
     quit = true;
     // 소켓을 먼저 닫아(shutdown) accept()/recv() 블로킹 스레드를 깨운다.
@@ -297,8 +309,9 @@ void Session::Close() {
     }
     // 게임 sendQ / HASH pair 도 함께 비움 — 같은 Session 객체 재사용 시 이전
     // 연결의 stale 프레임이 새 연결의 ioThread 에서 선두로 나가는 것 방지.
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
     // MATCH_RESULT 도 초기화. ClearGameOverChoices 만 의존하면 타이틀→새 매치
     // 경로에서 이전 라운드 결과가 새 매치 게임오버 시점에 즉시 읽히는 경계가
     // 있었다. Close 는 세션 경계마다 반드시 실행되므로 여기서 보장.
@@ -327,8 +340,9 @@ bool Session::QueueJoin(const std::string& host, uint16_t port,
     lastRemoteTick = 0;
     lastLocalTick = 0;
     recvBuf.clear();
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
     queueMatched_.store(false);
     queueLocalReady_.store(false);
     queuePeerReady_.store(false);
@@ -397,8 +411,9 @@ bool Session::RoomCreate(const std::string& host, uint16_t port,
     lastRemoteTick = 0;
     lastLocalTick = 0;
     recvBuf.clear();
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
     roomState_.store(RoomState::Connecting);
     roomPeerCount_.store(0);
     { std::lock_guard<std::mutex> lk(roomMu_); roomCode_.clear(); }
@@ -423,8 +438,9 @@ bool Session::RoomJoin(const std::string& host, uint16_t port,
     lastRemoteTick = 0;
     lastLocalTick = 0;
     recvBuf.clear();
-    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); }
+    { std::lock_guard<std::mutex> lk(sendMu); sendQ.clear(); sendChecksum_ = ChecksumKind::Fnv1a32; }
     { std::lock_guard<std::mutex> lk(hashMu_); lastHashTickRemote = 0; lastHashRemote = 0; }
+    rxChecksum_.Reset();
     roomState_.store(RoomState::Connecting);
     roomPeerCount_.store(0);
     { std::lock_guard<std::mutex> lk(roomMu_); roomCode_ = code; }
@@ -544,6 +560,8 @@ void Session::roomThread(std::string host, uint16_t port,
         }
 
         std::vector<Frame> frames;
+        // 로비 단계는 FNV 만 본다. 상대는 우리 HELLO(ioThread 기동 직전에 보낸다)에 답한
+        // 뒤에야 Word32 로 바꾸므로, 여기까지 오는 프레임은 전부 FNV 다.
         parse_frames(buf, frames);
         bool matchFound = false;
         for (auto& f : frames) {
@@ -618,6 +636,7 @@ void Session::roomThread(std::string host, uint16_t port,
             lastPingSentMs.store(0);
             roomState_.store(RoomState::Starting);
             ready = true;
+            queueHello();
             th = std::thread(&Session::ioThread, this);
             return;
         }
@@ -778,6 +797,8 @@ void Session::queueThread(std::string host, uint16_t port,
             return;
         }
         std::vector<Frame> frames;
+        // 로비 단계는 FNV 만 본다. 상대는 우리 HELLO(ioThread 기동 직전에 보낸다)에 답한
+        // 뒤에야 Word32 로 바꾸므로, 여기까지 오는 프레임은 전부 FNV 다.
         parse_frames(buf, frames);
         bool peerDeclined = false;
         // 로비 외 프레임(INPUT/PING/HASH 등)은 재직렬화해 recvBuf 에 바로 적재한다.
@@ -816,6 +837,7 @@ void Session::queueThread(std::string host, uint16_t port,
             lastPongMs.store(now_ms());
             lastPingSentMs.store(0);
             ready = true;
+            queueHello();
             th = std::thread(&Session::ioThread, this);
             return;
         }
@@ -852,8 +874,7 @@ void Session::ioThread() {
             if (lastSent == 0 || (now - lastSent) >= 1000) {
                 lastPingSentMs.store(now);
                 std::vector<uint8_t> pl; le_write_u64(pl, (uint64_t)now);
-                auto fr = build_frame(MsgType::PING, pl);
-                pushSend(std::move(fr));
+                pushLockstep(MsgType::PING, pl);
             }
 
             // 메인 스레드 스톨 자동 heartbeat — 창 드래그 시 메인 루프가 WM_ENTERSIZEMOVE
@@ -872,10 +893,9 @@ void Session::ioThread() {
                     le_write_u32(pl, nextTick);
                     le_write_u16(pl, 1);
                     pl.push_back(0);
-                    auto fr = build_frame(MsgType::INPUT, pl);
                     lastLocalTick.store(nextTick);
                     heartbeatTickEnd_.store(nextTick);
-                    pushSend(std::move(fr));
+                    pushLockstep(MsgType::INPUT, pl);
                 }
             } else {
                 lastHeartbeatMs_.store(0);
@@ -896,7 +916,7 @@ void Session::ioThread() {
             // 를 리턴하면 parse_frames 자체가 스킵되어 preload 가 소비되지 않는다.
             if (newBytes || !recvBuf.empty()) {
                 std::vector<Frame> frames;
-                parse_frames(recvBuf, frames);
+                parse_frames(recvBuf, frames, &rxChecksum_);
                 for (auto& f : frames) handleFrame(f);
             }
         } else {
@@ -976,12 +996,7 @@ void Session::acceptThread(uint16_t port)
     connected = true;
     listening = false;
     th = std::thread(&Session::ioThread, this);
-    {
-        std::vector<uint8_t> pl; le_write_u16(pl, 1);
-        auto fr = build_frame(MsgType::HELLO, pl);
-        pushSend(std::move(fr));
-        NET_TRACE("[NET] Queued HELLO message");
-    }
+    queueHello();
     {
         std::vector<uint8_t> pl;
         {
@@ -1008,9 +1023,18 @@ void Session::handleFrame(const Frame& f) {
     switch (f.type) {
     case MsgType::HELLO: {
         NET_TRACE("[NET] Received HELLO message");
-        std::vector<uint8_t> pl; pl.push_back(1);
-        auto fr = build_frame(MsgType::HELLO_ACK, pl);
-        pushSend(std::move(fr));
+        // 구버전 클라이언트는 version=1 을 보낸다 → FNV 유지. 답하는 HELLO_ACK 의
+        // 버전이 상대에게 전환 지점을 알린다. 같은 잠금 안에서 넣고 바꿔야 그 앞에
+        // 큐에 든 lockstep 프레임이 FNV 로 남는다.
+        const bool word = f.payload.size() >= 2
+            && le_read_u16(f.payload.data()) >= kProtocolVersionWordChecksum;
+        std::vector<uint8_t> pl;
+        pl.push_back(word ? (uint8_t)kProtocolVersionWordChecksum : (uint8_t)1);
+        {
+            std::lock_guard<std::mutex> lk(sendMu);
+            pushSendLocked(build_frame(MsgType::HELLO_ACK, pl));
+            if (word) sendChecksum_ = ChecksumKind::Word32;
+        }
         NET_TRACE("[NET] Queued HELLO_ACK response");
     } break;
     case MsgType::HELLO_ACK: {
@@ -1066,8 +1090,7 @@ void Session::handleFrame(const Frame& f) {
                 }
             }
             std::vector<uint8_t> ack; le_write_u32(ack, lastRemoteTick.load());
-            auto fr = build_frame(MsgType::ACK, ack);
-            pushSend(std::move(fr));
+            pushLockstep(MsgType::ACK, ack);
         }
     } break;
     case MsgType::ACK: {
@@ -1098,8 +1121,7 @@ void Session::handleFrame(const Frame& f) {
     case MsgType::PING: {
         // 상대의 PING 은 즉시 PONG 으로 에코 — io 스레드가 계속 돌고 있으면
         // 메인 스레드가 얼어도(창 드래그 등) 상대는 우리를 살아있다고 판정.
-        std::vector<uint8_t> pong = f.payload; auto fr = build_frame(MsgType::PONG, pong);
-        pushSend(std::move(fr));
+        pushLockstep(MsgType::PONG, f.payload);
     } break;
     case MsgType::PONG: {
         // 최신 PONG 도착 시각 기록 — linkStatus() 가 이 값을 기준으로 판정.
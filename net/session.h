@@ -174,6 +174,9 @@ public:
 private:
     void ioThread();  // I/O 루프 (송수신, 메시지 파싱)
     void handleFrame(const Frame& f);  // 메시지 처리
+    // HELLO(kProtocolVersionWordChecksum) 를 큐에 넣는다. 직접 연결·룸·큐 어느 경로든
+    // 게임 세션으로 들어서며 한 번 보내 lockstep 체크섬을 협상한다.
+    void queueHello();
     void acceptThread(uint16_t port);  // 호스트 전용: 연결 대기
     void queueThread(std::string host, uint16_t port,
                      uint32_t start_tick, uint8_t input_delay,
@@ -242,6 +245,17 @@ private:
     // 전송 큐에 프레임 하나를 넣는다. sendMu 는 이 안에서 잡는다.
     // 상한을 넘으면 프레임을 버리는 대신 연결을 실패 처리한다 — 이유는 .cpp 참고.
     void pushSend(std::vector<uint8_t>&& fr);
+    void pushSendLocked(std::vector<uint8_t>&& fr);   // sendMu 를 잡은 채로 부른다
+    // 매 틱 나가는 프레임(INPUT/HASH/ACK/PING/PONG). sendChecksum_ 으로 만들어 넣는다.
+    void pushLockstep(MsgType type, const std::vector<uint8_t>& payload);
+
+    // 이 세션이 lockstep 프레임에 붙이는 체크섬. sendMu 가 지킨다 — 상대 HELLO 가
+    // kProtocolVersionWordChecksum 이상이면 HELLO_ACK(2) 를 큐에 넣는 그 잠금 안에서
+    // Word32 로 바뀌므로, 상대는 큐 순서대로 HELLO_ACK 뒤부터 Word32 를 받는다.
+    ChecksumKind sendChecksum_ = ChecksumKind::Fnv1a32;
+    // 수신 쪽 짝. ioThread 만 만진다. 상대의 HELLO_ACK(2) 를 본 뒤부터 lockstep
+    // 타입을 Word32 로만 검증한다 — 둘 다 받아 주면 손상 프레임 통과율이 두 배가 된다.
+    RxChecksum rxChecksum_;
 
     std::mutex inMu;
     std::unordered_map<uint32_t, uint8_t> remoteInputs;
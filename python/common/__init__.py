@@ -13,6 +13,7 @@ Colab-training to local-inference boundary:
 - ``env``         — Gymnasium-compatible env so external RL frameworks (CleanRL,
   SB3, LightZero, RLlib) can plug in without bespoke glue
 - ``env_versus`` — two-board garbage environment with scripted/policy opponents
+- ``env_batch``  — N single-player envs stepped natively in one call
 
 The placement action space is fixed at ``COLS * ROTATIONS == 10 * 4 == 40``.
 Pieces with fewer than 4 distinct rotations (O, and the 2-state pieces) still
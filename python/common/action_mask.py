@@ -36,12 +36,12 @@ def legal_mask(sim: "SimGame") -> torch.Tensor:
     """Boolean tensor of shape ``(NUM_PLACEMENTS,)``.
 
     ``True`` at index ``encode_action(col, rot)`` iff that placement is in
-    ``sim.legal_placements()``. The result lives on CPU; move to the policy
+    ``sim.legal_placements()``. The mask is built natively by
+    ``SimGame.legal_mask()`` (the drop-height enumerator), so no Placement
+    objects are created per step. The result lives on CPU; move to the policy
     device at the call site.
     """
     import torch
 
-    mask = torch.zeros(NUM_PLACEMENTS, dtype=torch.bool)
-    for placement in sim.legal_placements():
-        mask[encode_action(placement.col, placement.rot)] = True
+    mask = torch.from_numpy(sim.legal_mask())
     return mask
@@ -0,0 +1,67 @@
+"""Vectorized placement environment backed by the native ``SimGameBatch``.
+
+``TetrisPlacementEnv`` steps one ``SimGame`` per Python call, so a trainer pays
+a pybind round-trip, a legal-mask rebuild and a handful of numpy allocations
+for every placement. ``BatchPlacementEnv`` owns ``num_envs`` games on the C++
+side and steps all of them from a single action array, with the GIL released.
+
+Contract (identical per slot to ``TetrisPlacementEnv``)::
+
+    actions     int32 (N,)           # encode_action(col, rot)
+    board       float32 (N, 1, 20, 10)
+    current     float32 (N, 7)
+    next        float32 (N, 7)
+    legal_mask  bool (N, 40)
+    reward      float32 (N,)         # lines cleared, 0 for an illegal action
+    done        bool (N,)
+
+Finished games reset automatically with a derived seed, so the observation in
+a ``done`` slot is already the first state of the next episode.
+
+The returned arrays are **reused buffers**: the next ``step()`` overwrites
+them in place. Copy anything you want to keep (e.g. into a replay buffer).
+"""
+
+from __future__ import annotations
+
+import numpy as np
+
+from . import BOARD_COLS, BOARD_ROWS, NUM_PIECE_TYPES, NUM_PLACEMENTS
+
+
+class BatchPlacementEnv:
+    """``num_envs`` single-player Tetris games stepped in one native call."""
+
+    def __init__(self, num_envs: int, seed: int = 0) -> None:
+        # env.py 와 같은 이유로 지연 import 한다.
+        from sim import SimGameBatch  # noqa: PLC0415
+
+        self.num_envs = int(num_envs)
+        self._batch = SimGameBatch(self.num_envs, int(seed))
+        n = self.num_envs
+        self.board = np.zeros((n, 1, BOARD_ROWS, BOARD_COLS), dtype=np.float32)
+        self.current = np.zeros((n, NUM_PIECE_TYPES), dtype=np.float32)
+        self.next = np.zeros((n, NUM_PIECE_TYPES), dtype=np.float32)
+        self.legal_mask = np.zeros((n, NUM_PLACEMENTS), dtype=bool)
+        self.reward = np.zeros(n, dtype=np.float32)
+        self.done = np.zeros(n, dtype=bool)
+        self._actions = np.zeros(n, dtype=np.int32)
+
+    def reset(self) -> tuple[dict[str, np.ndarray], np.ndarray]:
+        """Restart every game. Returns ``(obs, legal_mask)``."""
+        self._batch.reset(self.board, self.current, self.next, self.legal_mask)
+        return self._obs(), self.legal_mask
+
+    def step(
+        self, actions: np.ndarray
+    ) -> tuple[dict[str, np.ndarray], np.ndarray, np.ndarray, np.ndarray]:
+        """Step all games. Returns ``(obs, reward, done, legal_mask)``."""
+        np.copyto(self._actions, np.asarray(actions).reshape(self.num_envs), casting="unsafe")
+        self._batch.step(
+            self._actions, self.board, self.current, self.next,
+            self.legal_mask, self.reward, self.done,
+        )
+        return self._obs(), self.reward, self.done, self.legal_mask
+
+    def _obs(self) -> dict[str, np.ndarray]:
+        return {"board": self.board, "current": self.current, "next": self.next}
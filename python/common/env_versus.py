@@ -17,8 +17,8 @@ Design goals:
   win/loss bonus). Extra competitive signals live in ``info`` for wrappers that
   want them.
 * **Self-play ready.** Pass any ``opponent`` — a scripted heuristic
-  (``GreedyBCTSOpponent``, the default), random legal play
-  (``RandomLegalOpponent``), or a snapshot of the current policy via
+  (``GreedyBCTSOpponent``, the default), the native preview-aware beam search
+  (``BeamSearchOpponent``), random legal play (``RandomLegalOpponent``), or a snapshot of the current policy via
   ``PolicyOpponent`` — to train against a frozen copy of yourself.
 
 Action / observation contract (agent side)::
@@ -123,6 +123,29 @@ class GreedyBCTSOpponent(VersusOpponent):
         return best_action
 
 
+class BeamSearchOpponent(VersusOpponent):
+    """Native beam search over the current piece plus the preview queue
+    (``sim.beam_placement``). Noticeably stronger than the one-ply greedy under
+    garbage pressure. ``budget_ms=0`` keeps it deterministic. Pass a shared
+    ``sim.TranspositionTable`` as ``table`` to reuse evaluations across moves."""
+
+    def __init__(self, width: int = 24, depth: int = 4, budget_ms: float = 0.0,
+                 table: Any = None) -> None:
+        self._width = width
+        self._depth = depth
+        self._budget_ms = budget_ms
+        self._table = table
+
+    def act(self, sim: Any) -> Optional[int]:
+        from sim import beam_placement
+
+        move = beam_placement(sim, self._width, self._depth, self._budget_ms, self._table)
+        if move is None:
+            return None
+        col, rot = move
+        return encode_action(int(col), int(rot))
+
+
 class PolicyOpponent(VersusOpponent):
     """Wraps a callable ``policy_fn(obs_dict, legal_mask_np) -> action`` so a
     trained (or snapshot) policy can be the opponent for self-play. The env
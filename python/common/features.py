@@ -18,11 +18,20 @@ The feature set:
 - ``rows_cleared``       : passed in by the caller (it depends on the action)
 - ``wells``              : sum over columns of well depths
 
+Batched versions (``features_batch``, ``bcts_score_batch``) score a whole
+population of boards at once and add the Dellacherie features
+``row_transitions``, ``col_transitions`` and ``covered_cells``. They call the
+native bit-board extractor (``sim.board_features``, bot/board_features.h) when
+``tetris_py`` is built and fall back to vectorized numpy otherwise; both give
+identical integers.
+
 All features operate on the **post-placement** board state.
 """
 
 from __future__ import annotations
 
+from typing import Any
+
 import numpy as np
 
 from . import BOARD_COLS, BOARD_ROWS
@@ -117,3 +126,102 @@ BCTS_WEIGHTS = {
 def bcts_score(board: np.ndarray, rows_cleared: int) -> float:
     feats = all_features(board, rows_cleared)
     return float(sum(BCTS_WEIGHTS[k] * v for k, v in feats.items()))
+
+
+# board_features / features_batch 의 열 순서. C++ bot::BoardFeature 와 같아야 한다.
+FEATURE_NAMES = (
+    "aggregate_height",
+    "max_height",
+    "bumpiness",
+    "holes",
+    "wells",
+    "row_transitions",
+    "col_transitions",
+    "covered_cells",
+)
+
+_native_features: Any = None
+
+
+def _native():
+    """``sim.board_features`` if the native module is built, else ``False``."""
+    global _native_features
+    if _native_features is None:
+        # env.py 와 같은 이유로 지연 import 한다 — tetris_py 없이도 이 모듈은 써야 한다.
+        try:
+            from sim import board_features  # noqa: PLC0415
+            _native_features = board_features
+        except ImportError:
+            _native_features = False
+    return _native_features
+
+
+def _features_batch_numpy(occupied: np.ndarray) -> np.ndarray:
+    """numpy reference for ``features_batch``; ``occupied`` is bool (N, 20, 10)."""
+    n = occupied.shape[0]
+    filled_any = occupied.any(axis=1)
+    heights = np.where(filled_any, BOARD_ROWS - occupied.argmax(axis=1), 0)
+
+    above = np.logical_or.accumulate(occupied, axis=1)
+    hole_cells = above & ~occupied
+    # 자기보다 아래 행에 구멍이 있는 찬 칸. 아래에서 위로 누적한 뒤 한 행 올린다.
+    holes_from_bottom = np.logical_or.accumulate(hole_cells[:, ::-1], axis=1)[:, ::-1]
+    holes_below = np.zeros_like(occupied)
+    holes_below[:, :-1] = holes_from_bottom[:, 1:]
+
+    # 행 전환은 좌우 벽을, 열 전환은 바닥을 찬 칸으로 붙여 센다.
+    walls = np.ones((n, BOARD_ROWS, 1), dtype=bool)
+    rows_padded = np.concatenate([walls, occupied, walls], axis=2)
+    sky = np.zeros((n, 1, BOARD_COLS), dtype=bool)
+    floor = np.ones((n, 1, BOARD_COLS), dtype=bool)
+    cols_padded = np.concatenate([sky, occupied, floor], axis=1)
+
+    border = np.full((n, 1), BOARD_ROWS)
+    padded_h = np.concatenate([border, heights, border], axis=1)
+    depth = np.minimum(padded_h[:, :-2], padded_h[:, 2:]) - heights
+    depth = np.maximum(depth, 0)
+
+    out = np.empty((n, len(FEATURE_NAMES)), dtype=np.int32)
+    out[:, 0] = heights.sum(axis=1)
+    out[:, 1] = heights.max(axis=1)
+    out[:, 2] = np.abs(np.diff(heights, axis=1)).sum(axis=1)
+    out[:, 3] = hole_cells.sum(axis=(1, 2))
+    out[:, 4] = (depth * (depth + 1) // 2).sum(axis=1)
+    out[:, 5] = (rows_padded[:, :, 1:] != rows_padded[:, :, :-1]).sum(axis=(1, 2))
+    out[:, 6] = (cols_padded[:, 1:] != cols_padded[:, :-1]).sum(axis=(1, 2))
+    out[:, 7] = (occupied & holes_below).sum(axis=(1, 2))
+    return out
+
+
+def features_batch(boards: np.ndarray) -> np.ndarray:
+    """Features of N boards at once: int32 (N, 8) in ``FEATURE_NAMES`` order.
+
+    ``boards`` may be shaped (N, 20, 10), (N, 1, 20, 10) or (N, 200); cells
+    ``> 0`` count as filled, so both observations and raw ``grid()`` arrays work.
+    """
+    boards = np.asarray(boards)
+    native = _native()
+    if native:
+        return native(boards)
+    occupied = boards.reshape(boards.shape[0], BOARD_ROWS, BOARD_COLS) > 0
+    return _features_batch_numpy(occupied)
+
+
+def bcts_from_features(features: np.ndarray, rows_cleared: np.ndarray) -> np.ndarray:
+    """``bcts_score`` for rows of ``features_batch`` output. float64 (N,)."""
+    f = np.asarray(features, dtype=np.float64)
+    lines = np.asarray(rows_cleared, dtype=np.float64)
+    # bcts_score 와 같은 순서로 더해야 비트 단위로 같은 값이 나온다.
+    return (
+        BCTS_WEIGHTS["aggregate_height"] * f[:, 0]
+        + BCTS_WEIGHTS["bumpiness"] * f[:, 2]
+        + BCTS_WEIGHTS["holes"] * f[:, 3]
+        + BCTS_WEIGHTS["max_height"] * f[:, 1]
+        + BCTS_WEIGHTS["rows_cleared"] * lines
+        + BCTS_WEIGHTS["wells"] * f[:, 4]
+    )
+
+
+def bcts_score_batch(boards: np.ndarray, rows_cleared: np.ndarray) -> np.ndarray:
+    """Vectorized ``bcts_score`` over N boards. float64 (N,)."""
+    return bcts_from_features(features_batch(boards), rows_cleared)
@@ -1,11 +1,11 @@
 """SimGame -> observation tensor builder.
 
 This module is the **only** Python place that converts a ``SimGame`` snapshot
-into a network input. The C++ in-game bot's ``observe()`` (bot/placement.cpp)
-mirrors this contract. There is not yet a direct Python-vs-C++ observation
-parity test, so schema changes must update both implementations and be checked
-with an ONNX smoke test. Keeping the conversion in one spot per language
-prevents the classic "trained on one format, deployed on another" failure.
+into a network input. The encoding itself is done in C++ by the in-game bot's
+``observe()`` (bot/placement.cpp) through ``SimGame.observe_into``, so training
+and deployment share one implementation and are bit-identical by construction.
+Schema changes go in ``bot::observe`` only; ``python/tests/test_observe_into.py`` pins
+the result against the reference formula below.
 
 The schema:
 
@@ -38,16 +38,15 @@ def build_observation(sim: "SimGame") -> dict[str, torch.Tensor]:
 
     Returns un-batched tensors. Add a leading batch dim with ``unsqueeze(0)``
     before passing to the network — done at the call site so that batched
-    rollouts and single-step inference share this builder.
+    rollouts and single-step inference share this builder. Hot loops that
+    keep their own buffers should call ``sim.observe_into`` directly.
     """
     import torch
 
-    raw = np.asarray(sim.grid(), dtype=np.float32)  # (20, 10)
-    occupied = ((raw > 0) & (raw != 8)).astype(np.float32)
-    board = occupied[None, :, :]  # (1, 20, 10)
-
-    current = _piece_one_hot(sim.current_block_id())
-    nxt = _piece_one_hot(sim.next_block_id())
+    board = np.empty((1, 20, 10), dtype=np.float32)
+    current = np.empty(NUM_PIECE_TYPES, dtype=np.float32)
+    nxt = np.empty(NUM_PIECE_TYPES, dtype=np.float32)
+    sim.observe_into(board, current, nxt)
 
     return {
         "board": torch.from_numpy(board),
@@ -56,6 +55,21 @@ def build_observation(sim: "SimGame") -> dict[str, torch.Tensor]:
     }
 
 
+def reference_observation(sim: "SimGame") -> dict[str, np.ndarray]:
+    """Pure-numpy statement of the schema above, for parity tests only.
+
+    Slow (copies the grid and allocates per call); ``observe_into`` must
+    match it exactly.
+    """
+    raw = np.asarray(sim.grid(), dtype=np.float32)  # (20, 10)
+    occupied = ((raw > 0) & (raw != 8)).astype(np.float32)
+    return {
+        "board": occupied[None, :, :],  # (1, 20, 10)
+        "current": _piece_one_hot(sim.current_block_id()),
+        "next": _piece_one_hot(sim.next_block_id()),
+    }
+
+
 def _piece_one_hot(piece_id: int) -> np.ndarray:
     """One-hot encode a piece id (1..7) into a length-7 float32 vector."""
     out = np.zeros(NUM_PIECE_TYPES, dtype=np.float32)
@@ -40,13 +40,16 @@ INPUT_NAMES = ["board", "current", "next"]
 OUTPUT_NAMES = ["policy_logits", "value"]
 
 
-def export(ckpt_path: str | Path, out_path: str | Path, opset: int = 17) -> None:
+def export(
+    ckpt_path: str | Path, out_path: str | Path, opset: int = 17, dynamic_batch: bool = True
+) -> None:
     """Load ``ckpt_path`` (a TetrisPolicyNet .pt) and write an ONNX graph to
     ``out_path``.
 
-    Batch size is fixed at 1 — the C++ netbot only ever runs single-step
-    inference on one SimGame at a time. If a training-side consumer ever needs
-    batched ONNX inference, add ``dynamic_axes={"board": {0: "batch"}, ...}``.
+    With ``dynamic_batch`` (the default) the leading dimension of every input
+    and output is a symbolic ``batch``, so ``bot/inference_server.h`` can run
+    many boards in one session call; batch-1 calls from the client still work.
+    ``dynamic_batch=False`` pins it to 1 like older exports.
     """
     ckpt_path = Path(ckpt_path)
     out_path = Path(out_path)
@@ -67,7 +70,9 @@ def export(ckpt_path: str | Path, out_path: str | Path, opset: int = 17) -> None
         "input_names": INPUT_NAMES,
         "output_names": OUTPUT_NAMES,
         "opset_version": opset,
-        "dynamic_axes": None,
+        "dynamic_axes": {name: {0: "batch"} for name in INPUT_NAMES + OUTPUT_NAMES}
+        if dynamic_batch
+        else None,
         "do_constant_folding": True,
     }
     if "dynamo" in inspect.signature(torch.onnx.export).parameters:
@@ -106,8 +111,13 @@ def main() -> None:
     ap.add_argument("ckpt", help="path to trained .pt checkpoint (TetrisPolicyNet)")
     ap.add_argument("out",  help="output .onnx path (e.g. ../model/bots/run42.onnx)")
     ap.add_argument("--opset", type=int, default=17, help="ONNX opset (default: 17)")
+    ap.add_argument(
+        "--static-batch",
+        action="store_true",
+        help="pin the batch dimension to 1 (older runtimes); default is a dynamic batch",
+    )
     args = ap.parse_args()
-    export(args.ckpt, args.out, args.opset)
+    export(args.ckpt, args.out, args.opset, dynamic_batch=not args.static_batch)
 
 
 if __name__ == "__main__":
@@ -5,15 +5,22 @@ Frame layout (matches the C++ implementation byte-for-byte)::
     [LEN: u16 LE][TYPE: u8][PAYLOAD: LEN-1 bytes][CHECKSUM: u32 LE]
 
 - ``LEN``      = 1 + len(PAYLOAD) (i.e. it counts the TYPE byte)
-- ``CHECKSUM`` = FNV-1a 32-bit over the PAYLOAD bytes only (NOT over LEN/TYPE).
+- ``CHECKSUM`` = a 32-bit hash over the PAYLOAD bytes only (NOT over LEN/TYPE),
+  either FNV-1a 32 (:attr:`ChecksumKind.FNV1A32`, the original contract) or the
+  word-wise :func:`hash32_words` (:attr:`ChecksumKind.WORD32`). The frame does
+  not say which; each session checks exactly one. Lockstep types switch to
+  WORD32 right after a HELLO_ACK carrying :data:`PROTOCOL_VERSION_WORD_CHECKSUM`
+  (:class:`RxChecksum` tracks this on the receive side); everything else stays
+  FNV — see ``net::ChecksumKind`` in ``net/framing.h``.
   When the payload is empty the checksum is 0 (matches the C++ short-circuit).
 
 This module exposes:
 
 - :data:`MsgType` enum mirroring ``net::MsgType``
-- :func:`build_frame` for serialisation
+- :func:`build_frame` for serialisation (FNV unless told otherwise)
 - :func:`parse_frames` for stream parsing — operates on a ``bytearray`` and
   trims consumed bytes in place, just like the C++ ``erase`` does
+- :class:`RxChecksum` — 한 연결의 수신 체크섬 상태 (``net::RxChecksum`` 미러)
 - :class:`FramingError` — 오버사이즈 길이 선언 등 스트림을 오염시키는 위반.
   C++ 의 ``parse_frames`` return false 에 대응하며, 받은 호출자는 연결을
   닫아야 한다.
@@ -43,6 +50,17 @@ MIN_FRAME_BYTES = LEN_FIELD_BYTES + TYPE_FIELD_BYTES + CHECKSUM_FIELD_BYTES  # 7
 # body를 기다리며 수신 버퍼를 키우지 않게 하는 wire 보안 경계다.
 MAX_PAYLOAD_BYTES = 4096
 
+# HELLO 페이로드 [version:2 LE] — net::kProtocolVersion* 미러.
+PROTOCOL_VERSION_FNV_ONLY = 1
+PROTOCOL_VERSION_WORD_CHECKSUM = 2
+
+_U64 = 0xFFFFFFFFFFFFFFFF
+_P1 = 0x9E3779B185EBCA87
+_P2 = 0xC2B2AE3D27D4EB4F
+_P3 = 0x165667B19E3779F9
+_P4 = 0x85EBCA77C2B2AE63
+_P5 = 0x27D4EB2F165667C5
+
 
 class FramingError(Exception):
     """스트림 자체를 오염시키는 프레이밍 위반 (오버사이즈 길이 선언).
@@ -62,6 +80,13 @@ class FramingError(Exception):
         self.frames: list[tuple[MsgType, bytes]] = frames if frames is not None else []
 
 
+class ChecksumKind(enum.IntEnum):
+    """프레임 CHECKSUM 알고리즘 — ``net::ChecksumKind`` 미러. 값은 wire 규약."""
+
+    FNV1A32 = 0
+    WORD32 = 1
+
+
 class MsgType(enum.IntEnum):
     HELLO = 1
     HELLO_ACK = 2
@@ -139,6 +164,118 @@ def fnv1a32(data: bytes, seed: int = FNV1A32_OFFSET) -> int:
     return h
 
 
+def _rotl64(x: int, r: int) -> int:
+    return ((x << r) | (x >> (64 - r))) & _U64
+
+
+def _round64(acc: int, value: int) -> int:
+    acc = (acc + value * _P2) & _U64
+    return (_rotl64(acc, 31) * _P1) & _U64
+
+
+def hash64_words(data: bytes, seed: int = 0) -> int:
+    """Word-wise 64-bit hash. Identical bit pattern to ``hash64_words`` in core/hash.h.
+
+    Python 쪽은 속도 이점이 없다 — C++ 과 같은 값을 내기 위한 포팅일 뿐이다.
+    """
+    n = len(data)
+    p = 0
+    if n >= 32:
+        v1 = (seed + _P1 + _P2) & _U64
+        v2 = (seed + _P2) & _U64
+        v3 = seed & _U64
+        v4 = (seed - _P1) & _U64
+        while n - p >= 32:
+            a, b, c, d = struct.unpack_from("<QQQQ", data, p)
+            v1 = _round64(v1, a)
+            v2 = _round64(v2, b)
+            v3 = _round64(v3, c)
+            v4 = _round64(v4, d)
+            p += 32
+        h = (_rotl64(v1, 1) + _rotl64(v2, 7) + _rotl64(v3, 12) + _rotl64(v4, 18)) & _U64
+        for v in (v1, v2, v3, v4):
+            h = ((h ^ _round64(0, v)) * _P1 + _P4) & _U64
+    else:
+        h = (seed + _P5) & _U64
+    h = (h + n) & _U64
+
+    while n - p >= 8:
+        (word,) = struct.unpack_from("<Q", data, p)
+        h ^= _round64(0, word)
+        h = (_rotl64(h, 27) * _P1 + _P4) & _U64
+        p += 8
+    if p < n:
+        tail = int.from_bytes(data[p:], "little")
+        h ^= (tail * _P5) & _U64
+        h = (_rotl64(h, 11) * _P1) & _U64
+
+    h ^= h >> 33
+    h = (h * _P2) & _U64
+    h ^= h >> 29
+    h = (h * _P3) & _U64
+    h ^= h >> 32
+    return h
+
+
+def hash32_words(data: bytes, seed: int = 0) -> int:
+    """32-bit fold of :func:`hash64_words` — the ``WORD32`` frame checksum."""
+    h = hash64_words(data, seed)
+    return (h ^ (h >> 32)) & FNV1A32_MASK
+
+
+def frame_checksum(kind: ChecksumKind | int, payload: bytes) -> int:
+    """CHECKSUM field value for ``payload`` — ``net::frame_checksum`` 미러."""
+    if not payload:
+        return 0
+    if ChecksumKind(kind) == ChecksumKind.WORD32:
+        return hash32_words(payload)
+    return fnv1a32(payload)
+
+
+def checksum_matches(payload: bytes, chk: int,
+                     kind: ChecksumKind | int = ChecksumKind.FNV1A32) -> bool:
+    """``chk`` is the ``kind`` checksum of ``payload`` — ``net::checksum_matches`` 미러."""
+    return chk == frame_checksum(kind, payload)
+
+
+# 협상 뒤 WORD32 로 오가는 타입 — ``net::is_lockstep_type`` 미러.
+LOCKSTEP_TYPES = frozenset({
+    MsgType.INPUT,
+    MsgType.HASH,
+    MsgType.ACK,
+    MsgType.PING,
+    MsgType.PONG,
+})
+
+
+def is_lockstep_type(msg_type: MsgType | int) -> bool:
+    return int(msg_type) in LOCKSTEP_TYPES
+
+
+class RxChecksum:
+    """수신 방향 하나의 체크섬 상태 — ``net::RxChecksum`` 미러.
+
+    상대의 HELLO_ACK version 이 :data:`PROTOCOL_VERSION_WORD_CHECKSUM` 이상이면
+    그 뒤의 락스텝 타입을 WORD32 로만 검사한다. 되돌아가지 않는다.
+    """
+
+    def __init__(self) -> None:
+        self.word = False
+
+    def expected(self, msg_type: int) -> ChecksumKind:
+        if self.word and is_lockstep_type(msg_type):
+            return ChecksumKind.WORD32
+        return ChecksumKind.FNV1A32
+
+    def observe(self, msg_type: int, payload: bytes) -> None:
+        if (msg_type == MsgType.HELLO_ACK and payload
+                and payload[0] >= PROTOCOL_VERSION_WORD_CHECKSUM):
+            self.word = True
+
+    def reset(self) -> None:
+        self.word = False
+
+
 # --- little-endian 읽기/쓰기 ---
 
 def le_write_u16(buf: bytearray, value: int) -> None:
@@ -167,11 +304,13 @@ def le_read_u64(data: bytes, offset: int = 0) -> int:
 
 # --- 프레임 만들기와 뜯기 ---
 
-def build_frame(msg_type: MsgType | int, payload: bytes | bytearray) -> bytes:
+def build_frame(msg_type: MsgType | int, payload: bytes | bytearray,
+                kind: ChecksumKind | int = ChecksumKind.FNV1A32) -> bytes:
     """Serialise ``(msg_type, payload)`` into the wire format.
 
     The result is exactly what ``net::build_frame`` produces in C++ — bytewise
-    identical, including the empty-payload checksum=0 short-circuit.
+    identical, including the empty-payload checksum=0 short-circuit. Leave
+    ``kind`` at FNV unless the peer's HELLO announced WORD32 support.
     """
     payload_bytes = bytes(payload)
     if len(payload_bytes) > MAX_PAYLOAD_BYTES:
@@ -183,17 +322,19 @@ def build_frame(msg_type: MsgType | int, payload: bytes | bytearray) -> bytes:
     le_write_u16(out, length)
     out.append(int(msg_type) & 0xFF)
     out += payload_bytes
-    checksum = 0 if not payload_bytes else fnv1a32(payload_bytes)
-    le_write_u32(out, checksum)
+    le_write_u32(out, frame_checksum(kind, payload_bytes))
     return bytes(out)
 
 
-def parse_frames(stream_buf: bytearray) -> list[tuple[MsgType, bytes]]:
+def parse_frames(stream_buf: bytearray,
+                 rx: RxChecksum | None = None) -> list[tuple[MsgType, bytes]]:
     """Pull all complete frames out of ``stream_buf`` and return them.
 
     Bytes belonging to fully-parsed frames are removed from ``stream_buf`` in
-    place — partial frames at the end are left for the next call. Frames whose
-    checksum doesn't match are silently dropped (same behaviour as the C++
+    place — partial frames at the end are left for the next call. Without
+    ``rx`` every frame is checked as FNV; with it, the session's negotiated
+    kind is used (and updated as HELLO_ACK frames go by). Frames whose checksum
+    does not match are silently dropped (same behaviour as the C++
     parser, which keeps the lockstep loop forgiving rather than fatal).
 
     Raises:
@@ -245,9 +386,10 @@ def parse_frames(stream_buf: bytearray) -> list[tuple[MsgType, bytes]]:
 
         chk_pos = offset + LEN_FIELD_BYTES + length
         chk = le_read_u32(stream_buf, chk_pos)
-        calc = 0 if payload_len == 0 else fnv1a32(payload)
-
-        if chk == calc:
+        kind = rx.expected(msg_type_byte) if rx is not None else ChecksumKind.FNV1A32
+        if checksum_matches(payload, chk, kind):
+            if rx is not None:
+                rx.observe(msg_type_byte, payload)
             try:
                 msg_type = MsgType(msg_type_byte)
             except ValueError:
@@ -39,7 +39,10 @@ if str(_HERE) not in sys.path:
     sys.path.insert(0, str(_HERE))
 
 try:
-    from tetris_py import SimGame, Placement, SimBlock  # type: ignore
+    from tetris_py import (  # type: ignore
+        SimGame, SimGameBatch, Placement, SimBlock, observe_batch, beam_placement, TranspositionTable,
+        mcts_search, board_features, bcts_scores, FEATURE_NAMES,
+    )
 except ImportError as exc:  # pragma: no cover - environment failure path
     raise ImportError(
         "Could not import the native 'tetris_py' module.\n\n"
@@ -51,4 +54,7 @@ except ImportError as exc:  # pragma: no cover - environment failure path
     ) from exc
 
 
-__all__ = ["SimGame", "Placement", "SimBlock"]
+__all__ = [
+    "SimGame", "SimGameBatch", "Placement", "SimBlock", "observe_batch", "beam_placement",
+    "TranspositionTable", "mcts_search", "board_features", "bcts_scores", "FEATURE_NAMES",
+]
@@ -0,0 +1,84 @@
+"""Batched board features (``common.features.features_batch``).
+
+The numpy fallback must agree with the per-board reference functions in
+``common.features``; the native ``sim.board_features`` (bot/board_features.h)
+must agree with the numpy fallback and with ``SimGame.afterstate_features``.
+The native half is skipped if ``tetris_py`` is unavailable.
+"""
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+from common import features as F
+
+
+def _random_boards(n: int, seed: int) -> np.ndarray:
+    """Boards that get denser toward the bottom, with holes and overhangs."""
+    rng = np.random.default_rng(seed)
+    density = np.linspace(0.0, 0.9, 20)[None, :, None]
+    boards = (rng.random((n, 20, 10)) < density).astype(np.float32)
+    boards[0] = 0.0
+    boards[1] = 1.0
+    return boards
+
+
+def test_numpy_batch_matches_reference_features():
+    boards = _random_boards(200, seed=3)
+    lines = np.arange(200) % 5
+    feats = F._features_batch_numpy(boards > 0)
+    assert feats.shape == (200, len(F.FEATURE_NAMES)) and feats.dtype == np.int32
+    for i in range(len(boards)):
+        ref = F.all_features(boards[i], int(lines[i]))
+        for name in ("aggregate_height", "bumpiness", "holes", "max_height", "wells"):
+            assert feats[i, F.FEATURE_NAMES.index(name)] == ref[name], (i, name)
+    scores = F.bcts_from_features(feats, lines)
+    expected = [F.bcts_score(boards[i], int(lines[i])) for i in range(len(boards))]
+    assert np.array_equal(scores, np.asarray(expected))
+
+
+def test_transition_and_covered_edges():
+    empty = np.zeros((1, 20, 10), dtype=bool)
+    f = F._features_batch_numpy(empty)[0]
+    assert f[F.FEATURE_NAMES.index("row_transitions")] == 40   # 벽-빈칸, 빈칸-벽 x 20행
+    assert f[F.FEATURE_NAMES.index("col_transitions")] == 10   # 바닥만
+    covered = np.zeros((1, 20, 10), dtype=bool)
+    covered[0, 15:18, 4] = True                                 # 3칸 아래 19, 18행이 비었다
+    f = F._features_batch_numpy(covered)[0]
+    assert f[F.FEATURE_NAMES.index("holes")] == 2
+    assert f[F.FEATURE_NAMES.index("covered_cells")] == 3
+
+
+def test_native_matches_numpy():
+    sim_mod = pytest.importorskip("sim")
+    assert tuple(sim_mod.FEATURE_NAMES) == F.FEATURE_NAMES
+    boards = _random_boards(300, seed=11)
+    expected = F._features_batch_numpy(boards > 0)
+    assert np.array_equal(sim_mod.board_features(boards), expected)
+    assert np.array_equal(sim_mod.board_features(boards.reshape(300, 1, 20, 10)), expected)
+    lines = (np.arange(300) % 5).astype(np.int32)
+    assert np.allclose(sim_mod.bcts_scores(boards, lines), F.bcts_from_features(expected, lines))
+    with pytest.raises(ValueError):
+        sim_mod.board_features(np.zeros((4, 19, 10), dtype=np.float32))
+
+
+def test_afterstate_features_match_played_children():
+    sim_mod = pytest.importorskip("sim")
+    g = sim_mod.SimGame(21)
+    rng = np.random.default_rng(21)
+    for _ in range(30):
+        after = g.afterstate_features()
+        placements = g.enumerate_placements()
+        assert len(after["actions"]) == len(placements)
+        for k, (col, rot, _row) in enumerate(placements):
+            child = g.clone()
+            cleared = child.apply_placement(int(col), int(rot))
+            assert after["actions"][k] == col * 4 + rot
+            assert after["cleared"][k] == cleared
+            assert bool(after["game_over"][k]) == child.game_over()
+            grid = child.grid()[None]
+            assert np.array_equal(after["features"][k], F._features_batch_numpy((grid > 0) & (grid != 8))[0])
+        col, rot, _row = placements[rng.integers(len(placements))]
+        g.apply_placement(int(col), int(rot))
+        if g.game_over():
+            break
@@ -19,10 +19,16 @@ import pytest
 from netbot.framing import (
     FNV1A32_OFFSET,
     MAX_PAYLOAD_BYTES,
+    PROTOCOL_VERSION_FNV_ONLY,
+    PROTOCOL_VERSION_WORD_CHECKSUM,
+    ChecksumKind,
     FramingError,
     MsgType,
+    RxChecksum,
     build_frame,
     fnv1a32,
+    hash32_words,
+    hash64_words,
     parse_frames,
 )
 
@@ -44,6 +50,32 @@ def test_fnv1a32_known_values(data: bytes, expected: int) -> None:
     assert fnv1a32(data) == expected
 
 
+# ---- Word-wise hash known answers ------------------------------------------
+# Captured from core/hash.h (hash32_words / hash64_words, seed=0). The 7-byte
+# case is an INPUT payload (tick=42, count=1, mask=0x10), 40 bytes exercises
+# the 4-lane loop plus the word and tail steps, 800 bytes is grid-sized.
+@pytest.mark.parametrize(
+    "data, expected32, expected64",
+    [
+        (b"", 0xBE9E32AE, 0xEF46DB3751D8E999),
+        (b"a", 0x7BC2AAAA, 0xD24EC4F1A98C6E5B),
+        (b"foobar", 0xCC2CF5C3, 0x77FE26D3BBD2D310),
+        (struct.pack("<IHB", 42, 1, 0x10), 0xB9D25618, 0xC1E4737078362568),
+        (bytes(range(40)), 0x44CD0118, 0xF5DA40F1B11741E9),
+        (bytes((i * 7 + 3) & 0xFF for i in range(800)), 0xF778B150, 0xD26A963625122766),
+    ],
+)
+def test_hash_words_known_values(data: bytes, expected32: int, expected64: int) -> None:
+    assert hash64_words(data) == expected64
+    assert hash32_words(data) == expected32
+
+
+def test_protocol_version_and_checksum_kind_values() -> None:
+    assert PROTOCOL_VERSION_WORD_CHECKSUM == 2
+    assert int(ChecksumKind.FNV1A32) == 0
+    assert int(ChecksumKind.WORD32) == 1
+
+
 # ---- Frame round-trip ------------------------------------------------------
 def test_build_frame_empty_payload() -> None:
     frame = build_frame(MsgType.HELLO_ACK, b"")
@@ -105,6 +137,44 @@ def test_parse_frames_drops_bad_checksum() -> None:
     assert len(frame) == 0
 
 
+def test_parse_frames_checks_only_negotiated_checksum() -> None:
+    payload = struct.pack("<IHB", 7, 1, 0b101)
+    fnv = build_frame(MsgType.INPUT, payload)
+    word = build_frame(MsgType.INPUT, payload, ChecksumKind.WORD32)
+    assert fnv[:-4] == word[:-4]
+    assert struct.unpack_from("<I", word, len(word) - 4)[0] == hash32_words(payload)
+    # 협상 상태가 없으면 FNV 만 받는다.
+    stream = bytearray(fnv + word)
+    assert parse_frames(stream) == [(MsgType.INPUT, payload)]
+    assert len(stream) == 0
+
+    # HELLO_ACK(2) 뒤로는 락스텝 타입이 WORD32 로만 통과한다. 그 앞의 FNV 는 그대로.
+    rx = RxChecksum()
+    ack = build_frame(MsgType.HELLO_ACK, bytes([PROTOCOL_VERSION_WORD_CHECKSUM]))
+    stream = bytearray(fnv + ack + fnv + word)
+    assert parse_frames(stream, rx) == [
+        (MsgType.INPUT, payload),
+        (MsgType.HELLO_ACK, bytes([PROTOCOL_VERSION_WORD_CHECKSUM])),
+        (MsgType.INPUT, payload),
+    ]
+    # 락스텝이 아닌 타입은 계속 FNV.
+    chat = b"\x02\x00hi"
+    stream = bytearray(build_frame(MsgType.CHAT, chat)
+                       + build_frame(MsgType.CHAT, chat, ChecksumKind.WORD32))
+    assert parse_frames(stream, rx) == [(MsgType.CHAT, chat)]
+
+    # 구버전 HELLO_ACK(1) 은 전환하지 않는다.
+    old = RxChecksum()
+    stream = bytearray(build_frame(MsgType.HELLO_ACK, bytes([PROTOCOL_VERSION_FNV_ONLY])) + word + fnv)
+    assert parse_frames(stream, old) == [
+        (MsgType.HELLO_ACK, bytes([PROTOCOL_VERSION_FNV_ONLY])),
+        (MsgType.INPUT, payload),
+    ]
+    assert not old.word
+    # 빈 페이로드는 알고리즘과 무관하게 0 이다.
+    assert build_frame(MsgType.PING, b"", ChecksumKind.WORD32) == build_frame(MsgType.PING, b"")
+
+
 def test_parse_frames_drops_malformed_zero_length_frame() -> None:
     # LEN=0 has no TYPE byte. C++ consumes that complete malformed frame and
     # keeps parsing later bytes; Python should match that forgiving behavior.
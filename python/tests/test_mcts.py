@@ -0,0 +1,61 @@
+"""``sim.mcts_search`` — the native placement MCTS from Python.
+
+The C++ side is covered by tests/mcts_test.cpp; this pins the Python surface:
+the result dict, the heuristic default, and a Python callable as the leaf
+evaluator (batched, GIL re-acquired from the search threads).
+Skipped if the native ``tetris_py`` module is unavailable.
+"""
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+sim_mod = pytest.importorskip("sim")
+
+
+def _legal_actions(sim):
+    return {int(p.col) * 4 + int(p.rot) for p in sim.legal_placements()}
+
+
+def test_heuristic_search_visits_only_legal_moves():
+    sim = sim_mod.SimGame(5)
+    res = sim_mod.mcts_search(sim, simulations=120, leaf_batch=1)
+    visits = res["visits"]
+    assert visits.shape == (40,) and visits.dtype == np.float32
+    assert res["simulations"] == 120 and visits.sum() == 120
+    legal = _legal_actions(sim)
+    assert res["action"] in legal
+    assert all(a in legal for a in np.nonzero(visits)[0])
+
+
+def test_single_thread_is_deterministic():
+    sim = sim_mod.SimGame(9)
+    kw = dict(simulations=80, leaf_batch=1, dirichlet_alpha=0.3, seed=4)
+    a = sim_mod.mcts_search(sim, **kw)
+    b = sim_mod.mcts_search(sim, **kw)
+    assert a["action"] == b["action"]
+    assert np.array_equal(a["visits"], b["visits"])
+
+
+def test_python_evaluator_is_batched():
+    batches = []
+
+    def evaluate(sims):
+        batches.append(len(sims))
+        assert all(isinstance(s, sim_mod.SimGame) for s in sims)
+        return np.zeros((len(sims), 40), np.float32), np.zeros(len(sims), np.float32)
+
+    sim = sim_mod.SimGame(3)
+    res = sim_mod.mcts_search(sim, evaluator=evaluate, simulations=64,
+                              threads=2, leaf_batch=4)
+    assert res["action"] in _legal_actions(sim)
+    assert res["simulations"] >= 64
+    assert max(batches) <= 4 and max(batches) > 1
+
+
+def test_python_evaluator_error_propagates():
+    def broken(sims):
+        raise RuntimeError("boom")
+
+    with pytest.raises(RuntimeError, match="boom"):
+        sim_mod.mcts_search(sim_mod.SimGame(1), evaluator=broken, simulations=16)
@@ -0,0 +1,65 @@
+"""``SimGame.observe_into`` / ``observe_batch`` must reproduce the documented
+observation schema (``common.obs.reference_observation``) bit for bit, and
+must write into the caller's buffers rather than a converted copy.
+Skipped if the native ``tetris_py`` module is unavailable.
+"""
+from __future__ import annotations
+
+import numpy as np
+import pytest
+
+sim_mod = pytest.importorskip("sim")
+
+from common.obs import reference_observation  # noqa: E402
+
+
+def _play(seed: int, steps: int):
+    """Yield a sim after each of ``steps`` random legal placements."""
+    g = sim_mod.SimGame(seed)
+    rng = np.random.default_rng(seed)
+    for _ in range(steps):
+        if g.game_over():
+            break
+        yield g
+        placements = g.enumerate_placements()
+        col, rot, _ = placements[rng.integers(len(placements))]
+        g.apply_placement(int(col), int(rot))
+        g.add_pending_garbage(int(rng.integers(0, 2)))
+
+
+def test_observe_into_matches_reference():
+    board = np.full((1, 20, 10), -1.0, dtype=np.float32)
+    current = np.full(7, -1.0, dtype=np.float32)
+    nxt = np.full(7, -1.0, dtype=np.float32)
+    for g in _play(seed=11, steps=120):
+        ref = reference_observation(g)
+        g.observe_into(board, current, nxt)
+        assert np.array_equal(board, ref["board"])
+        assert np.array_equal(current, ref["current"])
+        assert np.array_equal(nxt, ref["next"])
+
+
+def test_observe_batch_matches_single():
+    games = [sim_mod.SimGame(s) for s in (1, 2, 3)]
+    for g in games[1:]:
+        for _ in range(5):
+            p = g.legal_placements()[0]
+            g.apply_placement(p.col, p.rot)
+    board = np.zeros((3, 1, 20, 10), dtype=np.float32)
+    current = np.zeros((3, 7), dtype=np.float32)
+    nxt = np.zeros((3, 7), dtype=np.float32)
+    sim_mod.observe_batch(games, board, current, nxt)
+    for i, g in enumerate(games):
+        ref = reference_observation(g)
+        assert np.array_equal(board[i], ref["board"])
+        assert np.array_equal(current[i], ref["current"])
+        assert np.array_equal(nxt[i], ref["next"])
+
+
+def test_observe_into_rejects_wrong_buffers():
+    g = sim_mod.SimGame(5)
+    ok7 = np.zeros(7, dtype=np.float32)
+    with pytest.raises(TypeError):  # float64 would be silently copied
+        g.observe_into(np.zeros((1, 20, 10)), ok7, ok7)
+    with pytest.raises(ValueError):
+        g.observe_into(np.zeros(199, dtype=np.float32), ok7, ok7)
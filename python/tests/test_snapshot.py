@@ -0,0 +1,65 @@
+"""``SimGame.snapshot`` / ``restore`` must round-trip the full sim state.
+
+The C++ side is covered by tests/snapshot_test.cpp; this pins the Python
+surface (bytes in/out, pickling, ValueError on bad blobs).
+Skipped if the native ``tetris_py`` module is unavailable.
+"""
+from __future__ import annotations
+
+import pickle
+
+import numpy as np
+import pytest
+
+sim_mod = pytest.importorskip("sim")
+
+
+def _played(seed: int, steps: int):
+    g = sim_mod.SimGame(seed)
+    rng = np.random.default_rng(seed)
+    for _ in range(steps):
+        if g.game_over():
+            break
+        placements = g.enumerate_placements()
+        col, rot, _ = placements[rng.integers(len(placements))]
+        g.apply_placement(int(col), int(rot))
+        g.add_pending_garbage(int(rng.integers(0, 2)))
+    return g
+
+
+@pytest.mark.parametrize("seed", [1, 7, 42])
+def test_snapshot_round_trip(seed: int) -> None:
+    g = _played(seed, 60)
+    blob = g.snapshot()
+    assert isinstance(blob, bytes)
+    assert len(blob) == sim_mod.SimGame.SNAPSHOT_BYTES <= 128
+
+    other = sim_mod.SimGame(seed + 1000)
+    other.restore(blob)
+    assert other.state_hash() == g.state_hash()
+    assert sim_mod.SimGame.from_snapshot(blob).state_hash() == g.state_hash()
+
+    # 같은 수를 두면 이후에도 같다 (가방/RNG 까지 복원됐는지).
+    for _ in range(20):
+        if g.game_over():
+            break
+        col, rot, _ = g.enumerate_placements()[0]
+        g.apply_placement(int(col), int(rot))
+        other.apply_placement(int(col), int(rot))
+        assert other.state_hash() == g.state_hash()
+
+
+def test_snapshot_pickles() -> None:
+    g = _played(3, 40)
+    clone = pickle.loads(pickle.dumps(g))
+    assert clone.state_hash() == g.state_hash()
+
+
+def test_restore_rejects_bad_blobs() -> None:
+    g = _played(5, 10)
+    before = g.state_hash()
+    with pytest.raises(ValueError):
+        g.restore(b"\x00" * 10)
+    with pytest.raises(ValueError):
+        g.restore(b"\x00" * sim_mod.SimGame.SNAPSHOT_BYTES)  # version 0
+    assert g.state_hash() == before
@@ -14,6 +14,7 @@ pytest.importorskip("gymnasium")
 
 from common.action_mask import decode_action  # noqa: E402
 from common.env_versus import (  # noqa: E402
+    BeamSearchOpponent,
     GreedyBCTSOpponent,
     RandomLegalOpponent,
     TetrisVersusEnv,
@@ -136,3 +137,31 @@ def test_env_attack_routes_to_opponent():
             break
     assert total_agent_attack > 0, "fixture must send attack (non-vacuous regression)"
     assert total_opp_garbage_received == total_agent_attack
+
+
+def test_beam_opponent_returns_legal_action():
+    """The native beam search picks a legal placement and is deterministic
+    without a time budget."""
+    sim = sim_mod.SimGame(17)
+    opp = BeamSearchOpponent(width=8, depth=4)
+    action = opp.act(sim)
+    assert action is not None
+    legal = {(int(p.col), int(p.rot)) for p in sim.legal_placements()}
+    assert decode_action(action) in legal
+    assert opp.act(sim) == action
+
+
+def test_beam_opponent_with_table_matches_plain():
+    """A shared transposition table changes speed, not the chosen move."""
+    table = sim_mod.TranspositionTable(1)
+    plain = BeamSearchOpponent(width=8, depth=4)
+    cached = BeamSearchOpponent(width=8, depth=4, table=table)
+    sim = sim_mod.SimGame(23)
+    for _ in range(10):
+        action = plain.act(sim)
+        assert cached.act(sim) == action
+        col, rot = decode_action(action)
+        sim.apply_placement(col, rot)
+    stats = table.stats()
+    assert stats["probes"] > 0 and stats["hits"] > 0
+    assert 0.0 < stats["hit_rate"] <= 1.0
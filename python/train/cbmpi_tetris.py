@@ -38,7 +38,7 @@ from common import BOARD_COLS, BOARD_ROWS
 from common.action_mask import encode_action
 from common.checkpoint import load_checkpoint, save_checkpoint
 from common.env import TetrisPlacementEnv
-from common.features import bcts_score
+from common.features import bcts_from_features, bcts_score
 from common.models import TetrisPolicyNet
 from common.obs import build_observation
 
@@ -83,6 +83,17 @@ def improve_action(
     line_weight: float,
 ) -> tuple[int, float]:
     """Return the best legal action and its scalar improvement score."""
+    if value_weight == 0.0 and hasattr(sim, "afterstate_features"):
+        # 가치 bootstrap 이 없으면 신경망을 부를 일이 없으니, 모든 합법 수의 afterstate
+        # 특징을 C++ 에서 한 번에 받아 numpy 로 점수화한다(수마다 clone·관측 변환 없음).
+        after = sim.afterstate_features()
+        if len(after["actions"]) == 0:
+            raise RuntimeError("Cannot improve an all-terminal/no-legal state.")
+        cleared = after["cleared"].astype(np.float64)
+        scores = line_weight * cleared + bcts_coef * bcts_from_features(after["features"], cleared)
+        best = int(np.argmax(scores))  # 동점이면 legal_placements 순서의 앞쪽(아래 루프와 같다)
+        return int(after["actions"][best]), float(scores[best])
+
     placements = sim.legal_placements()
     if not placements:
         raise RuntimeError("Cannot improve an all-terminal/no-legal state.")
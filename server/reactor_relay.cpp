@@ -1396,9 +1396,7 @@ private:
             }
             const size_t payload_len = (size_t)len - 1u;
             const uint32_t chk  = net::le_read_u32(c->rx.data() + 2u + len);
-            const uint32_t calc = payload_len == 0 ? 0u
-                                : net::fnv1a32(c->rx.data() + 3, payload_len);
-            if (chk != calc) { c->rx.erase(c->rx.begin(), c->rx.begin() + total); continue; }
+            if (!net::checksum_matches(net::ChecksumKind::Fnv1a32, c->rx.data() + 3, payload_len, chk)) { c->rx.erase(c->rx.begin(), c->rx.begin() + total); continue; }
 
             const bool is_ready = (type == (uint8_t)net::MsgType::READY);
             const uint8_t v = (is_ready && payload_len >= 1) ? c->rx[3] : 0;
@@ -1575,9 +1573,9 @@ private:
             if (p[2] == (uint8_t)net::MsgType::MATCH_SUMMARY) {
                 const size_t payload_len = (size_t)len - 1u;
                 const uint32_t chk  = net::le_read_u32(p + 2u + len);
-                const uint32_t calc = payload_len == 0 ? 0u : net::fnv1a32(p + 3, payload_len);
                 Summary s{};
-                if (chk == calc && parse_summary(p + 3, payload_len, s)) {
+                if (net::checksum_matches(net::ChecksumKind::Fnv1a32, p + 3, payload_len, chk) &&
+                    parse_summary(p + 3, payload_len, s)) {
                     auto& slot = c->is_a ? ch->sumA : ch->sumB;
                     if (!slot) slot = s;
                     RLOG_DEBUG("[relay] match=" << ch->match_id
@@ -522,11 +522,8 @@ void forwarderLoop(std::shared_ptr<Channel> ch, bool a_to_b)
                 const size_t payloadLen = payloadAndType >= 1u ? payloadAndType - 1u : 0u;
                 const uint8_t* payloadPtr = streamBuf.data() + 3;
                 const uint32_t chk = net::le_read_u32(streamBuf.data() + 2u + payloadAndType);
-                const uint32_t calc = payloadLen == 0
-                    ? 0u
-                    : net::fnv1a32(payloadPtr, payloadLen);
 
-                if (chk != calc) {
+                if (!net::checksum_matches(net::ChecksumKind::Fnv1a32, payloadPtr, payloadLen, chk)) {
                     RLOG_WARN("[relay] match=" << ch->match_id
                               << " uuid=" << ch->match_uuid
                               << " dropping MATCH_SUMMARY with bad checksum from "
@@ -730,9 +727,7 @@ void queueLobbyThread(Match match, meta::client::MetaClient* meta) {
             // 체크섬 검증 (다른 invalid 프레임이면 버리고 계속).
             const size_t payloadLen = (size_t)len - TYPE_FIELD;
             const uint32_t chk = net::le_read_u32(buf.data() + LEN_FIELD + (size_t)len);
-            const uint32_t calc = payloadLen == 0 ? 0u
-                : net::fnv1a32(buf.data() + LEN_FIELD + TYPE_FIELD, payloadLen);
-            if (chk != calc) {
+            if (!net::checksum_matches(net::ChecksumKind::Fnv1a32, buf.data() + LEN_FIELD + TYPE_FIELD, payloadLen, chk)) {
                 buf.erase(buf.begin(), buf.begin() + totalNeeded);
                 continue;
             }
@@ -116,7 +116,7 @@ void Game::DrawGrid(int offsetX, int offsetY) const
 void Game::DrawBlock(const SimBlock& block, int offsetX, int offsetY) const
 {
     constexpr int cellSize = 30;
-    std::vector<Position> tiles = block.GetCellPositions();
+    const auto tiles = block.GetCellPositions();
     for (const Position& p : tiles)
     {
         draw_rect(
@@ -205,7 +205,7 @@ void Game::DrawBlockMini(const SimBlock& block, int offsetX, int offsetY, int ce
     // SimBlock::GetCellPositions 는 블록의 로컬 좌표(0-based bounding box)를 반환.
     // cellSize 를 파라미터로 받아 축소 그리기. DrawBlock 과 달리 색상 팔레트를
     // 직접 인덱싱하고 전체 크기를 조절한다.
-    std::vector<Position> tiles = block.GetCellPositions();
+    const auto tiles = block.GetCellPositions();
     // 블록을 bounding box 기준으로 정규화 — next 의 row/column 가 스폰 위치 기준이라
     // 그대로 그리면 오른쪽 하단으로 치우침. min row/col 를 빼서 (0,0) 에서 시작하게.
     int minRow = INT_MAX, minCol = INT_MAX;
@@ -23,6 +23,7 @@
 #include "../core/constants.h"
 #include "../core/input.h"
 #include "../core/replay.h"
+#include "replay_recorder.h"
 #include "../core/hash.h"
 #include "../net/session.h"
 #include "../net/socket.h"
@@ -44,6 +45,9 @@
 #include "../renderer/renderer.h"
 #include "../renderer/shake.h"
 #include "../renderer/image.h"
+#include "../bot/async_bot.h"
+#include "../bot/beam_search.h"
+#include "../bot/mcts.h"
 #include "../bot/bot_onnx.h"
 #include "../bot/placement.h"
 #include "../meta/http_client.h"
@@ -79,11 +83,13 @@ struct BotEntry {
     std::string name;
     std::string path;
     int inputIntervalTicks = 1;  // 1 = consume one queued bot input every sim tick.
+    bot::OnnxSessionOptions onnx;  // .onnx 봇만 쓴다
 };
 
 struct BotConfigOverride {
     std::string name;
     int inputIntervalTicks = 0;  // 0 = keep default.
+    std::string onnxOptions;     // 넷째 칸 그대로. 비었으면 기본값
 };
 
 static std::string trim_copy(const std::string& s)
@@ -177,6 +183,7 @@ static std::unordered_map<std::string, BotConfigOverride> load_bot_config(const
             auto r = std::from_chars(raw.data(), raw.data() + raw.size(), ticks);
             if (r.ec == std::errc()) cfg.inputIntervalTicks = clamp_bot_input_interval(ticks);
         }
+        if (parts.size() >= 4) cfg.onnxOptions = parts[3];
         out[parts[0]] = cfg;
     }
     std::fclose(f);
@@ -187,11 +194,21 @@ static void apply_bot_config(
     BotEntry& entry,
     const std::unordered_map<std::string, BotConfigOverride>& cfg)
 {
+    auto apply_onnx = [&](const BotConfigOverride& c) {
+        std::string err;
+        if (!c.onnxOptions.empty() && !bot::parse_onnx_options(c.onnxOptions, entry.onnx, &err))
+            std::fprintf(stderr, "[bots.cfg] %s: %s\n", entry.path.c_str(), err.c_str());
+    };
     auto apply = [&](const BotConfigOverride& c) {
         if (!c.name.empty()) entry.name = c.name;
         if (c.inputIntervalTicks > 0) entry.inputIntervalTicks = c.inputIntervalTicks;
+        apply_onnx(c);
     };
 
+    // 경로가 * 인 줄은 모든 봇의 ONNX 세션 기본값. 봇 자신의 줄이 그 위에 덮어쓴다.
+    auto all = cfg.find("*");
+    if (all != cfg.end()) apply_onnx(all->second);
+
     auto it = cfg.find(entry.path);
     if (it != cfg.end()) {
         apply(it->second);
@@ -344,10 +361,14 @@ static bool save_settings(const char* path, const GameSettings& s)
 static std::vector<BotEntry> discover_bot_roster()
 {
     std::vector<BotEntry> roster;
-    roster.push_back({"Heuristic (test)", "@heuristic", 2});
+    roster.push_back({"Heuristic (test)", "@heuristic", 2, bot::OnnxSessionOptions{}});
+    // 미리보기 3 개까지 읽는 beam search. ONNX 모델 없이도 가장 강한 내장 상대.
+    roster.push_back({"Beam search", "@beam", 2, bot::OnnxSessionOptions{}});
+    // heuristic 평가기로 실제 판을 펼치는 MCTS. beam 과 같은 한 틱 예산 안에서 돈다.
+    roster.push_back({"MCTS", "@mcts", 2, bot::OnnxSessionOptions{}});
 
     const auto cfg = load_bot_config("model/bots.cfg");
-    apply_bot_config(roster[0], cfg);
+    for (BotEntry& builtin : roster) apply_bot_config(builtin, cfg);
 
     namespace fs = std::filesystem;
     std::vector<BotEntry> models;
@@ -362,7 +383,7 @@ static std::vector<BotEntry> discover_bot_roster()
             if (path.extension() != ".onnx") continue;
             const std::string key = normalize_model_key(path);
             if (!seen.insert(key).second) continue;
-            BotEntry entry{bot_name_from_path(path), key, 1};
+            BotEntry entry{bot_name_from_path(path), key, 1, bot::OnnxSessionOptions{}};
             apply_bot_config(entry, cfg);
             models.push_back(std::move(entry));
         }
@@ -1028,13 +1049,11 @@ int main(int argc, char** argv)
     // ── Section C — Single vs Bot ───────────────────────────────────────────
     // BotSingle 모드에선 gameSingle 이 사람, gameBot 이 봇 보드. 둘 다 같은
     // seed 로 생성되지만 입력 스트림이 다르므로 자연스럽게 서로 다른 전개가 된다.
-    // botInputQueue: BotOnnx::Infer → expand_placement 로 채운 틱 입력 마스크.
-    //   selectedBotInputIntervalTicks 마다 하나 pop 한다. 1이면 기존처럼 매 tick
+    // 봇의 착수는 botAsync(아래)가 봇 스레드에서 고르고, 틱 입력 마스크를
+    //   selectedBotInputIntervalTicks 마다 하나씩 낸다. 1이면 기존처럼 매 tick
     //   입력하고, 값이 커질수록 같은 모델이라도 느리게 움직인다.
     std::unique_ptr<Game> gameBot;
     bot::BotOnnx botOnnx;
-    std::deque<uint8_t> botInputQueue;
-    int botInputCooldownTicks = 0;
     int selectedBotInputIntervalTicks = 1;
     // 봇 로스터 — model/*.onnx 와 model/bots/*.onnx 를 스캔한다. 10개 이상
     // 모델을 떨궈두어도 선택 화면에서 스크롤/압축 표시된다. 표시 이름과 기본
@@ -1090,6 +1109,45 @@ int main(int argc, char** argv)
     std::string botSelectError;
     std::string selectedBotName = "Bot";
     bool        botUsesHeuristic = false;
+    bool        botUsesBeam = false;
+    // 봇 스레드에서 돌므로 렌더를 막지는 않는다. 그래도 블록이 스폰 줄에서 오래
+    // 머물지 않도록 한 수에 한 틱(16ms) 까지만 쓴다.
+    bot::BeamConfig botBeamConfig = [] {
+        bot::BeamConfig c;
+        c.budgetMs = 16.0;
+        return c;
+    }();
+    // 다음 수의 탐색이 직전 탐색이 펼친 판을 다시 쓰도록 붙이는 전치표. 캐시에
+    // 들어가는 크기일 때 가장 빠르다(tetris_selfplay --tt-mb 로 잰 값).
+    bot::TranspositionTable botBeamTable(1);
+    bool        botUsesMcts = false;
+    // MCTS 도 같은 16ms 예산. 봇 스레드 하나에서 돌므로 트리 스레드는 하나만 쓴다.
+    bot::HeuristicEvaluator botMctsEvaluator;
+    bot::Mcts botMcts(botMctsEvaluator, [] {
+        bot::MctsConfig c;
+        c.simulations = 1000;
+        c.leafBatch = 1;
+        c.budgetMs = 16.0;
+        return c;
+    }());
+    // 게임 스레드 밖에서 위 봇들 중 고른 것을 부른다. 블록이 바뀌면 돌던 탐색은
+    // cancel 로 끊긴다. planner 가 쓰는 봇 객체(botOnnx, botMcts, botBeamTable)는
+    // botAsync.Reset() 뒤에만 게임 스레드에서 만진다.
+    bot::AsyncBot botAsync([&](const SimGame& sim, const std::atomic<bool>& cancel,
+                               int& col, int& rot) {
+        if (botUsesHeuristic)
+            return bot::heuristic_placement(sim, col, rot);
+        if (botUsesBeam) {
+            bot::BeamConfig c = botBeamConfig;
+            c.cancel = &cancel;
+            return bot::beam_placement(sim, c, col, rot);
+        }
+        if (botUsesMcts) {
+            botMcts.SetCancel(&cancel);
+            return bot::mcts_placement(botMcts, sim, col, rot);
+        }
+        return botOnnx.IsLoaded() && botOnnx.Infer(sim, col, rot);
+    });
     BotMatchResult botMatchResult = BotMatchResult::None;
     int lastAttackHuman = 0, lastAttackBot = 0;
 
@@ -1099,9 +1157,24 @@ int main(int argc, char** argv)
     static bool localIpDone = false;
     static bool publicIpLaunched = false;
 
-    bool recording = false;
-    ReplayData replay;
-    replay.seed = sessionSeed;
+    // F5 부터 F6 까지 out/replay.trpl 에 바로 이어 쓴다(src/replay_recorder.h). 지난 세션이
+    // 녹화 중에 죽어 끝 청크가 없으면 마지막 온전한 청크까지 살려 옆으로 옮겨 둔다 —
+    // 다음 F5 가 같은 이름을 덮어쓰므로.
+    const char* const replayPath = "out/replay.trpl";
+    ReplayRecorder replayRecorder;
+    ReplayRecorderConfig replayConfig;
+    replayConfig.keyframeEvery = 600;   // 10초마다 되감기 지점
+    {
+        std::error_code ec;
+        ReplayData rescued;
+        if (std::filesystem::exists(replayPath, ec) && !ReplayIO::Load(replayPath, rescued) &&
+            ReplayIO::Recover(replayPath, &rescued))
+        {
+            std::filesystem::rename(replayPath, "out/replay.recovered.trpl", ec);
+            std::fprintf(stderr, "[replay] recovered %zu ticks of an interrupted recording -> out/replay.recovered.trpl\n",
+                         rescued.frames.size());
+        }
+    }
 
     GameOverState gameOverState = GameOverState::None;
     net::GameOverChoice myGameOverChoice = net::GameOverChoice::None;
@@ -1436,33 +1509,9 @@ int main(int argc, char** argv)
             else if (app == AppMode::BotSingle && gameSingle && gameBot &&
                      botMatchResult == BotMatchResult::None)
             {
-                // 1) 봇 입력 큐가 비었으면 새 placement 계산.
-                //    Infer 실패 또는 합법 수 없음 → INPUT_NONE 로 대기 (게임오버면 자연스럽게
-                //    gameBot 가 멈춰 있음).
-                if (botInputQueue.empty() && botInputCooldownTicks <= 0 &&
-                    !gameBot->sim.IsGameOver()) {
-                    int tgtCol = -1, tgtRot = -1;
-                    bool ok;
-                    if (botUsesHeuristic)
-                        ok = bot::heuristic_placement(gameBot->sim, tgtCol, tgtRot);
-                    else
-                        ok = botOnnx.IsLoaded() && botOnnx.Infer(gameBot->sim, tgtCol, tgtRot);
-                    if (!ok) ok = bot::fallback_placement(gameBot->sim, tgtCol, tgtRot);
-                    if (ok) {
-                        int curCol = gameBot->sim.CurrentCol();
-                        int curRot = gameBot->sim.CurrentRotation();
-                        auto seq = bot::expand_placement(curCol, curRot, tgtCol, tgtRot);
-                        for (uint8_t m : seq) botInputQueue.push_back(m);
-                    }
-                }
-                uint8_t botMask = INPUT_NONE;
-                if (botInputCooldownTicks > 0) {
-                    --botInputCooldownTicks;
-                } else if (!botInputQueue.empty()) {
-                    botMask = botInputQueue.front();
-                    botInputQueue.pop_front();
-                    botInputCooldownTicks = selectedBotInputIntervalTicks - 1;
-                }
+                // 1) 봇 입력. 새 블록이면 봇 스레드에 탐색을 맡기고 답이 올 때까지
+                //    INPUT_NONE. 답이 늦거나 실패하면 fallback_placement 로 둔다.
+                const uint8_t botMask = botAsync.NextInput(gameBot->sim);
 
                 gameSingle->SubmitInput(inputMask);
                 gameBot->SubmitInput(botMask);
@@ -1489,19 +1538,40 @@ int main(int argc, char** argv)
                         botMatchResult = BotMatchResult::Win;
                     else
                         botMatchResult = BotMatchResult::Lose;
-                    botInputQueue.clear();
-                    botInputCooldownTicks = 0;
+                    botAsync.Reset();   // 봇 스레드를 쉬게 한 뒤 지연 통계를 읽는다
+                    {
+                        const bot::AsyncBotStats st = botAsync.Stats();
+                        char line[160];
+                        st.thinkNs.Format(line, sizeof(line));
+                        std::fprintf(stderr, "[bot] %s think %s stale=%llu timeout=%llu\n",
+                                     selectedBotName.c_str(), line,
+                                     static_cast<unsigned long long>(st.stale),
+                                     static_cast<unsigned long long>(st.timeouts));
+                        botAsync.ResetStats();
+                    }
+                    if (!botUsesHeuristic && !botUsesBeam && !botUsesMcts &&
+                        botOnnx.Latency().Count() > 0) {
+                        // 저사양 기기에서 한 틱(16.7ms) 안에 드는지 보려고 판마다 남긴다.
+                        const bot::LatencyHistogram& lat = botOnnx.Latency();
+                        char line[160];
+                        lat.Format(line, sizeof(line));
+                        std::fprintf(stderr, "[bot] %s infer %s over_tick=%llu binding=%d\n",
+                                     selectedBotName.c_str(), line,
+                                     static_cast<unsigned long long>(lat.CountAbove(16666667)),
+                                     botOnnx.UsesIoBinding() ? 1 : 0);
+                        botOnnx.ResetLatency();
+                    }
                 }
 
-                // 상대(봇) 피스가 락되면 큐를 비우고 다음 피스에서 다시 Infer.
+                // 상대(봇) 피스가 락되면 botAsync 가 새 블록을 보고 다시 탐색한다.
                 // expand_placement 는 마지막에 INPUT_DROP 을 넣으므로 시퀀스 끝에서
                 // 자연스럽게 큐가 비워진다 — 별도 처리 불필요.
             }
 
-            if (recording)
+            if (replayRecorder.IsOpen())
             {
                 FrameInputs fr{}; fr.p1 = inputMask; fr.p2 = 0;
-                replay.frames.push_back(fr);
+                replayRecorder.Push(fr);
             }
             accumulator -= SECONDS_PER_TICK;
         }
@@ -1828,6 +1898,8 @@ int main(int argc, char** argv)
                 const BotEntry& cur = botRoster[botSelectIndex];
                 const std::string pathLabel =
                     (cur.path == "@heuristic") ? std::string("built-in heuristic")
+                    : (cur.path == "@beam")    ? std::string("built-in beam search (3-piece preview)")
+                    : (cur.path == "@mcts")    ? std::string("built-in MCTS (heuristic evaluator)")
                                                : truncate_middle(cur.path, 72);
 #if defined(TETRIS_ENABLE_DEBUG_UI)
                 draw_text(fmt_buf("Speed: one bot input every %d simulation tick(s)",
@@ -1858,12 +1930,13 @@ int main(int argc, char** argv)
                 const BotEntry& entry = botRoster[chosen];
                 const std::string& path = entry.path;
                 bool ready = true;
-                if (path == "@heuristic") {
-                    botUsesHeuristic = true;          // 내장 휴리스틱 — 로드 불필요
-                } else {
+                botAsync.Reset();   // 봇 스레드가 옛 봇 객체를 쓰는 중일 수 있다
+                botUsesHeuristic = (path == "@heuristic");  // 내장 봇 — 로드 불필요
+                botUsesBeam      = (path == "@beam");
+                botUsesMcts      = (path == "@mcts");
+                if (!botUsesHeuristic && !botUsesBeam && !botUsesMcts) {
                     std::string err;
-                    ready = botOnnx.Load(path, &err);
-                    botUsesHeuristic = false;
+                    ready = botOnnx.Load(path, &err, entry.onnx);
                     if (!ready) botSelectError = "Load failed: " + err;
                 }
                 if (ready) {
@@ -1872,10 +1945,17 @@ int main(int argc, char** argv)
                     app = AppMode::BotSingle;
                     gameSingle = std::make_unique<Game>(sessionSeed);
                     gameBot    = std::make_unique<Game>(sessionSeed);
-                    botInputQueue.clear();
-                    botInputCooldownTicks = 0;
+                    botAsync.SetConfig([&] {
+                        bot::AsyncBotConfig c;
+                        c.inputIntervalTicks = selectedBotInputIntervalTicks;
+                        return c;
+                    }());
                     botMatchResult = BotMatchResult::None;
                     lastAttackHuman = 0; lastAttackBot = 0;
+                    if (botUsesBeam) {
+                        botBeamConfig.table = &botBeamTable;
+                        botBeamTable.NewGeneration();  // 지난 판의 엔트리가 먼저 밀린다
+                    }
                 }
             }
         }
@@ -2554,13 +2634,22 @@ int main(int argc, char** argv)
         }
 
         // F5/F6 리플레이
-        if (platform_key_pressed(PKEY_F5)) { recording = true; replay.frames.clear(); }
-        if (platform_key_pressed(PKEY_F6) && recording)
+        if (platform_key_pressed(PKEY_F5))
         {
             std::error_code ec;
             std::filesystem::create_directories("out", ec);
-            ReplayIO::Save("out/replay.txt", replay);
-            recording = false;
+            if (!replayRecorder.Open(replayPath, sessionSeed, replayConfig))
+                std::fprintf(stderr, "[replay] cannot open '%s'\n", replayPath);
+        }
+        if (platform_key_pressed(PKEY_F6) && replayRecorder.IsOpen())
+        {
+            if (!replayRecorder.Close())
+                std::fprintf(stderr, "[replay] write to '%s' failed\n", replayPath);
+#if defined(TETRIS_ENABLE_DEBUG_UI)
+            ReplayData replay;
+            if (ReplayIO::Load(replayPath, replay))
+                ReplayIO::ExportText("out/replay.txt", replay);   // 눈으로 보는 디버깅용
+#endif
         }
 
 #if defined(TETRIS_ENABLE_DEBUG_UI)
@@ -2582,13 +2671,17 @@ int main(int argc, char** argv)
             if (platform_key_pressed(PKEY_LBRACKET)) {
                 selectedBotInputIntervalTicks =
                     clamp_bot_input_interval(selectedBotInputIntervalTicks - 1);
-                if (botInputCooldownTicks >= selectedBotInputIntervalTicks)
-                    botInputCooldownTicks = selectedBotInputIntervalTicks - 1;
             }
             if (platform_key_pressed(PKEY_RBRACKET)) {
                 selectedBotInputIntervalTicks =
                     clamp_bot_input_interval(selectedBotInputIntervalTicks + 1);
             }
+            if (botAsync.Config().inputIntervalTicks != selectedBotInputIntervalTicks) {
+                // 설정은 게임 스레드만 읽으므로 바로 바꿔도 된다. 다음 입력부터 적용.
+                bot::AsyncBotConfig c = botAsync.Config();
+                c.inputIntervalTicks = selectedBotInputIntervalTicks;
+                botAsync.SetConfig(c);
+            }
 #endif
 
             int leftX = 11, rightX = 11 + 300 + 60;
@@ -2665,15 +2758,13 @@ int main(int argc, char** argv)
                 if (platform_key_pressed(PKEY_R)) {
                     gameSingle = std::make_unique<Game>(sessionSeed);
                     gameBot    = std::make_unique<Game>(sessionSeed);
-                    botInputQueue.clear();
-                    botInputCooldownTicks = 0;
+                    botAsync.Reset();
                     botMatchResult = BotMatchResult::None;
                     lastAttackHuman = 0; lastAttackBot = 0;
                 } else if (platform_key_pressed(PKEY_Q)) {
                     gameSingle.reset();
                     gameBot.reset();
-                    botInputQueue.clear();
-                    botInputCooldownTicks = 0;
+                    botAsync.Reset();
                     botMatchResult = BotMatchResult::None;
                     app = AppMode::Menu;
                 }
@@ -2690,7 +2781,7 @@ int main(int argc, char** argv)
             if (platform_key_pressed(PKEY_R))
             {
                 gameSingle = std::make_unique<Game>(sessionSeed);
-                if (recording) replay.frames.clear();
+                if (replayRecorder.IsOpen()) replayRecorder.Open(replayPath, sessionSeed, replayConfig);
             }
             else if (platform_key_pressed(PKEY_Q))
             {
@@ -2975,7 +3066,7 @@ int main(int argc, char** argv)
                 lastRemoteHashSeenTick = 0;
                 desyncDetected         = false;
                 desyncTick             = 0;
-                if (recording) { replay.frames.clear(); replay.seed = sessionSeed; }
+                if (replayRecorder.IsOpen()) replayRecorder.Open(replayPath, sessionSeed, replayConfig);
                 gameOverState = GameOverState::None;
             }
             else if (gameOverState == GameOverState::GoingToTitle)
@@ -3291,8 +3382,7 @@ int main(int argc, char** argv)
                 if (app == AppMode::BotSingle) {
                     gameSingle.reset();
                     gameBot.reset();
-                    botInputQueue.clear();
-                    botInputCooldownTicks = 0;
+                    botAsync.Reset();
                     botMatchResult = BotMatchResult::None;
                 }
                 app = AppMode::Menu;
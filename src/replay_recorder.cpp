@@ -0,0 +1,149 @@
+#include "replay_recorder.h"
+#include "sim_replay.h"
+
+#include <algorithm>
+#include <utility>
+
+bool ReplayRecorder::Open(const std::string& path, uint64_t seed, const ReplayRecorderConfig& config)
+{
+    Close();
+    config_ = config;
+    config_.chunkTicks = std::max<uint32_t>(config_.chunkTicks, 1);
+    config_.maxPendingChunks = std::max<size_t>(config_.maxPendingChunks, 1);
+
+    file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        file_.clear();
+        return false;
+    }
+    // 쓰기 스레드가 청크를 닫는 단위와 넘기는 단위를 맞춘다. 넘긴 버퍼 하나가 청크 하나다.
+    writer_ = std::make_unique<ReplayIO::BinaryWriter>(file_, seed, config_.chunkTicks);
+    file_.flush();
+
+    current_.clear();
+    current_.reserve(config_.chunkTicks);
+    ticks_ = 0;
+    queue_.clear();
+    handedOff_ = 0;
+    done_ = 0;
+    stopping_ = false;
+    stats_ = ReplayRecorderStats{};
+    stats_.ok = static_cast<bool>(file_);
+    worker_ = std::thread([this, seed] { Run(seed); });
+    return true;
+}
+
+void ReplayRecorder::Push(const FrameInputs& f)
+{
+    if (!IsOpen()) return;
+    current_.push_back(f);
+    ++ticks_;
+    if (current_.size() >= config_.chunkTicks) Handoff();
+}
+
+void ReplayRecorder::Handoff()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (queue_.size() >= config_.maxPendingChunks) {
+        ++stats_.stalls;
+        drained_.wait(lock);
+    }
+    queue_.push_back(std::move(current_));
+    current_ = std::vector<FrameInputs>();
+    ++handedOff_;
+    stats_.maxPending = std::max(stats_.maxPending, queue_.size());
+    if (!spare_.empty()) {
+        current_.swap(spare_.back());
+        spare_.pop_back();
+    }
+    current_.clear();
+    current_.reserve(config_.chunkTicks);
+    cv_.notify_one();
+}
+
+bool ReplayRecorder::Flush()
+{
+    if (!IsOpen()) return false;
+    Handoff();
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t target = handedOff_;
+    drained_.wait(lock, [&] { return done_ >= target; });
+    return stats_.ok;
+}
+
+bool ReplayRecorder::Close()
+{
+    if (!IsOpen()) return false;
+    if (!current_.empty()) Handoff();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_one();
+    worker_.join();
+
+    writer_.reset();
+    file_.close();
+    const bool closed = !file_.fail();
+    file_.clear();
+    std::vector<std::vector<FrameInputs>>().swap(spare_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.ok = stats_.ok && closed;
+    return stats_.ok;
+}
+
+ReplayRecorderStats ReplayRecorder::Stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReplayRecorderStats s = stats_;
+    s.ticks = ticks_;
+    return s;
+}
+
+void ReplayRecorder::Run(uint64_t seed)
+{
+    const uint32_t every = config_.keyframeEvery;
+    ReplaySim sim(seed);
+    uint64_t written = 0;
+
+    for (;;) {
+        std::vector<FrameInputs> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) break;
+            batch = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // 락 밖에서 인코딩·쓰기. keyframe 은 그 틱의 입력보다 앞에 온다(AddKeyframes 와 같다).
+        for (const FrameInputs& f : batch) {
+            if (every) {
+                if (written % every == 0) writer_->PushKeyframe(sim.Keyframe());
+                sim.Step(f);
+            }
+            writer_->Push(f);
+            ++written;
+        }
+        const bool ok = writer_->Flush();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++done_;
+            stats_.written = written;
+            stats_.bytes = writer_->BytesWritten();
+            stats_.ok = stats_.ok && ok;
+            if (spare_.size() < config_.maxPendingChunks) {
+                batch.clear();
+                spare_.push_back(std::move(batch));
+            }
+        }
+        drained_.notify_all();
+    }
+
+    if (every && written % every == 0) writer_->PushKeyframe(sim.Keyframe());
+    const bool ok = writer_->Finish();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.bytes = writer_->BytesWritten();
+    stats_.ok = stats_.ok && ok;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../core/replay.h"
+
+// [NET] 녹화하면서 바로 쓰는 리플레이 recorder.
+//
+// 예전 main.cpp 는 세션 내내 ReplayData 에 틱을 쌓았다가 F6 에서야 Save 했다. 중간에
+// 죽으면 전부 잃고, 긴 세션은 메모리가 끝없이 는다. ReplayRecorder 는 파일을 먼저 열고
+// 이어 쓴다(append-only, 포맷은 core/replay.h 의 .trpl 그대로).
+//   - 게임 스레드는 틱마다 Push 로 FrameInputs 2바이트를 버퍼에 넣기만 한다.
+//   - chunkTicks 틱이 차면 그 버퍼를 쓰기 스레드에 넘긴다. 쓰기 스레드가 varint run
+//     으로 접어 'I' 청크로 쓰고 flush 한다. keyframeEvery 가 있으면 같은 스레드가
+//     ReplaySim 으로 따라 굴려 'K' 청크를 끼운다(AddKeyframes 와 같은 자리).
+//   - 넘긴 버퍼는 maxPendingChunks 개까지 줄을 선다. 그보다 밀리면(디스크가 멈춤) Push 가
+//     기다린다 — 입력을 버리면 리플레이가 틀리므로 지연 쪽을 고른다. 쓴 버퍼는 다시 쓴다.
+// 그래서 메모리는 (maxPendingChunks + 1) × chunkTicks 틱분으로 묶이고, 강제 종료 때 잃는
+// 것은 아직 넘기지 않은 chunkTicks 틱 안쪽이다. 끊긴 파일은 ReplayIO::Recover 로 살린다.
+//
+// Push·Flush·Close 는 게임 스레드 하나에서만 부른다.
+
+struct ReplayRecorderConfig
+{
+    uint32_t chunkTicks = 600;       // 넘기는 단위(60Hz 로 10초). 강제 종료 때 잃는 최대 틱 수
+    uint32_t keyframeEvery = 0;      // 0 이면 keyframe 을 쓰지 않는다
+    size_t   maxPendingChunks = 8;   // 쓰기 스레드 앞에 줄 설 수 있는 버퍼 수
+};
+
+struct ReplayRecorderStats
+{
+    uint64_t ticks = 0;              // Push 한 틱
+    uint64_t written = 0;            // 파일에 쓴 틱
+    uint64_t bytes = 0;              // 파일 크기(끝 청크 전)
+    uint64_t stalls = 0;             // 줄이 차서 Push 가 기다린 횟수
+    size_t   maxPending = 0;         // 줄의 최대 길이
+    bool     ok = true;              // 쓰기 실패가 없었다
+};
+
+class ReplayRecorder
+{
+public:
+    ReplayRecorder() = default;
+    ~ReplayRecorder() { Close(); }
+
+    ReplayRecorder(const ReplayRecorder&) = delete;
+    ReplayRecorder& operator=(const ReplayRecorder&) = delete;
+
+    // path 를 새로 만들고(있으면 덮어쓴다) 헤더를 쓴 뒤 쓰기 스레드를 띄운다.
+    // 열려 있던 녹화는 먼저 Close 한다.
+    bool Open(const std::string& path, uint64_t seed, const ReplayRecorderConfig& config = ReplayRecorderConfig{});
+    bool IsOpen() const { return worker_.joinable(); }
+
+    void Push(const FrameInputs& f);
+    // 모은 틱을 청크로 넘기고 파일에 닿을 때까지 기다린다. 라운드가 끝났을 때처럼
+    // 잃으면 아까운 지점에서 부른다.
+    bool Flush();
+    // 남은 틱과 색인·끝 청크를 쓰고 파일을 닫는다. 쓰기 실패가 없었으면 true.
+    bool Close();
+
+    ReplayRecorderStats Stats() const;
+
+private:
+    void Handoff();
+    void Run(uint64_t seed);
+
+    ReplayRecorderConfig config_;
+
+    // 게임 스레드만 만진다.
+    std::vector<FrameInputs> current_;
+    uint64_t ticks_ = 0;
+
+    // 아래는 mutex_ 가 지킨다.
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;          // 쓰기 스레드를 깨운다
+    std::condition_variable drained_;     // 줄이 줄었다 / Flush 한 버퍼를 썼다
+    std::deque<std::vector<FrameInputs>> queue_;   // 넘긴 버퍼. 하나가 청크 하나
+    std::vector<std::vector<FrameInputs>> spare_;
+    uint64_t handedOff_ = 0;              // 넘긴 버퍼 수
+    uint64_t done_ = 0;                   // 쓰기 스레드가 끝낸 버퍼 수
+    bool stopping_ = false;
+    ReplayRecorderStats stats_;
+
+    // 쓰기 스레드만 만진다(Open 이 만들고 Close 가 join 뒤에 치운다).
+    std::ofstream file_;
+    std::unique_ptr<ReplayIO::BinaryWriter> writer_;
+    std::thread worker_;
+};
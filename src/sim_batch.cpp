@@ -0,0 +1,91 @@
+#include "sim_batch.h"
+#include "../bot/placement.h"
+#include "../core/rng.h"
+
+#include <cstring>
+
+static_assert(SimGameBatch::kNumActions == bot::kNumPlacements,
+              "batch action space must match the bot/Python action space");
+static_assert(SimGameBatch::kNumPieceTypes == bot::kNumPieceTypes,
+              "batch one-hot width must match bot::observe");
+
+SimGameBatch::SimGameBatch(int numGames, uint64_t seed)
+    : baseSeed(seed)
+{
+    if (numGames < 0) numGames = 0;
+    games.reserve(numGames);
+    episodes.assign(numGames, 0);
+    for (int i = 0; i < numGames; ++i)
+    {
+        games.emplace_back(EpisodeSeed(baseSeed, i, 0));
+    }
+}
+
+uint64_t SimGameBatch::EpisodeSeed(uint64_t seed, int index, uint32_t episode)
+{
+    const uint64_t z = splitmix64(seed
+                                  + 0x9E3779B97F4A7C15ull * (static_cast<uint64_t>(index) + 1)
+                                  + 0xD1B54A32D192ED03ull * episode);
+    // 0 은 SimGame 이 고정 기본 시드로 바꿔 버리므로 피한다.
+    return z ? z : 1;
+}
+
+void SimGameBatch::Reset(const Buffers& out)
+{
+    const int n = Size();
+    for (int i = 0; i < n; ++i)
+    {
+        episodes[i] = 0;
+        games[i] = SimGame(EpisodeSeed(baseSeed, i, 0));
+        WriteObservation(i, out);
+        if (out.reward) out.reward[i] = 0.0f;
+        if (out.done)   out.done[i] = 0;
+    }
+}
+
+void SimGameBatch::Step(const int32_t* actions, const Buffers& out)
+{
+    const int n = Size();
+    for (int i = 0; i < n; ++i)
+    {
+        SimGame& g = games[i];
+        float reward = 0.0f;
+        const int action = actions[i];
+        if (action >= 0 && action < kNumActions)
+        {
+            int col, rot;
+            bot::decode_action(action, col, rot);
+            const int cleared = g.ApplyPlacement(col, rot);
+            // 불법 수는 판을 건드리지 않고 보상 0 (env.py 와 같다).
+            if (cleared > 0) reward = static_cast<float>(cleared);
+        }
+
+        const bool done = g.IsGameOver();
+        if (done)
+        {
+            ++episodes[i];
+            g = SimGame(EpisodeSeed(baseSeed, i, episodes[i]));
+        }
+        WriteObservation(i, out);
+        if (out.reward) out.reward[i] = reward;
+        if (out.done)   out.done[i] = done ? 1 : 0;
+    }
+}
+
+void SimGameBatch::WriteObservation(int index, const Buffers& out) const
+{
+    const SimGame& g = games[index];
+    bot::observe(g,
+                 out.board   + static_cast<size_t>(index) * kBoardSize,
+                 out.current + static_cast<size_t>(index) * kNumPieceTypes,
+                 out.next    + static_cast<size_t>(index) * kNumPieceTypes);
+
+    uint8_t* mask = out.legalMask + static_cast<size_t>(index) * kNumActions;
+    std::memset(mask, 0, kNumActions);
+    SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+    const int count = g.EnumeratePlacements(landed);
+    for (int k = 0; k < count; ++k)
+    {
+        mask[bot::encode_action(landed[k].col, landed[k].rot)] = 1;
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "sim_game.h"
+
+// [RL] N 개의 SimGame 을 한 번에 돌리는 벡터화 환경.
+//
+// Python 학습 루프가 SimGame 을 하나씩 pybind 로 부르면 착수마다 GIL 왕복과
+// Python 객체 생성이 따라붙는다. SimGameBatch 는 게임들을 연속 메모리에 두고
+// action 배열 하나로 전부 한 수씩 진행한 뒤, 관측·합법 수 마스크·보상·종료
+// 플래그를 호출자가 넘긴 버퍼에 바로 쓴다. 바인딩은 이 호출 동안 GIL 을 놓는다.
+//
+// 계약은 python/common/env.py 의 TetrisPlacementEnv 와 같다.
+//   action  = col * 4 + rot (bot::encode_action)
+//   reward  = 그 착수로 지운 줄 수. 불법 수는 판을 건드리지 않고 0.
+//   관측    = bot::observe 인코딩 그대로 (board 200, current 7, next 7)
+// 끝난 게임은 그 자리에서 새 시드로 다시 시작한다(auto-reset). 그래서 done=1 인
+// 슬롯의 관측은 이미 새 게임의 첫 상태다 — gymnasium vector env 의 관례와 같다.
+class SimGameBatch
+{
+public:
+    // 호출자 소유 버퍼. 모두 C-contiguous, 첫 축이 게임 인덱스.
+    //   board     (N, 200)  float32 — (N, 1, 20, 10) 을 평평하게 본 것
+    //   current   (N, 7)    float32
+    //   next      (N, 7)    float32
+    //   legalMask (N, 40)   uint8 (0/1)
+    //   reward    (N,)      float32 — Step 전용, Reset 에선 nullptr 가능
+    //   done      (N,)      uint8   — Step 전용, Reset 에선 nullptr 가능
+    struct Buffers
+    {
+        float*   board     = nullptr;
+        float*   current   = nullptr;
+        float*   next      = nullptr;
+        uint8_t* legalMask = nullptr;
+        float*   reward    = nullptr;
+        uint8_t* done      = nullptr;
+    };
+
+    static constexpr int kBoardSize = SimGrid::kRows * SimGrid::kCols;   // 200
+    static constexpr int kNumPieceTypes = 7;
+    static constexpr int kNumActions = SimGame::kMaxPlacements;           // 40
+
+    // seed 에서 게임·에피소드별 시드를 유도한다(EpisodeSeed). 같은 seed 면
+    // 모든 게임의 궤적이 플랫폼과 무관하게 같다.
+    SimGameBatch(int numGames, uint64_t seed);
+
+    int Size() const { return static_cast<int>(games.size()); }
+    const SimGame& Game(int index) const { return games[index]; }
+
+    // 모든 게임을 첫 에피소드로 되돌리고 관측을 쓴다.
+    void Reset(const Buffers& out);
+
+    // actions[i] 로 게임 i 를 한 수 진행한다. 끝난 게임은 auto-reset 한다.
+    void Step(const int32_t* actions, const Buffers& out);
+
+    // (seed, 게임 인덱스, 에피소드 번호) → SimGame 시드. splitmix64 로 섞는다.
+    static uint64_t EpisodeSeed(uint64_t seed, int index, uint32_t episode);
+
+private:
+    void WriteObservation(int index, const Buffers& out) const;
+
+    uint64_t baseSeed;
+    std::vector<SimGame> games;
+    std::vector<uint32_t> episodes;
+};
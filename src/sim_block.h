@@ -1,15 +1,20 @@
 #pragma once
-#include <vector>
-#include <map>
+#include <array>
+#include <cstdint>
 #include "position.h"
+#include "sim_shapes.h"
 
 // [NET/RL] Pure, headless block state. No renderer, no audio, no rendering.
-// Holds shape data (cells per rotation), position offsets, and rotation state.
+// Holds the shape index, position offsets, and rotation state. Cell shapes live
+// in the shared constexpr tables of sim_shapes.h, so a SimBlock is a handful of
+// ints and copies as a plain memcpy.
 // Used by SimGame for deterministic simulation (Colab training + Windows inference).
 class SimBlock
 {
 public:
-    SimBlock() : id(0), rotationState(0), rowOffset(0), columnOffset(0) {}
+    static constexpr int kNumRotations = sim_shapes::kNumRotations;
+
+    SimBlock() : id(0), shape(0), rotationState(0), rowOffset(0), columnOffset(0) {}
 
     void Move(int rows, int columns)
     {
@@ -17,22 +22,29 @@ public:
         columnOffset += columns;
     }
 
-    std::vector<Position> GetCellPositions() const
+    // 현재 rotation 에서 차지하는 4칸의 절대 좌표. 고정 크기라 할당이 없다.
+    std::array<Position, 4> GetCellPositions() const
     {
-        const std::vector<Position>& tiles = cells.at(rotationState);
-        std::vector<Position> movedTiles;
-        movedTiles.reserve(tiles.size());
-        for (const Position& item : tiles)
-        {
-            movedTiles.emplace_back(item.row + rowOffset, item.column + columnOffset);
-        }
-        return movedTiles;
+        const SimCell* c = sim_shapes::kCells[shape][rotationState];
+        return {{
+            Position(c[0].row + rowOffset, c[0].column + columnOffset),
+            Position(c[1].row + rowOffset, c[1].column + columnOffset),
+            Position(c[2].row + rowOffset, c[2].column + columnOffset),
+            Position(c[3].row + rowOffset, c[3].column + columnOffset),
+        }};
+    }
+
+    // 현재 rotation 의 bounding box 행별 점유 마스크 (비트 c = 로컬 열 c).
+    // SimGrid::Fits 에 그대로 넘긴다.
+    const uint16_t (&RowMasks() const)[4]
+    {
+        return sim_shapes::kRowMasks.rows[shape][rotationState];
     }
 
     void Rotate()
     {
         rotationState++;
-        if (rotationState == static_cast<int>(cells.size()))
+        if (rotationState == kNumRotations)
         {
             rotationState = 0;
         }
@@ -43,13 +55,14 @@ public:
         rotationState--;
         if (rotationState == -1)
         {
-            rotationState = static_cast<int>(cells.size()) - 1;
+            rotationState = kNumRotations - 1;
         }
     }
 
     // Public data — read by SimGame logic and by rendering wrappers.
+    // id 는 화면/해시용 셀 값(ghost 는 8), shape 는 sim_shapes 테이블 인덱스(1..7).
     int id;
-    std::map<int, std::vector<Position>> cells;
+    int shape;
     int rotationState;
     int rowOffset;
     int columnOffset;
@@ -1,105 +1,59 @@
 #pragma once
 #include "sim_block.h"
-#include "position.h"
 
 // [NET/RL] Pure block shape factories — 헤드리스 SimGame 전용. 렌더러 의존성 없음.
+// 모양 자체는 sim_shapes.h 의 공유 테이블에 있고, 여기서는 ID 와 스폰 위치만 정한다.
 // 7-bag 의 ID 와 rotation 테이블은 결정론 보장을 위해 절대 변경하지 말 것
 // (변경 시 StateHash 가 어긋나 cross-platform / replay 회귀가 깨진다).
 
+// id(1..7) 블록을 스폰 위치에 만든다.
+inline SimBlock MakeSimBlock(int id)
+{
+    SimBlock block;
+    block.id = id;
+    block.shape = id;
+    block.Move(0, sim_shapes::kSpawnColumn[id]);
+    return block;
+}
+
 class SimLBlock : public SimBlock
 {
 public:
-    SimLBlock()
-    {
-        id = 1;
-        cells[0] = {Position(0, 2), Position(1, 0), Position(1, 1), Position(1, 2)};
-        cells[1] = {Position(0, 1), Position(1, 1), Position(2, 1), Position(2, 2)};
-        cells[2] = {Position(1, 0), Position(1, 1), Position(1, 2), Position(2, 0)};
-        cells[3] = {Position(0, 0), Position(0, 1), Position(1, 1), Position(2, 1)};
-        Move(0, 3);
-    }
+    SimLBlock() : SimBlock(MakeSimBlock(1)) {}
 };
 
 class SimJBlock : public SimBlock
 {
 public:
-    SimJBlock()
-    {
-        id = 2;
-        cells[0] = {Position(0, 0), Position(1, 0), Position(1, 1), Position(1, 2)};
-        cells[1] = {Position(0, 1), Position(0, 2), Position(1, 1), Position(2, 1)};
-        cells[2] = {Position(1, 0), Position(1, 1), Position(1, 2), Position(2, 2)};
-        cells[3] = {Position(0, 1), Position(1, 1), Position(2, 0), Position(2, 1)};
-        Move(0, 3);
-    }
+    SimJBlock() : SimBlock(MakeSimBlock(2)) {}
 };
 
 class SimIBlock : public SimBlock
 {
 public:
-    SimIBlock()
-    {
-        id = 3;
-        cells[0] = {Position(1, 0), Position(1, 1), Position(1, 2), Position(1, 3)};
-        cells[1] = {Position(0, 2), Position(1, 2), Position(2, 2), Position(3, 2)};
-        cells[2] = {Position(2, 0), Position(2, 1), Position(2, 2), Position(2, 3)};
-        cells[3] = {Position(0, 1), Position(1, 1), Position(2, 1), Position(3, 1)};
-        Move(0, 3);
-    }
+    SimIBlock() : SimBlock(MakeSimBlock(3)) {}
 };
 
 class SimOBlock : public SimBlock
 {
 public:
-    SimOBlock()
-    {
-        id = 4;
-        cells[0] = {Position(0, 0), Position(0, 1), Position(1, 0), Position(1, 1)};
-        cells[1] = {Position(0, 0), Position(0, 1), Position(1, 0), Position(1, 1)};
-        cells[2] = {Position(0, 0), Position(0, 1), Position(1, 0), Position(1, 1)};
-        cells[3] = {Position(0, 0), Position(0, 1), Position(1, 0), Position(1, 1)};
-        Move(0, 4);
-    }
+    SimOBlock() : SimBlock(MakeSimBlock(4)) {}
 };
 
 class SimSBlock : public SimBlock
 {
 public:
-    SimSBlock()
-    {
-        id = 5;
-        cells[0] = {Position(0, 1), Position(0, 2), Position(1, 0), Position(1, 1)};
-        cells[1] = {Position(0, 1), Position(1, 1), Position(1, 2), Position(2, 2)};
-        cells[2] = {Position(1, 1), Position(1, 2), Position(2, 0), Position(2, 1)};
-        cells[3] = {Position(0, 0), Position(1, 0), Position(1, 1), Position(2, 1)};
-        Move(0, 3);
-    }
+    SimSBlock() : SimBlock(MakeSimBlock(5)) {}
 };
 
 class SimTBlock : public SimBlock
 {
 public:
-    SimTBlock()
-    {
-        id = 6;
-        cells[0] = {Position(0, 1), Position(1, 0), Position(1, 1), Position(1, 2)};
-        cells[1] = {Position(0, 1), Position(1, 1), Position(1, 2), Position(2, 1)};
-        cells[2] = {Position(1, 0), Position(1, 1), Position(1, 2), Position(2, 1)};
-        cells[3] = {Position(0, 1), Position(1, 0), Position(1, 1), Position(2, 1)};
-        Move(0, 3);
-    }
+    SimTBlock() : SimBlock(MakeSimBlock(6)) {}
 };
 
 class SimZBlock : public SimBlock
 {
 public:
-    SimZBlock()
-    {
-        id = 7;
-        cells[0] = {Position(0, 0), Position(0, 1), Position(1, 1), Position(1, 2)};
-        cells[1] = {Position(0, 2), Position(1, 1), Position(1, 2), Position(2, 1)};
-        cells[2] = {Position(1, 0), Position(1, 1), Position(2, 1), Position(2, 2)};
-        cells[3] = {Position(0, 1), Position(1, 0), Position(1, 1), Position(2, 0)};
-        Move(0, 3);
-    }
+    SimZBlock() : SimBlock(MakeSimBlock(7)) {}
 };
@@ -1,6 +1,12 @@
 #include "sim_game.h"
+#include "sim_placement_kernels.h"
 #include "../core/hash.h"
 
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<SimGame>::value,
+              "SimGame copies must stay allocation-free (bot search clones it per placement)");
+
 // [NET/RL] This file is the single source of truth for game logic.
 // Ported line-for-line from src/game.cpp to preserve deterministic state hashes.
 // Do NOT add rendering/audio/platform deps here — those belong in the Game wrapper.
@@ -20,12 +26,11 @@ SimGame::SimGame(uint64_t seed)
       attackLinesSent(0),
       pendingGarbage(0)
 {
-    blocks = GetAllBlocks();
+    RefillBag();
     currentBlock = GetRandomBlock();
-    nextBlocks.reserve(kNextPreviewCount);
     for (int i = 0; i < kNextPreviewCount; ++i)
     {
-        nextBlocks.push_back(GetRandomBlock());
+        nextBlocks[i] = GetRandomBlock();
     }
     ghostBlock = MakeGhostBlock(currentBlock);
     // sim_grid is zero-initialized by its default constructor.
@@ -35,22 +40,34 @@ SimBlock SimGame::GetRandomBlock()
 {
     // [NET] '가방'이 비면 새 가방을 채웁니다. RNG 호출 횟수가 틱/입력 흐름에 따라
     // 달라지지 않도록 주의 — 이 함수가 RNG의 유일한 호출 지점입니다.
-    if (blocks.empty())
+    if (bagSize == 0)
+    {
+        RefillBag();
+    }
+    int randomIndex = rng.nextUInt(static_cast<uint32_t>(bagSize));
+    SimBlock block = bag[randomIndex];
+    // vector::erase 와 같은 의미 — 남은 블록의 상대 순서를 유지해야 인덱스가 같다.
+    for (int i = randomIndex; i + 1 < bagSize; ++i)
     {
-        blocks = GetAllBlocks();
+        bag[i] = bag[i + 1];
     }
-    int randomIndex = rng.nextUInt(static_cast<uint32_t>(blocks.size()));
-    SimBlock block = blocks[randomIndex];
-    blocks.erase(blocks.begin() + randomIndex);
+    bagSize--;
     return block;
 }
 
-std::vector<SimBlock> SimGame::GetAllBlocks() const
+void SimGame::RefillBag()
 {
     // Order MUST match original Game::GetAllBlocks exactly: I,J,L,O,S,T,Z.
-    // The order determines which id is at which vector index, and the RNG
+    // The order determines which id is at which bag index, and the RNG
     // selects by index — changing order breaks state hash parity.
-    return {SimIBlock(), SimJBlock(), SimLBlock(), SimOBlock(), SimSBlock(), SimTBlock(), SimZBlock()};
+    bag[0] = SimIBlock();
+    bag[1] = SimJBlock();
+    bag[2] = SimLBlock();
+    bag[3] = SimOBlock();
+    bag[4] = SimSBlock();
+    bag[5] = SimTBlock();
+    bag[6] = SimZBlock();
+    bagSize = kBagSize;
 }
 
 SimBlock SimGame::MakeGhostBlock(const SimBlock& block) const
@@ -170,8 +187,7 @@ void SimGame::DropExpectation()
 
 bool SimGame::IsBlockOutside(const SimBlock& block) const
 {
-    std::vector<Position> tiles = block.GetCellPositions();
-    for (const Position& item : tiles)
+    for (const Position& item : block.GetCellPositions())
     {
         if (sim_grid.IsCellOutside(item.row, item.column))
         {
@@ -245,10 +261,9 @@ bool SimGame::IsTSpinLock() const
 void SimGame::LockBlock()
 {
     const bool tSpin = IsTSpinLock();
-    std::vector<Position> tiles = currentBlock.GetCellPositions();
-    for (const Position& item : tiles)
+    for (const Position& item : currentBlock.GetCellPositions())
     {
-        sim_grid.grid[item.row][item.column] = currentBlock.id;
+        sim_grid.SetCell(item.row, item.column, currentBlock.id);
     }
     currentBlock = NextBlock();
     ghostBlock = MakeGhostBlock(currentBlock);
@@ -258,8 +273,11 @@ void SimGame::LockBlock()
         gameOver = true;
     }
 
-    nextBlocks.erase(nextBlocks.begin());
-    nextBlocks.push_back(GetRandomBlock());
+    for (int i = 0; i + 1 < kNextPreviewCount; ++i)
+    {
+        nextBlocks[i] = nextBlocks[i + 1];
+    }
+    nextBlocks[kNextPreviewCount - 1] = GetRandomBlock();
     int rowsCleared = sim_grid.ClearFullRows();
     lastLinesCleared = rowsCleared;
     lastTSpinLines = tSpin ? rowsCleared : -1;
@@ -294,36 +312,15 @@ void SimGame::InsertGarbage(int rows)
     if (rows > SimGrid::kRows) rows = SimGrid::kRows;
 
     // 기존 행을 위로 밀어올린다 — 상단 rows 만큼은 소실 (오버플로우는 게임오버 처리).
-    for (int r = 0; r + rows < SimGrid::kRows; r++)
-    {
-        for (int c = 0; c < SimGrid::kCols; c++)
-        {
-            sim_grid.grid[r][c] = sim_grid.grid[r + rows][c];
-        }
-    }
     // 하단 rows 행은 가비지 (id=9, 홀 1개). 한 공격 묶음은 동일 홀 컬럼 공유.
     int hole = static_cast<int>(garbageRng.nextUInt(SimGrid::kCols));
-    for (int i = 0; i < rows; i++)
-    {
-        int gr = SimGrid::kRows - 1 - i;
-        for (int c = 0; c < SimGrid::kCols; c++)
-        {
-            sim_grid.grid[gr][c] = (c == hole) ? 0 : 9;
-        }
-    }
+    sim_grid.PushGarbageRows(rows, hole);
 }
 
 bool SimGame::BlockFits(const SimBlock& block) const
 {
-    std::vector<Position> tiles = block.GetCellPositions();
-    for (const Position& item : tiles)
-    {
-        if (sim_grid.IsCellEmpty(item.row, item.column) == false)
-        {
-            return false;
-        }
-    }
-    return true;
+    // 범위 밖 셀도 '막힘'으로 판정하므로 IsBlockOutside 검사를 겸한다.
+    return sim_grid.Fits(block.rowOffset, block.columnOffset, block.RowMasks());
 }
 
 void SimGame::UpdateScore(int linesCleared, int levelUp, bool tSpin)
@@ -420,6 +417,206 @@ SimGame::HashBreakdown SimGame::StateHashBreakdown() const
     return b;
 }
 
+uint64_t SimGame::Fingerprint() const
+{
+    // StateHash 가 덮는 필드를 빠짐없이 섞는다. 블록 좌표·회전과 카운터들은
+    // 작은 정수라 워드 하나에 둘씩 묶어 mix 횟수를 줄인다.
+    auto packBlock = [](const SimBlock& b) {
+        return static_cast<uint64_t>(static_cast<uint8_t>(b.id))
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.rotationState)) << 8
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.rowOffset)) << 16
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.columnOffset)) << 24;
+    };
+    auto mix = [](uint64_t h, uint64_t v) { return splitmix64(h ^ v); };
+
+    uint64_t h = sim_grid.Fingerprint();
+    h = mix(h, packBlock(currentBlock));
+    for (const SimBlock& next : nextBlocks) h = mix(h, packBlock(next));
+    h = mix(h, rng.getState());
+    h = mix(h, static_cast<uint32_t>(score));
+    h = mix(h, static_cast<uint64_t>(static_cast<uint32_t>(gravityCounterTicks))
+             | static_cast<uint64_t>(static_cast<uint32_t>(dropIntervalTicks)) << 32);
+    h = mix(h, static_cast<uint64_t>(static_cast<uint32_t>(softDropCounterTicks))
+             | static_cast<uint64_t>(static_cast<uint32_t>(totalLinesCleared)) << 32);
+    h = mix(h, static_cast<uint64_t>(static_cast<uint32_t>(level))
+             | static_cast<uint64_t>(gameOver ? 1 : 0) << 32
+             | static_cast<uint64_t>(lastMoveWasRotate ? 1 : 0) << 33);
+    h = mix(h, garbageRng.getState());
+    h = mix(h, static_cast<uint64_t>(static_cast<uint32_t>(attackLinesSent))
+             | static_cast<uint64_t>(static_cast<uint32_t>(pendingGarbage)) << 32);
+    return h;
+}
+
+uint64_t SimGame::PositionKey() const
+{
+    auto packBlock = [](const SimBlock& b) {
+        return static_cast<uint64_t>(static_cast<uint8_t>(b.id))
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.rotationState)) << 8
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.rowOffset)) << 16
+             | static_cast<uint64_t>(static_cast<uint8_t>(b.columnOffset)) << 24;
+    };
+    auto mix = [](uint64_t h, uint64_t v) { return splitmix64(h ^ v); };
+
+    // 미리보기 블록은 회전·좌표가 스폰값으로 고정이라 id 만 본다.
+    uint64_t queue = static_cast<uint64_t>(bagSize);
+    for (int i = 0; i < kNextPreviewCount; ++i)
+        queue |= static_cast<uint64_t>(static_cast<uint8_t>(nextBlocks[i].id)) << (8 + 4 * i);
+    for (int i = 0; i < bagSize; ++i)
+        queue |= static_cast<uint64_t>(static_cast<uint8_t>(bag[i].id)) << (32 + 4 * i);
+
+    uint64_t h = sim_grid.Fingerprint();
+    h = mix(h, packBlock(currentBlock)
+             | static_cast<uint64_t>(gameOver ? 1 : 0) << 32
+             | static_cast<uint64_t>(lastMoveWasRotate ? 1 : 0) << 33);
+    h = mix(h, queue);
+    h = mix(h, rng.getState());
+    h = mix(h, garbageRng.getState());
+    h = mix(h, static_cast<uint32_t>(pendingGarbage));
+    return h;
+}
+
+// RefillBag 의 슬롯 순서(I,J,L,O,S,T,Z)를 id 로 적은 것. 스냅샷의 bagMask 비트 i 가 이 슬롯이다.
+static constexpr int kBagSlotIds[7] = {3, 2, 1, 4, 5, 6, 7};
+
+SimSnapshot SimGame::Snapshot() const
+{
+    SimSnapshot snap{};
+    snap.version = SimSnapshot::kVersion;
+    snap.rngState = rng.getState();
+    snap.garbageRngState = garbageRng.getState();
+    snap.score = score;
+    snap.totalLinesCleared = totalLinesCleared;
+    snap.attackLinesSent = attackLinesSent;
+    snap.pendingGarbage = pendingGarbage;
+
+    for (int r = 0; r < SimGrid::kRows; ++r)
+    {
+        bool garbageRow = false;
+        for (int c = 0; c < SimGrid::kCols; ++c)
+        {
+            const int id = sim_grid.grid[r][c];
+            int code = id;
+            if (id == 9) { garbageRow = true; code = 1; }
+            const int bit = 3 * (r * SimGrid::kCols + c);
+            // 3비트가 바이트 경계를 넘을 수 있어 두 바이트에 나눠 쓴다.
+            snap.grid[bit >> 3] |= static_cast<uint8_t>(code << (bit & 7));
+            if ((bit & 7) > 5) snap.grid[(bit >> 3) + 1] |= static_cast<uint8_t>(code >> (8 - (bit & 7)));
+        }
+        if (garbageRow) snap.garbageRows[r >> 3] |= static_cast<uint8_t>(1u << (r & 7));
+    }
+
+    snap.currentId = static_cast<uint8_t>(currentBlock.id);
+    snap.currentRotation = static_cast<uint8_t>(currentBlock.rotationState);
+    snap.currentRow = static_cast<int8_t>(currentBlock.rowOffset);
+    snap.currentCol = static_cast<int8_t>(currentBlock.columnOffset);
+    snap.ghostRow = static_cast<int8_t>(ghostBlock.rowOffset);
+    for (int i = 0; i < kNextPreviewCount; ++i)
+    {
+        snap.nextIds[i] = static_cast<uint8_t>(nextBlocks[i].id);
+    }
+    for (int i = 0; i < bagSize; ++i)
+    {
+        for (int slot = 0; slot < kBagSize; ++slot)
+        {
+            if (kBagSlotIds[slot] == bag[i].id) snap.bagMask |= static_cast<uint8_t>(1u << slot);
+        }
+    }
+
+    snap.gravityCounterTicks = static_cast<uint8_t>(gravityCounterTicks);
+    snap.dropIntervalTicks = static_cast<uint8_t>(dropIntervalTicks);
+    snap.softDropCounterTicks = static_cast<uint8_t>(softDropCounterTicks);
+    snap.level = static_cast<uint8_t>(level);
+    snap.flags = static_cast<uint8_t>((gameOver ? 1u : 0u) | (lastMoveWasRotate ? 2u : 0u));
+    return snap;
+}
+
+bool SimGame::Restore(const SimSnapshot& snap)
+{
+    auto validId = [](int id) { return id >= 1 && id <= 7; };
+    if (snap.version != SimSnapshot::kVersion) return false;
+    if (!validId(snap.currentId) || snap.currentRotation >= SimBlock::kNumRotations) return false;
+    for (uint8_t id : snap.nextIds)
+    {
+        if (!validId(id)) return false;
+    }
+    if (snap.bagMask >> kBagSize) return false;
+    // XorShift 상태 0 은 생성자가 기본 시드로 바꿔 버리므로 왕복이 안 된다.
+    if (snap.rngState == 0 || snap.garbageRngState == 0) return false;
+    if (snap.dropIntervalTicks == 0 || snap.level < 1 || snap.level > 20) return false;
+    if (snap.pendingGarbage < 0 || (snap.flags >> 2) != 0) return false;
+    if (snap.garbageRows[2] >> (SimGrid::kRows - 16)) return false;
+
+    // 그리드와 블록은 지역 사본에 먼저 풀어 검사한다. 검사가 끝나기 전에는 this 를 건드리지 않는다.
+    SimGrid grid;
+    grid.Initialize();
+    for (int r = 0; r < SimGrid::kRows; ++r)
+    {
+        const bool garbageRow = (snap.garbageRows[r >> 3] >> (r & 7)) & 1u;
+        for (int c = 0; c < SimGrid::kCols; ++c)
+        {
+            const int bit = 3 * (r * SimGrid::kCols + c);
+            int code = snap.grid[bit >> 3] >> (bit & 7);
+            if ((bit & 7) > 5) code |= snap.grid[(bit >> 3) + 1] << (8 - (bit & 7));
+            code &= 7;
+            if (code != 0) grid.SetCell(r, c, garbageRow ? 9 : code);
+        }
+    }
+
+    // 현재 블록·ghost 의 위치는 LockBlock 이 그대로 SetCell 에 넘기는 좌표라, 범위를 믿으면
+    // 외부 바이트열이 그리드 밖을 쓰게 된다. 두 블록 모두 그리드 안이어야 하고, 게임 오버가
+    // 아니면 현재 블록은 굳은 셀과 겹칠 수 없다(스폰이 막히면 그 자리에서 gameOver 가 선다).
+    SimBlock current = MakeSimBlock(snap.currentId);
+    current.rotationState = snap.currentRotation;
+    current.rowOffset = snap.currentRow;
+    current.columnOffset = snap.currentCol;
+    SimBlock ghost = MakeGhostBlock(current);
+    ghost.rowOffset = snap.ghostRow;
+    auto insideGrid = [&grid](const SimBlock& block) {
+        for (const Position& item : block.GetCellPositions())
+        {
+            if (grid.IsCellOutside(item.row, item.column)) return false;
+        }
+        return true;
+    };
+    if (!insideGrid(current) || !insideGrid(ghost)) return false;
+    if ((snap.flags & 1u) == 0 && !grid.Fits(current.rowOffset, current.columnOffset, current.RowMasks()))
+        return false;
+
+    sim_grid = grid;
+    currentBlock = current;
+    ghostBlock = ghost;
+    for (int i = 0; i < kNextPreviewCount; ++i)
+    {
+        nextBlocks[i] = MakeSimBlock(snap.nextIds[i]);
+    }
+    bagSize = 0;
+    for (int slot = 0; slot < kBagSize; ++slot)
+    {
+        if ((snap.bagMask >> slot) & 1u) bag[bagSize++] = MakeSimBlock(kBagSlotIds[slot]);
+    }
+
+    rng = XorShift64Star(snap.rngState);
+    garbageRng = XorShift64Star(snap.garbageRngState);
+    score = snap.score;
+    totalLinesCleared = snap.totalLinesCleared;
+    attackLinesSent = snap.attackLinesSent;
+    pendingGarbage = snap.pendingGarbage;
+    gravityCounterTicks = snap.gravityCounterTicks;
+    dropIntervalTicks = snap.dropIntervalTicks;
+    softDropCounterTicks = snap.softDropCounterTicks;
+    level = snap.level;
+    gameOver = (snap.flags & 1u) != 0;
+    lastMoveWasRotate = (snap.flags & 2u) != 0;
+
+    rotateSoundEvent = clearSoundEvent = dropSoundEvent = garbageSoundEvent = false;
+    hardDropEvent = false;
+    lastLinesCleared = 0;
+    lastTSpinLines = -1;
+    lastGarbageReceived = 0;
+    gameOverEvent = false;
+    return true;
+}
+
 uint64_t SimGame::StateHash() const
 {
     uint64_t h = 14695981039346656037ull;
@@ -467,36 +664,61 @@ uint64_t SimGame::StateHash() const
 // Placement-level API (for RL training — not exercised by the lockstep game).
 // ============================================================================
 
+bool SimGame::LandingRow(int col, int rot, const uint32_t (&columnMasks)[SimGrid::kCols],
+                         int& rowOut) const
+{
+    // 회전 → 이동은 스폰 높이(currentBlock.rowOffset)에서 검사한다. 예전 구현이
+    // 회전·이동한 블록을 그 자리에서 BlockFits 로 거르던 것과 같은 조건이다.
+    // col 은 bounding box 기준이라 음수일 수 있다(I 세로 등). 벽 밖이면 Fits 가 거른다.
+    const int shape = currentBlock.shape;
+    const int startRow = currentBlock.rowOffset;
+    if (!sim_grid.Fits(startRow, col, sim_shapes::kRowMasks.rows[shape][rot])) return false;
+
+    // 열마다 블록 바닥 칸 아래로 첫 막힌 행까지의 거리를 재서 최솟값만큼 떨어진다.
+    // 열 안의 칸이 연속이므로 위쪽 칸은 바닥 칸이 이미 지나온 행만 지난다.
+    const int8_t* bottom = sim_shapes::kBottomProfiles.bottom[shape][rot];
+    int drop = SimGrid::kRows;
+    for (int j = 0; j < 4; ++j)
+    {
+        if (bottom[j] < 0) continue;
+        const int below = startRow + bottom[j] + 1;
+        const int gap = SimGrid::FirstBlockedRow(columnMasks[col + j], below) - below;
+        if (gap < drop) drop = gap;
+    }
+    rowOut = startRow + drop;
+    return true;
+}
+
+int SimGame::EnumeratePlacements(LandedPlacement (&out)[kMaxPlacements]) const
+{
+    if (gameOver) return 0;
+    return sim_kernels::kEnumerateKernels[currentBlock.shape](sim_grid, currentBlock.rowOffset,
+                                                              false, out);
+}
+
+int SimGame::EnumerateDistinctPlacements(LandedPlacement (&out)[kMaxPlacements]) const
+{
+    if (gameOver) return 0;
+    return sim_kernels::kEnumerateKernels[currentBlock.shape](sim_grid, currentBlock.rowOffset,
+                                                              true, out);
+}
+
 std::vector<SimGame::Placement> SimGame::LegalPlacements() const
 {
+    // 커널과 따로 둔 참조 구현. (shape, rot) 를 런타임 인덱스로 받는 LandingRow 하나로
+    // 전부 센다 — ApplyPlacement 가 합법성을 보는 것과 같은 경로다.
     std::vector<Placement> out;
     if (gameOver) return out;
 
-    const int numRotations = static_cast<int>(currentBlock.cells.size());
-    for (int rot = 0; rot < numRotations; rot++)
+    uint32_t columnMasks[SimGrid::kCols];
+    sim_grid.ColumnMasks(columnMasks);
+    out.reserve(kMaxPlacements);
+    for (int rot = 0; rot < SimBlock::kNumRotations; rot++)
     {
         for (int col = 0; col < SimGrid::kCols; col++)
         {
-            // Start from a fresh copy of the live piece.
-            SimBlock test = currentBlock;
-            // Rotate in place to the target rotation.
-            while (test.rotationState != rot)
-            {
-                test.Rotate();
-            }
-            // Slide horizontally to the target column offset.
-            int delta = col - test.columnOffset;
-            test.columnOffset += delta;
-            // Reject if the rotated & translated piece is invalid at spawn height.
-            if (IsBlockOutside(test) || !BlockFits(test)) continue;
-            // Hard drop simulation.
-            while (IsBlockOutside(test) == false && BlockFits(test) == true)
-            {
-                test.rowOffset++;
-            }
-            test.rowOffset--;
-            if (IsBlockOutside(test) || !BlockFits(test)) continue;
-            out.push_back({col, rot});
+            int row;
+            if (LandingRow(col, rot, columnMasks, row)) out.push_back({col, rot});
         }
     }
     return out;
@@ -505,32 +727,39 @@ std::vector<SimGame::Placement> SimGame::LegalPlacements() const
 int SimGame::ApplyPlacement(int col, int rot)
 {
     if (gameOver) return -1;
+    if (rot < 0 || rot >= SimBlock::kNumRotations) return -1;
 
-    // Build target configuration from the live currentBlock.
-    SimBlock target = currentBlock;
-    const int numRotations = static_cast<int>(target.cells.size());
-    if (rot < 0 || rot >= numRotations) return -1;
-    while (target.rotationState != rot)
-    {
-        target.Rotate();
-    }
-    int delta = col - target.columnOffset;
-    target.columnOffset += delta;
-    if (IsBlockOutside(target) || !BlockFits(target)) return -1;
-    // Hard drop
-    while (IsBlockOutside(target) == false && BlockFits(target) == true)
-    {
-        target.rowOffset++;
-    }
-    target.rowOffset--;
-    if (IsBlockOutside(target) || !BlockFits(target)) return -1;
+    uint32_t columnMasks[SimGrid::kCols];
+    sim_grid.ColumnMasks(columnMasks);
+    int row;
+    if (!LandingRow(col, rot, columnMasks, row)) return -1;
+    return CommitPlacement(col, rot, row);
+}
 
+int SimGame::ApplyLandedPlacement(const LandedPlacement& p)
+{
+    if (gameOver) return -1;
+    if (p.rot < 0 || p.rot >= SimBlock::kNumRotations) return -1;
+
+    // Python 등 외부에서 들어온 값일 수 있으므로 착지 행을 한 번 더 맞춰 본다.
+    // 표면 마스크 비교 몇 번이라 낙하 시뮬레이션이 아니다.
+    uint32_t columnMasks[SimGrid::kCols];
+    sim_grid.ColumnMasks(columnMasks);
+    int row;
+    if (!LandingRow(p.col, p.rot, columnMasks, row) || row != p.row) return -1;
+    return CommitPlacement(p.col, p.rot, p.row);
+}
+
+int SimGame::CommitPlacement(int col, int rot, int row)
+{
     // Snapshot cleared-line count before lock. Score is level-scaled, so it
     // cannot be inverted back to a line count after level 1.
     int linesBefore = totalLinesCleared;
 
     // Commit: overwrite currentBlock with the landed configuration and lock.
-    currentBlock = target;
+    currentBlock.rotationState = rot;
+    currentBlock.columnOffset = col;
+    currentBlock.rowOffset = row;
     lastMoveWasRotate = false;
     LockBlock();
 
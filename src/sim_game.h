@@ -1,5 +1,7 @@
 #pragma once
+#include <array>
 #include <cstdint>
+#include <type_traits>
 #include <vector>
 #include "sim_grid.h"
 #include "sim_block.h"
@@ -8,6 +10,50 @@
 #include "../core/input.h"
 #include "../core/constants.h"
 
+// 고정 크기 상태 스냅샷 — SimGame::Snapshot()/Restore() 의 직렬화 형식.
+// 롤백 넷코드, MCTS 노드, 리플레이 탐색, 분산 학습처럼 상태를 대량으로 저장하는
+// 곳에서 SimGame 전체(~1.3KB, 행 마스크·Zobrist 키 같은 파생 데이터 포함) 대신
+// 쓴다. 128바이트 POD 라 memcpy·바이트열 전송이 그대로 된다. 정수 필드는 호스트
+// 바이트 순서(지원 플랫폼은 모두 리틀엔디안)다.
+//
+// 생략하는 것은 전부 다른 필드에서 다시 만들 수 있는 값이다.
+//   · 그리드: 셀당 3비트(0 빈칸, 1..7 블록). 가비지(id 9)는 가비지 행에만 있고
+//     가비지 행에는 블록 셀이 섞이지 않으므로(구멍이 메워지면 그 줄은 즉시 지워진다)
+//     garbageRows 의 행 비트로 복원한다. ghost(8)는 그리드에 쓰이지 않는다.
+//   · next 큐: 가방에서 막 뽑힌 스폰 상태 블록이라 id 만 있으면 된다.
+//   · 가방: RefillBag 순서의 부분열이라 남은 슬롯 비트마스크 7비트.
+//   · ghost: 회전·열은 현재 블록과 같고 행만 따로 둔다.
+// 오디오/렌더용 1회 이벤트 플래그(rotateSoundEvent, lastLinesCleared 등)는 상태가
+// 아니므로 담지 않는다. Restore 는 그것들을 기본값으로 돌린다.
+struct SimSnapshot
+{
+    static constexpr uint8_t kVersion = 1;
+    static constexpr int kGridBytes = (SimGrid::kRows * SimGrid::kCols * 3 + 7) / 8;  // 75
+
+    uint64_t rngState;
+    uint64_t garbageRngState;
+    int32_t score;
+    int32_t totalLinesCleared;
+    int32_t attackLinesSent;
+    int32_t pendingGarbage;
+    uint8_t grid[kGridBytes];        // 셀 (r*kCols + c) 가 비트 3*(r*kCols + c) 부터
+    uint8_t garbageRows[3];          // 비트 r = 행 r 이 가비지 행
+    uint8_t currentId;
+    uint8_t currentRotation;
+    int8_t currentRow;
+    int8_t currentCol;
+    int8_t ghostRow;
+    uint8_t nextIds[3];
+    uint8_t bagMask;                 // 비트 i = RefillBag 의 슬롯 i 가 아직 남음
+    uint8_t gravityCounterTicks;
+    uint8_t dropIntervalTicks;
+    uint8_t softDropCounterTicks;
+    uint8_t level;
+    uint8_t flags;                   // bit0 gameOver, bit1 lastMoveWasRotate
+    uint8_t version;
+    uint8_t reserved[3];
+};
+
 // [NET/RL] Headless Tetris simulation. No renderer, no audio, no I/O.
 //
 // SimGame is the single source of truth for game logic and must produce the
@@ -18,6 +64,10 @@
 //   - placement-level (RL):                LegalPlacements() + ApplyPlacement(col, rot)
 //
 // Observations for Python/pybind11 are exposed via accessor methods.
+//
+// 상태는 전부 고정 크기 멤버라 SimGame 은 trivially copyable 하다. 복사 한 번이
+// 힙 할당 없는 memcpy 라서 heuristic_placement 처럼 착수마다 보드를 복제하는
+// 탐색 코드가 부담 없이 복사본을 만들 수 있다.
 class SimGame
 {
 public:
@@ -39,6 +89,29 @@ public:
     // Returns the number of lines cleared, or -1 if the placement is illegal.
     int ApplyPlacement(int col, int rot);
 
+    // 착지 행까지 계산된 placement. row 는 hard drop 후 currentBlock 의 rowOffset.
+    struct LandedPlacement
+    {
+        int col;
+        int rot;
+        int row;
+    };
+    static constexpr int kMaxPlacements = SimGrid::kCols * SimBlock::kNumRotations;  // 40
+    // LegalPlacements 의 할당 없는 fast path. 열별 표면(점유 마스크)과 블록의
+    // (shape, rot) 바닥 프로파일로 착지 행을 O(1) 에 구한다 — 한 줄씩 떨어뜨려 보는
+    // 시뮬레이션이 없다. 블록 종류별로 특수화한 커널(sim_placement_kernels.h)을 쓴다.
+    // 순서는 LegalPlacements 와 같다(rot 오름차순, 그 안에서 col).
+    // 반환값은 out 에 채운 개수.
+    int EnumeratePlacements(LandedPlacement (&out)[kMaxPlacements]) const;
+    // EnumeratePlacements 에서 회전 대칭으로 같은 칸에 떨어지는 placement 를 뺀 것
+    // (O 의 rot 1..3, I·S·Z 의 rot 2·3 이 대개 빠진다). 남는 쪽은 rot 가 작은 쪽이고
+    // 순서는 같다. 결과 보드만 보는 탐색용 — 액션 공간 전체가 필요하면 위를 쓴다.
+    int EnumerateDistinctPlacements(LandedPlacement (&out)[kMaxPlacements]) const;
+    // EnumeratePlacements 가 돌려준 placement 를 그대로 적용한다. 낙하를 다시
+    // 시뮬레이션하지 않고 row 에 바로 lock 한다. 반환값은 ApplyPlacement 와 같다.
+    // row 가 실제 착지 행과 다르면(다른 상태에서 얻은 placement 등) -1.
+    int ApplyLandedPlacement(const LandedPlacement& p);
+
     // ---- Frame-level action API (for lockstep net play) ----
     void SubmitInput(uint8_t inputMask);
     void Tick();
@@ -48,11 +121,13 @@ public:
     // Returns a const reference to the raw 20x10 grid. Layout matches old
     // Grid::grid for bitwise hash parity.
     const int (&Grid() const)[SimGrid::kRows][SimGrid::kCols] { return sim_grid.grid; }
+    // row 행의 굳은 칸 마스크(비트 c = 열 c, ghost 제외). 증분 유지되므로 O(1).
+    uint16_t RowMask(int row) const { return sim_grid.RowMask(row); }
 
     const SimBlock& CurrentBlock() const { return currentBlock; }
     const SimBlock& GhostBlock() const { return ghostBlock; }
     const SimBlock& NextBlock() const { return nextBlocks.front(); }
-    const std::vector<SimBlock>& NextBlocks() const { return nextBlocks; }
+    const std::array<SimBlock, kNextPreviewCount>& NextBlocks() const { return nextBlocks; }
 
     int CurrentBlockId() const { return currentBlock.id; }
     int CurrentRotation() const { return currentBlock.rotationState; }
@@ -61,12 +136,29 @@ public:
     int NextBlockId() const { return NextBlock().id; }
     int Score() const { return score; }
     bool IsGameOver() const { return gameOver; }
+    // 프레임 단위 이동 규칙의 내부 상태. 지금 상태에서 이어지는 입력 경로를 찾는
+    // 쪽(bot/reachability.h)이 읽는다. 다음 lock 의 T-spin 판정과 DOWN 의 즉시 반응 여부.
+    bool LastMoveWasRotate() const { return lastMoveWasRotate; }
+    int SoftDropCounterTicks() const { return softDropCounterTicks; }
 
     // ---- Determinism / debugging ----
     // Matches Game::ComputeStateHash bitwise (hash parity gate).
     uint64_t StateHash() const;
     uint64_t RngState() const { return rng.getState(); }
 
+    // 빠른 상태 지문. StateHash 와 같은 필드를 덮지만 그리드 부분은 SimGrid 가
+    // lock·줄 삭제·가비지 때 증분으로 유지하는 Zobrist 값을 쓰므로 800바이트를
+    // 다시 훑지 않는다. 값은 StateHash 와 다르다 — 전송·리플레이·패리티에는
+    // 계속 StateHash 를 쓰고, 이것은 프로세스 안 캐시 키(전치표 등)와 로컬
+    // desync 조기 감지용이다. 버전 간 값 안정성도 보장하지 않는다.
+    uint64_t Fingerprint() const;
+    // 탐색용 위치 키. 보드와 블록 상태(지금 블록, 미리보기, 가방, 두 RNG, 받을
+    // 가비지)만 섞고 점수·지운 줄 수·레벨·틱 카운터는 뺀다. 착수 단위 전개에
+    // 영향을 주지 않는 값이라, 다른 순서로 같은 판에 온 수순이 같은 키를 갖는다.
+    // 전치표(bot/transposition.h) 키용이며 Fingerprint 와 같은 조건으로만 쓴다.
+    uint64_t PositionKey() const;
+    uint64_t GridFingerprint() const { return sim_grid.Fingerprint(); }
+
     // DESYNC 원인 특정용 섹션별 해시. 두 인스턴스에서 이 값을 비교하면 어느
     // 부분(그리드/블록/RNG/콤바트)이 달라졌는지 즉시 좁힐 수 있다.
     struct HashBreakdown {
@@ -79,6 +171,15 @@ public:
     };
     HashBreakdown StateHashBreakdown() const;
 
+    // ---- Snapshot / restore ----
+    // 현재 상태를 SimSnapshot 으로 포장한다. Restore(Snapshot()) 뒤의 StateHash 는
+    // 원본과 같고, 이후 같은 입력에 같은 전개를 한다(가방·RNG·ghost 포함).
+    SimSnapshot Snapshot() const;
+    // 스냅샷을 이 인스턴스에 푼다. 버전이나 필드 범위가 맞지 않거나, 현재 블록·ghost 가
+    // 그리드 밖이거나, 게임 오버가 아닌데 현재 블록이 굳은 셀과 겹치면(손상되었거나
+    // 외부에서 만든 바이트열) false 를 돌려주고 상태를 건드리지 않는다.
+    bool Restore(const SimSnapshot& snap);
+
     // ---- Combat API (Section I) ----
     // attackLinesSent: 세션 전체 누적 공격 라인 수. 외부에서 델타를 뽑아
     //   상대 SimGame::AddPendingGarbage 로 전달한다. 네트워크 프레임 없음.
@@ -126,23 +227,29 @@ private:
     void UpdateScore(int linesCleared, int levelUp, bool tSpin);
     void InsertGarbage(int rows);
 
+    bool LandingRow(int col, int rot, const uint32_t (&columnMasks)[SimGrid::kCols],
+                    int& rowOut) const;
+    int CommitPlacement(int col, int rot, int row);
     bool IsTSpinLock() const;
     bool IsBlockOutside(const SimBlock& block) const;
     bool BlockFits(const SimBlock& block) const;
 
     SimBlock GetRandomBlock();
-    std::vector<SimBlock> GetAllBlocks() const;
+    void RefillBag();
     SimBlock MakeGhostBlock(const SimBlock& block) const;
 
     SimGrid sim_grid;
-    std::vector<SimBlock> blocks;
+    // 7-bag. 남은 블록이 앞쪽 bagSize 칸에 원래 순서대로 모여 있다.
+    static constexpr int kBagSize = 7;
+    SimBlock bag[kBagSize];
+    int bagSize = 0;
     XorShift64Star rng;
     // 가비지 홀 컬럼용 별도 RNG 스트림. 시드에서 유도되어 양쪽 클라이언트가
     // 동일한 홀 시퀀스를 뽑는다. piece-bag RNG 와 상태가 섞이지 않음이 중요.
     XorShift64Star garbageRng;
     SimBlock currentBlock;
     SimBlock ghostBlock;
-    std::vector<SimBlock> nextBlocks;
+    std::array<SimBlock, kNextPreviewCount> nextBlocks;
 
     int gravityCounterTicks;
     int dropIntervalTicks;
@@ -160,3 +267,7 @@ private:
     int attackLinesSent = 0;
     int pendingGarbage = 0;
 };
+
+static_assert(sizeof(SimSnapshot) == 128, "SimSnapshot wire size");
+static_assert(std::is_trivially_copyable<SimSnapshot>::value &&
+              std::is_standard_layout<SimSnapshot>::value, "SimSnapshot must stay POD");
@@ -1,26 +1,74 @@
 #pragma once
+#include <cstdint>
+#include <cstring>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+#include "../core/rng.h"
 
 // [NET/RL] Pure, headless grid. No renderer, no rendering.
 // Layout (int grid[kRows][kCols]) must match the old Grid class so that
 // ComputeStateHash produces identical bytes when fnv1a64 is applied to the
 // contiguous memory range.
+//
+// 비트보드: id 그리드 옆에 행마다 uint16_t 점유 마스크(비트 c = 열 c)를 함께 들고
+// 있다. 줄 완성 판정은 마스크 비교 한 번, 줄 삭제는 행 단위 memmove, 충돌 판정은
+// 블록의 행 마스크와 AND 몇 번으로 끝난다. 마스크는 파생 데이터라 해시에 들어가지
+// 않는다 — 그리드를 바꾸는 경로가 전부 아래 멤버 함수를 거쳐야 둘이 어긋나지 않는다.
+//
+// Zobrist 지문: 같은 경로에서 그리드 지문(Fingerprint)도 증분으로 갱신한다. 행마다
+// (열, id) 키를 XOR 한 rowKey 를 두고, 그리드 지문은 행 번호로 섞은 rowKey 들의
+// XOR 이다. 셀 하나를 쓰면 O(1), 줄 삭제·가비지처럼 행이 통째로 밀리면 20개 행
+// 항을 다시 접는다. FNV StateHash(와이어/패리티 해시)와 값은 다르며 대체하지 않는다.
+namespace sim_zobrist {
+
+// 그리드 지문 키. splitmix64 로 컴파일 타임에 뽑는다. 빈칸(id 0) 키는 0 이라 빈
+// 셀은 행 키에 기여하지 않는다. 크기는 SimGrid 의 kRows/kCols/kNumCellIds 와 같다.
+constexpr int kRows = 20;
+constexpr int kCols = 10;
+constexpr int kNumCellIds = 10;
+
+struct Table
+{
+    uint64_t cell[kCols][kNumCellIds];
+    uint64_t rowSalt[kRows];
+};
+
+constexpr Table MakeKeys()
+{
+    Table t{};
+    uint64_t seed = 0x5A0B5715C0FFEE00ull;
+    for (int c = 0; c < kCols; ++c)
+        for (int id = 1; id < kNumCellIds; ++id)
+            t.cell[c][id] = splitmix64(seed++);
+    for (int r = 0; r < kRows; ++r)
+        t.rowSalt[r] = splitmix64(seed++);
+    return t;
+}
+
+constexpr Table kKeys = MakeKeys();
+
+}  // namespace sim_zobrist
+
 class SimGrid
 {
 public:
     static constexpr int kRows = 20;
     static constexpr int kCols = 10;
+    static constexpr uint16_t kFullRowMask = static_cast<uint16_t>((1u << kCols) - 1);
+    // 셀 id 범위: 0 빈칸, 1..7 블록, 8 ghost, 9 가비지.
+    static constexpr int kNumCellIds = 10;
+    static_assert(kRows == sim_zobrist::kRows && kCols == sim_zobrist::kCols &&
+                  kNumCellIds == sim_zobrist::kNumCellIds, "Zobrist table size");
 
     SimGrid() { Initialize(); }
 
     void Initialize()
     {
-        for (int row = 0; row < kRows; row++)
-        {
-            for (int column = 0; column < kCols; column++)
-            {
-                grid[row][column] = 0;
-            }
-        }
+        std::memset(grid, 0, sizeof(grid));
+        std::memset(rowMask, 0, sizeof(rowMask));
+        std::memset(rowKey, 0, sizeof(rowKey));
+        RefoldFingerprint();
     }
 
     bool IsCellOutside(int row, int column) const
@@ -42,61 +90,167 @@ public:
         {
             return false;
         }
-        if (grid[row][column] == 0 || grid[row][column] == 8)
+        return ((rowMask[row] >> column) & 1u) == 0;
+    }
+
+    // 셀 하나를 쓴다. 0(빈칸)과 8(ghost)은 점유로 치지 않는다 — IsCellEmpty 의
+    // 기존 규칙과 같다. grid 를 쓰는 유일한 셀 단위 경로다.
+    void SetCell(int row, int column, int id)
+    {
+        const uint64_t oldKey = rowKey[row];
+        rowKey[row] ^= sim_zobrist::kKeys.cell[column][grid[row][column]] ^ sim_zobrist::kKeys.cell[column][id];
+        fingerprint ^= RowTerm(oldKey, row) ^ RowTerm(rowKey[row], row);
+        grid[row][column] = id;
+        const uint16_t bit = static_cast<uint16_t>(1u << column);
+        if (id != 0 && id != 8) rowMask[row] |= bit;
+        else                    rowMask[row] &= static_cast<uint16_t>(~bit);
+    }
+
+    uint16_t RowMask(int row) const { return rowMask[row]; }
+
+    // 그리드 내용의 Zobrist 지문. 증분 유지되므로 읽기는 O(1).
+    uint64_t Fingerprint() const { return fingerprint; }
+
+    // 열별 점유 마스크(비트 r = 행 r). kRows 이상 비트는 바닥으로 채워 두므로
+    // FirstBlockedRow 는 항상 답이 있다. 착지 높이 계산(LandingRow)이 쓰는 표면 정보.
+    void ColumnMasks(uint32_t (&out)[kCols]) const
+    {
+        for (int c = 0; c < kCols; ++c) out[c] = kFloorBits;
+        for (int r = 0; r < kRows; ++r)
         {
-            return true;
+            uint32_t bits = rowMask[r];
+            while (bits)
+            {
+                const int c = LowestSetBit(bits);
+                out[c] |= 1u << r;
+                bits &= bits - 1;
+            }
         }
-        return false;
+    }
+
+    // columnMask 에서 fromRow 이상인 첫 막힌 행. 없으면 바닥(kRows).
+    static int FirstBlockedRow(uint32_t columnMask, int fromRow)
+    {
+        return fromRow + LowestSetBit(columnMask >> fromRow);
+    }
+
+    static int LowestSetBit(uint32_t bits)
+    {
+    #if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, bits);
+        return static_cast<int>(index);
+    #else
+        return __builtin_ctz(bits);
+    #endif
+    }
+
+    // 블록이 (row, column) 에 놓였을 때 벽·바닥·굳은 셀과 겹치지 않으면 true.
+    // shapeRows[i] 는 블록 bounding box 의 i번째 행 마스크(열 0 기준)다.
+    // 보드 행을 kWallPad 비트만큼 올린 32비트 lane 에 좌우 벽 비트를 채워 두면
+    // 좌우 경계 검사와 충돌 검사가 AND 하나로 합쳐진다.
+    bool Fits(int row, int column, const uint16_t (&shapeRows)[4]) const
+    {
+        if (column < -kWallPad || column > kCols) return false;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (shapeRows[i] == 0) continue;
+            const int r = row + i;
+            if (r < 0 || r >= kRows) return false;
+            const uint32_t lane = (static_cast<uint32_t>(rowMask[r]) << kWallPad) | kWallLane;
+            if (lane & (static_cast<uint32_t>(shapeRows[i]) << (column + kWallPad))) return false;
+        }
+        return true;
     }
 
     int ClearFullRows()
     {
-        int completed = 0;
+        // 아래에서 위로 훑으며 가득 차지 않은 행만 write 위치로 당겨 내린다.
+        // 결과는 행 단위 삭제 + MoveRowDown 을 반복하던 예전 구현과 같다.
+        int write = kRows - 1;
         for (int row = kRows - 1; row >= 0; row--)
         {
-            if (IsRowFull(row))
+            if (IsRowFull(row)) continue;
+            if (write != row)
             {
-                ClearRow(row);
-                completed++;
+                std::memcpy(grid[write], grid[row], sizeof(grid[row]));
+                rowMask[write] = rowMask[row];
+                rowKey[write] = rowKey[row];
             }
-            else if (completed > 0)
+            write--;
+        }
+        const int completed = write + 1;
+        if (completed > 0)
+        {
+            std::memset(grid, 0, sizeof(grid[0]) * completed);
+            std::memset(rowMask, 0, sizeof(rowMask[0]) * completed);
+            std::memset(rowKey, 0, sizeof(rowKey[0]) * completed);
+            RefoldFingerprint();
+        }
+        return completed;
+    }
+
+    // 바닥에서 rows 줄을 밀어 올린다. 상단 rows 줄은 소실되고, 하단 rows 줄은
+    // holeColumn 만 비운 가비지(id=9)로 채운다.
+    void PushGarbageRows(int rows, int holeColumn)
+    {
+        if (rows <= 0) return;
+        if (rows > kRows) rows = kRows;
+        const int kept = kRows - rows;
+        if (kept > 0)
+        {
+            std::memmove(grid[0], grid[rows], sizeof(grid[0]) * kept);
+            std::memmove(&rowMask[0], &rowMask[rows], sizeof(rowMask[0]) * kept);
+            std::memmove(&rowKey[0], &rowKey[rows], sizeof(rowKey[0]) * kept);
+        }
+        uint64_t garbageKey = 0;
+        for (int c = 0; c < kCols; c++)
+        {
+            if (c != holeColumn) garbageKey ^= sim_zobrist::kKeys.cell[c][9];
+        }
+        for (int r = kept; r < kRows; r++)
+        {
+            for (int c = 0; c < kCols; c++)
             {
-                MoveRowDown(row, completed);
+                grid[r][c] = (c == holeColumn) ? 0 : 9;
             }
+            rowMask[r] = static_cast<uint16_t>(kFullRowMask & ~(1u << holeColumn));
+            rowKey[r] = garbageKey;
         }
-        return completed;
+        RefoldFingerprint();
     }
 
     // Public: matches old Grid::grid layout for hash parity.
+    // 읽기 전용으로 취급할 것 — 직접 쓰면 rowMask·지문이 어긋난다. 쓰기는 SetCell.
     int grid[kRows][kCols];
 
 private:
+    // lane 의 하위 kWallPad 비트는 왼쪽 벽, kCols+kWallPad 이상은 오른쪽 벽.
+    static constexpr int kWallPad = 4;
+    static constexpr uint32_t kFloorBits = ~0u << kRows;
+    static constexpr uint32_t kWallLane =
+        ((1u << kWallPad) - 1) | (~0u << (kCols + kWallPad));
+
     bool IsRowFull(int row) const
     {
-        for (int column = 0; column < kCols; column++)
-        {
-            if (grid[row][column] == 0)
-            {
-                return false;
-            }
-        }
-        return true;
+        return rowMask[row] == kFullRowMask;
     }
 
-    void ClearRow(int row)
+    // 행 내용 키를 행 번호와 섞는다. XOR 만으로 접으면 행이 밀려도 지문이
+    // 같아질 수 있어 비선형 mix 를 한 번 거친다.
+    static uint64_t RowTerm(uint64_t key, int row)
     {
-        for (int column = 0; column < kCols; column++)
-        {
-            grid[row][column] = 0;
-        }
+        return splitmix64(key ^ sim_zobrist::kKeys.rowSalt[row]);
     }
 
-    void MoveRowDown(int row, int numRowsDown)
+    void RefoldFingerprint()
     {
-        for (int column = 0; column < kCols; column++)
-        {
-            grid[row + numRowsDown][column] = grid[row][column];
-            grid[row][column] = 0;
-        }
+        uint64_t f = 0;
+        for (int r = 0; r < kRows; ++r) f ^= RowTerm(rowKey[r], r);
+        fingerprint = f;
     }
+
+    uint16_t rowMask[kRows];
+    uint64_t rowKey[kRows];
+    uint64_t fingerprint;
 };
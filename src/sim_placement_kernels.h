@@ -0,0 +1,121 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+
+#include "sim_game.h"
+#include "sim_grid.h"
+#include "sim_shapes.h"
+
+// [NET/RL] 블록 종류별로 특수화한 placement 열거 커널.
+//
+// SimGame::LandingRow 는 (shape, rot) 를 런타임 인덱스로 받아 표를 읽고, 칸이 없는
+// 행·열도 루프 안에서 건너뛴다. 여기서는 shape 와 rot 가 템플릿 인자라 행 마스크·
+// 바닥 프로파일·벽 안 열 범위가 전부 상수다. 컴파일러가 충돌 검사와 착지 계산을
+// 칸 수만큼 펼치고, 빈 행·빈 열 분기와 벽 검사는 코드에서 사라진다.
+//
+// distinct 이면 회전 대칭(sim_shapes::kSymmetries)으로 같은 칸에 떨어지는
+// placement 를 한 번만 낸다. 남는 쪽은 rot 가 작은 대표다. O 는 36 개가 9 개로,
+// I·S·Z 는 절반 가까이로 준다. 보드 결과만 보는 탐색(heuristic, beam)이 쓴다. 액션 공간 전체가
+// 필요한 곳(정책 마스크, MCTS, self-play)은 distinct=false 로 예전과 같은 목록을 받는다.
+//
+// SimGame::EnumeratePlacements 가 kEnumerateKernels[shape] 로 고른다. 결과는
+// LegalPlacements(LandingRow 기반 참조 구현)와 같다 — tests/placement_kernels_test.cpp.
+
+namespace sim_kernels {
+
+static_assert(sim_shapes::kBoardCols == SimGrid::kCols, "board width");
+
+using Landed = SimGame::LandedPlacement;
+using ColumnMasks = uint32_t[SimGrid::kCols];
+
+// 대표 rotation 의 착지 행. distinct 일 때 대칭 rotation 이 같은 칸인지 본다. -1 = 불법.
+using LandedRows = int8_t[sim_shapes::kNumRotations][SimGrid::kCols];
+
+template <int Shape, int Rot>
+struct RotationShape
+{
+    static constexpr const uint16_t (&kRows)[4] = sim_shapes::kRowMasks.rows[Shape][Rot];
+    static constexpr const int8_t (&kBottom)[4] = sim_shapes::kBottomProfiles.bottom[Shape][Rot];
+    static constexpr int kCanon  = sim_shapes::kSymmetries.canon[Shape][Rot];
+    static constexpr int kDRow   = sim_shapes::kSymmetries.dRow[Shape][Rot];
+    static constexpr int kDCol   = sim_shapes::kSymmetries.dCol[Shape][Rot];
+    static constexpr int kMaxCol = sim_shapes::kSymmetries.maxCol[Shape][Rot];
+    static constexpr int kTop    = kRows[0] ? 0 : kRows[1] ? 1 : kRows[2] ? 2 : 3;
+    static constexpr int kBase   = kRows[3] ? 3 : kRows[2] ? 2 : kRows[1] ? 1 : 0;
+};
+
+template <int Shape, int Rot>
+inline int EnumerateRotation(const SimGrid& grid, const ColumnMasks& columns, int startRow,
+                             bool distinct, LandedRows& landedRows, Landed* out)
+{
+    using S = RotationShape<Shape, Rot>;
+    for (int col = 0; col < SimGrid::kCols; ++col) landedRows[Rot][col] = -1;
+    // SimGrid::Fits 의 행 검사. 스폰 위치의 칸이 보드 위아래로 나가면 이 rot 는 없다.
+    if (startRow + S::kTop < 0 || startRow + S::kBase >= SimGrid::kRows) return 0;
+
+    uint32_t lane[4] = {0, 0, 0, 0};
+    for (int i = S::kTop; i <= S::kBase; ++i)
+        lane[i] = grid.RowMask(startRow + i);
+
+    // 열은 LegalPlacements 처럼 0 부터 센다(로컬 열도 0 이상이라 왼쪽 벽은 볼 것이 없다).
+    // 오른쪽 벽은 kMaxCol 에서 끊는다.
+    int n = 0;
+    for (int col = 0; col <= S::kMaxCol; ++col) {
+        bool fits = true;
+        for (int i = S::kTop; i <= S::kBase; ++i)
+            if (lane[i] & (static_cast<uint32_t>(S::kRows[i]) << col)) fits = false;
+        if (!fits) continue;
+
+        int drop = SimGrid::kRows;
+        for (int j = 0; j < 4; ++j) {
+            if (S::kBottom[j] < 0) continue;
+            const int below = startRow + S::kBottom[j] + 1;
+            const int gap = SimGrid::FirstBlockedRow(columns[col + j], below) - below;
+            if (gap < drop) drop = gap;
+        }
+        const int row = startRow + drop;
+        landedRows[Rot][col] = static_cast<int8_t>(row);
+
+        // 대표가 스폰 위치에서 막혔으면(-1) 같은 칸이라도 이쪽을 낸다.
+        if (distinct && S::kCanon != Rot) {
+            const int canonCol = col + S::kDCol;
+            if (canonCol >= 0 && canonCol < SimGrid::kCols &&
+                landedRows[S::kCanon][canonCol] == row + S::kDRow)
+                continue;   // 대표 rotation 이 같은 칸에 이미 떨어졌다
+        }
+        out[n++] = {col, Rot, row};
+    }
+    return n;
+}
+
+template <int Shape, int... Rots>
+inline int EnumerateShape(const SimGrid& grid, int startRow, bool distinct, Landed* out,
+                          std::integer_sequence<int, Rots...>)
+{
+    ColumnMasks columns;
+    grid.ColumnMasks(columns);
+    LandedRows landedRows;
+    int n = 0;
+    // rot 오름차순, 그 안에서 col — LegalPlacements 와 같은 순서.
+    ((n += EnumerateRotation<Shape, Rots>(grid, columns, startRow, distinct, landedRows, out + n)), ...);
+    return n;
+}
+
+template <int Shape>
+int Enumerate(const SimGrid& grid, int startRow, bool distinct, Landed* out)
+{
+    return EnumerateShape<Shape>(grid, startRow, distinct, out,
+                                 std::make_integer_sequence<int, sim_shapes::kNumRotations>{});
+}
+
+using EnumerateKernel = int (*)(const SimGrid&, int, bool, Landed*);
+
+// shape 1..7 = L, J, I, O, S, T, Z. 0(빈 블록)은 둘 곳이 없다.
+inline int EnumerateNone(const SimGrid&, int, bool, Landed*) { return 0; }
+
+constexpr EnumerateKernel kEnumerateKernels[sim_shapes::kNumShapes] = {
+    EnumerateNone, Enumerate<1>, Enumerate<2>, Enumerate<3>,
+    Enumerate<4>,  Enumerate<5>, Enumerate<6>, Enumerate<7>,
+};
+
+}  // namespace sim_kernels
@@ -0,0 +1,193 @@
+// 리플레이 되감기 — keyframe 만들기·복원·검증. 배선은 sim_replay.h 에 적어 뒀다.
+#include "sim_replay.h"
+
+#include <algorithm>
+#include <cstring>
+
+ReplaySim::ReplaySim(uint64_t seed)
+    : boards_{SimGame(seed), SimGame(seed)}
+{
+}
+
+void ReplaySim::Step(const FrameInputs& f)
+{
+    boards_[0].SubmitInput(f.p1);
+    boards_[1].SubmitInput(f.p2);
+    boards_[0].Tick();
+    boards_[1].Tick();
+    const int att0 = boards_[0].AttackLinesSent() - lastAttack_[0];
+    const int att1 = boards_[1].AttackLinesSent() - lastAttack_[1];
+    if (att0 > 0) boards_[1].AddPendingGarbage(att0);
+    if (att1 > 0) boards_[0].AddPendingGarbage(att1);
+    lastAttack_[0] = boards_[0].AttackLinesSent();
+    lastAttack_[1] = boards_[1].AttackLinesSent();
+    ++tick_;
+}
+
+ReplayKeyframe ReplaySim::Keyframe() const
+{
+    ReplayKeyframe k;
+    k.tick = tick_;
+    k.state.resize(kStateBytes);
+    for (int p = 0; p < 2; ++p) {
+        const SimSnapshot snap = boards_[p].Snapshot();
+        std::memcpy(k.state.data() + p * sizeof(SimSnapshot), &snap, sizeof(snap));
+        k.hash[p] = boards_[p].StateHash();
+    }
+    return k;
+}
+
+bool ReplaySim::Restore(const ReplayKeyframe& k)
+{
+    if (k.state.size() != kStateBytes) return false;
+    SimSnapshot snap[2];
+    std::memcpy(snap, k.state.data(), kStateBytes);
+    // 둘 다 풀리는지 먼저 본다. 한쪽만 바뀐 채로 남지 않게.
+    SimGame probe = boards_[0];
+    if (!probe.Restore(snap[0]) || !probe.Restore(snap[1])) return false;
+    for (int p = 0; p < 2; ++p) {
+        boards_[p].Restore(snap[p]);
+        lastAttack_[p] = boards_[p].AttackLinesSent();
+    }
+    tick_ = k.tick;
+    return true;
+}
+
+void AddKeyframes(ReplayData& rp, uint32_t everyTicks)
+{
+    rp.keyframes.clear();
+    if (everyTicks == 0) return;
+    ReplaySim sim(rp.seed);
+    for (size_t i = 0; i <= rp.frames.size(); ++i) {
+        if (i % everyTicks == 0) rp.keyframes.push_back(sim.Keyframe());
+        if (i < rp.frames.size()) sim.Step(rp.frames[i]);
+    }
+}
+
+bool SeekReplay(const ReplayData& rp, uint64_t tick, ReplaySim& sim)
+{
+    if (tick > rp.frames.size()) return false;
+    // tick 이하의 마지막 keyframe. 복원에 실패하면 더 앞의 것으로 물러난다.
+    auto it = std::upper_bound(rp.keyframes.begin(), rp.keyframes.end(), tick,
+                               [](uint64_t t, const ReplayKeyframe& k) { return t < k.tick; });
+    bool restored = false;
+    while (it != rp.keyframes.begin() && !restored) restored = sim.Restore(*--it);
+    if (!restored) sim = ReplaySim(rp.seed);
+    else if (sim.Tick() > tick) return false;   // 정렬되지 않은 keyframe
+    while (sim.Tick() < tick) sim.Step(rp.frames[sim.Tick()]);
+    return true;
+}
+
+int VerifyKeyframes(const ReplayData& rp, std::string* error)
+{
+    auto fail = [&](size_t index, const char* why) {
+        if (error) *error = why;
+        return static_cast<int>(index);
+    };
+    ReplaySim live(rp.seed);
+    ReplaySim restored(rp.seed);
+    for (size_t k = 0; k < rp.keyframes.size(); ++k) {
+        const ReplayKeyframe& key = rp.keyframes[k];
+        if (key.tick > rp.frames.size() || key.tick < live.Tick()) return fail(k, "keyframe tick out of range");
+        while (live.Tick() < key.tick) live.Step(rp.frames[live.Tick()]);
+        if (live.Board(0).StateHash() != key.hash[0] || live.Board(1).StateHash() != key.hash[1])
+            return fail(k, "keyframe hash differs from resimulation");
+        if (!restored.Restore(key)) return fail(k, "keyframe state does not restore");
+        if (restored.Board(0).StateHash() != key.hash[0] || restored.Board(1).StateHash() != key.hash[1])
+            return fail(k, "keyframe state differs from its hash");
+    }
+    if (error) error->clear();
+    return -1;
+}
+
+const char* const kHashComponentNames[kHashComponents] = {
+    "grid", "currentBlock", "nextBlock", "rng", "scoreFlags", "combat",
+};
+
+namespace {
+
+void breakdown_words(const SimGame::HashBreakdown& b, uint64_t (&out)[kHashComponents])
+{
+    const uint64_t words[kHashComponents] = {b.grid, b.currentBlock, b.nextBlock, b.rng, b.scoreFlags, b.combat};
+    std::copy(words, words + kHashComponents, out);
+}
+
+}  // namespace
+
+ReplayHashes ReplayHashesOf(const ReplaySim& sim)
+{
+    ReplayHashes h;
+    h.tick = sim.Tick();
+    for (int p = 0; p < 2; ++p) h.board[p] = sim.Board(p).StateHashBreakdown();
+    return h;
+}
+
+bool FirstHashDifference(const ReplayHashes& a, const ReplayHashes& b, int& board, int& component)
+{
+    for (int p = 0; p < 2; ++p) {
+        uint64_t x[kHashComponents], y[kHashComponents];
+        breakdown_words(a.board[p], x);
+        breakdown_words(b.board[p], y);
+        for (int c = 0; c < kHashComponents; ++c) {
+            if (x[c] != y[c]) {
+                board = p;
+                component = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool KeyframeDivergence(const ReplayData& rp, size_t index, ReplayDivergence& out)
+{
+    out = ReplayDivergence{};
+    if (index >= rp.keyframes.size()) return false;
+    const ReplayKeyframe& key = rp.keyframes[index];
+    if (key.tick > rp.frames.size()) return false;
+    out.tick = key.tick;
+    // SeekReplay 는 바로 이 keyframe 을 풀어 출발하므로 양쪽이 늘 같아진다. 로컬 쪽은 시드부터.
+    ReplaySim local(rp.seed), recorded(rp.seed);
+    while (local.Tick() < key.tick) local.Step(rp.frames[local.Tick()]);
+    if (!recorded.Restore(key)) return false;
+    out.local = ReplayHashesOf(local);
+    out.reference = ReplayHashesOf(recorded);
+    FirstHashDifference(out.local, out.reference, out.board, out.component);
+    return true;
+}
+
+bool BisectDivergence(const ReplayData& rp, uint64_t good, uint64_t bad,
+                      const ReferenceHashes& reference, ReplayDivergence& out)
+{
+    out = ReplayDivergence{};
+    if (good >= bad || bad > rp.frames.size()) return false;
+    // 불변식: good 에서 같고 bad 에서 다르다. atGood 은 good 틱 직후 상태라, 다음 탐침은
+    // 늘 거기서 앞으로만 굴린다. 구간 안에서 굴리는 틱 수는 구간 길이의 두 배를 넘지 않는다.
+    // atGood 은 시드부터 굴린다. 파일의 keyframe 은 다른 빌드가 남긴 것일 수 있어, 거기서
+    // 출발하면 로컬 쪽이 이미 기준 빌드의 상태를 물려받는다.
+    ReplaySim atGood(rp.seed);
+    while (atGood.Tick() < good) atGood.Step(rp.frames[atGood.Tick()]);
+    while (bad - good > 1) {
+        const uint64_t mid = good + (bad - good) / 2;
+        ReplayHashes ref;
+        ++out.probes;
+        if (!reference(mid, ref)) return false;
+        ReplaySim sim = atGood;
+        while (sim.Tick() < mid) sim.Step(rp.frames[sim.Tick()]);
+        int board = 0, component = 0;
+        if (FirstHashDifference(ReplayHashesOf(sim), ref, board, component)) {
+            bad = mid;
+        } else {
+            good = mid;
+            atGood = sim;
+        }
+    }
+    ++out.probes;
+    if (!reference(bad, out.reference)) return false;
+    ReplaySim sim = atGood;
+    while (sim.Tick() < bad) sim.Step(rp.frames[sim.Tick()]);
+    out.local = ReplayHashesOf(sim);
+    out.tick = bad;
+    FirstHashDifference(out.local, out.reference, out.board, out.component);
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "sim_game.h"
+#include "../core/replay.h"
+
+// [NET] 리플레이 되감기. core/replay.h 의 keyframe 상태 바이트를 만들고 푼다.
+//
+// 리플레이 한 판은 두 보드를 lockstep 으로 돌린 것이다(main.cpp 의 versus 와 같은 배선):
+// 틱마다 두 쪽에 입력을 넣고 Tick 한 뒤, 새로 보낸 공격 줄을 상대 pendingGarbage 로 넘긴다.
+// keyframe 은 그 틱 직후 두 SimSnapshot 을 이어 붙인 256바이트다. 공격 델타의 기준점은
+// 틱 끝에서 늘 AttackLinesSent 와 같으므로 따로 담지 않는다.
+//
+// 임의 틱으로의 이동은 그 틱 이하의 가장 가까운 keyframe 을 복원하고 남은 입력만
+// 다시 굴린다. N 틱마다 keyframe 이면 재시뮬레이션은 N 틱을 넘지 않는다.
+class ReplaySim
+{
+public:
+    static constexpr size_t kStateBytes = 2 * sizeof(SimSnapshot);
+
+    explicit ReplaySim(uint64_t seed);
+
+    void Step(const FrameInputs& f);
+    uint64_t Tick() const { return tick_; }
+    const SimGame& Board(int p) const { return boards_[p]; }
+
+    ReplayKeyframe Keyframe() const;
+    // 상태 바이트 크기·스냅샷 검증이 어긋나면 false 이고 상태는 그대로다.
+    bool Restore(const ReplayKeyframe& k);
+
+private:
+    SimGame boards_[2];
+    int lastAttack_[2] = {0, 0};
+    uint64_t tick_ = 0;
+};
+
+// rp.frames 를 처음부터 다시 굴려 everyTicks 틱마다(0 틱 포함) keyframe 을 채운다.
+// 기존 keyframe 은 버린다. everyTicks == 0 이면 비우기만 한다.
+void AddKeyframes(ReplayData& rp, uint32_t everyTicks);
+
+// sim 을 tick 틱 진행한 직후 상태로 만든다. tick 이 입력 길이를 넘으면 false.
+bool SeekReplay(const ReplayData& rp, uint64_t tick, ReplaySim& sim);
+
+// 시드부터 다시 굴려 keyframe 마다 저장된 해시를 살아 있는 보드와, 그 상태 바이트를
+// 복원한 보드 양쪽과 대조한다. 모두 맞으면 -1, 아니면 처음 어긋난 keyframe 번호.
+int VerifyKeyframes(const ReplayData& rp, std::string* error = nullptr);
+
+// ---- 빌드 간 대조 ----
+// 한 틱 직후 두 보드의 섹션별 해시(SimGame::StateHashBreakdown). main.cpp 가 DESYNC 때
+// 찍는 것과 같은 단위라, 어느 섹션이 먼저 갈라졌는지로 원인을 좁힌다.
+struct ReplayHashes
+{
+    uint64_t tick = 0;
+    SimGame::HashBreakdown board[2]{};
+};
+
+constexpr int kHashComponents = 6;
+// HashBreakdown 의 필드 순서.
+extern const char* const kHashComponentNames[kHashComponents];
+
+ReplayHashes ReplayHashesOf(const ReplaySim& sim);
+// 처음 다른 (보드, 섹션). 보드 0 의 섹션부터 본다. 같으면 false.
+bool FirstHashDifference(const ReplayHashes& a, const ReplayHashes& b, int& board, int& component);
+
+// 기준 빌드가 tick 틱 직후의 해시를 돌려준다. 못 구하면 false.
+using ReferenceHashes = std::function<bool(uint64_t tick, ReplayHashes& out)>;
+
+struct ReplayDivergence
+{
+    uint64_t tick = 0;          // 처음 다른 틱
+    int board = -1;
+    int component = -1;         // kHashComponentNames 번호
+    ReplayHashes local;
+    ReplayHashes reference;
+    int probes = 0;             // reference 를 부른 횟수
+};
+
+// rp.keyframes[index] 를 기준으로 본 차이. local 은 시드부터 다시 굴린 상태라 다른 빌드가
+// 남긴 keyframe 에서 출발하지 않고, reference 는 그 keyframe 을 푼 상태다. index·tick 이
+// 범위 밖이거나 keyframe 이 풀리지 않으면 false(out.board 는 -1 그대로).
+bool KeyframeDivergence(const ReplayData& rp, size_t index, ReplayDivergence& out);
+
+// good 틱에서 같고 bad 틱에서 다르다고 알려진 구간(good < bad)을 이분해 처음 다른 틱을
+// 찾는다. 한 번 갈라진 상태는 다시 합쳐지지 않는다고 본다(결정론 시뮬레이션에서 해시가
+// 우연히 다시 같아질 일은 없다). reference 가 실패하면 false.
+bool BisectDivergence(const ReplayData& rp, uint64_t good, uint64_t bad,
+                      const ReferenceHashes& reference, ReplayDivergence& out);
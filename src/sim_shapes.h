@@ -0,0 +1,195 @@
+#pragma once
+#include <cstdint>
+
+// [NET/RL] 테트로미노 모양 테이블 — 헤드리스 SimGame 전용. 렌더러 의존성 없음.
+//
+// 예전에는 SimBlock 인스턴스마다 std::map<int, std::vector<Position>> 로 모양을
+// 들고 다녀, 블록을 복사하거나 셀 좌표를 물어볼 때마다 힙 할당이 생겼다. 모양은
+// 블록 종류와 rotation 만으로 정해지므로 여기 constexpr 표 하나를 모두가 공유한다.
+//
+// 블록 ID 와 rotation 테이블은 결정론 보장을 위해 절대 변경하지 말 것
+// (변경 시 StateHash 가 어긋나 cross-platform / replay 회귀가 깨진다).
+
+// bounding box 안의 로컬 (row, column).
+struct SimCell
+{
+    int8_t row;
+    int8_t column;
+};
+
+namespace sim_shapes {
+
+// 인덱스 0 은 빈 블록(기본 생성 SimBlock), 1..7 = L, J, I, O, S, T, Z.
+// ghost(id=8)는 원래 블록의 shape 를 그대로 들고 있으므로 여기 행이 없다.
+constexpr int kNumShapes    = 8;
+constexpr int kNumRotations = 4;
+constexpr int kCellsPerBlock = 4;
+constexpr int kBoardCols    = 10;   // SimGrid::kCols. 벽 안 columnOffset 범위 계산용
+
+constexpr SimCell kCells[kNumShapes][kNumRotations][kCellsPerBlock] = {
+    // 0: empty
+    {{{0, 0}, {0, 0}, {0, 0}, {0, 0}},
+     {{0, 0}, {0, 0}, {0, 0}, {0, 0}},
+     {{0, 0}, {0, 0}, {0, 0}, {0, 0}},
+     {{0, 0}, {0, 0}, {0, 0}, {0, 0}}},
+    // 1: L
+    {{{0, 2}, {1, 0}, {1, 1}, {1, 2}},
+     {{0, 1}, {1, 1}, {2, 1}, {2, 2}},
+     {{1, 0}, {1, 1}, {1, 2}, {2, 0}},
+     {{0, 0}, {0, 1}, {1, 1}, {2, 1}}},
+    // 2: J
+    {{{0, 0}, {1, 0}, {1, 1}, {1, 2}},
+     {{0, 1}, {0, 2}, {1, 1}, {2, 1}},
+     {{1, 0}, {1, 1}, {1, 2}, {2, 2}},
+     {{0, 1}, {1, 1}, {2, 0}, {2, 1}}},
+    // 3: I
+    {{{1, 0}, {1, 1}, {1, 2}, {1, 3}},
+     {{0, 2}, {1, 2}, {2, 2}, {3, 2}},
+     {{2, 0}, {2, 1}, {2, 2}, {2, 3}},
+     {{0, 1}, {1, 1}, {2, 1}, {3, 1}}},
+    // 4: O
+    {{{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+     {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+     {{0, 0}, {0, 1}, {1, 0}, {1, 1}},
+     {{0, 0}, {0, 1}, {1, 0}, {1, 1}}},
+    // 5: S
+    {{{0, 1}, {0, 2}, {1, 0}, {1, 1}},
+     {{0, 1}, {1, 1}, {1, 2}, {2, 2}},
+     {{1, 1}, {1, 2}, {2, 0}, {2, 1}},
+     {{0, 0}, {1, 0}, {1, 1}, {2, 1}}},
+    // 6: T
+    {{{0, 1}, {1, 0}, {1, 1}, {1, 2}},
+     {{0, 1}, {1, 1}, {1, 2}, {2, 1}},
+     {{1, 0}, {1, 1}, {1, 2}, {2, 1}},
+     {{0, 1}, {1, 0}, {1, 1}, {2, 1}}},
+    // 7: Z
+    {{{0, 0}, {0, 1}, {1, 1}, {1, 2}},
+     {{0, 2}, {1, 1}, {1, 2}, {2, 1}},
+     {{1, 0}, {1, 1}, {2, 1}, {2, 2}},
+     {{0, 1}, {1, 0}, {1, 1}, {2, 0}}},
+};
+
+// 스폰 시 columnOffset. O 만 한 칸 오른쪽에서 시작한다.
+constexpr int kSpawnColumn[kNumShapes] = {0, 3, 3, 3, 4, 3, 3, 3};
+
+// (shape, rotation) 별 bounding box 행 마스크 (비트 c = 로컬 열 c).
+// SimGrid::Fits 가 그대로 받는다. kCells 에서 컴파일 타임에 유도한다.
+struct RowMaskTable
+{
+    uint16_t rows[kNumShapes][kNumRotations][4];
+};
+
+constexpr RowMaskTable MakeRowMasks()
+{
+    RowMaskTable t{};
+    for (int s = 1; s < kNumShapes; ++s)
+        for (int r = 0; r < kNumRotations; ++r)
+            for (int i = 0; i < kCellsPerBlock; ++i)
+            {
+                const SimCell c = kCells[s][r][i];
+                t.rows[s][r][c.row] = static_cast<uint16_t>(t.rows[s][r][c.row] | (1u << c.column));
+            }
+    return t;
+}
+
+constexpr RowMaskTable kRowMasks = MakeRowMasks();
+
+// (shape, rotation) 별 바닥 프로파일 — 로컬 열 j 에서 가장 아래 칸의 로컬 행.
+// 그 열에 칸이 없으면 -1. 테트로미노는 열마다 칸이 연속이라 hard drop 의 착지
+// 높이는 열별 "바닥 칸 아래 첫 막힌 행" 만 보면 정해진다 (SimGame::LandingRow).
+struct BottomTable
+{
+    int8_t bottom[kNumShapes][kNumRotations][4];
+};
+
+constexpr BottomTable MakeBottomProfiles()
+{
+    BottomTable t{};
+    for (int s = 0; s < kNumShapes; ++s)
+        for (int r = 0; r < kNumRotations; ++r)
+            for (int j = 0; j < 4; ++j)
+                t.bottom[s][r][j] = -1;
+    for (int s = 1; s < kNumShapes; ++s)
+        for (int r = 0; r < kNumRotations; ++r)
+            for (int i = 0; i < kCellsPerBlock; ++i)
+            {
+                const SimCell c = kCells[s][r][i];
+                if (c.row > t.bottom[s][r][c.column]) t.bottom[s][r][c.column] = c.row;
+            }
+    return t;
+}
+
+constexpr BottomTable kBottomProfiles = MakeBottomProfiles();
+
+// (shape, rotation) 별 회전 대칭. 칸 집합을 평행이동만 해서 더 작은 rotation 과
+// 겹치면 그 rotation 이 대표(canon)다: 이 rotation 의 칸 = canon 의 칸 + (dRow, dCol).
+// O 는 넷 다 0, I·S·Z 는 2→0, 3→1 이다. 같은 자리에 떨어지는 placement 를 두 번
+// 두어 보지 않으려고 쓴다(sim_placement_kernels.h).
+struct SymmetryTable
+{
+    int8_t canon[kNumShapes][kNumRotations];
+    int8_t dRow[kNumShapes][kNumRotations];
+    int8_t dCol[kNumShapes][kNumRotations];
+    // 칸이 오른쪽 벽 안에 드는 가장 큰 columnOffset. 열거는 0 부터 센다
+    // (action = col*4+rot 이라 음수 열은 없다).
+    int8_t maxCol[kNumShapes][kNumRotations];
+};
+
+constexpr SymmetryTable MakeSymmetries()
+{
+    SymmetryTable t{};
+    int8_t minRow[kNumShapes][kNumRotations] = {};
+    int8_t minLocalCol[kNumShapes][kNumRotations] = {};
+    for (int s = 0; s < kNumShapes; ++s)
+        for (int r = 0; r < kNumRotations; ++r)
+        {
+            int lo = 3, hi = 0, top = 3;
+            for (int i = 0; i < kCellsPerBlock; ++i)
+            {
+                const SimCell c = kCells[s][r][i];
+                if (c.column < lo) lo = c.column;
+                if (c.column > hi) hi = c.column;
+                if (c.row < top) top = c.row;
+            }
+            minRow[s][r] = static_cast<int8_t>(top);
+            minLocalCol[s][r] = static_cast<int8_t>(lo);
+            t.maxCol[s][r] = static_cast<int8_t>(kBoardCols - 1 - hi);
+            t.canon[s][r] = static_cast<int8_t>(r);
+        }
+    for (int s = 1; s < kNumShapes; ++s)
+        for (int r = 1; r < kNumRotations; ++r)
+            for (int q = 0; q < r; ++q)
+            {
+                if (t.canon[s][q] != q) continue;
+                const int dr = minRow[s][r] - minRow[s][q];
+                const int dc = minLocalCol[s][r] - minLocalCol[s][q];
+                // r 의 칸마다 (dr, dc) 를 빼면 q 의 칸 중 하나여야 한다. 넷 다 서로 다르므로
+                // 전부 찾으면 두 집합이 같다.
+                bool same = true;
+                for (int i = 0; i < kCellsPerBlock && same; ++i)
+                {
+                    const SimCell c = kCells[s][r][i];
+                    bool found = false;
+                    for (int k = 0; k < kCellsPerBlock; ++k)
+                    {
+                        const SimCell d = kCells[s][q][k];
+                        if (d.row + dr == c.row && d.column + dc == c.column) found = true;
+                    }
+                    same = found;
+                }
+                if (!same) continue;
+                t.canon[s][r] = static_cast<int8_t>(q);
+                t.dRow[s][r] = static_cast<int8_t>(dr);
+                t.dCol[s][r] = static_cast<int8_t>(dc);
+                break;
+            }
+    return t;
+}
+
+constexpr SymmetryTable kSymmetries = MakeSymmetries();
+
+static_assert(kSymmetries.canon[4][3] == 0 && kSymmetries.canon[3][2] == 0 &&
+              kSymmetries.canon[3][3] == 1 && kSymmetries.canon[6][2] == 2,
+              "O 는 한 가지, I 는 두 가지, T 는 네 가지 모양");
+
+}  // namespace sim_shapes
@@ -0,0 +1,138 @@
+// tests/arena_test.cpp — 헤드리스 토너먼트(bot/arena.h) 회귀
+//
+//   - wilson_interval 이 알려진 값과 맞다
+//   - TickDriver 는 inputIntervalTicks 간격으로 입력을 내고 블록마다 정책을 한 번 부른다
+//   - 틱 루프의 공격이 상대 보드에 가비지로 쌓인다(main.cpp lockstep 과 같은 배선)
+//   - 같은 봇끼리는 같은 시드라 무승부, heuristic 은 random 을 이긴다
+//   - run_arena 결과는 스레드 수와 무관하다
+
+#include "../bot/arena.h"
+#include "../bot/placement.h"
+#include "../core/input.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[arena] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[arena] ok:   %s\n", what); }
+}
+
+void test_wilson() {
+    double lo = 0.0, hi = 0.0;
+    bot::wilson_interval(50.0, 100, 1.96, lo, hi);
+    check(std::fabs(lo - 0.4038) < 1e-3 && std::fabs(hi - 0.5962) < 1e-3, "Wilson 50/100 = [0.404, 0.596]");
+    bot::wilson_interval(0.0, 10, 1.96, lo, hi);
+    check(lo == 0.0 && hi > 0.2 && hi < 0.35, "Wilson 0/10 은 하한 0, 상한 약 0.28");
+    bot::wilson_interval(0.0, 0, 1.96, lo, hi);
+    check(lo == 0.0 && hi == 1.0, "n=0 이면 [0, 1]");
+}
+
+void test_tick_driver_interval() {
+    int calls = 0;
+    bot::TickDriver driver([&](const SimGame& sim, int& col, int& rot) {
+        ++calls;
+        return bot::heuristic_placement(sim, col, rot);
+    }, 4);
+    SimGame g(3);
+    int firstInput = -1, secondInput = -1;
+    for (int t = 0; t < 40 && secondInput < 0; ++t) {
+        const uint8_t m = driver.NextInput(g);
+        if (m != INPUT_NONE) (firstInput < 0 ? firstInput : secondInput) = t;
+        g.SubmitInput(m);
+        g.Tick();
+    }
+    check(firstInput == 0 && secondInput == 4, "입력 간격이 inputIntervalTicks");
+    check(calls == 1 && driver.Pieces() == 1, "한 블록에 정책은 한 번");
+
+    for (int t = 0; t < 2000 && !g.IsGameOver() && driver.Pieces() < 20; ++t) {
+        g.SubmitInput(driver.NextInput(g));
+        g.Tick();
+    }
+    check(driver.Pieces() == 20 && calls == 20, "블록이 바뀔 때마다 새로 정한다");
+}
+
+void test_match_routing() {
+    bot::ArenaConfig config;
+    config.maxTicks = 60 * 60 * 3;
+    bot::PlacementPolicy mirror[2] = {bot::heuristic_policy(), bot::heuristic_policy()};
+    const bot::ArenaMatchResult same = bot::play_arena_match(9, mirror, config);
+    check(same.winner == -1 && same.attack[0] == same.attack[1] && same.ticks > 0,
+          "같은 봇·같은 시드면 두 보드가 똑같이 흘러 무승부");
+
+    bot::PlacementPolicy uneven[2] = {bot::heuristic_policy(), bot::random_policy(4)};
+    const bot::ArenaMatchResult r = bot::play_arena_match(9, uneven, config);
+    check(r.winner == 0 && r.pieces[0] > 0 && r.pieces[1] > 0, "heuristic 이 random 을 이긴다");
+
+    // 같은 판을 손으로 돌려 B 가 받은 가비지가 A 의 공격과 같은지 본다.
+    SimGame board[2] = {SimGame(9), SimGame(9)};
+    bot::TickDriver driver[2] = {bot::TickDriver(bot::heuristic_policy(), 1),
+                                 bot::TickDriver(bot::random_policy(4), 1)};
+    int last[2] = {0, 0};
+    int received[2] = {0, 0};
+    while (!board[0].IsGameOver() && !board[1].IsGameOver()) {
+        const uint8_t a = driver[0].NextInput(board[0]);
+        const uint8_t b = driver[1].NextInput(board[1]);
+        board[0].SubmitInput(a);
+        board[1].SubmitInput(b);
+        board[0].Tick();
+        board[1].Tick();
+        for (int p = 0; p < 2; ++p) {
+            const int att = board[p].AttackLinesSent() - last[p];
+            if (att > 0) { board[1 - p].AddPendingGarbage(att); received[1 - p] += att; }
+            last[p] = board[p].AttackLinesSent();
+        }
+    }
+    check(received[1] == r.attack[0] && received[0] == r.attack[1],
+          "A 의 공격이 그대로 B 의 가비지로 쌓인다");
+}
+
+void test_thread_invariance() {
+    bot::ArenaConfig config;
+    config.matches = 8;
+    config.seed = 5;
+    config.maxTicks = 60 * 60 * 2;
+    const bot::PolicyFactory factory = [](int, int player) {
+        return player == 0 ? bot::heuristic_policy() : bot::random_policy(7);
+    };
+    config.threads = 1;
+    const bot::ArenaResult one = bot::run_arena(config, factory);
+    config.threads = 3;
+    const bot::ArenaResult three = bot::run_arena(config, factory);
+
+    bool same = one.matches.size() == three.matches.size();
+    for (size_t i = 0; same && i < one.matches.size(); ++i) {
+        const bot::ArenaMatchResult& a = one.matches[i];
+        const bot::ArenaMatchResult& b = three.matches[i];
+        same = a.winner == b.winner && a.ticks == b.ticks && a.attack[0] == b.attack[0]
+            && a.attack[1] == b.attack[1] && a.pieces[0] == b.pieces[0] && a.pieces[1] == b.pieces[1];
+    }
+    check(same && one.winsA == three.winsA && one.ticks == three.ticks, "스레드 수와 무관한 결과");
+    check(one.winsA == config.matches && one.ScoreA() == 1.0, "heuristic 이 random 에 전승");
+    check(one.threads == 1 && three.threads == 3, "스레드 수가 채워진다");
+
+    bot::ArenaResult r;
+    r.ticks = 2 * 60 * 60;   // 60Hz 로 2분
+    r.attack[0] = 10;
+    r.winsA = 3; r.draws = 1;
+    check(r.AttackPerMinute(0) == 5.0 && r.AttackPerMinute(1) == 0.0 && r.ScoreA() == 0.875,
+          "attack/min 은 게임 시간 기준, 무승부는 반 승");
+}
+
+}  // namespace
+
+int main() {
+    test_wilson();
+    test_tick_driver_interval();
+    test_match_routing();
+    test_thread_invariance();
+    if (g_failures) {
+        std::fprintf(stderr, "[arena] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[arena] all passed\n");
+    return 0;
+}
@@ -0,0 +1,235 @@
+// tests/async_bot_test.cpp — 게임 스레드 밖 봇 컨트롤러(bot/async_bot.h) 회귀
+//
+//   - 탐색이 느려도 NextInput 은 기다리지 않고 INPUT_NONE 을 낸다
+//   - 답이 오면 expand_placement 시퀀스를 inputIntervalTicks 간격으로 낸다
+//   - 블록이 바뀌면 돌던 탐색에 cancel 이 오르고 그 답은 쓰지 않는다
+//   - 답이 maxWaitTicks 안에 안 오면 fallback 으로 둔다
+//   - 요청을 연달아 바꿔도 늦게 오른 cancel 이 새 탐색을 끊지 않는다(마지막 답이 잘리지 않는다)
+//   - beam planner 로 실제 틱 루프(NextInput → SubmitInput → Tick)를 돌리면 줄을 지운다
+
+#include "../bot/async_bot.h"
+#include "../bot/beam_search.h"
+#include "../bot/placement.h"
+#include "../core/input.h"
+#include "../src/sim_game.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[async_bot] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[async_bot] ok:   %s\n", what); }
+}
+
+using Clock = std::chrono::steady_clock;
+
+double ms_since(Clock::time_point t) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t).count();
+}
+
+// 답이 날 때까지 틱을 흉내 낸다(보드는 움직이지 않는다). 낸 마스크를 모은다.
+std::vector<uint8_t> drain(bot::AsyncBot& bot, const SimGame& g, int ticks) {
+    std::vector<uint8_t> out;
+    for (int i = 0; i < ticks; ++i) {
+        out.push_back(bot.NextInput(g));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return out;
+}
+
+void test_slow_planner_does_not_block() {
+    std::atomic<int> calls{0};
+    bot::AsyncBot bot([&](const SimGame& sim, const std::atomic<bool>&, int& col, int& rot) {
+        calls.fetch_add(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+        return bot::heuristic_placement(sim, col, rot);
+    });
+    const SimGame g(11);
+    const auto t0 = Clock::now();
+    const uint8_t first = bot.NextInput(g);
+    const double firstMs = ms_since(t0);
+    check(first == INPUT_NONE && firstMs < 20.0 && bot.Thinking(),
+          "느린 탐색 중에도 첫 틱은 기다리지 않고 INPUT_NONE");
+
+    int col = 0, rot = 0;
+    bot::heuristic_placement(g, col, rot);
+    const std::vector<uint8_t> want = bot::expand_placement(g.CurrentCol(), g.CurrentRotation(), col, rot);
+    std::vector<uint8_t> got;
+    for (int i = 0; i < 500 && got.size() < want.size(); ++i) {
+        const uint8_t m = bot.NextInput(g);
+        if (m != INPUT_NONE) got.push_back(m);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    check(got == want && calls.load() == 1, "답이 오면 expand_placement 시퀀스를 그대로 낸다");
+}
+
+void test_input_interval() {
+    bot::AsyncBotConfig config;
+    config.inputIntervalTicks = 3;
+    bot::AsyncBot bot([](const SimGame& sim, const std::atomic<bool>&, int& col, int& rot) {
+        return bot::heuristic_placement(sim, col, rot);
+    }, config);
+    const SimGame g(4);
+    std::vector<uint8_t> ticks = drain(bot, g, 200);
+    int first = -1, second = -1;
+    for (int i = 0; i < static_cast<int>(ticks.size()); ++i) {
+        if (ticks[i] == INPUT_NONE) continue;
+        if (first < 0) first = i;
+        else { second = i; break; }
+    }
+    check(first >= 0 && second - first == 3, "입력 사이 간격이 inputIntervalTicks");
+}
+
+void test_piece_change_cancels_stale_search() {
+    std::atomic<int> started{0}, sawCancel{0};
+    bot::AsyncBot bot([&](const SimGame& sim, const std::atomic<bool>& cancel, int& col, int& rot) {
+        const int n = started.fetch_add(1);
+        if (n == 0) {
+            // 첫 탐색은 cancel 이 올 때까지 버틴다.
+            const auto t0 = Clock::now();
+            while (!cancel.load() && ms_since(t0) < 2000.0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            if (cancel.load()) sawCancel.fetch_add(1);
+            col = 0; rot = 0;   // 버려져야 하는 답
+            return true;
+        }
+        return bot::heuristic_placement(sim, col, rot);
+    });
+    SimGame g(8);
+    bot.NextInput(g);
+    while (started.load() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    int c = 0, r = 0;
+    bot::heuristic_placement(g, c, r);
+    g.ApplyPlacement(c, r);   // 블록이 바뀌었다
+    int col = 0, rot = 0;
+    bot::heuristic_placement(g, col, rot);
+    const std::vector<uint8_t> want = bot::expand_placement(g.CurrentCol(), g.CurrentRotation(), col, rot);
+    std::vector<uint8_t> got;
+    for (int i = 0; i < 2000 && got.size() < want.size(); ++i) {
+        const uint8_t m = bot.NextInput(g);
+        if (m != INPUT_NONE) got.push_back(m);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bot.Reset();
+    const bot::AsyncBotStats st = bot.Stats();
+    check(sawCancel.load() == 1, "블록이 바뀌면 돌던 탐색에 cancel 이 오른다");
+    check(got == want && st.stale == 1 && st.searches == 2, "낡은 답은 버리고 새 블록의 답만 쓴다");
+}
+
+void test_timeout_falls_back() {
+    bot::AsyncBotConfig config;
+    config.maxWaitTicks = 5;
+    bot::AsyncBot bot([](const SimGame&, const std::atomic<bool>& cancel, int&, int&) {
+        while (!cancel.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return false;
+    }, config);
+    const SimGame g(2);
+    int col = 0, rot = 0;
+    bot::fallback_placement(g, col, rot);
+    const std::vector<uint8_t> want = bot::expand_placement(g.CurrentCol(), g.CurrentRotation(), col, rot);
+    std::vector<uint8_t> ticks;
+    for (int i = 0; i < config.maxWaitTicks; ++i) ticks.push_back(bot.NextInput(g));
+    const uint8_t firstMove = bot.NextInput(g);
+    bool quiet = true;
+    for (uint8_t m : ticks) if (m != INPUT_NONE) quiet = false;
+    bot.Reset();
+    check(quiet && firstMove == want.front() && bot.Stats().timeouts == 1,
+          "maxWaitTicks 를 넘기면 fallback_placement 로 둔다");
+}
+
+// 블록을 매 틱 바꿔 Submit 을 몰아친다. 스레드가 새 요청을 집는 순간과 cancel 이 오르는
+// 순간이 겹치면 새 탐색이 잘리고, 그 답은 세대가 맞아 그대로 쓰인다(failures 로 드러난다).
+void test_rapid_resubmit_keeps_last_search() {
+    std::atomic<int> cancelled{0};
+    bot::AsyncBotConfig config;
+    config.maxWaitTicks = 0;
+    bot::AsyncBot bot([&](const SimGame& sim, const std::atomic<bool>& cancel, int& col, int& rot) {
+        // 잠깐 일하는 척하다 cancel 을 보면 잘린 답(false)을 낸다.
+        for (int i = 0; i < 64 && !cancel.load(); ++i) std::this_thread::yield();
+        if (cancel.load()) {
+            cancelled.fetch_add(1);
+            return false;
+        }
+        return bot::heuristic_placement(sim, col, rot);
+    }, config);
+
+    std::vector<SimGame> games;
+    for (uint64_t seed = 100; seed < 108; ++seed) games.emplace_back(seed);
+    for (int round = 0; round < 20000; ++round) {
+        bot.NextInput(games[round % games.size()]);
+        if (round % 7 == 0) std::this_thread::yield();
+    }
+
+    const SimGame& last = games[3];
+    int col = 0, rot = 0;
+    bot::heuristic_placement(last, col, rot);
+    const std::vector<uint8_t> want = bot::expand_placement(last.CurrentCol(), last.CurrentRotation(), col, rot);
+    std::vector<uint8_t> got;
+    for (int i = 0; i < 2000 && got.size() < want.size(); ++i) {
+        const uint8_t m = bot.NextInput(last);
+        if (m != INPUT_NONE) got.push_back(m);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    bot.Reset();
+    const bot::AsyncBotStats st = bot.Stats();
+    std::fprintf(stderr, "[async_bot] 20000 resubmits: %llu searches, %llu stale, %d cancelled\n",
+                 static_cast<unsigned long long>(st.searches), static_cast<unsigned long long>(st.stale),
+                 cancelled.load());
+    check(st.failures == 0, "쓰인 답 중 cancel 로 잘린 것이 없다");
+    check(got == want, "마지막 요청의 답이 끝까지 탐색한 답이다");
+}
+
+// main.cpp 의 BotSingle 틱과 같은 순서로 돈다: NextInput → SubmitInput → Tick.
+void test_drives_a_real_game() {
+    bot::BeamConfig beam;
+    beam.budgetMs = 0.0;
+    beam.depth = 2;
+    bot::AsyncBot bot([&](const SimGame& sim, const std::atomic<bool>& cancel, int& col, int& rot) {
+        bot::BeamConfig c = beam;
+        c.cancel = &cancel;
+        return bot::beam_placement(sim, c, col, rot);
+    });
+    SimGame g(31);
+    const auto t0 = Clock::now();
+    double worstTickMs = 0.0;
+    for (int tick = 0; tick < 6000 && !g.IsGameOver(); ++tick) {
+        const auto t = Clock::now();
+        const uint8_t m = bot.NextInput(g);
+        worstTickMs = std::max(worstTickMs, ms_since(t));
+        g.SubmitInput(m);
+        g.Tick();
+        // 60Hz 를 흉내 내지는 않지만 봇 스레드가 돌 틈은 준다.
+        if (bot.Thinking()) std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    bot.Reset();
+    const bot::AsyncBotStats st = bot.Stats();
+    std::fprintf(stderr, "[async_bot] 6000 ticks in %.0f ms: %d lines, %llu searches, worst NextInput %.2f ms\n",
+                 ms_since(t0), g.totalLinesCleared, static_cast<unsigned long long>(st.searches),
+                 worstTickMs);
+    check(g.totalLinesCleared >= 10 && st.searches >= 50, "비동기 beam 봇이 실제 틱 루프에서 줄을 지운다");
+}
+
+}  // namespace
+
+int main() {
+    test_slow_planner_does_not_block();
+    test_input_interval();
+    test_piece_change_cancels_stale_search();
+    test_timeout_falls_back();
+    test_rapid_resubmit_keeps_last_search();
+    test_drives_a_real_game();
+    if (g_failures) {
+        std::fprintf(stderr, "[async_bot] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[async_bot] all passed\n");
+    return 0;
+}
@@ -0,0 +1,109 @@
+// tests/beam_search_test.cpp — beam search 착수 엔진(bot/beam_search.h) 회귀
+//
+//   - depth=1 이면 heuristic_placement 와 같은 수 (같은 평가 함수, 같은 동점 규칙)
+//   - 예산 없이(budgetMs=0) 돌리면 결정론적
+//   - 예산을 넘기면 깊이 0 만 끝내고 답을 낸다
+//   - 가비지 압박 아래 생존 수순이 greedy 보다 길다
+
+#include "../bot/beam_search.h"
+#include "../bot/placement.h"
+
+#include <cstdio>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[beam] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[beam] ok:   %s\n", what); }
+}
+
+bot::BeamConfig fixed(int width, int depth) {
+    bot::BeamConfig config;
+    config.width = width;
+    config.depth = depth;
+    config.budgetMs = 0.0;
+    return config;
+}
+
+void test_depth_one_matches_heuristic() {
+    int compared = 0, same = 0;
+    for (uint64_t seed = 1; seed <= 8; ++seed) {
+        SimGame g(seed);
+        // 초반 30 수 — 스택이 낮아 게임 오버로 끝나는 수가 없다.
+        for (int k = 0; k < 30 && !g.IsGameOver(); ++k) {
+            int hc = 0, hr = 0, bc = 0, br = 0;
+            if (!bot::heuristic_placement(g, hc, hr)) break;
+            const bool ok = bot::beam_placement(g, fixed(8, 1), bc, br);
+            ++compared;
+            if (ok && hc == bc && hr == br) ++same;
+            g.ApplyPlacement(hc, hr);
+        }
+    }
+    check(compared > 100 && same == compared, "depth=1 은 heuristic_placement 와 같은 수");
+}
+
+void test_deterministic_without_budget() {
+    SimGame g(99);
+    for (int k = 0; k < 20; ++k) {
+        int c = 0, r = 0;
+        bot::heuristic_placement(g, c, r);
+        g.ApplyPlacement(c, r);
+    }
+    int c1 = -1, r1 = -1, c2 = -2, r2 = -2;
+    bot::BeamStats s1, s2;
+    bot::beam_placement(g, fixed(16, 4), c1, r1, &s1);
+    bot::beam_placement(g, fixed(16, 4), c2, r2, &s2);
+    check(c1 == c2 && r1 == r2 && s1.nodes == s2.nodes, "예산 없으면 같은 입력에 같은 수");
+    check(s1.depthReached == 4 && !s1.timedOut, "미리보기 3 개까지 끝까지 펼친다");
+}
+
+void test_budget_cuts_depth() {
+    SimGame g(5);
+    bot::BeamConfig config = fixed(24, 4);
+    config.budgetMs = 1e-6;
+    int c = -1, r = -1;
+    bot::BeamStats stats;
+    const bool ok = bot::beam_placement(g, config, c, r, &stats);
+    check(ok && stats.depthReached == 1 && stats.timedOut, "예산을 넘기면 깊이 0 의 답을 낸다");
+}
+
+// 세 수마다 가비지 두 줄. 버틴 수를 잰다.
+int survive(bool beam, uint64_t seed) {
+    SimGame g(seed);
+    int n = 0;
+    for (; n < 400 && !g.IsGameOver(); ++n) {
+        int c = 0, r = 0;
+        const bool ok = beam ? bot::beam_placement(g, fixed(8, 4), c, r)
+                             : bot::heuristic_placement(g, c, r);
+        if (!ok) break;
+        g.ApplyPlacement(c, r);
+        if (n % 3 == 0) g.AddPendingGarbage(2);
+    }
+    return n;
+}
+
+void test_stronger_than_greedy() {
+    int greedy = 0, beam = 0;
+    for (uint64_t seed = 1; seed <= 4; ++seed) {
+        greedy += survive(false, seed);
+        beam += survive(true, seed);
+    }
+    std::fprintf(stderr, "[beam] survival: greedy %d pieces, beam %d pieces\n", greedy, beam);
+    check(beam > greedy, "가비지 압박 아래 greedy 보다 오래 버틴다");
+}
+
+}  // namespace
+
+int main() {
+    test_depth_one_matches_heuristic();
+    test_deterministic_without_budget();
+    test_budget_cuts_depth();
+    test_stronger_than_greedy();
+    if (g_failures) {
+        std::fprintf(stderr, "[beam] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[beam] all passed\n");
+    return 0;
+}
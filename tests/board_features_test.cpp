@@ -0,0 +1,263 @@
+// tests/board_features_test.cpp — 보드 특징 추출기(bot/board_features.h) 회귀
+//
+//   - 특징 8개가 칸을 하나씩 보는 단순 구현과 같다(무작위 보드 + 실제 대국 보드)
+//   - SimGame 행 마스크와 int 그리드 두 입구가 같은 마스크를 만든다
+//   - 마스크로 옮긴 eval_shape 가 예전 이중 루프 구현과 비트 단위로 같다
+//   - batch 결과가 한 판씩 부른 결과와 같다
+//   - bcts_score 가 features.py 의 가중치 합과 같다
+
+#include "../bot/board_features.h"
+#include "../bot/placement.h"
+#include "../src/sim_game.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[board_features] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[board_features] ok:   %s\n", what); }
+}
+
+using bot::kBoardCols;
+using bot::kBoardRows;
+using bot::kNumBoardFeatures;
+using Grid = int[kBoardRows][kBoardCols];
+struct Board { Grid g; };
+
+bool filled(const Grid& g, int r, int c) { return g[r][c] > 0 && g[r][c] != 8; }
+
+// 칸 단위 기준 구현. 정의는 board_features.h 주석 그대로 옮겼다.
+void reference_features(const Grid& g, int32_t (&out)[kNumBoardFeatures]) {
+    int h[kBoardCols] = {0};
+    int holes = 0, covered = 0;
+    for (int c = 0; c < kBoardCols; ++c) {
+        int top = kBoardRows;
+        for (int r = 0; r < kBoardRows; ++r)
+            if (filled(g, r, c)) { top = r; break; }
+        h[c] = kBoardRows - top;
+        for (int r = top; r < kBoardRows; ++r) {
+            if (!filled(g, r, c)) { ++holes; continue; }
+            bool holeBelow = false;
+            for (int k = r + 1; k < kBoardRows; ++k)
+                if (!filled(g, k, c)) holeBelow = true;
+            if (holeBelow) ++covered;
+        }
+    }
+    int agg = 0, maxH = 0, bump = 0, wells = 0;
+    for (int c = 0; c < kBoardCols; ++c) {
+        agg += h[c];
+        maxH = std::max(maxH, h[c]);
+        if (c + 1 < kBoardCols) bump += std::abs(h[c] - h[c + 1]);
+        const int left = c > 0 ? h[c - 1] : kBoardRows;
+        const int right = c + 1 < kBoardCols ? h[c + 1] : kBoardRows;
+        const int d = std::min(left, right) - h[c];
+        if (d > 0) wells += d * (d + 1) / 2;
+    }
+    int rowT = 0, colT = 0;
+    for (int r = 0; r < kBoardRows; ++r) {
+        bool prev = true;   // 왼쪽 벽
+        for (int c = 0; c < kBoardCols; ++c) {
+            if (filled(g, r, c) != prev) ++rowT;
+            prev = filled(g, r, c);
+        }
+        if (!prev) ++rowT;  // 오른쪽 벽
+    }
+    for (int c = 0; c < kBoardCols; ++c) {
+        bool prev = false;  // 맨 위 바깥
+        for (int r = 0; r < kBoardRows; ++r) {
+            if (filled(g, r, c) != prev) ++colT;
+            prev = filled(g, r, c);
+        }
+        if (!prev) ++colT;  // 바닥
+    }
+    const int32_t vals[kNumBoardFeatures] = {agg, maxH, bump, holes, wells, rowT, colT, covered};
+    std::memcpy(out, vals, sizeof(vals));
+}
+
+// 특징 추출기로 옮기기 전의 eval_shape.
+double legacy_eval_shape(const Grid& g) {
+    int heights[kBoardCols] = {0};
+    int holes = 0;
+    for (int c = 0; c < kBoardCols; ++c) {
+        int top = -1;
+        for (int r = 0; r < kBoardRows; ++r)
+            if (filled(g, r, c)) { top = r; break; }
+        if (top < 0) continue;
+        heights[c] = kBoardRows - top;
+        for (int r = top; r < kBoardRows; ++r)
+            if (!filled(g, r, c)) ++holes;
+    }
+    int agg = 0, bump = 0;
+    for (int c = 0; c < kBoardCols; ++c) agg += heights[c];
+    for (int c = 0; c + 1 < kBoardCols; ++c) bump += std::abs(heights[c] - heights[c + 1]);
+    return -0.510066 * agg - 0.356630 * holes - 0.184483 * bump;
+}
+
+// 위쪽은 비고 아래로 갈수록 찬 무작위 보드. ghost(8) 도 섞어 빈 칸 취급을 본다.
+void random_board(std::mt19937& rng, Grid& g) {
+    const int surface = static_cast<int>(rng() % (kBoardRows + 1));
+    for (int r = 0; r < kBoardRows; ++r)
+        for (int c = 0; c < kBoardCols; ++c) {
+            const uint32_t roll = rng() % 100;
+            int v = 0;
+            if (r >= surface && roll < 70) v = 1 + static_cast<int>(rng() % 7);
+            else if (roll < 4) v = 8;
+            else if (roll < 8) v = 1 + static_cast<int>(rng() % 7);
+            g[r][c] = v;
+        }
+}
+
+std::vector<SimGame> played_games() {
+    std::vector<SimGame> games;
+    for (uint64_t seed = 1; seed <= 6; ++seed) {
+        SimGame g(seed);
+        for (int k = 0; k < 120 && !g.IsGameOver(); ++k) {
+            int c = 0, r = 0;
+            // 일부러 엉성하게 둬서 구멍·우물이 있는 판도 나오게 한다.
+            const bool ok = (k % 3 == 0) ? bot::fallback_placement(g, c, r)
+                                         : bot::heuristic_placement(g, c, r);
+            if (!ok) break;
+            g.ApplyPlacement(c, r);
+            games.push_back(g);
+        }
+    }
+    return games;
+}
+
+bool same(const int32_t (&a)[kNumBoardFeatures], const int32_t (&b)[kNumBoardFeatures]) {
+    return std::memcmp(a, b, sizeof(a)) == 0;
+}
+
+void test_matches_reference_on_random_boards() {
+    std::mt19937 rng(20240611);
+    bool all = true, heightsOk = true;
+    for (int t = 0; t < 5000; ++t) {
+        Grid g;
+        random_board(rng, g);
+        bot::BoardRows rows;
+        bot::board_rows(g, rows);
+        int32_t got[kNumBoardFeatures], want[kNumBoardFeatures], h[kBoardCols];
+        bot::board_features(rows, got, h);
+        reference_features(g, want);
+        if (!same(got, want)) all = false;
+        int agg = 0;
+        for (int c = 0; c < kBoardCols; ++c) agg += h[c];
+        if (agg != got[bot::kFeatAggHeight]) heightsOk = false;
+    }
+    check(all, "무작위 보드 5000개에서 특징 8개가 칸 단위 구현과 같다");
+    check(heightsOk, "heights_out 의 합이 총높이와 같다");
+}
+
+void test_empty_and_full_edges() {
+    Grid empty = {};
+    bot::BoardRows rows;
+    bot::board_rows(empty, rows);
+    int32_t f[kNumBoardFeatures];
+    bot::board_features(rows, f);
+    check(f[bot::kFeatAggHeight] == 0 && f[bot::kFeatHoles] == 0 && f[bot::kFeatWells] == 0 &&
+          f[bot::kFeatRowTransitions] == 2 * kBoardRows && f[bot::kFeatColTransitions] == kBoardCols,
+          "빈 보드: 행마다 벽 전환 2, 열마다 바닥 전환 1");
+
+    Grid well = {};
+    for (int r = 10; r < kBoardRows; ++r)
+        for (int c = 1; c < kBoardCols; ++c) well[r][c] = 1;
+    bot::board_rows(well, rows);
+    bot::board_features(rows, f);
+    check(f[bot::kFeatWells] == 10 * 11 / 2 && f[bot::kFeatMaxHeight] == 10,
+          "왼쪽 벽에 붙은 깊이 10 우물은 55");
+}
+
+void test_sim_rows_and_eval_shape() {
+    const std::vector<SimGame> games = played_games();
+    bool rowsOk = true, featsOk = true, shapeOk = true;
+    for (const SimGame& g : games) {
+        bot::BoardRows fromSim, fromGrid;
+        bot::board_rows(g, fromSim);
+        bot::board_rows(g.Grid(), fromGrid);
+        if (std::memcmp(fromSim, fromGrid, sizeof(fromSim)) != 0) rowsOk = false;
+        int32_t got[kNumBoardFeatures], want[kNumBoardFeatures];
+        bot::board_features(fromSim, got);
+        reference_features(g.Grid(), want);
+        if (!same(got, want)) featsOk = false;
+        const double legacy = legacy_eval_shape(g.Grid());
+        if (bot::eval_shape(g) != legacy || bot::eval_shape(g.Grid()) != legacy ||
+            bot::eval_board(g, 3) != bot::eval_board(g.Grid(), 3))
+            shapeOk = false;
+    }
+    std::fprintf(stderr, "[board_features] %zu played boards\n", games.size());
+    check(rowsOk, "SimGame::RowMask 와 Grid() 에서 만든 마스크가 같다");
+    check(featsOk, "실제 대국 보드에서도 칸 단위 구현과 같다");
+    check(shapeOk, "eval_shape / eval_board 가 예전 구현과 비트 단위로 같다");
+}
+
+void test_batch_and_bcts() {
+    std::mt19937 rng(7);
+    const int n = 257;
+    std::vector<uint16_t> rows(static_cast<size_t>(n) * kBoardRows);
+    std::vector<Board> boards(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        random_board(rng, boards[i].g);
+        bot::BoardRows one;
+        bot::board_rows(boards[i].g, one);
+        std::memcpy(&rows[static_cast<size_t>(i) * kBoardRows], one, sizeof(one));
+    }
+    std::vector<int32_t> out(static_cast<size_t>(n) * kNumBoardFeatures);
+    bot::board_features_batch(rows.data(), n, out.data());
+    bool batchOk = true, bctsOk = true;
+    for (int i = 0; i < n; ++i) {
+        int32_t want[kNumBoardFeatures];
+        reference_features(boards[i].g, want);
+        if (std::memcmp(&out[static_cast<size_t>(i) * kNumBoardFeatures], want, sizeof(want)) != 0)
+            batchOk = false;
+        // features.py: sum(BCTS_WEIGHTS[k] * v) — agg, bump, holes, max(0), lines, wells 순서.
+        const int lines = i % 5;
+        const double py = -0.510066 * want[0] + -0.184483 * want[2] + -0.35663 * want[3]
+                        + 0.0 * want[1] + 0.760666 * lines + -0.1 * want[4];
+        if (std::fabs(bot::bcts_score(want, lines) - py) > 1e-9) bctsOk = false;
+    }
+    check(batchOk, "batch 결과가 판마다 부른 결과와 같다");
+    check(bctsOk, "bcts_score 가 features.py 가중치 합과 같다");
+}
+
+void bench() {
+    const std::vector<SimGame> games = played_games();
+    const int reps = 200;
+    double sink = 0.0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < reps; ++k)
+        for (const SimGame& g : games) sink += legacy_eval_shape(g.Grid());
+    auto t1 = std::chrono::steady_clock::now();
+    for (int k = 0; k < reps; ++k)
+        for (const SimGame& g : games) sink += bot::eval_shape(g);
+    auto t2 = std::chrono::steady_clock::now();
+    const double boards = static_cast<double>(reps) * games.size();
+    const double legacyNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / boards;
+    const double maskNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / boards;
+    std::fprintf(stderr, "[board_features] eval_shape: scalar %.1f ns, row masks %.1f ns (%g)\n",
+                 legacyNs, maskNs, sink != 0.0 ? 1.0 : 0.0);
+}
+
+}  // namespace
+
+int main() {
+    test_matches_reference_on_random_boards();
+    test_empty_and_full_edges();
+    test_sim_rows_and_eval_shape();
+    test_batch_and_bcts();
+    bench();
+    if (g_failures) {
+        std::fprintf(stderr, "[board_features] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[board_features] all passed\n");
+    return 0;
+}
@@ -0,0 +1,100 @@
+// tests/bot_onnx_test.cpp — BotOnnx 의 ONNX Runtime 없이 확인할 수 있는 부분
+//
+//   - 지연 히스토그램: 칸 경계, 백분위 오차 상한, Merge, CountAbove
+//   - bots.cfg 넷째 칸(parse_onnx_options) 파싱과 잘못된 값 거절
+//   - 로드 전 BotOnnx 는 추론을 거절하고 지연을 기록하지 않는다
+
+#include "../bot/bot_onnx.h"
+#include "../bot/latency_histogram.h"
+#include "../bot/placement.h"
+#include "../src/sim_game.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[bot_onnx] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[bot_onnx] ok:   %s\n", what); }
+}
+
+void test_histogram_buckets() {
+    using H = bot::LatencyHistogram;
+    bool monotone = true, covers = true;
+    for (int i = 1; i < H::kBuckets; ++i)
+        if (H::UpperBound(i) <= H::UpperBound(i - 1)) monotone = false;
+    const uint64_t samples[] = {0, 1, 7, 8, 9, 15, 16, 17, 1000, 123456, 16666667, 1ull << 40, ~0ull};
+    for (uint64_t v : samples) {
+        const int i = H::Index(v);
+        const uint64_t lower = i == 0 ? 0 : H::UpperBound(i - 1) + 1;
+        if (i < 0 || i >= H::kBuckets || v < lower || v > H::UpperBound(i)) covers = false;
+    }
+    check(monotone && covers, "칸 경계가 겹치지 않고 모든 값을 덮는다");
+}
+
+void test_histogram_percentiles() {
+    bot::LatencyHistogram h;
+    for (uint64_t us = 1; us <= 1000; ++us) h.Record(us * 1000);
+    const double p50 = static_cast<double>(h.PercentileNs(0.5));
+    const double p99 = static_cast<double>(h.PercentileNs(0.99));
+    check(h.Count() == 1000 && h.MaxNs() == 1000000, "개수와 최댓값");
+    check(p50 >= 500000.0 && p50 <= 500000.0 * 1.125, "p50 은 실제 이상, 12.5% 이내");
+    check(p99 >= 990000.0 && p99 <= 1000000.0, "p99 는 최댓값을 넘지 않는다");
+    check(h.MeanNs() == 500500.0, "평균");
+
+    bot::LatencyHistogram other;
+    other.Record(20000000);   // 한 틱(16.7ms)을 넘긴 추론 하나
+    h.Merge(other);
+    check(h.Count() == 1001 && h.CountAbove(16666667) == 1 && h.MaxNs() == 20000000,
+          "Merge 후 틱을 넘긴 추론을 센다");
+    char line[160];
+    h.Format(line, sizeof(line));
+    check(std::strstr(line, "n=1001") != nullptr && std::strstr(line, "p99=") != nullptr,
+          "한 줄 요약");
+    h.Reset();
+    check(h.Count() == 0 && h.PercentileNs(0.5) == 0, "Reset");
+}
+
+void test_parse_options() {
+    bot::OnnxSessionOptions o;
+    check(bot::parse_onnx_options("", o) && o.intraOpThreads == 1 && o.interOpThreads == 1 &&
+          o.graphOpt == bot::OnnxSessionOptions::GraphOpt::All, "빈 칸이면 기본값");
+    check(bot::parse_onnx_options("intra_threads=2  graph_opt=basic", o) && o.intraOpThreads == 2 &&
+          o.interOpThreads == 1 && o.graphOpt == bot::OnnxSessionOptions::GraphOpt::Basic,
+          "적은 키만 덮어쓴다");
+    std::string err;
+    const bot::OnnxSessionOptions before = o;
+    const bool bad = !bot::parse_onnx_options("inter_threads=4 graph_opt=fast", o, &err)
+                  && o.interOpThreads == before.interOpThreads && !err.empty();
+    check(bad, "모르는 값이면 아무것도 바꾸지 않고 사유를 준다");
+    check(!bot::parse_onnx_options("threads=2", o) && !bot::parse_onnx_options("intra_threads=-1", o),
+          "모르는 키와 음수 스레드 수를 거절한다");
+}
+
+void test_unloaded_model() {
+    bot::BotOnnx model;
+    SimGame g(1);
+    int col = -1, rot = -1;
+    float logits[bot::kNumPlacements], value = 0.0f;
+    check(!model.IsLoaded() && !model.Infer(g, col, rot) && !model.Evaluate(g, logits, &value),
+          "로드 전에는 추론을 거절한다");
+    check(model.Latency().Count() == 0 && !model.UsesIoBinding(), "거절한 호출은 지연으로 세지 않는다");
+}
+
+}  // namespace
+
+int main() {
+    test_histogram_buckets();
+    test_histogram_percentiles();
+    test_parse_options();
+    test_unloaded_model();
+    if (g_failures) {
+        std::fprintf(stderr, "[bot_onnx] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[bot_onnx] all passed\n");
+    return 0;
+}
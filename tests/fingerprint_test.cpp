@@ -0,0 +1,95 @@
+// tests/fingerprint_test.cpp — 증분 Zobrist 지문(SimGame::Fingerprint) 회귀
+//
+//   - 증분 유지한 그리드 지문이 같은 그리드를 빈 SimGrid 에 SetCell 로 새로 쓴
+//     값과 같다 (lock, 줄 삭제, 가비지 삽입을 모두 거친 뒤에도)
+//   - StateHash 가 다르면 지문도 다르다 (이 실행 범위 안에서 충돌 없음)
+//   - 복사본은 같은 지문을 가진다
+
+#include "../src/sim_game.h"
+
+#include <cstdio>
+#include <unordered_map>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[fingerprint] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[fingerprint] ok:   %s\n", what); }
+}
+
+uint64_t rebuilt_grid_fingerprint(const SimGame& g) {
+    SimGrid fresh;
+    const auto& grid = g.Grid();
+    for (int r = 0; r < SimGrid::kRows; ++r)
+        for (int c = 0; c < SimGrid::kCols; ++c)
+            if (grid[r][c] != 0) fresh.SetCell(r, c, grid[r][c]);
+    return fresh.Fingerprint();
+}
+
+void test_incremental_matches_rebuild() {
+    bool gridOk = true;
+    bool noCollision = true;
+    bool copyOk = true;
+    int clears = 0, garbage = 0, states = 0;
+    std::unordered_map<uint64_t, uint64_t> seen;  // fingerprint -> StateHash
+
+    for (uint64_t seed = 1; seed <= 40; ++seed) {
+        SimGame g(seed);
+        XorShift64Star pick(seed * 7919);
+        for (int step = 0; step < 400 && !g.IsGameOver(); ++step) {
+            SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+            const int n = g.EnumeratePlacements(landed);
+            if (n == 0) break;
+            // 대체로 가장 깊이 떨어지는 수를 골라 줄 삭제가 자주 나게 한다.
+            int k = static_cast<int>(pick.nextUInt(static_cast<uint32_t>(n)));
+            if (pick.nextUInt(4) != 0)
+                for (int i = 0; i < n; ++i)
+                    if (landed[i].row > landed[k].row) k = i;
+            if (g.ApplyLandedPlacement(landed[k]) > 0) ++clears;
+            if (g.lastGarbageReceived > 0) ++garbage;
+            if (step % 9 == 0) g.AddPendingGarbage(1 + static_cast<int>(pick.nextUInt(3)));
+            // 프레임 단위 경로도 섞는다 (좌우·소프트 드롭·회전. 바닥에 닿으면 여기서 lock).
+            g.SubmitInput(static_cast<uint8_t>(pick.nextUInt(16)));
+
+            if (g.GridFingerprint() != rebuilt_grid_fingerprint(g)) gridOk = false;
+            const SimGame copy = g;
+            if (copy.Fingerprint() != g.Fingerprint()) copyOk = false;
+
+            const auto it = seen.emplace(g.Fingerprint(), g.StateHash());
+            if (!it.second && it.first->second != g.StateHash()) noCollision = false;
+            ++states;
+        }
+    }
+    std::fprintf(stderr, "[fingerprint] %d states, %d clears, %d garbage locks\n",
+                 states, clears, garbage);
+    check(clears > 0 && garbage > 0, "줄 삭제와 가비지 삽입 경로를 모두 거쳤다");
+    check(gridOk, "증분 그리드 지문 == 새로 쓴 그리드의 지문");
+    check(copyOk, "복사본의 지문이 같다");
+    check(noCollision, "지문이 같으면 StateHash 도 같다");
+}
+
+void test_fresh_grids() {
+    SimGrid a, b;
+    check(a.Fingerprint() == b.Fingerprint(), "빈 그리드끼리 같은 지문");
+    a.SetCell(19, 0, 3);
+    check(a.Fingerprint() != b.Fingerprint(), "셀 하나가 다르면 다른 지문");
+    a.SetCell(19, 0, 0);
+    check(a.Fingerprint() == b.Fingerprint(), "되돌리면 원래 지문");
+    a.SetCell(19, 4, 2);
+    b.SetCell(18, 4, 2);
+    check(a.Fingerprint() != b.Fingerprint(), "같은 행 내용이라도 행 위치가 다르면 다른 지문");
+}
+
+}  // namespace
+
+int main() {
+    test_fresh_grids();
+    test_incremental_matches_rebuild();
+    if (g_failures) {
+        std::fprintf(stderr, "[fingerprint] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[fingerprint] all passed\n");
+    return 0;
+}
@@ -0,0 +1,185 @@
+// tests/inference_server_test.cpp — batch 추론 앞단(bot/inference_server.h) 회귀
+//
+//   - batch 로 돌려도 요청마다 자기 입력의 결과를 받는다
+//   - 여러 스레드의 요청이 maxBatch 이하의 batch 로 묶인다
+//   - 혼자 온 요청도 지연 상한 뒤에는 돈다
+//   - backend 실패는 ok = false 로, 서버를 멈출 때 남은 요청은 마저 돈다
+//   - ServerEvaluator 로 MCTS 여러 스레드의 잎이 한 batch 에 섞인다
+//
+// 실제 ONNX 세션 대신 입력만 보고 값을 정하는 가짜 backend 를 쓴다.
+
+#include "../bot/inference_server.h"
+#include "../bot/mcts.h"
+#include "../bot/placement.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[inference] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[inference] ok:   %s\n", what); }
+}
+
+constexpr int kCells = bot::kBoardRows * bot::kBoardCols;
+using bot::kNumPieceTypes;
+using bot::kNumPlacements;
+
+// logits[a] = 찬 칸 수 + a, value = 현재 블록 번호. 판마다 값이 달라 섞이면 드러난다.
+void fake_one(const float* board, const float* current, float* logits, float* value) {
+    float filled = 0.0f;
+    for (int i = 0; i < kCells; ++i) filled += board[i];
+    for (int a = 0; a < kNumPlacements; ++a) logits[a] = filled + static_cast<float>(a);
+    *value = 0.0f;
+    for (int t = 0; t < kNumPieceTypes; ++t)
+        if (current[t] > 0.5f) *value = static_cast<float>(t);
+}
+
+bot::InferenceServer::Backend fake_backend(std::atomic<int>* calls = nullptr) {
+    return [calls](const float* board, const float* current, const float*, int n,
+                   float* logits, float* values) {
+        if (calls) calls->fetch_add(1);
+        for (int i = 0; i < n; ++i)
+            fake_one(board + i * kCells, current + i * kNumPieceTypes,
+                     logits + i * kNumPlacements, values + i);
+        return true;
+    };
+}
+
+SimGame played(uint64_t seed, int pieces) {
+    SimGame g(seed);
+    for (int k = 0; k < pieces; ++k) {
+        int c = 0, r = 0;
+        if (!bot::heuristic_placement(g, c, r)) break;
+        g.ApplyPlacement(c, r);
+    }
+    return g;
+}
+
+bool matches_direct(const SimGame& g, const bot::InferenceResult& r) {
+    float board[kCells], current[kNumPieceTypes], next[kNumPieceTypes];
+    bot::observe(g, board, current, next);
+    float logits[kNumPlacements], value;
+    fake_one(board, current, logits, &value);
+    if (!r.ok || r.eval.value != value) return false;
+    for (int a = 0; a < kNumPlacements; ++a)
+        if (r.eval.logits[a] != logits[a]) return false;
+    return true;
+}
+
+void test_results_routed_per_request() {
+    bot::InferenceServerConfig config;
+    config.maxBatch = 8;
+    config.maxLatencyUs = 2000;
+    bot::InferenceServer server(fake_backend(), config);
+    std::vector<SimGame> games;
+    for (int i = 0; i < 20; ++i) games.push_back(played(100 + i, i));
+    std::vector<std::future<bot::InferenceResult>> futures;
+    for (const SimGame& g : games) futures.push_back(server.Submit(g));
+    bool all = true;
+    for (size_t i = 0; i < games.size(); ++i)
+        if (!matches_direct(games[i], futures[i].get())) all = false;
+    check(all, "batch 안에서도 요청마다 자기 판의 결과를 받는다");
+    const bot::InferenceServerStats st = server.Stats();
+    check(st.requests == 20 && st.largestBatch <= 8 && st.batches >= 3,
+          "batch 는 maxBatch 를 넘지 않는다");
+}
+
+void test_concurrent_submitters_are_batched() {
+    bot::InferenceServerConfig config;
+    config.maxBatch = 16;
+    config.maxLatencyUs = 5000;
+    std::atomic<int> calls{0};
+    bot::InferenceServer server(fake_backend(&calls), config);
+    const SimGame g = played(7, 10);
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&] {
+            for (int k = 0; k < 50; ++k)
+                if (!matches_direct(g, server.Submit(g).get())) wrong.fetch_add(1);
+        });
+    }
+    for (auto& t : threads) t.join();
+    const bot::InferenceServerStats st = server.Stats();
+    std::fprintf(stderr, "[inference] 8 threads x 50: %llu batches, mean %.2f, largest %d\n",
+                 static_cast<unsigned long long>(st.batches), st.meanBatch(), st.largestBatch);
+    check(wrong.load() == 0 && st.requests == 400, "동시 요청이 모두 올바른 결과를 받는다");
+    check(st.meanBatch() > 1.5 && st.largestBatch <= 16 && calls.load() == static_cast<int>(st.batches),
+          "여러 스레드의 요청이 한 backend 호출로 묶인다");
+}
+
+void test_lone_request_meets_deadline() {
+    bot::InferenceServerConfig config;
+    config.maxBatch = 64;
+    config.maxLatencyUs = 1000;
+    bot::InferenceServer server(fake_backend(), config);
+    const SimGame g(3);
+    auto f = server.Submit(g);
+    const bool ready = f.wait_for(std::chrono::seconds(2)) == std::future_status::ready;
+    check(ready && f.get().ok, "batch 가 안 차도 지연 상한 뒤에는 돈다");
+    check(server.Stats().largestBatch == 1, "혼자 온 요청은 batch 1");
+}
+
+void test_failure_and_shutdown() {
+    bot::InferenceServerConfig config;
+    config.maxBatch = 4;
+    config.maxLatencyUs = 100000;  // 마감이 한참 남은 요청을 멈출 때 마저 돌리는지 본다
+    std::future<bot::InferenceResult> failed, flushed;
+    {
+        bot::InferenceServer broken(
+            [](const float*, const float*, const float*, int, float*, float*) { return false; },
+            config);
+        failed = broken.Submit(SimGame(1));
+    }
+    check(!failed.get().ok, "backend 실패는 ok = false");
+    {
+        bot::InferenceServer server(fake_backend(), config);
+        flushed = server.Submit(SimGame(2));
+    }
+    check(flushed.get().ok, "서버를 멈추면 남은 요청을 마저 돌린다");
+}
+
+void test_mcts_leaves_share_batches() {
+    bot::InferenceServerConfig config;
+    config.maxBatch = 32;
+    config.maxLatencyUs = 2000;
+    bot::InferenceServer server(fake_backend(), config);
+    bot::ServerEvaluator eval(server);
+    bot::MctsConfig mc;
+    mc.simulations = 200;
+    mc.threads = 4;
+    mc.leafBatch = 4;
+    bot::Mcts mcts(eval, mc);
+    const SimGame g = played(12, 8);
+    const bot::MctsResult r = mcts.Search(g);
+    bool legal = false;
+    for (const auto& p : g.LegalPlacements())
+        if (bot::encode_action(p.col, p.rot) == r.action) legal = true;
+    const bot::InferenceServerStats st = server.Stats();
+    std::fprintf(stderr, "[inference] mcts: %d sims, %llu requests in %llu batches, largest %d\n",
+                 r.simulations, static_cast<unsigned long long>(st.requests),
+                 static_cast<unsigned long long>(st.batches), st.largestBatch);
+    check(legal && r.simulations >= 200, "ServerEvaluator 로 돈 MCTS 도 합법 수를 낸다");
+    check(st.largestBatch > mc.leafBatch, "여러 탐색 스레드의 잎이 한 batch 에 섞인다");
+}
+
+}  // namespace
+
+int main() {
+    test_results_routed_per_request();
+    test_concurrent_submitters_are_batched();
+    test_lone_request_meets_deadline();
+    test_failure_and_shutdown();
+    test_mcts_leaves_share_batches();
+    if (g_failures) {
+        std::fprintf(stderr, "[inference] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[inference] all passed\n");
+    return 0;
+}
@@ -0,0 +1,187 @@
+// tests/mcts_test.cpp — 착수 MCTS(bot/mcts.h) 회귀
+//
+//   - 합법 수만 방문하고, 방문 수 합이 시뮬레이션 수와 맞다
+//   - 1 스레드·잎 1 개면 결정론적
+//   - 여러 스레드 + 잎 batch 로 돌려도 시뮬레이션 수를 지키고 합법 수를 낸다
+//   - 평가기 batch 크기가 leafBatch 를 넘지 않는다
+//   - 가비지 압박 아래 heuristic 평가기 MCTS 가 greedy 보다 오래 버틴다
+
+#include "../bot/mcts.h"
+#include "../bot/placement.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[mcts] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[mcts] ok:   %s\n", what); }
+}
+
+SimGame midgame(uint64_t seed, int pieces) {
+    SimGame g(seed);
+    for (int k = 0; k < pieces; ++k) {
+        int c = 0, r = 0;
+        if (!bot::heuristic_placement(g, c, r)) break;
+        g.ApplyPlacement(c, r);
+    }
+    return g;
+}
+
+bool legal_action(const SimGame& g, int action) {
+    for (const auto& p : g.LegalPlacements())
+        if (bot::encode_action(p.col, p.rot) == action) return true;
+    return false;
+}
+
+// 평가기 호출을 세는 래퍼.
+class CountingEvaluator : public bot::Evaluator {
+public:
+    void Evaluate(const SimGame* const* sims, int count, bot::Evaluation* out) override {
+        calls.fetch_add(1);
+        int prev = maxBatch.load();
+        while (count > prev && !maxBatch.compare_exchange_weak(prev, count)) {}
+        inner.Evaluate(sims, count, out);
+    }
+    double Reward(int lines, bool toppedOut) const override { return inner.Reward(lines, toppedOut); }
+
+    bot::HeuristicEvaluator inner;
+    std::atomic<int> calls{0};
+    std::atomic<int> maxBatch{0};
+};
+
+void test_visits_legal_and_counted() {
+    const SimGame g = midgame(3, 12);
+    bot::HeuristicEvaluator eval;
+    bot::MctsConfig config;
+    config.simulations = 300;
+    config.leafBatch = 1;
+    bot::Mcts mcts(eval, config);
+    const bot::MctsResult r = mcts.Search(g);
+
+    float sum = 0.0f;
+    bool onlyLegal = true;
+    for (int a = 0; a < bot::kNumPlacements; ++a) {
+        sum += r.visits[a];
+        if (r.visits[a] > 0 && !legal_action(g, a)) onlyLegal = false;
+    }
+    check(onlyLegal, "합법 수만 방문한다");
+    check(r.simulations == 300 && sum == 300.0f, "루트 방문 수 합 == 시뮬레이션 수");
+    check(legal_action(g, r.action) && r.visits[r.action] == *std::max_element(r.visits, r.visits + 40),
+          "고른 수는 방문이 가장 많은 합법 수");
+    check(r.maxDepth >= 2 && r.nodes > 1, "루트 아래로 여러 단을 펼친다");
+}
+
+void test_deterministic_single_thread() {
+    const SimGame g = midgame(8, 20);
+    bot::HeuristicEvaluator eval;
+    bot::MctsConfig config;
+    config.simulations = 200;
+    config.leafBatch = 1;
+    config.dirichletAlpha = 0.3;
+    config.seed = 11;
+    bot::Mcts a(eval, config), b(eval, config);
+    const bot::MctsResult ra = a.Search(g);
+    const bot::MctsResult rb = b.Search(g);
+    const bool same = std::equal(ra.visits, ra.visits + 40, rb.visits)
+                   && std::equal(ra.prior, ra.prior + 40, rb.prior);
+    check(same && ra.action == rb.action, "1 스레드·잎 1 개면 (상태, seed) 로 결과가 정해진다");
+    const bot::MctsResult again = a.Search(g);
+    check(std::equal(ra.visits, ra.visits + 40, again.visits), "노드 풀을 재사용해도 같은 결과");
+}
+
+void test_multithreaded_batched() {
+    const SimGame g = midgame(21, 15);
+    CountingEvaluator eval;
+    bot::MctsConfig config;
+    config.simulations = 400;
+    config.threads = 4;
+    config.leafBatch = 8;
+    config.virtualLoss = 3;
+    bot::Mcts mcts(eval, config);
+    const bot::MctsResult r = mcts.Search(g);
+    float sum = 0.0f;
+    for (float v : r.visits) sum += v;
+    std::fprintf(stderr, "[mcts] 4 threads: %d sims, %d evaluate calls, max batch %d, %d collisions\n",
+                 r.simulations, eval.calls.load(), eval.maxBatch.load(), r.collisions);
+    check(r.simulations >= 400 && static_cast<int>(sum) == r.simulations,
+          "여러 스레드도 시뮬레이션을 빠짐없이 되돌린다");
+    check(legal_action(g, r.action), "여러 스레드 결과도 합법 수");
+    check(eval.maxBatch.load() > 1 && eval.maxBatch.load() <= 8, "잎을 leafBatch 까지 묶어 평가한다");
+}
+
+void test_budget_stops_early() {
+    const SimGame g = midgame(4, 10);
+    bot::HeuristicEvaluator eval;
+    bot::MctsConfig config;
+    config.simulations = 1000000;
+    config.budgetMs = 2.0;
+    bot::Mcts mcts(eval, config);
+    const bot::MctsResult r = mcts.Search(g);
+    check(r.simulations > 0 && r.simulations < 1000000 && legal_action(g, r.action),
+          "시간 예산이 다 되면 멈추고 그때까지의 답을 낸다");
+}
+
+int survive(bool mcts, uint64_t seed) {
+    bot::HeuristicEvaluator eval;
+    bot::MctsConfig config;
+    config.simulations = 64;
+    config.leafBatch = 1;
+    config.discount = 1.0;
+    bot::Mcts search(eval, config);
+    SimGame g(seed);
+    int n = 0;
+    for (; n < 300 && !g.IsGameOver(); ++n) {
+        int c = 0, r = 0;
+        const bool ok = mcts ? bot::mcts_placement(search, g, c, r)
+                             : bot::heuristic_placement(g, c, r);
+        if (!ok) break;
+        g.ApplyPlacement(c, r);
+        if (n % 3 == 0) g.AddPendingGarbage(2);
+    }
+    return n;
+}
+
+void test_stronger_than_greedy() {
+    int greedy = 0, mcts = 0;
+    for (uint64_t seed = 1; seed <= 3; ++seed) {
+        greedy += survive(false, seed);
+        mcts += survive(true, seed);
+    }
+    std::fprintf(stderr, "[mcts] survival: greedy %d pieces, mcts %d pieces\n", greedy, mcts);
+    check(mcts > greedy, "가비지 압박 아래 greedy 보다 오래 버틴다");
+}
+
+void test_no_legal_moves() {
+    SimGame g(1);
+    // 가운데에만 쌓다가 못 놓게 되면 아무 데나 놓아 게임 오버를 만든다.
+    for (int k = 0; k < 200 && !g.IsGameOver(); ++k) {
+        int c = 4, r = 0;
+        if (g.ApplyPlacement(c, r) < 0 && bot::fallback_placement(g, c, r)) g.ApplyPlacement(c, r);
+    }
+    check(g.IsGameOver(), "게임 오버 판을 만든다");
+    bot::HeuristicEvaluator eval;
+    bot::Mcts mcts(eval, bot::MctsConfig{});
+    int c = -1, r = -1;
+    check(!bot::mcts_placement(mcts, g, c, r), "게임 오버 판에서는 false");
+}
+
+}  // namespace
+
+int main() {
+    test_visits_legal_and_counted();
+    test_deterministic_single_thread();
+    test_multithreaded_batched();
+    test_budget_stops_early();
+    test_stronger_than_greedy();
+    test_no_legal_moves();
+    if (g_failures) {
+        std::fprintf(stderr, "[mcts] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[mcts] all passed\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+// tests/placement_kernels_test.cpp — 블록 종류별 placement 커널(src/sim_placement_kernels.h) 회귀
+//
+//   - EnumeratePlacements(커널)가 LegalPlacements(LandingRow 참조 구현)와 순서까지 같고,
+//     착지 행을 ApplyLandedPlacement 가 받아 준다
+//   - EnumerateDistinctPlacements 는 그 부분열이고, 빠진 수는 남은 수 중 하나와 칸이
+//     같으며, 남은 수끼리는 칸이 모두 다르다
+//   - 빈 보드에서 O 는 36→9, T 는 33 그대로
+//   - 무작위 보드 · 무작위 스폰 높이(0..8) · 블록 7 종 전부
+
+#include "../src/sim_game.h"
+#include "../src/sim_shapes.h"
+#include "../core/rng.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[kernels] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[kernels] ok:   %s\n", what); }
+}
+
+void set_cell(SimSnapshot& s, int r, int c, int code) {
+    const int bit = 3 * (r * SimGrid::kCols + c);
+    for (int k = 0; k < 3; ++k) {
+        const int b = bit + k;
+        s.grid[b >> 3] = static_cast<uint8_t>((s.grid[b >> 3] & ~(1u << (b & 7))) | (((code >> k) & 1u) << (b & 7)));
+    }
+}
+
+// 아래로 갈수록 빽빽한 무작위 보드. 꽉 찬 줄은 만들지 않는다.
+SimGame make_board(XorShift64Star& rng, int shape, int startRow) {
+    SimSnapshot s = SimGame(rng.next() | 1).Snapshot();
+    std::memset(s.grid, 0, sizeof(s.grid));
+    std::memset(s.garbageRows, 0, sizeof(s.garbageRows));
+    const int height = static_cast<int>(rng.nextUInt(17));
+    for (int r = SimGrid::kRows - height; r < SimGrid::kRows; ++r) {
+        int filled = 0;
+        for (int c = 0; c < SimGrid::kCols; ++c) {
+            if (rng.nextUInt(100) < 65 && filled < SimGrid::kCols - 1) {
+                set_cell(s, r, c, 1 + static_cast<int>(rng.nextUInt(7)));
+                ++filled;
+            }
+        }
+    }
+    s.currentId = static_cast<uint8_t>(shape);
+    s.currentRotation = 0;
+    s.currentRow = static_cast<int8_t>(startRow);
+    s.currentCol = static_cast<int8_t>(sim_shapes::kSpawnColumn[shape]);
+    s.flags = 0;
+    // 게임 오버가 아니면 현재 블록은 굳은 셀과 겹칠 수 없으니(Restore 가 거절한다) 그 자리는 비운다.
+    for (const SimCell& c : sim_shapes::kCells[shape][0])
+        set_cell(s, startRow + c.row, s.currentCol + c.column, 0);
+    SimGame g;
+    if (!g.Restore(s)) check(false, "make_board 의 스냅샷을 Restore 가 받는다");
+    return g;
+}
+
+std::array<int, 4> cells_of(int shape, const SimGame::LandedPlacement& p) {
+    std::array<int, 4> out{};
+    for (int i = 0; i < 4; ++i) {
+        const SimCell c = sim_shapes::kCells[shape][p.rot][i];
+        out[i] = (p.row + c.row) * 16 + (p.col + c.column);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void test_empty_board_counts() {
+    SimGame::LandedPlacement full[SimGame::kMaxPlacements];
+    SimGame::LandedPlacement distinct[SimGame::kMaxPlacements];
+    SimSnapshot s = SimGame(3).Snapshot();
+    std::memset(s.grid, 0, sizeof(s.grid));
+    int counts[8][2] = {};
+    for (int shape = 1; shape <= 7; ++shape) {
+        s.currentId = static_cast<uint8_t>(shape);
+        s.currentRotation = 0;
+        s.currentRow = 0;
+        SimGame g;
+        g.Restore(s);
+        counts[shape][0] = g.EnumeratePlacements(full);
+        counts[shape][1] = g.EnumerateDistinctPlacements(distinct);
+    }
+    check(counts[4][0] == 36 && counts[4][1] == 9, "빈 보드 O: 36 수, 서로 다른 자리 9");
+    check(counts[6][0] == 33 && counts[6][1] == 33, "빈 보드 T: 대칭이 없어 33 그대로");
+    check(counts[3][1] < counts[3][0] && counts[5][1] < counts[5][0] && counts[7][1] < counts[7][0],
+          "I·S·Z 는 대칭 중복이 빠진다");
+}
+
+void test_random_boards() {
+    XorShift64Star rng(0x5EED);
+    int boards = 0, orderMismatch = 0, rowRejected = 0;
+    int notSubset = 0, uncovered = 0, duplicated = 0;
+    long fullTotal = 0, distinctTotal = 0;
+    for (int trial = 0; trial < 3000; ++trial) {
+        const int shape = 1 + trial % 7;
+        const int startRow = static_cast<int>(rng.nextUInt(9));
+        const SimGame g = make_board(rng, shape, startRow);
+        ++boards;
+
+        SimGame::LandedPlacement full[SimGame::kMaxPlacements];
+        const int n = g.EnumeratePlacements(full);
+        const std::vector<SimGame::Placement> ref = g.LegalPlacements();
+        bool same = n == static_cast<int>(ref.size());
+        for (int k = 0; same && k < n; ++k)
+            same = full[k].col == ref[k].col && full[k].rot == ref[k].rot;
+        if (!same) ++orderMismatch;
+        for (int k = 0; k < n; ++k) {
+            SimGame child = g;
+            if (child.ApplyLandedPlacement(full[k]) < 0) ++rowRejected;
+        }
+
+        SimGame::LandedPlacement distinct[SimGame::kMaxPlacements];
+        const int m = g.EnumerateDistinctPlacements(distinct);
+        fullTotal += n;
+        distinctTotal += m;
+        // 순서를 지킨 부분열인가.
+        int j = 0;
+        for (int k = 0; k < n && j < m; ++k)
+            if (full[k].col == distinct[j].col && full[k].rot == distinct[j].rot && full[k].row == distinct[j].row) ++j;
+        if (j != m) ++notSubset;
+        // 빠진 수는 남은 수와 칸이 같고, 남은 수끼리는 모두 다르다.
+        std::vector<std::array<int, 4>> kept;
+        for (int k = 0; k < m; ++k) kept.push_back(cells_of(shape, distinct[k]));
+        for (int k = 0; k < n; ++k)
+            if (std::find(kept.begin(), kept.end(), cells_of(shape, full[k])) == kept.end()) ++uncovered;
+        std::sort(kept.begin(), kept.end());
+        if (std::adjacent_find(kept.begin(), kept.end()) != kept.end()) ++duplicated;
+    }
+    std::fprintf(stderr, "[kernels] %d boards: %ld placements, %ld distinct\n",
+                 boards, fullTotal, distinctTotal);
+    check(orderMismatch == 0, "커널이 LegalPlacements 와 순서까지 같다");
+    check(rowRejected == 0, "커널의 착지 행을 ApplyLandedPlacement 가 받아 준다");
+    check(notSubset == 0, "distinct 는 순서를 지킨 부분열");
+    check(uncovered == 0 && duplicated == 0, "distinct 는 서로 다른 착지 칸을 빠짐없이 한 번씩");
+    check(distinctTotal < fullTotal, "대칭 중복이 실제로 빠진다");
+}
+
+void test_game_over_and_play() {
+    // 실제 게임 흐름(가비지 포함)에서도 같은지, 끝난 게임은 0 인지.
+    SimGame g(77);
+    XorShift64Star rng(77);
+    int compared = 0, bad = 0;
+    while (!g.IsGameOver() && compared < 2000) {
+        SimGame::LandedPlacement full[SimGame::kMaxPlacements];
+        const int n = g.EnumeratePlacements(full);
+        const std::vector<SimGame::Placement> ref = g.LegalPlacements();
+        if (n != static_cast<int>(ref.size())) ++bad;
+        ++compared;
+        if (n == 0) break;
+        if (compared % 5 == 0) g.AddPendingGarbage(1);
+        g.ApplyLandedPlacement(full[rng.nextUInt(static_cast<uint32_t>(n))]);
+    }
+    SimGame::LandedPlacement out[SimGame::kMaxPlacements];
+    check(bad == 0 && compared > 10, "무작위 대국 내내 개수가 같다");
+    check(!g.IsGameOver() || (g.EnumeratePlacements(out) == 0 && g.EnumerateDistinctPlacements(out) == 0),
+          "게임 오버면 0");
+}
+
+}  // namespace
+
+int main() {
+    test_empty_board_counts();
+    test_random_boards();
+    test_game_over_and_play();
+    if (g_failures) {
+        std::fprintf(stderr, "[kernels] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[kernels] all passed\n");
+    return 0;
+}
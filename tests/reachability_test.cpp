@@ -0,0 +1,257 @@
+// tests/reachability_test.cpp — 닿을 수 있는 자리 BFS(bot/reachability.h) 회귀
+//
+//   - 모든 경로를 SubmitInput 으로 재생하면 그 자리·그 T-spin 여부로 lock 한다
+//     (무작위 보드, 무작위 선행 입력으로 소프트 드롭 카운터·회전 플래그가 걸린 상태 포함)
+//   - hard drop 자리(EnumerateDistinctPlacements)를 전부 포함하고, 경로는
+//     expand_placement 보다 길지 않으며, 같은 칸·같은 T-spin 여부는 한 번만 나온다
+//   - 지붕 밑 tuck 과 T-spin double 슬롯을 찾는다(hard drop 으로는 못 닿는 자리)
+//   - ReachabilityCache 는 같은 상태에 같은 결과를 돌려주고 적중을 센다
+
+#include "../bot/reachability.h"
+#include "../bot/placement.h"
+#include "../src/sim_game.h"
+#include "../src/sim_shapes.h"
+#include "../core/input.h"
+#include "../core/rng.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[reach] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[reach] ok:   %s\n", what); }
+}
+
+void set_cell(SimSnapshot& s, int r, int c, int code) {
+    const int bit = 3 * (r * SimGrid::kCols + c);
+    for (int k = 0; k < 3; ++k) {
+        const int b = bit + k;
+        if ((code >> k) & 1) s.grid[b >> 3] = static_cast<uint8_t>(s.grid[b >> 3] | (1u << (b & 7)));
+    }
+}
+
+SimSnapshot empty_snapshot(uint64_t seed, int shape) {
+    SimSnapshot s = SimGame(seed).Snapshot();
+    std::memset(s.grid, 0, sizeof(s.grid));
+    std::memset(s.garbageRows, 0, sizeof(s.garbageRows));
+    s.currentId = static_cast<uint8_t>(shape);
+    s.currentRotation = 0;
+    s.currentRow = 0;
+    s.currentCol = static_cast<int8_t>(sim_shapes::kSpawnColumn[shape]);
+    s.ghostRow = 0;
+    s.softDropCounterTicks = 0;
+    s.flags = 0;
+    return s;
+}
+
+SimGame restored(const SimSnapshot& s) {
+    SimGame g;
+    if (!g.Restore(s)) check(false, "손으로 만든 스냅샷을 Restore 가 받는다");
+    // 손으로 만든 보드라 스냅샷의 ghost 행은 맞지 않는다. 빈 입력 한 틱으로 다시 내린다.
+    g.SubmitInput(INPUT_NONE);
+    return g;
+}
+
+// 아래로 갈수록 빽빽하고 군데군데 지붕이 걸린 무작위 보드. 꽉 찬 줄은 만들지 않는다.
+SimGame make_board(XorShift64Star& rng, int shape) {
+    SimSnapshot s = empty_snapshot(rng.next() | 1, shape);
+    const int height = static_cast<int>(rng.nextUInt(13));
+    for (int r = SimGrid::kRows - height; r < SimGrid::kRows; ++r) {
+        int filled = 0;
+        for (int c = 0; c < SimGrid::kCols; ++c) {
+            if (rng.nextUInt(100) < 55 && filled < SimGrid::kCols - 1) {
+                set_cell(s, r, c, 1 + static_cast<int>(rng.nextUInt(7)));
+                ++filled;
+            }
+        }
+    }
+    return restored(s);
+}
+
+std::array<int, 4> cells_of(int shape, int col, int rot, int row) {
+    std::array<int, 4> out{};
+    for (int i = 0; i < 4; ++i) {
+        const SimCell c = sim_shapes::kCells[shape][rot][i];
+        out[i] = (row + c.row) * 16 + (col + c.column + 4);
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+void test_random_boards() {
+    XorShift64Star rng(0xAB1E);
+    bot::ReachableSet set;
+    int boards = 0, replayFailed = 0, missing = 0, longer = 0, duplicated = 0;
+    long reachable = 0, hardDrop = 0, tspins = 0;
+    for (int trial = 0; trial < 1500; ++trial) {
+        const int shape = 1 + trial % 7;
+        SimGame g = make_board(rng, shape);
+        // 선행 입력 몇 틱: 소프트 드롭 카운터, lastMoveWasRotate 가 걸린 상태에서 시작해 본다.
+        const uint8_t prefix[5] = {INPUT_DOWN, INPUT_ROTATE, INPUT_LEFT, INPUT_RIGHT, INPUT_NONE};
+        const int prefixLen = static_cast<int>(rng.nextUInt(4));
+        for (int k = 0; k < prefixLen && !g.IsGameOver(); ++k) g.SubmitInput(prefix[rng.nextUInt(5)]);
+        if (g.IsGameOver() || g.CurrentBlockId() != shape) continue;
+        ++boards;
+
+        const int n = bot::reachable_placements(g, set);
+        reachable += n;
+        std::vector<std::array<int, 5>> keys;
+        for (int k = 0; k < n; ++k) {
+            const bot::ReachablePlacement& p = set.placements[k];
+            tspins += p.tspin;
+            std::array<int, 5> key{};
+            const std::array<int, 4> cells = cells_of(shape, p.col, p.rot, p.row);
+            std::copy(cells.begin(), cells.end(), key.begin());
+            key[4] = p.tspin;
+            keys.push_back(key);
+            SimGame child = g;
+            if (bot::apply_reachable(child, set, k) < 0) ++replayFailed;
+        }
+        std::sort(keys.begin(), keys.end());
+        if (std::adjacent_find(keys.begin(), keys.end()) != keys.end()) ++duplicated;
+
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        const int m = g.EnumerateDistinctPlacements(landed);
+        hardDrop += m;
+        for (int k = 0; k < m; ++k) {
+            const std::array<int, 4> cells = cells_of(shape, landed[k].col, landed[k].rot, landed[k].row);
+            int best = -1;
+            for (int j = 0; j < n; ++j) {
+                const bot::ReachablePlacement& p = set.placements[j];
+                if (cells_of(shape, p.col, p.rot, p.row) != cells) continue;
+                if (best < 0 || p.pathLength < best) best = p.pathLength;
+            }
+            const size_t expanded = bot::expand_placement(g.CurrentCol(), g.CurrentRotation(),
+                                                          landed[k].col, landed[k].rot).size();
+            if (best < 0) ++missing;
+            else if (best > static_cast<int>(expanded)) ++longer;
+        }
+    }
+    std::fprintf(stderr, "[reach] %d boards: %ld reachable, %ld hard-drop, %ld t-spin\n",
+                 boards, reachable, hardDrop, tspins);
+    check(boards > 1000, "무작위 보드가 충분하다");
+    check(replayFailed == 0, "모든 경로가 SubmitInput 재생으로 그 자리·T-spin 여부에 lock");
+    check(missing == 0, "hard drop 자리를 전부 포함");
+    check(longer == 0, "경로가 expand_placement 보다 길지 않다");
+    check(duplicated == 0, "같은 칸·같은 T-spin 여부는 한 번만");
+    check(reachable > hardDrop && tspins > 0, "tuck·T-spin 자리가 더해진다");
+}
+
+void test_tuck() {
+    // 왼쪽 두 칸 위에 지붕(17행), 바닥 두 줄은 4열부터 차 있다. O 는 2열로 떨어진 뒤
+    // 왼쪽으로 밀어 넣어야 (18, 0) 에 닿는다.
+    SimSnapshot s = empty_snapshot(11, 4);
+    set_cell(s, 17, 0, 1);
+    set_cell(s, 17, 1, 1);
+    for (int r = 18; r < 20; ++r)
+        for (int c = 4; c < SimGrid::kCols; ++c) set_cell(s, r, c, 2);
+    const SimGame g = restored(s);
+
+    bot::ReachableSet set;
+    const int n = bot::reachable_placements(g, set);
+    int tuck = -1;
+    for (int k = 0; k < n; ++k)
+        if (set.placements[k].col == 0 && set.placements[k].row == 18) tuck = k;
+    SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+    const int m = g.EnumeratePlacements(landed);
+    bool hardDropReaches = false;
+    for (int k = 0; k < m; ++k) hardDropReaches |= landed[k].col == 0 && landed[k].row == 18;
+    check(tuck >= 0 && !hardDropReaches, "지붕 밑 O tuck 은 BFS 로만 닿는다");
+
+    if (tuck >= 0) {
+        SimGame child = g;
+        const bot::ReachablePlacement& p = set.placements[tuck];
+        const uint8_t* path = set.Path(p);
+        const bool hasDown = std::find(path, path + p.pathLength, INPUT_DOWN) != path + p.pathLength;
+        check(bot::apply_reachable(child, set, tuck) == 0 && child.Grid()[19][0] != 0 && hasDown,
+              "소프트 드롭으로 내려가 지붕 밑으로 밀어 넣는다");
+    }
+}
+
+void test_tspin_double() {
+    // 19행은 4열만, 18행은 3..5열이 비었고 (17, 3) 에 지붕. T 를 세워 4열로 내린 뒤
+    // 돌려 넣어야 하는 T-spin double 슬롯이다.
+    SimSnapshot s = empty_snapshot(12, 6);
+    for (int c = 0; c < SimGrid::kCols; ++c) {
+        if (c != 4) set_cell(s, 19, c, 3);
+        if (c < 3 || c > 5) set_cell(s, 18, c, 3);
+    }
+    set_cell(s, 17, 3, 3);
+    const SimGame g = restored(s);
+
+    bot::ReachableSet set;
+    const int n = bot::reachable_placements(g, set);
+    int slot = -1;
+    for (int k = 0; k < n; ++k) {
+        const bot::ReachablePlacement& p = set.placements[k];
+        if (p.col == 3 && p.rot == 2 && p.row == 17 && p.tspin) slot = k;
+    }
+    SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+    const int m = g.EnumeratePlacements(landed);
+    bool hardDropReaches = false;
+    for (int k = 0; k < m; ++k) hardDropReaches |= landed[k].col == 3 && landed[k].rot == 2 && landed[k].row == 17;
+    check(slot >= 0 && !hardDropReaches, "T-spin double 슬롯은 BFS 로만 닿는다");
+
+    if (slot >= 0) {
+        SimGame child = g;
+        const int before = child.AttackLinesSent();
+        const int lines = bot::apply_reachable(child, set, slot);
+        check(lines == 2 && child.lastTSpinLines == 2 && child.AttackLinesSent() - before == 4,
+              "경로 재생이 T-spin double(공격 4)로 lock");
+        const bot::ReachablePlacement& p = set.placements[slot];
+        check(set.Path(p)[p.pathLength - 2] == INPUT_ROTATE, "마지막 이동이 회전이다");
+    }
+}
+
+void test_cache_and_game_over() {
+    bot::ReachabilityCache cache(64);
+    check(cache.Entries() == 64, "엔트리 수는 2의 거듭제곱");
+    SimGame g(21);
+    bot::ReachableSet direct;
+    bot::reachable_placements(g, direct);
+    const bot::ReachableSet& first = cache.Get(g);
+    const bool same = first.placements.size() == direct.placements.size() && first.inputs == direct.inputs;
+    const size_t firstSize = first.placements.size();
+    const bot::ReachableSet& again = cache.Get(g);
+    check(same && again.placements.size() == firstSize && cache.Hits() == 1 && cache.Misses() == 1,
+          "같은 상태는 적중, 결과는 직접 부른 것과 같다");
+
+    SimGame moved = g;
+    moved.SubmitInput(INPUT_LEFT);
+    cache.Get(moved);
+    check(cache.Misses() == 2, "블록을 움직이면 다른 키");
+
+    // 무작위로 끝까지 두어 게임 오버면 0.
+    XorShift64Star rng(3);
+    bot::ReachableSet set;
+    int applied = 0, failed = 0;
+    while (!g.IsGameOver() && applied < 500) {
+        const int n = bot::reachable_placements(g, set);
+        if (n == 0) break;
+        if (bot::apply_reachable(g, set, static_cast<int>(rng.nextUInt(static_cast<uint32_t>(n)))) < 0) ++failed;
+        ++applied;
+    }
+    check(failed == 0 && applied > 10, "무작위 대국 내내 경로 재생이 맞다");
+    check(!g.IsGameOver() || bot::reachable_placements(g, set) == 0, "게임 오버면 0");
+}
+
+}  // namespace
+
+int main() {
+    test_random_boards();
+    test_tuck();
+    test_tspin_double();
+    test_cache_and_game_over();
+    if (g_failures) {
+        std::fprintf(stderr, "[reach] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[reach] all passed\n");
+    return 0;
+}
@@ -0,0 +1,259 @@
+// tests/replay_corpus_test.cpp — 리플레이 코퍼스(core/replay_corpus.h)와 디코더(bot/replay_dataset.h) 회귀
+//
+//   - 여러 판을 써서 mmap 으로 열면 시드·틱 수·입력이 그대로고, 입력 포인터는 매핑 안을 가리킨다
+//   - 본문 손상은 Verify 가, 색인 손상·Finish 없이 끝난 파일은 Open 이 거절한다
+//   - 디코더가 낸 (관측, 착수) 가 입력을 만든 봇이 본 관측·실제로 놓인 자리와 같다
+//   - skipIdle 은 중력으로만 떨어진 블록을 뺀다
+//   - 병렬 디코딩 결과가 스레드 수와 무관하게 바이트 단위로 같다
+
+#include "../bot/replay_dataset.h"
+#include "../bot/placement.h"
+#include "../core/input.h"
+#include "../core/rng.h"
+#include "../src/sim_replay.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[replay_corpus] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[replay_corpus] ok:   %s\n", what); }
+}
+
+struct Expected {
+    int player;
+    uint8_t action;
+    uint16_t board[20];
+    uint8_t current;
+    uint8_t next;
+};
+
+// 두 보드를 휴리스틱 봇이 틱마다 입력 하나씩으로 두는 판. 블록마다 입력을 펼치기 전
+// 관측을 expected 에 남기고, 착수는 마지막 DROP 을 넣는 순간의 블록 자리로 채운다
+// (판이 높으면 회전·이동이 막혀 봇이 고른 자리와 다를 수 있다).
+// 끝에 idleTicks 만큼 입력 없이 굴린다.
+ReplayData bot_match(uint64_t seed, int pieces, int idleTicks, std::vector<Expected>* expected) {
+    ReplayData rp;
+    rp.seed = seed;
+    ReplaySim sim(seed);
+    std::deque<uint8_t> queue[2];
+    size_t current[2] = {0, 0};
+    int placed = 0;
+    while (placed < pieces && !sim.Board(0).IsGameOver() && !sim.Board(1).IsGameOver()) {
+        FrameInputs f;
+        bool stuck = false;
+        for (int p = 0; p < 2; ++p) {
+            const SimGame& board = sim.Board(p);
+            if (queue[p].empty()) {
+                int col = 0, rot = 0;
+                if (!bot::heuristic_placement(board, col, rot)) { stuck = true; break; }
+                const std::vector<uint8_t> keys =
+                    bot::expand_placement(board.CurrentCol(), board.CurrentRotation(), col, rot);
+                queue[p].assign(keys.begin(), keys.end());
+                if (expected) {
+                    bot::SelfPlayRecord rec{};
+                    bot::capture_observation(board, rec);
+                    Expected e{p, 0, {}, rec.current, rec.next};
+                    std::memcpy(e.board, rec.board, sizeof(e.board));
+                    current[p] = expected->size();
+                    expected->push_back(e);
+                }
+                ++placed;
+            }
+            if (expected && queue[p].size() == 1)
+                (*expected)[current[p]].action =
+                    static_cast<uint8_t>(bot::encode_action(board.CurrentCol(), board.CurrentRotation()));
+            (p == 0 ? f.p1 : f.p2) = queue[p].front();
+            queue[p].pop_front();
+        }
+        if (stuck) break;
+        rp.frames.push_back(f);
+        sim.Step(f);
+    }
+    for (int i = 0; i < idleTicks; ++i) rp.frames.push_back(FrameInputs{});
+    return rp;
+}
+
+// 아무 키나 누르는 판. 한 틱 두 lock(DOWN 뒤 DROP 등) 같은 구석을 건드린다.
+ReplayData noisy_match(uint64_t seed, size_t ticks) {
+    XorShift64Star rng(seed);
+    ReplayData rp;
+    rp.seed = seed;
+    rp.frames.resize(ticks);
+    for (FrameInputs& f : rp.frames) {
+        f.p1 = static_cast<uint8_t>(rng.nextUInt(32) & rng.nextUInt(32));
+        f.p2 = static_cast<uint8_t>(rng.nextUInt(4) == 0 ? rng.nextUInt(32) : 0);
+    }
+    return rp;
+}
+
+void test_corpus_round_trip() {
+    const std::string path = "replay_corpus_test.trpc";
+    std::vector<ReplayData> games;
+    for (int i = 0; i < 7; ++i) games.push_back(noisy_match(100 + i, 301 + 977 * i));
+    games.push_back(ReplayData{});   // 빈 판
+    {
+        ReplayCorpusWriter w(path);
+        bool ok = w.Ok();
+        for (const ReplayData& g : games) ok = w.Add(g) && ok;
+        check(ok && w.Finish() && w.Count() == games.size(), "코퍼스 쓰기");
+    }
+
+    ReplayCorpus c;
+    std::string err;
+    check(c.Open(path, &err) && c.Size() == games.size(), "mmap 으로 열기");
+    bool same = true;
+    for (size_t i = 0; i < games.size() && same; ++i) {
+        const FrameInputs* in = c.Inputs(i);
+        same = c.Seed(i) == games[i].seed && c.Ticks(i) == games[i].frames.size() && c.Verify(i) &&
+               (games[i].frames.empty() ||
+                std::memcmp(in, games[i].frames.data(), games[i].frames.size() * sizeof(FrameInputs)) == 0) &&
+               reinterpret_cast<uintptr_t>(in) % 8 == 0;
+        ReplayData back;
+        same = same && c.Load(i, back) && back.seed == games[i].seed && back.frames == games[i].frames;
+    }
+    check(same, "시드·틱 수·입력이 그대로, 입력은 8바이트 정렬된 매핑 포인터");
+
+    ReplayCorpus moved = std::move(c);
+    check(!c.IsOpen() && moved.IsOpen() && moved.Ticks(3) == games[3].frames.size(), "이동하면 매핑이 넘어간다");
+    moved.Close();
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto write = [&](const std::vector<char>& b) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(b.data(), static_cast<std::streamsize>(b.size()));
+    };
+
+    std::vector<char> body = bytes;
+    body[32 + 5] ^= 0x04;   // 첫 판의 입력
+    write(body);
+    check(c.Open(path, &err) && !c.Verify(0) && c.Verify(1), "본문 손상은 Open 은 되고 그 판의 Verify 만 실패");
+    c.Close();
+
+    std::vector<char> index = bytes;
+    index[index.size() - 20] ^= 0x01;
+    write(index);
+    check(!c.Open(path, &err) && err == "index checksum mismatch", "색인 손상은 Open 이 거절");
+
+    {
+        ReplayCorpusWriter w(path);
+        w.Add(games[0]);   // Finish 없이 끝난 쓰기
+    }
+    check(!c.Open(path, &err) && err == "not a replay corpus", "Finish 없이 끝난 파일은 열리지 않는다");
+    check(!c.Open("no_such_corpus.trpc", &err) && err == "cannot open corpus", "없는 파일");
+    std::remove(path.c_str());
+}
+
+void test_decoder_matches_bot() {
+    std::vector<Expected> expected;
+    const ReplayData rp = bot_match(7, 160, 0, &expected);
+    std::vector<bot::SelfPlayRecord> records;
+    bot::ReplayDecodeConfig config;
+    int64_t skipped = 0;
+    const int64_t locks = bot::decode_replay(0, rp.seed, rp.frames.data(), rp.frames.size(), config,
+                                             records, &skipped);
+    // 마지막 블록은 입력이 끝나 아직 떨어지는 중일 수 있다.
+    bool ok = records.size() + 2 >= expected.size() && records.size() <= expected.size() && skipped == 0 &&
+              locks == static_cast<int64_t>(records.size());
+    size_t matched = 0;
+    uint16_t ply[2] = {0, 0};
+    for (const bot::SelfPlayRecord& rec : records) {
+        // 플레이어별 순서로 맞춘다. expected 는 블록을 고른 순서라 두 보드가 섞여 있다.
+        size_t k = 0, seen = 0;
+        for (; k < expected.size(); ++k)
+            if (expected[k].player == rec.player && seen++ == rec.ply) break;
+        if (k == expected.size() || rec.ply != ply[rec.player]) { ok = false; break; }
+        ++ply[rec.player];
+        const Expected& e = expected[k];
+        if (rec.action == e.action && rec.current == e.current && rec.next == e.next &&
+            std::memcmp(rec.board, e.board, sizeof(e.board)) == 0 && ((rec.legalMask >> rec.action) & 1))
+            ++matched;
+    }
+    std::fprintf(stderr, "[replay_corpus] %zu ticks, %zu picks, %zu records, %zu matched\n",
+                 rp.frames.size(), expected.size(), records.size(), matched);
+    check(ok && matched == records.size(), "디코딩한 (관측, 착수) = 봇이 본 관측과 고른 착수");
+}
+
+void test_skip_idle() {
+    const ReplayData rp = bot_match(8, 20, 4000, nullptr);
+    bot::ReplayDecodeConfig config;
+    std::vector<bot::SelfPlayRecord> kept, all;
+    int64_t skipped = 0;
+    bot::decode_replay(0, rp.seed, rp.frames.data(), rp.frames.size(), config, kept, &skipped);
+    config.skipIdle = false;
+    bot::decode_replay(0, rp.seed, rp.frames.data(), rp.frames.size(), config, all);
+    check(skipped > 0 && all.size() == kept.size() + static_cast<size_t>(skipped),
+          "skipIdle 은 중력으로만 떨어진 블록을 뺀다");
+
+    config.players = 0x1;
+    std::vector<bot::SelfPlayRecord> one;
+    bot::decode_replay(0, rp.seed, rp.frames.data(), rp.frames.size(), config, one);
+    bool onlyA = !one.empty();
+    for (const bot::SelfPlayRecord& rec : one) onlyA = onlyA && rec.player == 0;
+    check(onlyA && one.size() < all.size(), "players 비트마스크로 보드를 고른다");
+}
+
+void test_parallel_decode() {
+    const std::string path = "replay_corpus_test_decode.trpc";
+    {
+        ReplayCorpusWriter w(path);
+        for (int i = 0; i < 9; ++i) {
+            if (i % 3 == 0) w.Add(noisy_match(200 + i, 2500 + 400 * i));
+            else w.Add(bot_match(300 + i, 40 + 15 * i, 200, nullptr));
+        }
+        w.Finish();
+    }
+    ReplayCorpus c;
+    check(c.Open(path), "디코딩용 코퍼스");
+
+    bot::ReplayDecodeConfig config;
+    config.threads = 1;
+    const bot::ReplayDecodeResult one = bot::decode_corpus(c, 0, c.Size(), config);
+    config.threads = 4;
+    const bot::ReplayDecodeResult four = bot::decode_corpus(c, 0, c.Size(), config);
+    std::fprintf(stderr, "[replay_corpus] %d replays, %llu ticks -> %zu records (%lld locks, %lld skipped)\n",
+                 one.replays, static_cast<unsigned long long>(one.ticks), one.records.size(),
+                 static_cast<long long>(one.placements), static_cast<long long>(one.skipped));
+    check(!one.records.empty() && one.records.size() == four.records.size() &&
+          std::memcmp(one.records.data(), four.records.data(),
+                      one.records.size() * sizeof(bot::SelfPlayRecord)) == 0 &&
+          one.placements == four.placements && four.threads == 4,
+          "1 스레드와 4 스레드의 기록이 바이트 단위로 같다");
+
+    bool ordered = true;
+    for (size_t i = 1; i < one.records.size(); ++i)
+        ordered = ordered && one.records[i - 1].match <= one.records[i].match;
+    const bot::ReplayDecodeResult tail = bot::decode_corpus(c, 6, 100, config);
+    bool tailOk = tail.replays == 3 && !tail.records.empty() && tail.records.front().match == 6;
+    check(ordered && tailOk, "기록은 판 번호 순이고, 구간만 풀 수 있다");
+    c.Close();
+    std::remove(path.c_str());
+}
+
+}  // namespace
+
+int main() {
+    test_corpus_round_trip();
+    test_decoder_matches_bot();
+    test_skip_idle();
+    test_parallel_decode();
+    if (g_failures) {
+        std::fprintf(stderr, "[replay_corpus] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[replay_corpus] all passed\n");
+    return 0;
+}
@@ -0,0 +1,204 @@
+// tests/replay_recorder_test.cpp — 스트리밍 recorder(src/replay_recorder.h)와 ReplayIO::Recover 회귀
+//
+//   - 틱마다 Push 해 쓴 파일이 Save 한 것과 같은 입력·keyframe 으로 읽힌다
+//   - Flush 뒤의 파일은 끝 청크가 없어도 Recover 로 거기까지 살아난다
+//   - 어디서 자른 파일이든 Recover 는 마지막 온전한 청크까지 남기고 다시 읽히는 파일을 만든다
+//   - 손상된 청크부터 뒤는 버리고, 완전한 파일은 건드리지 않는다
+//   - 줄 길이가 maxPendingChunks 를 넘지 않는다
+
+#include "../core/replay.h"
+#include "../core/input.h"
+#include "../core/rng.h"
+#include "../src/replay_recorder.h"
+#include "../src/sim_replay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[replay_recorder] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[replay_recorder] ok:   %s\n", what); }
+}
+
+// replay_test 와 같은 사람 손 빠르기의 입력.
+ReplayData make_match(uint64_t seed, size_t ticks, uint32_t everyTicks) {
+    XorShift64Star rng(seed);
+    ReplayData rp;
+    rp.seed = seed * 7919;
+    rp.frames.resize(ticks);
+    const uint8_t keys[5] = {INPUT_LEFT, INPUT_RIGHT, INPUT_DOWN, INPUT_ROTATE, INPUT_DROP};
+    for (FrameInputs& f : rp.frames) {
+        if (rng.nextUInt(everyTicks) == 0) f.p1 = keys[rng.nextUInt(5)];
+        if (rng.nextUInt(everyTicks * 4) == 0) f.p2 = keys[rng.nextUInt(5)];
+    }
+    return rp;
+}
+
+std::vector<uint8_t> read_file(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const uint8_t* data, size_t size) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    f.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+}
+
+bool same_keyframes(const ReplayData& a, const ReplayData& b) {
+    if (a.keyframes.size() != b.keyframes.size()) return false;
+    for (size_t i = 0; i < a.keyframes.size(); ++i) {
+        const ReplayKeyframe& x = a.keyframes[i];
+        const ReplayKeyframe& y = b.keyframes[i];
+        if (x.tick != y.tick || x.hash[0] != y.hash[0] || x.hash[1] != y.hash[1] || x.state != y.state)
+            return false;
+    }
+    return true;
+}
+
+bool is_prefix(const ReplayData& part, const ReplayData& whole) {
+    return part.seed == whole.seed && part.frames.size() <= whole.frames.size() &&
+           std::equal(part.frames.begin(), part.frames.end(), whole.frames.begin());
+}
+
+const char* const kPath = "replay_recorder_test.trpl";
+const char* const kCopy = "replay_recorder_test_copy.trpl";
+
+void test_stream_matches_save() {
+    ReplayData rp = make_match(1, 5000, 4);
+    ReplayRecorder rec;
+    ReplayRecorderConfig config;
+    config.chunkTicks = 600;
+    config.keyframeEvery = 600;
+    check(rec.Open(kPath, rp.seed, config) && rec.IsOpen(), "Open");
+    for (const FrameInputs& f : rp.frames) rec.Push(f);
+    check(rec.Close() && !rec.IsOpen(), "Close");
+    const ReplayRecorderStats s = rec.Stats();
+    check(s.ok && s.ticks == rp.frames.size() && s.written == rp.frames.size(), "Push 한 틱을 전부 썼다");
+
+    AddKeyframes(rp, 600);
+    ReplayData back;
+    check(ReplayIO::Load(kPath, back) && back.seed == rp.seed && back.frames == rp.frames,
+          "스트림으로 쓴 입력 = 원래 입력");
+    check(same_keyframes(rp, back) && VerifyKeyframes(back) == -1, "keyframe 이 AddKeyframes 와 같은 자리·상태");
+
+    ReplayRecorder bad;
+    check(!bad.Open("no_such_dir/replay_recorder_test.trpl", 1) && !bad.IsOpen(), "못 여는 경로는 false");
+    bad.Push(FrameInputs{});
+    check(!bad.Flush() && !bad.Close(), "열지 않은 recorder 는 아무것도 하지 않는다");
+}
+
+void test_flush_then_crash() {
+    const ReplayData rp = make_match(2, 3000, 3);
+    ReplayRecorder rec;
+    ReplayRecorderConfig config;
+    config.chunkTicks = 256;
+    check(rec.Open(kPath, rp.seed, config), "Open");
+    for (size_t t = 0; t < 1000; ++t) rec.Push(rp.frames[t]);
+    check(rec.Flush(), "Flush");
+
+    // 녹화가 아직 열려 있는 지금의 파일 = 여기서 프로세스가 죽었을 때 남는 파일.
+    const std::vector<uint8_t> image = read_file(kPath);
+    ReplayData back;
+    std::string err;
+    check(!ReplayIO::Decode(image.data(), image.size(), back, &err) && err == "truncated: missing end chunk",
+          "녹화 중 파일에는 끝 청크가 없다");
+    write_file(kCopy, image.data(), image.size());
+    ReplayData recovered;
+    check(ReplayIO::Recover(kCopy, &recovered) && recovered.frames.size() == 1000 && is_prefix(recovered, rp),
+          "Flush 까지의 1000 틱이 Recover 로 살아난다");
+    ReplayData reloaded;
+    check(ReplayIO::Load(kCopy, reloaded) && reloaded.frames == recovered.frames, "살린 파일은 Load 가 읽는다");
+
+    for (size_t t = 1000; t < rp.frames.size(); ++t) rec.Push(rp.frames[t]);
+    check(rec.Close() && ReplayIO::Load(kPath, back) && back.frames == rp.frames, "이어 쓴 녹화도 온전하다");
+}
+
+void test_recover_any_cut() {
+    ReplayData rp = make_match(3, 4000, 4);
+    ReplayRecorder rec;
+    ReplayRecorderConfig config;
+    config.chunkTicks = 500;
+    config.keyframeEvery = 1000;
+    rec.Open(kPath, rp.seed, config);
+    for (const FrameInputs& f : rp.frames) rec.Push(f);
+    rec.Close();
+    const std::vector<uint8_t> full = read_file(kPath);
+
+    bool ok = true;
+    size_t lastTicks = 0;
+    for (size_t cut = 14; cut <= full.size() && ok; cut += 23) {
+        write_file(kCopy, full.data(), cut);
+        ReplayData recovered, reloaded;
+        ok = ReplayIO::Recover(kCopy, &recovered) && is_prefix(recovered, rp) &&
+             recovered.frames.size() >= lastTicks &&
+             (recovered.frames.size() % 500 == 0 || recovered.frames.size() == rp.frames.size()) &&
+             VerifyKeyframes(recovered) == -1 &&
+             ReplayIO::Load(kCopy, reloaded) && reloaded.frames == recovered.frames &&
+             reloaded.keyframes.size() == recovered.keyframes.size();
+        lastTicks = recovered.frames.size();
+    }
+    check(ok, "어디서 잘리든 마지막 온전한 청크(500틱 단위)까지 살아나고 keyframe 도 맞다");
+
+    write_file(kCopy, full.data(), 10);
+    std::string err;
+    check(!ReplayIO::Recover(kCopy, nullptr, &err) && err == "truncated header" && read_file(kCopy).size() == 10,
+          "헤더가 잘린 파일은 거절하고 건드리지 않는다");
+    check(!ReplayIO::Recover("no_such_file.trpl", nullptr, &err) && err == "cannot open replay",
+          "없는 파일은 거절");
+
+    write_file(kCopy, full.data(), full.size());
+    ReplayData same;
+    check(ReplayIO::Recover(kCopy, &same) && read_file(kCopy) == full && same.frames == rp.frames,
+          "완전한 파일은 그대로 둔다");
+
+    // 가운데 청크 하나를 망가뜨리면 그 앞까지만 남는다.
+    std::vector<uint8_t> damaged = full;
+    damaged[full.size() / 2] ^= 0x20;
+    write_file(kCopy, damaged.data(), damaged.size());
+    ReplayData partial;
+    check(ReplayIO::Recover(kCopy, &partial) && is_prefix(partial, rp) &&
+          partial.frames.size() < rp.frames.size() && ReplayIO::Load(kCopy, same),
+          "손상된 청크부터 뒤는 버린다");
+}
+
+void test_bounded_queue() {
+    const ReplayData rp = make_match(4, 100000, 2);
+    ReplayRecorder rec;
+    ReplayRecorderConfig config;
+    config.chunkTicks = 16;
+    config.maxPendingChunks = 2;
+    rec.Open(kPath, rp.seed, config);
+    for (const FrameInputs& f : rp.frames) rec.Push(f);
+    rec.Close();
+    const ReplayRecorderStats s = rec.Stats();
+    std::fprintf(stderr, "[replay_recorder] 100000 ticks in 16-tick chunks: %llu B, max pending %zu, stalls %llu\n",
+                 static_cast<unsigned long long>(s.bytes), s.maxPending,
+                 static_cast<unsigned long long>(s.stalls));
+    ReplayData back;
+    check(s.maxPending <= 2 && s.written == rp.frames.size(), "줄은 maxPendingChunks 를 넘지 않는다");
+    check(ReplayIO::Load(kPath, back) && back.frames == rp.frames, "기다린 틱도 빠짐없이 쓴다");
+}
+
+}  // namespace
+
+int main() {
+    test_stream_matches_save();
+    test_flush_then_crash();
+    test_recover_any_cut();
+    test_bounded_queue();
+    std::remove(kPath);
+    std::remove(kCopy);
+    if (g_failures) {
+        std::fprintf(stderr, "[replay_recorder] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[replay_recorder] all passed\n");
+    return 0;
+}
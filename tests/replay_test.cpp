@@ -0,0 +1,510 @@
+// tests/replay_test.cpp — 바이너리 리플레이 포맷(core/replay.h) 회귀
+//
+//   - Encode/Decode, Save/Load, 스트림 writer/reader 가 청크 크기와 무관하게 같은 입력을 돌려준다
+//   - 10분 대국 크기의 입력에서 텍스트 내보내기보다 수십 배 작다
+//   - 텍스트 내보내기도 Load 로 다시 읽힌다
+//   - 잘린 파일은 완전한 청크까지만, 손상·버전 불일치는 거절, 모르는 청크는 건너뛴다
+//   - run 합이 kMaxChunkTicks 를 넘는 'I' 청크는 풀지 않고 거절한다(체크섬이 맞아도)
+//   - 청크를 이어 붙여 누적 틱이 kMaxReplayTicks 를 넘어도 거절한다(Decode·reader·Recover·텍스트)
+//   - 읽어 들인 입력으로 다시 시뮬레이션하면 같은 StateHash
+//   - keyframe 이 Encode/Decode·Save/Load 를 거쳐 살아남고, 색인으로 하나만 꺼낼 수 있다
+//   - keyframe 에서 탐색한 상태가 처음부터 굴린 상태와 같고, 변조된 keyframe 은 검증에 걸린다
+//   - 기준 해시와 어긋난 구간을 이분해 처음 갈라진 틱·보드·섹션을 찾는다
+//   - 다른 이력의 keyframe 과 어긋나면 시드부터 굴린 상태와 비교해 보드·섹션을 짚는다
+
+#include "../core/replay.h"
+#include "../core/hash.h"
+#include "../core/input.h"
+#include "../core/rng.h"
+#include "../src/sim_game.h"
+#include "../src/sim_replay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[replay] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[replay] ok:   %s\n", what); }
+}
+
+// 사람 손 빠르기의 입력: 평균 everyTicks 틱마다 한 번, 나머지는 빈 틱. p2 는 가끔.
+ReplayData make_match(uint64_t seed, size_t ticks, uint32_t everyTicks) {
+    XorShift64Star rng(seed);
+    ReplayData rp;
+    rp.seed = seed * 7919;
+    rp.frames.resize(ticks);
+    const uint8_t keys[5] = {INPUT_LEFT, INPUT_RIGHT, INPUT_DOWN, INPUT_ROTATE, INPUT_DROP};
+    for (FrameInputs& f : rp.frames) {
+        if (rng.nextUInt(everyTicks) == 0) f.p1 = keys[rng.nextUInt(5)];
+        if (rng.nextUInt(everyTicks * 4) == 0) f.p2 = keys[rng.nextUInt(5)];
+    }
+    return rp;
+}
+
+bool same(const ReplayData& a, const ReplayData& b) {
+    return a.seed == b.seed && a.frames == b.frames;
+}
+
+bool same_keyframes(const ReplayData& a, const ReplayData& b) {
+    if (a.keyframes.size() != b.keyframes.size()) return false;
+    for (size_t i = 0; i < a.keyframes.size(); ++i) {
+        const ReplayKeyframe& x = a.keyframes[i];
+        const ReplayKeyframe& y = b.keyframes[i];
+        if (x.tick != y.tick || x.hash[0] != y.hash[0] || x.hash[1] != y.hash[1] || x.state != y.state)
+            return false;
+    }
+    return true;
+}
+
+void test_round_trip() {
+    const ReplayData rp = make_match(1, 5000, 6);
+    bool ok = true;
+    for (uint32_t chunk : {1u, 7u, 600u, ReplayIO::kDefaultChunkTicks}) {
+        const std::vector<uint8_t> bytes = ReplayIO::Encode(rp, chunk);
+        ReplayData back;
+        ok = ok && ReplayIO::Decode(bytes.data(), bytes.size(), back) && same(rp, back);
+
+        std::istringstream is(std::string(bytes.begin(), bytes.end()));
+        ReplayIO::BinaryReader r(is);
+        ReplayData streamed;
+        streamed.seed = r.Seed();
+        FrameInputs f;
+        while (r.Next(f)) streamed.frames.push_back(f);
+        ok = ok && r.Ok() && r.Complete() && r.Ticks() == rp.frames.size() && same(rp, streamed);
+    }
+    check(ok, "청크 크기(1/7/600/3600)와 무관하게 Encode→Decode, 스트림 reader 가 같다");
+
+    ReplayData empty;
+    empty.seed = 5;
+    const std::vector<uint8_t> bytes = ReplayIO::Encode(empty);
+    ReplayData back;
+    check(ReplayIO::Decode(bytes.data(), bytes.size(), back) && back.seed == 5 && back.frames.empty(),
+          "빈 리플레이");
+
+    std::ostringstream os;
+    ReplayIO::BinaryWriter w(os, rp.seed);
+    for (const FrameInputs& fr : rp.frames) w.Push(fr);
+    const std::vector<uint8_t> encoded = ReplayIO::Encode(rp);
+    check(w.Finish() && w.Ticks() == rp.frames.size() && os.str().size() == w.BytesWritten() &&
+          os.str() == std::string(encoded.begin(), encoded.end()),
+          "스트림 writer 는 Encode 와 같은 바이트");
+}
+
+void test_files_and_size() {
+    // 60Hz 10분, 평균 24틱(0.4초)마다 한 번 입력.
+    const ReplayData rp = make_match(2, 36000, 24);
+    const std::string bin = "replay_test.trpl";
+    const std::string txt = "replay_test.txt";
+    check(ReplayIO::Save(bin, rp) && ReplayIO::ExportText(txt, rp), "Save·ExportText");
+
+    ReplayData fromBin, fromTxt;
+    check(ReplayIO::Load(bin, fromBin) && same(rp, fromBin), "바이너리 Load");
+    check(ReplayIO::Load(txt, fromTxt) && same(rp, fromTxt), "텍스트 내보내기도 Load 가 읽는다");
+
+    std::ifstream b(bin, std::ios::binary | std::ios::ate), t(txt, std::ios::binary | std::ios::ate);
+    const long binBytes = static_cast<long>(b.tellg()), txtBytes = static_cast<long>(t.tellg());
+    std::fprintf(stderr, "[replay] 36000 ticks: binary %ld B, text %ld B (%.0fx)\n",
+                 binBytes, txtBytes, static_cast<double>(txtBytes) / binBytes);
+    check(binBytes > 0 && txtBytes > 30 * binBytes, "텍스트보다 30배 넘게 작다");
+    b.close();
+    t.close();
+    std::remove(bin.c_str());
+    std::remove(txt.c_str());
+}
+
+void test_damage() {
+    const ReplayData rp = make_match(3, 2000, 6);
+    const std::vector<uint8_t> bytes = ReplayIO::Encode(rp, 500);
+
+    // 잘림: 어디서 자르든 Decode 는 실패하고, 스트림 reader 는 완전한 청크까지만 낸다.
+    bool truncOk = true;
+    for (size_t cut = 0; cut < bytes.size(); cut += 37) {
+        ReplayData back;
+        if (ReplayIO::Decode(bytes.data(), cut, back)) truncOk = false;
+        std::istringstream is(std::string(bytes.begin(), bytes.begin() + static_cast<long>(cut)));
+        ReplayIO::BinaryReader r(is);
+        std::vector<FrameInputs> got;
+        FrameInputs f;
+        while (r.Next(f)) got.push_back(f);
+        if (r.Complete() || got.size() % 500 != 0 || got.size() > rp.frames.size() ||
+            !std::equal(got.begin(), got.end(), rp.frames.begin()))
+            truncOk = false;
+    }
+    check(truncOk, "잘린 파일은 완전한 청크까지만(500틱 단위), 끝 청크 없으면 Complete=false");
+
+    std::vector<uint8_t> flipped = bytes;
+    flipped[40] ^= 0x10;
+    ReplayData back;
+    std::string err;
+    check(!ReplayIO::Decode(flipped.data(), flipped.size(), back, &err) && err == "chunk checksum mismatch",
+          "바이트 하나가 바뀌면 체크섬으로 걸린다");
+
+    std::vector<uint8_t> future = bytes;
+    future[4] = ReplayIO::kBinaryVersion + 1;
+    std::istringstream is(std::string(future.begin(), future.end()));
+    ReplayIO::BinaryReader r(is);
+    check(!r.Ok() && r.Error() == "unsupported replay version", "모르는 버전은 거절");
+
+    // 헤더 뒤에 모르는 청크 'Z' 를 끼워 넣는다.
+    std::vector<uint8_t> extra(bytes.begin(), bytes.begin() + 14);
+    const uint8_t body[3] = {1, 2, 3};
+    const uint32_t sum = hash32_words(body, sizeof(body), 'Z');
+    const uint8_t chunk[] = {'Z', 3, 1, 2, 3, static_cast<uint8_t>(sum), static_cast<uint8_t>(sum >> 8),
+                             static_cast<uint8_t>(sum >> 16), static_cast<uint8_t>(sum >> 24)};
+    extra.insert(extra.end(), chunk, chunk + sizeof(chunk));
+    extra.insert(extra.end(), bytes.begin() + 14, bytes.end());
+    check(ReplayIO::Decode(extra.data(), extra.size(), back) && same(rp, back), "모르는 청크는 건너뛴다");
+}
+
+// 체크섬까지 맞춘 'I' 청크. body = [first varint][(run << 2) varint]... — 모두 빈 입력 run.
+std::vector<uint8_t> input_chunk(uint64_t first, const std::vector<uint64_t>& runs) {
+    auto put = [](std::vector<uint8_t>& out, uint64_t v) {
+        while (v >= 0x80) { out.push_back(static_cast<uint8_t>(v | 0x80)); v >>= 7; }
+        out.push_back(static_cast<uint8_t>(v));
+    };
+    std::vector<uint8_t> body;
+    put(body, first);
+    for (uint64_t run : runs) put(body, run << 2);
+    std::vector<uint8_t> chunk{'I'};
+    put(chunk, body.size());
+    chunk.insert(chunk.end(), body.begin(), body.end());
+    const uint32_t sum = hash32_words(body.data(), body.size(), 'I');
+    for (int i = 0; i < 4; ++i) chunk.push_back(static_cast<uint8_t>(sum >> (8 * i)));
+    return chunk;
+}
+
+void test_hostile_run_lengths() {
+    const std::vector<uint8_t> header = [] {
+        const std::vector<uint8_t> empty = ReplayIO::Encode(ReplayData{});
+        return std::vector<uint8_t>(empty.begin(), empty.begin() + 14);
+    }();
+    const std::vector<uint8_t> good = input_chunk(0, {500});
+
+    // 청크 하나가 run 마다 2^24 틱씩 4096 번 — 예전 검사(run 하나만 봤다)로는 1 조 틱을 풀었다.
+    std::vector<uint8_t> hostile = header;
+    hostile.insert(hostile.end(), good.begin(), good.end());
+    const std::vector<uint8_t> bomb = input_chunk(500, std::vector<uint64_t>(4096, uint64_t(1) << 24));
+    hostile.insert(hostile.end(), bomb.begin(), bomb.end());
+
+    ReplayData back;
+    std::string err;
+    check(!ReplayIO::Decode(hostile.data(), hostile.size(), back, &err) && err == "corrupt input chunk",
+          "run 합이 상한을 넘는 청크는 Decode 가 거절");
+    std::istringstream is(std::string(hostile.begin(), hostile.end()));
+    ReplayIO::BinaryReader r(is);
+    size_t n = 0;
+    FrameInputs f;
+    while (r.Next(f)) ++n;
+    check(n == 500 && !r.Complete() && r.Error() == "corrupt input chunk", "스트림 reader 는 앞 청크까지만 낸다");
+
+    const char* const path = "replay_test_hostile.trpl";
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(hostile.data()), static_cast<std::streamsize>(hostile.size()));
+    }
+    ReplayData recovered;
+    check(ReplayIO::Recover(path, &recovered) && recovered.frames.size() == 500, "Recover 는 그 청크 앞에서 자른다");
+    std::remove(path);
+
+    // 경계: 딱 상한까지는 받고, 한 틱이라도 넘으면 거절한다(run 을 나눠도 합으로 센다).
+    const uint64_t half = ReplayIO::kMaxChunkTicks / 2;
+    std::vector<uint8_t> atCap = header;
+    const std::vector<uint8_t> full = input_chunk(0, {half, half});
+    atCap.insert(atCap.end(), full.begin(), full.end());
+    std::vector<uint8_t> overCap = header;
+    const std::vector<uint8_t> over = input_chunk(0, {half, half, 1});
+    overCap.insert(overCap.end(), over.begin(), over.end());
+    std::istringstream isCap(std::string(atCap.begin(), atCap.end()));
+    std::istringstream isOver(std::string(overCap.begin(), overCap.end()));
+    ReplayIO::BinaryReader rCap(isCap), rOver(isOver);
+    size_t nCap = 0;
+    while (rCap.Next(f)) ++nCap;
+    check(nCap == ReplayIO::kMaxChunkTicks && rOver.Next(f) == false && rOver.Error() == "corrupt input chunk",
+          "kMaxChunkTicks 까지는 풀고, 넘으면 거절");
+
+    // 여러 청크: 하나하나는 청크 상한 안이지만 이어 붙이면 파일 상한을 넘는다. 15바이트 남짓한
+    // 청크 64 개가 6천만 틱을 선언한다. 딱 파일 상한까지는 풀고 그 다음 청크에서 멈춘다.
+    std::vector<uint8_t> many = header;
+    const uint64_t perChunk = ReplayIO::kMaxChunkTicks;
+    for (uint64_t first = 0; first < 64 * perChunk; first += perChunk) {
+        const std::vector<uint8_t> c = input_chunk(first, {perChunk});
+        many.insert(many.end(), c.begin(), c.end());
+    }
+    check(!ReplayIO::Decode(many.data(), many.size(), back, &err) && err == "corrupt input chunk" &&
+          back.frames.size() == ReplayIO::kMaxReplayTicks,
+          "누적 틱이 kMaxReplayTicks 를 넘는 청크열은 Decode 가 거절");
+    std::istringstream isMany(std::string(many.begin(), many.end()));
+    ReplayIO::BinaryReader rMany(isMany);
+    size_t nMany = 0;
+    while (rMany.Next(f)) ++nMany;
+    check(nMany == ReplayIO::kMaxReplayTicks && !rMany.Complete() && rMany.Error() == "corrupt input chunk",
+          "스트림 reader 도 파일 상한에서 멈춘다");
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(many.data()), static_cast<std::streamsize>(many.size()));
+    }
+    check(ReplayIO::Recover(path, &recovered) && recovered.frames.size() == ReplayIO::kMaxReplayTicks,
+          "Recover 는 파일 상한까지만 남긴다");
+    {
+        std::ofstream out(path, std::ios::trunc);
+        out << "seed 1\nticks 1000000000000\n";
+    }
+    check(!ReplayIO::Load(path, back), "텍스트 ticks 도 파일 상한을 넘으면 거절");
+    std::remove(path);
+
+    // writer 는 chunkTicks 를 상한으로 잘라, 아무리 크게 불러도 자기가 쓴 파일을 다시 읽는다.
+    ReplayData big;
+    big.seed = 5;
+    big.frames.resize(ReplayIO::kMaxChunkTicks + 7);
+    big.frames.back().p1 = INPUT_DROP;
+    const std::vector<uint8_t> bytes = ReplayIO::Encode(big, 0xFFFFFFFFu);
+    check(ReplayIO::Decode(bytes.data(), bytes.size(), back) && same(big, back), "큰 chunkTicks 도 상한에서 끊어 쓴다");
+}
+
+void test_resimulation() {
+    // 두 보드를 입력대로 굴린 해시가 리플레이를 거쳐도 같다.
+    const ReplayData rp = make_match(4, 6000, 5);
+    auto run = [](const ReplayData& d) {
+        SimGame a(d.seed), b(d.seed);
+        for (const FrameInputs& f : d.frames) {
+            a.SubmitInput(f.p1);
+            b.SubmitInput(f.p2);
+            a.Tick();
+            b.Tick();
+        }
+        return a.StateHash() ^ (b.StateHash() * 31);
+    };
+    const std::vector<uint8_t> bytes = ReplayIO::Encode(rp);
+    ReplayData back;
+    check(ReplayIO::Decode(bytes.data(), bytes.size(), back) && run(back) == run(rp),
+          "리플레이로 다시 시뮬레이션하면 같은 StateHash");
+}
+
+void test_keyframes() {
+    ReplayData rp = make_match(5, 5000, 4);
+    AddKeyframes(rp, 600);
+    check(rp.keyframes.size() == 9 && rp.keyframes.front().tick == 0 && rp.keyframes.back().tick == 4800 &&
+          rp.keyframes[1].state.size() == ReplaySim::kStateBytes,
+          "600틱마다 keyframe (0 틱 포함)");
+
+    bool ok = true;
+    for (uint32_t chunk : {7u, 600u, ReplayIO::kDefaultChunkTicks}) {
+        const std::vector<uint8_t> bytes = ReplayIO::Encode(rp, chunk);
+        ReplayData back;
+        ok = ok && ReplayIO::Decode(bytes.data(), bytes.size(), back) && same(rp, back) &&
+             same_keyframes(rp, back);
+
+        // 옛 reader 경로(스트림)는 keyframe 을 건너뛰고 입력만 낸다.
+        std::istringstream is(std::string(bytes.begin(), bytes.end()));
+        ReplayIO::BinaryReader r(is);
+        std::vector<FrameInputs> streamed;
+        FrameInputs f;
+        while (r.Next(f)) streamed.push_back(f);
+        ok = ok && r.Complete() && streamed == rp.frames;
+    }
+    check(ok, "keyframe 이 Encode→Decode 를 거쳐 같고, 스트림 reader 는 입력만 읽는다");
+
+    const std::string path = "replay_test_keyframes.trpl";
+    ReplayData loaded;
+    check(ReplayIO::Save(path, rp) && ReplayIO::Load(path, loaded) && same(rp, loaded) &&
+          same_keyframes(rp, loaded),
+          "Save→Load 도 keyframe 을 담는다");
+    std::remove(path.c_str());
+
+    const std::vector<uint8_t> bytes = ReplayIO::Encode(rp);
+    std::vector<ReplayIO::KeyframeIndexEntry> index;
+    bool indexOk = ReplayIO::ReadKeyframeIndex(bytes.data(), bytes.size(), index) &&
+                   index.size() == rp.keyframes.size();
+    for (size_t i = 0; indexOk && i < index.size(); ++i) {
+        ReplayKeyframe k;
+        indexOk = index[i].tick == rp.keyframes[i].tick &&
+                  ReplayIO::ReadKeyframeAt(bytes.data(), bytes.size(), index[i].offset, k) &&
+                  k.state == rp.keyframes[i].state && k.hash[0] == rp.keyframes[i].hash[0];
+    }
+    ReplayKeyframe k;
+    check(indexOk && !ReplayIO::ReadKeyframeAt(bytes.data(), bytes.size(), index[1].offset + 1, k),
+          "색인으로 keyframe 하나만 꺼내고, 어긋난 offset 은 거절");
+
+    ReplayData plain = rp;
+    plain.keyframes.clear();
+    const std::vector<uint8_t> noKeys = ReplayIO::Encode(plain);
+    ReplayData back;
+    check(ReplayIO::Decode(noKeys.data(), noKeys.size(), back) && back.keyframes.empty() &&
+          !ReplayIO::ReadKeyframeIndex(noKeys.data(), noKeys.size(), index),
+          "keyframe 이 없는 파일은 색인도 없다");
+}
+
+void test_seek_and_verify() {
+    ReplayData rp = make_match(6, 4000, 3);
+    AddKeyframes(rp, 500);
+
+    XorShift64Star rng(99);
+    bool ok = true;
+    for (int trial = 0; trial < 12 && ok; ++trial) {
+        const uint64_t tick = trial == 0 ? rp.frames.size() : rng.nextUInt(static_cast<uint32_t>(rp.frames.size()));
+        ReplaySim full(rp.seed);
+        while (full.Tick() < tick) full.Step(rp.frames[full.Tick()]);
+        ReplaySim sought(rp.seed);
+        ok = SeekReplay(rp, tick, sought) && sought.Tick() == tick &&
+             sought.Board(0).StateHash() == full.Board(0).StateHash() &&
+             sought.Board(1).StateHash() == full.Board(1).StateHash();
+        // 탐색 뒤에도 같은 입력에 같은 전개(가비지 델타 기준점 포함).
+        for (uint64_t t = tick; ok && t < std::min<uint64_t>(tick + 300, rp.frames.size()); ++t) {
+            full.Step(rp.frames[t]);
+            sought.Step(rp.frames[t]);
+            ok = sought.Board(0).StateHash() == full.Board(0).StateHash() &&
+                 sought.Board(1).StateHash() == full.Board(1).StateHash();
+        }
+    }
+    ReplaySim sim(rp.seed);
+    check(ok && !SeekReplay(rp, rp.frames.size() + 1, sim), "keyframe 에서 탐색한 상태 = 처음부터 굴린 상태");
+
+    std::string err;
+    check(VerifyKeyframes(rp, &err) == -1 && err.empty(), "온전한 keyframe 은 검증을 통과");
+
+    ReplayData badHash = rp;
+    badHash.keyframes[3].hash[1] ^= 1;
+    check(VerifyKeyframes(badHash, &err) == 3 && err == "keyframe hash differs from resimulation",
+          "해시가 바뀐 keyframe 을 찾는다");
+
+    ReplayData badState = rp;
+    badState.keyframes[5].state[4] ^= 0x40;   // 보드 0 의 rngState
+    check(VerifyKeyframes(badState, &err) == 5 && err == "keyframe state differs from its hash",
+          "상태 바이트가 바뀐 keyframe 을 찾는다");
+}
+
+// 다른 입력 이력으로 만든 keyframe 이 섞인 파일. 로컬 쪽은 그 keyframe 을 풀지 않고 시드부터
+// 굴려야 차이가 보인다(풀어서 시작하면 양쪽이 늘 같아 board=-1 이 된다).
+void test_keyframe_divergence() {
+    ReplayData rp = make_match(8, 1200, 3);
+    ReplayData other = rp;
+    size_t changed = 120;
+    while (other.frames[changed].p2 != 0) ++changed;
+    other.frames[changed].p2 = INPUT_DROP;
+    AddKeyframes(rp, 100);
+    AddKeyframes(other, 100);
+    rp.keyframes[2] = other.keyframes[2];   // tick 200
+
+    ReplaySim mine(rp.seed), theirs(other.seed);
+    while (mine.Tick() < 200) mine.Step(rp.frames[mine.Tick()]);
+    while (theirs.Tick() < 200) theirs.Step(other.frames[theirs.Tick()]);
+    int board = -1, component = -1;
+    const bool differs = FirstHashDifference(ReplayHashesOf(mine), ReplayHashesOf(theirs), board, component);
+
+    std::string err;
+    ReplayDivergence d;
+    check(differs && VerifyKeyframes(rp, &err) == 2 && KeyframeDivergence(rp, 2, d),
+          "다른 이력의 keyframe 2 를 찾아 풀어 본다");
+    check(d.tick == 200 && d.board == board && d.board >= 0 && d.component == component,
+          "keyframe 불일치의 보드·섹션을 짚는다");
+    check(d.local.tick == 200 && d.reference.tick == 200 &&
+          d.local.board[d.board].grid != 0 && d.reference.board[d.board].grid != 0,
+          "양쪽 해시를 돌려준다");
+
+    ReplayData broken = rp;
+    broken.keyframes[2].state.resize(3);
+    ReplayDivergence none;
+    check(!KeyframeDivergence(broken, 2, none) && none.board == -1 && !KeyframeDivergence(rp, 99, none),
+          "풀리지 않는 keyframe·범위 밖 번호는 false");
+
+    // 이분 탐색도 파일의 keyframe 을 믿지 않는다. good 틱 전에 갈라진 세 번째 이력의
+    // keyframe 으로 바꿔 끼워도 결과가 같다.
+    ReplayData third = rp;
+    size_t early = 40;
+    while (third.frames[early].p1 != 0) ++early;
+    third.frames[early].p1 = INPUT_DROP;
+    AddKeyframes(third, 100);
+    ReplayData foreign = rp;
+    foreign.keyframes = third.keyframes;
+    std::vector<ReplayHashes> table;
+    ReplaySim ref(other.seed);
+    for (size_t t = 0; t <= 600; ++t) {
+        table.push_back(ReplayHashesOf(ref));
+        ref.Step(other.frames[t]);
+    }
+    const ReferenceHashes reference = [&](uint64_t tick, ReplayHashes& out) {
+        if (tick >= table.size()) return false;
+        out = table[tick];
+        return true;
+    };
+    ReplayDivergence a, b;
+    check(BisectDivergence(rp, 100, 600, reference, a) && BisectDivergence(foreign, 100, 600, reference, b) &&
+          a.tick == changed + 1 && b.tick == a.tick && b.board == a.board && b.component == a.component,
+          "이분 탐색의 로컬 쪽은 시드부터 굴린다");
+}
+
+// 기준 빌드 대신 p2 입력 하나를 바꾼 리플레이로 기준 해시를 만든다. 갈라지는 틱은 알려져 있다.
+void test_bisect() {
+    const ReplayData rp = make_match(8, 1200, 3);
+    ReplayData other = rp;
+    size_t changed = 100;   // 무작위 입력은 200 틱 안팎에서 끝난다
+    while (other.frames[changed].p2 != 0) ++changed;
+    other.frames[changed].p2 = INPUT_DROP;
+
+    std::vector<ReplayHashes> table;
+    ReplaySim ref(other.seed);
+    for (size_t t = 0;; ++t) {
+        table.push_back(ReplayHashesOf(ref));
+        if (t == other.frames.size()) break;
+        ref.Step(other.frames[t]);
+    }
+    int calls = 0;
+    const ReferenceHashes reference = [&](uint64_t tick, ReplayHashes& out) {
+        ++calls;
+        if (tick >= table.size()) return false;
+        out = table[tick];
+        return true;
+    };
+
+    int board = -1, component = -1;
+    check(!FirstHashDifference(table[changed], table[changed], board, component) && board == -1,
+          "같은 해시는 차이가 없다");
+    ReplaySim local(rp.seed);
+    SeekReplay(rp, changed + 1, local);
+    check(FirstHashDifference(ReplayHashesOf(local), table[changed + 1], board, component) && board == 1,
+          "바뀐 입력의 보드를 짚는다");
+
+    // 600 틱 체크포인트 구간 (0, 600] 을 이분한다.
+    ReplayDivergence d;
+    const bool ok = BisectDivergence(rp, 0, 600, reference, d);
+    check(ok && d.tick == changed + 1 && d.board == 1 && d.component >= 0,
+          "처음 갈라진 틱·보드를 찾는다");
+    check(d.probes == calls && d.probes <= 11, "탐침은 구간 길이의 log2 남짓");
+    check(d.local.tick == d.tick && d.reference.tick == d.tick &&
+          FirstHashDifference(d.local, d.reference, board, component) && component == d.component,
+          "갈라진 틱의 양쪽 해시를 돌려준다");
+
+    ReplayDivergence none;
+    check(!BisectDivergence(rp, 600, 0, reference, none) &&
+          !BisectDivergence(rp, 0, rp.frames.size() + 1, reference, none),
+          "잘못된 구간은 거절");
+    const ReferenceHashes broken = [](uint64_t, ReplayHashes&) { return false; };
+    check(!BisectDivergence(rp, 0, 600, broken, none), "기준 해시를 못 받으면 실패");
+}
+
+}  // namespace
+
+int main() {
+    test_round_trip();
+    test_files_and_size();
+    test_damage();
+    test_hostile_run_lengths();
+    test_resimulation();
+    test_keyframes();
+    test_seek_and_verify();
+    test_bisect();
+    test_keyframe_divergence();
+    if (g_failures) {
+        std::fprintf(stderr, "[replay] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[replay] all passed\n");
+    return 0;
+}
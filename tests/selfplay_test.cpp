@@ -0,0 +1,96 @@
+// tests/selfplay_test.cpp — self-play 엔진(bot/selfplay.h) 회귀
+//
+//   - VersusMatch: 공격 델타가 상대 pendingGarbage 로 넘어간다
+//   - run_selfplay: 스레드 수와 무관하게 기록이 바이트 단위로 같다(work-stealing 이
+//     매치 배정 순서를 바꿔도 출력에 새지 않는다)
+
+#include "../bot/selfplay.h"
+#include "../bot/placement.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[selfplay] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[selfplay] ok:   %s\n", what); }
+}
+
+void test_versus_routing() {
+    bot::VersusMatch match(bot::match_seed(7, 0, 0), bot::match_seed(7, 0, 1));
+    check(match.board[0].StateHash() != match.board[1].StateHash(), "두 보드의 시드가 다르다");
+
+    // 휴리스틱끼리 공격이 한 번 나올 때까지 둔다.
+    int sent = 0;
+    int before = 0;
+    for (int i = 0; i < 4000 && !match.Over() && sent == 0; ++i) {
+        const int player = i % 2;
+        int col = 0, rot = 0;
+        if (!bot::heuristic_placement(match.board[player], col, rot)) break;
+        before = match.board[1 - player].PendingGarbage();
+        match.Place(player, col, rot, &sent);
+        if (sent > 0) {
+            check(match.board[1 - player].PendingGarbage() == before + sent,
+                  "보낸 공격만큼 상대 pendingGarbage 가 늘었다");
+        }
+    }
+    check(sent > 0, "공격이 한 번은 나왔다");
+
+    int attack = -1;
+    check(match.Place(0, -99, 0, &attack) == -1 && attack == 0, "불법 수는 -1, 공격 0");
+}
+
+void test_thread_invariance() {
+    bot::SelfPlayConfig config;
+    config.matches = 12;
+    config.seed = 42;
+    config.maxPieces = 300;
+    const bot::PolicyFactory factory = [](int, int player) {
+        return player == 0 ? bot::heuristic_policy() : bot::random_policy(5);
+    };
+
+    config.threads = 1;
+    const bot::SelfPlayResult one = bot::run_selfplay(config, factory);
+    config.threads = 4;
+    const bot::SelfPlayResult four = bot::run_selfplay(config, factory);
+
+    check(one.placements > 0 && one.placements == static_cast<int64_t>(one.records.size()),
+          "착수마다 기록 하나");
+    check(one.placements == four.placements, "스레드 수와 무관한 총 착수 수");
+    check(one.winsA == four.winsA && one.winsB == four.winsB && one.draws == four.draws,
+          "스레드 수와 무관한 승패");
+    check(one.records.size() == four.records.size()
+              && std::memcmp(one.records.data(), four.records.data(),
+                             one.records.size() * sizeof(bot::SelfPlayRecord)) == 0,
+          "스레드 수와 무관한 기록 바이트");
+    check(one.winsA + one.winsB + one.draws == config.matches, "모든 매치가 끝났다");
+
+    bool ordered = true;
+    for (size_t i = 1; i < one.records.size(); ++i) {
+        const bot::SelfPlayRecord& a = one.records[i - 1];
+        const bot::SelfPlayRecord& b = one.records[i];
+        if (a.match > b.match || (a.match == b.match && a.ply > b.ply)) ordered = false;
+    }
+    check(ordered, "기록은 (match, ply) 순");
+
+    bool legal = true;
+    for (const bot::SelfPlayRecord& r : one.records) {
+        if (((r.legalMask >> r.action) & 1u) == 0) legal = false;
+    }
+    check(legal, "기록된 수는 모두 그 시점의 합법 수");
+}
+
+}  // namespace
+
+int main() {
+    test_versus_routing();
+    test_thread_invariance();
+    if (g_failures) {
+        std::fprintf(stderr, "[selfplay] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[selfplay] all passed\n");
+    return 0;
+}
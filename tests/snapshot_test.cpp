@@ -0,0 +1,164 @@
+// tests/snapshot_test.cpp — SimGame::Snapshot/Restore 회귀
+//
+//   - 왕복: 여러 시점에서 찍은 스냅샷을 다른 시드의 인스턴스에 풀면 StateHash·
+//     Fingerprint·ghost 가 같다 (가비지 행·T-spin 플래그·빈 가방 경우 포함)
+//   - 이후 전개: 복원본과 원본에 같은 입력을 계속 주면 해시가 계속 같다 (가방/RNG)
+//   - 손상된 스냅샷은 false 를 돌려주고 상태를 바꾸지 않는다
+//   - 블록 위치가 그리드 밖이거나 굳은 셀과 겹치는 스냅샷도 거절한다(풀어 두면 LockBlock 이
+//     그리드 밖을 쓴다). 게임 오버 상태의 겹침만은 정상이다
+
+#include "../src/sim_game.h"
+#include "../core/rng.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[snapshot] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[snapshot] ok:   %s\n", what); }
+}
+
+// 결정론적 입력 스트림. 하드드롭을 섞어 lock·줄 삭제가 자주 일어나게 한다.
+uint8_t input_at(uint64_t seed, int step) {
+    const uint64_t r = splitmix64(seed + static_cast<uint64_t>(step));
+    uint8_t mask = static_cast<uint8_t>(r & (INPUT_LEFT | INPUT_RIGHT | INPUT_ROTATE | INPUT_DOWN));
+    if ((r >> 8) % 9 == 0) mask |= INPUT_DROP;
+    return mask;
+}
+
+void advance(SimGame& g, uint64_t seed, int step) {
+    g.SubmitInput(input_at(seed, step));
+    g.Tick();
+    if (step % 97 == 0) g.AddPendingGarbage(1 + step % 3);
+}
+
+bool same_state(const SimGame& a, const SimGame& b) {
+    return a.StateHash() == b.StateHash()
+        && a.Fingerprint() == b.Fingerprint()
+        && a.GhostBlock().rowOffset == b.GhostBlock().rowOffset
+        && a.GhostBlock().columnOffset == b.GhostBlock().columnOffset
+        && a.GhostBlock().rotationState == b.GhostBlock().rotationState;
+}
+
+void test_round_trip() {
+    int snapshots = 0, mismatches = 0, divergences = 0;
+    bool sawGarbage = false, sawEmptyBag = false, sawGameOver = false;
+    for (uint64_t seed = 1; seed <= 6; ++seed) {
+        SimGame game(seed * 7919);
+        for (int step = 0; step < 6000; ++step) {
+            advance(game, seed, step);
+            if (step % 23 != 0) continue;
+
+            const SimSnapshot snap = game.Snapshot();
+            SimGame restored(12345);
+            if (!restored.Restore(snap) || !same_state(game, restored)) { ++mismatches; continue; }
+            ++snapshots;
+            for (int r = 0; r < SimGrid::kRows; ++r)
+                for (int c = 0; c < SimGrid::kCols; ++c)
+                    if (game.Grid()[r][c] == 9) sawGarbage = true;
+            if (snap.bagMask == 0) sawEmptyBag = true;
+            if (game.IsGameOver()) sawGameOver = true;
+
+            // 같은 입력으로 40 스텝 더 — 복원본이 가방·RNG 까지 같은지 본다.
+            SimGame original = game;
+            for (int k = 1; k <= 40; ++k) {
+                advance(original, seed, step + k);
+                advance(restored, seed, step + k);
+            }
+            if (!same_state(original, restored)) ++divergences;
+        }
+    }
+    check(snapshots > 1000, "충분한 수의 스냅샷을 찍었다");
+    check(mismatches == 0, "Restore(Snapshot()) 의 해시·지문·ghost 가 원본과 같다");
+    check(divergences == 0, "복원 이후 같은 입력에 같은 전개");
+    check(sawGarbage, "가비지 행이 있는 상태를 덮었다");
+    check(sawEmptyBag, "빈 가방 상태를 덮었다");
+    check(sawGameOver, "게임 오버 상태를 덮었다");
+}
+
+void test_rejects_corrupt() {
+    SimGame game(77);
+    for (int step = 0; step < 300; ++step) advance(game, 3, step);
+    const SimSnapshot good = game.Snapshot();
+
+    SimGame target(5);
+    const uint64_t before = target.StateHash();
+    auto rejected = [&](SimSnapshot snap) {
+        return !target.Restore(snap) && target.StateHash() == before;
+    };
+
+    SimSnapshot bad = good; bad.version = 0;
+    check(rejected(bad), "다른 버전은 거절");
+    bad = good; bad.currentId = 8;
+    check(rejected(bad), "범위 밖 블록 id 는 거절");
+    bad = good; bad.nextIds[1] = 0;
+    check(rejected(bad), "빈 next id 는 거절");
+    bad = good; bad.bagMask = 0x80;
+    check(rejected(bad), "가방 마스크 상위 비트는 거절");
+    bad = good; bad.rngState = 0;
+    check(rejected(bad), "RNG 상태 0 은 거절");
+    bad = good; bad.garbageRows[2] = 0x10;
+    check(rejected(bad), "20 행 밖 가비지 비트는 거절");
+    check(target.Restore(good) && target.StateHash() == game.StateHash(), "정상 스냅샷은 받는다");
+}
+
+// 셀 (r, c) 의 3비트 코드를 쓴다. Restore 의 grid 해석과 같은 배치.
+void set_cell(SimSnapshot& snap, int r, int c, int code) {
+    const int bit = 3 * (r * SimGrid::kCols + c);
+    const unsigned word = (snap.grid[bit >> 3] | ((bit >> 3) + 1 < SimSnapshot::kGridBytes
+                                                      ? snap.grid[(bit >> 3) + 1] << 8 : 0));
+    const unsigned next = (word & ~(7u << (bit & 7))) | (static_cast<unsigned>(code) << (bit & 7));
+    snap.grid[bit >> 3] = static_cast<uint8_t>(next);
+    if ((bit >> 3) + 1 < SimSnapshot::kGridBytes) snap.grid[(bit >> 3) + 1] = static_cast<uint8_t>(next >> 8);
+}
+
+void test_rejects_hostile_positions() {
+    SimGame game(91);
+    const SimSnapshot good = game.Snapshot();   // 빈 판, 스폰 직후
+
+    SimGame target(5);
+    const uint64_t before = target.StateHash();
+    auto rejected = [&](SimSnapshot snap) {
+        return !target.Restore(snap) && target.StateHash() == before;
+    };
+
+    SimSnapshot bad = good; bad.currentRow = 100; bad.currentCol = 100;
+    check(rejected(bad), "그리드 밖 현재 블록(row=100, col=100)은 거절");
+    bad = good; bad.currentRow = -3;
+    check(rejected(bad), "천장 위로 나간 현재 블록은 거절");
+    bad = good; bad.currentCol = -5;
+    check(rejected(bad), "왼쪽 벽을 넘은 현재 블록은 거절");
+    bad = good; bad.ghostRow = 100;
+    check(rejected(bad), "그리드 밖 ghost 는 거절");
+    bad = good; bad.ghostRow = -100;
+    check(rejected(bad), "음수 ghost 행은 거절");
+
+    // 현재 블록 자리를 굳은 셀로 채운다. 게임 오버가 아니면 있을 수 없는 상태다.
+    SimSnapshot overlap = good;
+    for (const Position& p : game.CurrentBlock().GetCellPositions()) set_cell(overlap, p.row, p.column, 1);
+    check(rejected(overlap), "게임 오버가 아닌데 굳은 셀과 겹친 현재 블록은 거절");
+    overlap.flags |= 1u;
+    SimGame over(6);
+    check(over.Restore(overlap) && over.IsGameOver(), "게임 오버 상태의 겹침은 받는다");
+
+    // 거절된 뒤에도 target 은 멀쩡히 돈다(ASan 빌드에서 그리드 밖 쓰기가 없어야 한다).
+    for (int step = 0; step < 200; ++step) advance(target, 9, step);
+    check(target.Restore(good) && target.StateHash() == game.StateHash(), "정상 스냅샷은 받는다");
+}
+
+}  // namespace
+
+int main() {
+    test_round_trip();
+    test_rejects_corrupt();
+    test_rejects_hostile_positions();
+    if (g_failures) {
+        std::fprintf(stderr, "[snapshot] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[snapshot] all passed\n");
+    return 0;
+}
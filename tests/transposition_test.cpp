@@ -0,0 +1,180 @@
+// tests/transposition_test.cpp — 봇 탐색 전치표(bot/transposition.h) 회귀
+//
+//   - 저장한 값을 그대로 돌려주고, 없는 키는 miss
+//   - 교체: 같은 키는 덮어쓰고, 꽉 찬 bucket 에서는 이전 세대·얕은 depth 를 민다
+//   - 여러 스레드가 같은 칸을 두드려도 찢어진 엔트리를 돌려주지 않는다
+//   - beam search 에 붙이면 고르는 수는 같고 평가를 다시 쓴다
+//   - PositionKey 는 점수 같은 전개 밖 값을 빼고 보드·블록 상태만 본다
+
+#include "../bot/beam_search.h"
+#include "../bot/placement.h"
+#include "../bot/transposition.h"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int g_failures = 0;
+void check(bool cond, const char* what) {
+    if (!cond) { std::fprintf(stderr, "[tt] FAIL: %s\n", what); ++g_failures; }
+    else       { std::fprintf(stderr, "[tt] ok:   %s\n", what); }
+}
+
+bot::TTEntry entry(double value, int action, int depth) {
+    bot::TTEntry e;
+    e.value = value;
+    e.bestAction = static_cast<uint8_t>(action);
+    e.depth = static_cast<uint8_t>(depth);
+    return e;
+}
+
+void test_store_probe() {
+    bot::TranspositionTable table(1);
+    bot::TTEntry out;
+    check(!table.Probe(42, out), "빈 표는 miss");
+    table.Store(42, entry(-3.25, 17, 2));
+    check(table.Probe(42, out) && out.value == -3.25 && out.bestAction == 17 && out.depth == 2,
+          "저장한 값·수·깊이를 그대로 돌려준다");
+    table.Store(0, entry(1.0, 3, 0));
+    check(table.Probe(0, out) && out.value == 1.0, "키 0 도 담긴다");
+    table.Store(42, entry(5.0, 1, 1));
+    check(table.Probe(42, out) && out.value == 5.0 && out.bestAction == 1, "같은 키는 덮어쓴다");
+
+    const bot::TTStats s = table.Stats();
+    check(s.probes == 4 && s.hits == 3 && s.stores == 3 && s.overwrites == 0, "카운터가 호출 수와 맞다");
+    check(s.hitRate() == 0.75, "hitRate = hits / probes");
+    table.Clear();
+    check(!table.Probe(42, out) && table.Stats().probes == 1, "Clear 는 엔트리와 카운터를 비운다");
+}
+
+void test_replacement() {
+    bot::TranspositionTable table(1);
+    const uint64_t stride = table.Entries() / 2;  // bucket 수. 같은 bucket 에 떨어지는 키 간격
+    bot::TTEntry out;
+
+    // bucket 하나(2 칸)에 깊은 것·얕은 것을 채운 뒤 세 번째 키를 넣는다.
+    table.Store(7, entry(1.0, 0, 4));
+    table.Store(7 + stride, entry(2.0, 0, 1));
+    table.Store(7 + 2 * stride, entry(3.0, 0, 3));
+    check(table.Probe(7, out) && !table.Probe(7 + stride, out) && table.Probe(7 + 2 * stride, out),
+          "같은 세대에서는 얕은 엔트리를 민다");
+    check(table.Stats().overwrites == 1, "다른 키를 민 저장이 overwrite 로 잡힌다");
+
+    // 세대를 넘기면 깊은 옛 엔트리보다 새 얕은 엔트리가 남는다.
+    table.NewGeneration();
+    table.Store(7 + 3 * stride, entry(4.0, 0, 0));
+    table.Store(7 + 4 * stride, entry(5.0, 0, 0));
+    check(!table.Probe(7, out) && !table.Probe(7 + 2 * stride, out)
+          && table.Probe(7 + 3 * stride, out) && table.Probe(7 + 4 * stride, out),
+          "이전 세대 엔트리가 먼저 밀린다");
+    check(table.Stats().occupancy > 0.0, "이번 세대 점유율이 잡힌다");
+}
+
+// 키마다 값이 정해지는 엔트리를 여러 스레드가 좁은 키 공간에 마구 쓰고 읽는다.
+// 적중한 엔트리의 값·수가 키와 어긋나면 찢어진 읽기다.
+void test_concurrent_no_torn_reads() {
+    bot::TranspositionTable table(1);
+    const uint64_t stride = table.Entries() / 2;
+    std::atomic<int> torn{0};
+    std::atomic<uint64_t> hits{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            uint64_t local = 0;
+            for (int i = 0; i < 200000; ++i) {
+                const uint64_t key = 11 + static_cast<uint64_t>((i * 7 + t) % 6) * stride;
+                if (i % 3 == 0) {
+                    table.Store(key, entry(static_cast<double>(key) * 0.5,
+                                           static_cast<int>(key % 40), static_cast<int>(key % 5)));
+                } else {
+                    bot::TTEntry out;
+                    if (table.Probe(key, out)) {
+                        ++local;
+                        if (out.value != static_cast<double>(key) * 0.5 || out.bestAction != key % 40
+                            || out.depth != key % 5)
+                            torn.fetch_add(1);
+                    }
+                }
+            }
+            hits.fetch_add(local);
+        });
+    }
+    for (auto& th : threads) th.join();
+    check(hits.load() > 0 && torn.load() == 0, "동시 접근에서도 찢어진 엔트리가 없다");
+    const bot::TTStats s = table.Stats();
+    check(s.probes + s.stores == 4u * 200000u && s.hits == hits.load(),
+          "줄무늬 카운터 합이 스레드별 호출 수와 맞다");
+}
+
+bot::BeamConfig fixed(bot::TranspositionTable* table) {
+    bot::BeamConfig config;
+    config.width = 12;
+    config.depth = 4;
+    config.budgetMs = 0.0;
+    config.table = table;
+    return config;
+}
+
+void test_beam_with_table() {
+    bot::TranspositionTable table(8);
+    SimGame plain(31), cached(31);
+    int moves = 0, mismatches = 0, tableHits = 0, rootHits = 0;
+    for (; moves < 60 && !plain.IsGameOver(); ++moves) {
+        int c1 = 0, r1 = 0, c2 = 0, r2 = 0;
+        bot::BeamStats s;
+        if (!bot::beam_placement(plain, fixed(nullptr), c1, r1)) break;
+        bot::beam_placement(cached, fixed(&table), c2, r2, &s);
+        if (c1 != c2 || r1 != r2) ++mismatches;
+        tableHits += s.tableHits;
+        // 같은 위치를 다시 물으면 루트 답이 바로 나온다.
+        bot::BeamStats again;
+        int c3 = 0, r3 = 0;
+        bot::beam_placement(cached, fixed(&table), c3, r3, &again);
+        if (again.rootHit && again.nodes == 0 && c3 == c2 && r3 == r2) ++rootHits;
+        plain.ApplyPlacement(c1, r1);
+        cached.ApplyPlacement(c1, r1);
+    }
+    std::fprintf(stderr, "[tt] beam: %d moves, %d child evals from table, hit rate %.2f\n",
+                 moves, tableHits, table.Stats().hitRate());
+    check(moves > 30 && mismatches == 0, "전치표가 있어도 같은 수를 고른다");
+    check(tableHits > moves * 50, "다음 수 탐색이 직전 탐색의 평가를 다시 쓴다");
+    check(rootHits == moves, "같은 위치 재질의는 루트 엔트리로 답한다");
+}
+
+void test_position_key_transposition() {
+    SimGame base(3);
+    SimGame a = base, b = base;
+    check(a.PositionKey() == b.PositionKey(), "같은 상태는 같은 키");
+    a.ApplyPlacement(0, 0);
+    check(a.PositionKey() != base.PositionKey(), "착수하면 키가 바뀐다");
+
+    // 점수처럼 착수 전개에 영향을 주지 않는 값은 키에 들어가지 않고, 받을 가비지는 들어간다.
+    SimSnapshot snap = base.Snapshot();
+    snap.score += 1000;
+    SimGame scored = base;
+    check(scored.Restore(snap) && scored.PositionKey() == base.PositionKey()
+          && scored.Fingerprint() != base.Fingerprint(),
+          "점수는 PositionKey 에 들어가지 않는다 (Fingerprint 에는 들어간다)");
+    SimGame garbage = base;
+    garbage.AddPendingGarbage(1);
+    check(garbage.PositionKey() != base.PositionKey(), "받을 가비지는 키에 들어간다");
+}
+
+}  // namespace
+
+int main() {
+    test_store_probe();
+    test_replacement();
+    test_concurrent_no_torn_reads();
+    test_beam_with_table();
+    test_position_key_transposition();
+    if (g_failures) {
+        std::fprintf(stderr, "[tt] %d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::fprintf(stderr, "[tt] all passed\n");
+    return 0;
+}
@@ -0,0 +1,196 @@
+// tetris_arena — 헤드리스 봇 대 봇 토너먼트. 모델을 내보내기 전 승률 게이트.
+//
+//   tetris_arena --a model/bots/new.onnx --vs heuristic --vs beam --matches 2000
+//   tetris_arena --a model/bots/new.onnx --vs-dir model/bots --gate 0.55
+//
+// 엔진은 bot/arena.h(main.cpp lockstep 과 같은 틱 루프·가비지 배선). 상대마다 한 줄:
+// 승/패/무, A 의 점수율과 95% Wilson 구간, 양쪽 attack/min, matches/sec.
+
+#include "../bot/arena.h"
+#include "../bot/bot_onnx.h"
+#include "../core/constants.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage()
+{
+    std::cout <<
+        "Usage: tetris_arena --a BOT [--vs BOT]... [--vs-dir DIR] [--matches N] [--threads N]\n"
+        "                    [--seed S] [--max-minutes M] [--a-interval N] [--b-interval N]\n"
+        "                    [--beam-width N] [--beam-depth N] [--mcts-sims N] [--gate P]\n"
+        "  BOT              heuristic | beam | mcts | random | 경로.onnx\n"
+        "                   random 은 (시드, 판)으로 정해지는 무작위 합법 수 — 스크립트 상대\n"
+        "  --a BOT          평가할 봇 (default heuristic)\n"
+        "  --vs BOT         상대. 여러 번 줄 수 있다 (default random)\n"
+        "  --vs-dir DIR     DIR 의 *.onnx 를 전부 상대로 더한다 (이름순)\n"
+        "  --matches N      상대마다 대전 수 (default 256)\n"
+        "  --threads N      워커 스레드 수. 0 이면 하드웨어 스레드 수 (default 0)\n"
+        "  --seed S         매치 시드의 기준값 (default 1). 두 보드는 같은 시드다\n"
+        "  --max-minutes M  게임 시간 상한(분). 넘으면 무승부 (default 10)\n"
+        "  --a-interval N   A 의 입력 간격(틱), bots.cfg 의 속도 (default 1)\n"
+        "  --b-interval N   상대의 입력 간격(틱) (default 1)\n"
+        "  --beam-width N   beam 봇의 폭 (default 24)\n"
+        "  --beam-depth N   beam 봇이 둬 볼 블록 수 1..4 (default 4). 시간 예산 없이 깊이로만\n"
+        "                   자른다 (결정론)\n"
+        "  --mcts-sims N    mcts 봇의 수당 시뮬레이션 수 (default 64)\n"
+        "  --gate P         어느 상대에게든 A 점수율 95% 구간 하한이 P 보다 낮으면 종료 코드 1\n";
+}
+
+bool isOnnxPath(const std::string& spec)
+{
+    return spec.size() > 5 && spec.compare(spec.size() - 5, 5, ".onnx") == 0;
+}
+
+bool isBuiltin(const std::string& spec)
+{
+    return spec == "heuristic" || spec == "beam" || spec == "mcts" || spec == "random";
+}
+
+std::string displayName(const std::string& spec)
+{
+    return isOnnxPath(spec) ? std::filesystem::path(spec).stem().string() : spec;
+}
+
+struct PolicyOptions
+{
+    bot::BeamConfig beam;
+    bot::MctsConfig mcts;
+    uint64_t seed = 1;
+};
+
+// 워커마다 새로 만든다. ONNX 는 워커·보드마다 세션을 하나씩 연다(tetris_selfplay 와 같다).
+bot::PlacementPolicy makePolicy(const std::string& spec, const PolicyOptions& opt, int player)
+{
+    if (spec == "beam")   return bot::beam_policy(opt.beam);
+    if (spec == "mcts")   return bot::mcts_policy(opt.mcts);
+    if (spec == "random") return bot::random_policy(opt.seed + static_cast<uint64_t>(player));
+    if (isOnnxPath(spec))
+    {
+        auto onnx = std::make_shared<bot::BotOnnx>();
+        if (onnx->Load(spec))
+        {
+            return [onnx](const SimGame& sim, int& col, int& rot) { return onnx->Infer(sim, col, rot); };
+        }
+        // main 에서 한 번 열어 봤으므로 여기서 실패할 일은 드물다. 판을 멈추지 않게 물러선다.
+    }
+    return bot::heuristic_policy();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bot::ArenaConfig config;
+    PolicyOptions opt;
+    opt.beam.budgetMs = 0.0;
+    opt.mcts.simulations = 64;
+    opt.mcts.leafBatch = 1;
+    std::string specA = "heuristic";
+    std::vector<std::string> opponents;
+    double gate = -1.0;
+    double maxMinutes = 10.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else if (arg == "--a" && hasValue)           specA = argv[++i];
+        else if (arg == "--vs" && hasValue)          opponents.push_back(argv[++i]);
+        else if (arg == "--vs-dir" && hasValue)
+        {
+            namespace fs = std::filesystem;
+            const fs::path dir = argv[++i];
+            std::vector<std::string> found;
+            std::error_code ec;
+            for (fs::directory_iterator it(dir, ec), end; it != end && !ec; it.increment(ec))
+            {
+                if (it->is_regular_file(ec) && it->path().extension() == ".onnx")
+                    found.push_back(it->path().string());
+            }
+            if (ec)
+            {
+                std::cerr << "cannot read " << dir.string() << ": " << ec.message() << "\n";
+                return 2;
+            }
+            std::sort(found.begin(), found.end());
+            opponents.insert(opponents.end(), found.begin(), found.end());
+        }
+        else if (arg == "--matches" && hasValue)     config.matches = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue)     config.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)        config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-minutes" && hasValue) maxMinutes = std::atof(argv[++i]);
+        else if (arg == "--a-interval" && hasValue)  config.inputIntervalTicks[0] = std::atoi(argv[++i]);
+        else if (arg == "--b-interval" && hasValue)  config.inputIntervalTicks[1] = std::atoi(argv[++i]);
+        else if (arg == "--beam-width" && hasValue)  opt.beam.width = std::atoi(argv[++i]);
+        else if (arg == "--beam-depth" && hasValue)  opt.beam.depth = std::atoi(argv[++i]);
+        else if (arg == "--mcts-sims" && hasValue)   opt.mcts.simulations = std::atoi(argv[++i]);
+        else if (arg == "--gate" && hasValue)        gate = std::atof(argv[++i]);
+        else
+        {
+            std::cerr << "unknown argument: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+    if (opponents.empty()) opponents.push_back("random");
+    config.maxTicks = std::max(1, static_cast<int>(maxMinutes * 60.0 * TICKS_PER_SECOND));
+    opt.seed = config.seed;
+
+    // 모델은 시작 전에 한 번 열어 본다. 게이트가 조용히 heuristic 과 붙는 일을 막는다.
+    std::vector<std::string> all = opponents;
+    all.push_back(specA);
+    for (const std::string& spec : all)
+    {
+        if (isBuiltin(spec)) continue;
+        if (!isOnnxPath(spec))
+        {
+            std::cerr << "unknown bot: " << spec << "\n";
+            return 2;
+        }
+        bot::BotOnnx probe;
+        std::string err;
+        if (!probe.Load(spec, &err))
+        {
+            std::cerr << "model load failed: " << spec << ": " << err << "\n";
+            return 2;
+        }
+    }
+
+    bool gateFailed = false;
+    for (const std::string& specB : opponents)
+    {
+        const bot::PolicyFactory factory = [&](int, int player) {
+            return makePolicy(player == 0 ? specA : specB, opt, player);
+        };
+        const bot::ArenaResult r = bot::run_arena(config, factory);
+
+        const int n = r.winsA + r.winsB + r.draws;
+        double lo = 0.0, hi = 1.0;
+        bot::wilson_interval(r.winsA + 0.5 * r.draws, n, 1.96, lo, hi);
+        const double rate = r.seconds > 0.0 ? n / r.seconds : 0.0;
+        std::printf("A=%s B=%s matches=%d W=%d L=%d D=%d score=%.3f ci95=[%.3f,%.3f] "
+                    "apm_a=%.1f apm_b=%.1f minutes=%.1f threads=%d matches/sec=%.1f\n",
+                    displayName(specA).c_str(), displayName(specB).c_str(), n, r.winsA, r.winsB,
+                    r.draws, r.ScoreA(), lo, hi, r.AttackPerMinute(0), r.AttackPerMinute(1),
+                    static_cast<double>(r.ticks) / (60.0 * TICKS_PER_SECOND), r.threads, rate);
+        std::fflush(stdout);
+        if (gate >= 0.0 && lo < gate) gateFailed = true;
+    }
+    if (gateFailed)
+    {
+        std::cerr << "gate failed: score lower bound below " << gate << "\n";
+        return 1;
+    }
+    return 0;
+}
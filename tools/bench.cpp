@@ -0,0 +1,390 @@
+// tetris_bench — 시뮬레이션·봇·프레이밍 hot path 마이크로벤치마크.
+//
+//   tetris_bench                         # 전체, JSON 을 stdout 으로
+//   tetris_bench --out bench.json        # JSON 을 파일로, 표는 stderr
+//   tetris_bench --filter state_hash --repeat 9
+//
+// 반복 수는 벤치마크마다 고정이다(--scale 로만 늘고 줄어든다). 실행 시간에 맞춰
+// 반복 수를 고르면 기계마다 재는 구간이 달라져 결과를 나란히 비교하기 어렵다.
+// 반복 한 벌을 --repeat 번 재서 ns/op 는 중앙값을 낸다.
+//
+// 할당 수는 이 실행 파일의 전역 operator new/delete 한 벌을 바꿔 센다. 측정 구간에서
+// 일어난 할당만 세므로 allocs/op 는 hot path 가 힙을 얼마나 건드리는지 그대로 보여 준다.
+//
+// 입력 상태는 고정 시드에서 휴리스틱으로 둔 중반 국면 64개다. 시드가 고정이라
+// 실행마다 같은 상태를 같은 순서로 돈다.
+
+#include "../bot/beam_search.h"
+#include "../bot/placement.h"
+#include "../bot/reachability.h"
+#include "../net/framing.h"
+#include "../src/sim_game.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>   // _aligned_malloc
+#endif
+
+namespace {
+
+uint64_t g_allocs = 0;
+
+// 단일 스레드 도구라 카운터는 원자적일 필요가 없다.
+void* countedAlloc(std::size_t size) noexcept
+{
+    ++g_allocs;
+    return std::malloc(size ? size : 1);
+}
+
+// 정렬 할당은 해제 함수가 따로라(_aligned_free) 일반 free 와 섞이지 않게 나눈다.
+void* countedAlignedAlloc(std::size_t size, std::align_val_t align) noexcept
+{
+    ++g_allocs;
+    const std::size_t a = std::max(static_cast<std::size_t>(align), sizeof(void*));
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, a);
+#else
+    void* p = nullptr;
+    return posix_memalign(&p, a, size ? size : 1) == 0 ? p : nullptr;
+#endif
+}
+
+// 해제는 인라인되지 않게 둔다. operator delete 가 호출 지점에 인라인되면 GCC 가
+// new-expression 과 free 를 짝지어 -Wmismatched-new-delete 를 낸다(거짓 양성).
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void plainFree(void* p) noexcept { std::free(p); }
+
+BENCH_NOINLINE void alignedFree(void* p) noexcept
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+}  // namespace
+
+// 전역 operator new/delete 는 한 벌을 통째로 바꾼다. 일부만 바꾸면 표준 라이브러리
+// 쪽 짝(정렬·nothrow)이 섞여 malloc 한 것을 다른 할당기로 돌려주게 된다.
+void* operator new(std::size_t size)
+{
+    if (void* p = countedAlloc(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t align)
+{
+    if (void* p = countedAlignedAlloc(size, align)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t align) { return ::operator new(size, align); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return countedAlignedAlloc(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    return countedAlignedAlloc(size, align);
+}
+
+void operator delete(void* p) noexcept { plainFree(p); }
+void operator delete[](void* p) noexcept { plainFree(p); }
+void operator delete(void* p, std::size_t) noexcept { plainFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { plainFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { plainFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { plainFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { alignedFree(p); }
+
+namespace {
+
+void printUsage()
+{
+    std::cout <<
+        "Usage: tetris_bench [--filter SUBSTR] [--repeat N] [--scale F] [--out FILE]\n"
+        "  --filter SUBSTR  이름에 SUBSTR 이 들어간 벤치마크만 돈다\n"
+        "  --repeat N       벤치마크마다 잴 횟수. ns/op 는 중앙값 (default 5)\n"
+        "  --scale F        모든 반복 수에 곱할 배율 (default 1.0)\n"
+        "  --out FILE       JSON 을 FILE 에 쓴다. 없으면 stdout\n";
+}
+
+struct Result {
+    std::string name;
+    long iterations;
+    double nsPerOp;     // 중앙값
+    double nsPerOpMin;
+    double allocsPerOp;
+    double opsPerSec;
+};
+
+struct Runner {
+    std::string filter;
+    int repeat = 5;
+    double scale = 1.0;
+    std::vector<Result> results;
+    uint64_t sink = 0;
+
+    // op(i) 가 한 번의 연산이다. 반환값은 sink 에 더해 최적화로 지워지지 않게 한다.
+    template <typename Op>
+    void run(const char* name, long baseIterations, Op&& op)
+    {
+        if (!filter.empty() && std::string(name).find(filter) == std::string::npos) return;
+        const long iters = std::max(1L, static_cast<long>(baseIterations * scale));
+
+        for (long i = 0; i < iters / 10; ++i) sink += op(i);  // warm-up
+
+        std::vector<double> samples;
+        uint64_t allocs = 0;
+        for (int r = 0; r < repeat; ++r) {
+            const uint64_t allocsBefore = g_allocs;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (long i = 0; i < iters; ++i) sink += op(i);
+            const auto t1 = std::chrono::steady_clock::now();
+            allocs += g_allocs - allocsBefore;
+            samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count() / iters);
+        }
+        std::sort(samples.begin(), samples.end());
+        Result res;
+        res.name = name;
+        res.iterations = iters;
+        res.nsPerOp = samples[samples.size() / 2];
+        res.nsPerOpMin = samples.front();
+        res.allocsPerOp = static_cast<double>(allocs) / (static_cast<double>(iters) * repeat);
+        res.opsPerSec = res.nsPerOp > 0 ? 1e9 / res.nsPerOp : 0;
+        std::fprintf(stderr, "  %-22s %10.1f ns/op  %6.2f allocs/op  %12.0f ops/s\n",
+                     name, res.nsPerOp, res.allocsPerOp, res.opsPerSec);
+        results.push_back(res);
+    }
+};
+
+// 고정 시드에서 휴리스틱으로 5..131 수를 둔 국면들. 끝난 게임은 건너뛴다.
+std::vector<SimGame> make_positions(int count)
+{
+    std::vector<SimGame> out;
+    out.reserve(count);
+    for (uint64_t seed = 1; static_cast<int>(out.size()) < count; ++seed) {
+        SimGame g(seed * 2654435761ull);
+        const int depth = 5 + static_cast<int>(seed % 64) * 2;
+        for (int k = 0; k < depth && !g.IsGameOver(); ++k) {
+            int col = 0, rot = 0;
+            if (!bot::heuristic_placement(g, col, rot)) break;
+            g.ApplyPlacement(col, rot);
+            if (k % 11 == 0) g.AddPendingGarbage(1);
+        }
+        if (!g.IsGameOver() && !g.LegalPlacements().empty()) out.push_back(g);
+    }
+    return out;
+}
+
+std::string json_escape(const std::string& s)
+{
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+void write_json(std::FILE* f, const Runner& runner)
+{
+#if defined(__clang__)
+    const std::string compiler = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+#if defined(NDEBUG)
+    const bool optimized = true;
+#else
+    const bool optimized = false;
+#endif
+    std::fprintf(f, "{\n  \"schema\": \"tetris_bench/1\",\n");
+    std::fprintf(f, "  \"compiler\": \"%s\",\n", json_escape(compiler).c_str());
+    std::fprintf(f, "  \"ndebug\": %s,\n", optimized ? "true" : "false");
+    std::fprintf(f, "  \"repeat\": %d,\n  \"scale\": %g,\n", runner.repeat, runner.scale);
+    std::fprintf(f, "  \"benchmarks\": [\n");
+    for (size_t i = 0; i < runner.results.size(); ++i) {
+        const Result& r = runner.results[i];
+        std::fprintf(f,
+            "    {\"name\": \"%s\", \"iterations\": %ld, \"ns_per_op\": %.2f, "
+            "\"ns_per_op_min\": %.2f, \"allocs_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+            json_escape(r.name).c_str(), r.iterations, r.nsPerOp, r.nsPerOpMin,
+            r.allocsPerOp, r.opsPerSec, i + 1 < runner.results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Runner runner;
+    std::string outPath;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--filter" && i + 1 < argc)      runner.filter = argv[++i];
+        else if (a == "--repeat" && i + 1 < argc) runner.repeat = std::atoi(argv[++i]);
+        else if (a == "--scale" && i + 1 < argc)  runner.scale = std::atof(argv[++i]);
+        else if (a == "--out" && i + 1 < argc)    outPath = argv[++i];
+        else { printUsage(); return a == "--help" ? 0 : 2; }
+    }
+    if (runner.repeat < 1 || runner.scale <= 0) { printUsage(); return 2; }
+
+    const std::vector<SimGame> positions = make_positions(64);
+    const size_t kPos = positions.size();
+
+    // 국면마다 미리 골라 둔 착수. apply_placement 는 매번 국면을 복사한 뒤 둔다.
+    std::vector<SimGame::Placement> firstMove(kPos);
+    for (size_t i = 0; i < kPos; ++i) {
+        int col = 0, rot = 0;
+        bot::heuristic_placement(positions[i], col, rot);
+        firstMove[i] = {col, rot};
+    }
+
+    std::fprintf(stderr, "tetris_bench: %zu positions, repeat %d, scale %g\n",
+                 kPos, runner.repeat, runner.scale);
+
+    // 프레임 단위 한 틱: 입력 한 번 + 중력 한 번. 끝난 게임은 다음 국면으로 바꾼다.
+    {
+        SimGame g = positions[0];
+        size_t next = 1;
+        runner.run("submit_input_tick", 400000, [&](long i) -> uint64_t {
+            if (g.IsGameOver()) g = positions[next++ % kPos];
+            const uint8_t masks[8] = {0, INPUT_LEFT, 0, INPUT_ROTATE, INPUT_RIGHT, 0, INPUT_DOWN, 0};
+            uint8_t mask = masks[i & 7];
+            if ((i & 63) == 63) mask = INPUT_DROP;
+            g.SubmitInput(mask);
+            g.Tick();
+            return static_cast<uint64_t>(g.CurrentRow());
+        });
+    }
+
+    runner.run("legal_placements", 100000, [&](long i) -> uint64_t {
+        return positions[static_cast<size_t>(i) % kPos].LegalPlacements().size();
+    });
+
+    runner.run("enumerate_placements", 100000, [&](long i) -> uint64_t {
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        return static_cast<uint64_t>(positions[static_cast<size_t>(i) % kPos].EnumeratePlacements(landed));
+    });
+
+    runner.run("enumerate_distinct_placements", 100000, [&](long i) -> uint64_t {
+        SimGame::LandedPlacement landed[SimGame::kMaxPlacements];
+        return static_cast<uint64_t>(
+            positions[static_cast<size_t>(i) % kPos].EnumerateDistinctPlacements(landed));
+    });
+
+    // tuck·T-spin 까지 넣은 BFS. 결과 버퍼는 재사용하므로 할당은 처음 몇 번뿐이다.
+    {
+        bot::ReachableSet set;
+        runner.run("reachable_placements", 20000, [&](long i) -> uint64_t {
+            return static_cast<uint64_t>(
+                bot::reachable_placements(positions[static_cast<size_t>(i) % kPos], set));
+        });
+        bot::ReachabilityCache cache(1024);
+        runner.run("reachable_placements_cached", 200000, [&](long i) -> uint64_t {
+            return cache.Get(positions[static_cast<size_t>(i) % kPos]).placements.size();
+        });
+    }
+
+    runner.run("apply_placement", 100000, [&](long i) -> uint64_t {
+        const size_t k = static_cast<size_t>(i) % kPos;
+        SimGame g = positions[k];
+        return static_cast<uint64_t>(g.ApplyPlacement(firstMove[k].col, firstMove[k].rot) + 1);
+    });
+
+    runner.run("state_hash", 200000, [&](long i) -> uint64_t {
+        return positions[static_cast<size_t>(i) % kPos].StateHash();
+    });
+
+    runner.run("heuristic_placement", 20000, [&](long i) -> uint64_t {
+        int col = 0, rot = 0;
+        bot::heuristic_placement(positions[static_cast<size_t>(i) % kPos], col, rot);
+        return static_cast<uint64_t>(col * 4 + rot);
+    });
+
+    {
+        // 인게임 기본 폭·깊이, 예산 없이 — 시계가 아니라 탐색량을 잰다.
+        bot::BeamConfig beam;
+        beam.budgetMs = 0.0;
+        runner.run("beam_placement", 200, [&](long i) -> uint64_t {
+            int col = 0, rot = 0;
+            bot::beam_placement(positions[static_cast<size_t>(i) % kPos], beam, col, rot);
+            return static_cast<uint64_t>(col * 4 + rot);
+        });
+    }
+
+    {
+        float board[bot::kBoardRows * bot::kBoardCols];
+        float current[bot::kNumPieceTypes];
+        float nextPiece[bot::kNumPieceTypes];
+        runner.run("observe", 200000, [&](long i) -> uint64_t {
+            bot::observe(positions[static_cast<size_t>(i) % kPos], board, current, nextPiece);
+            return static_cast<uint64_t>(board[199] + current[0]);
+        });
+    }
+
+    // INPUT 한 틱 프레임([tick:4][count:2][mask:1]).
+    const std::vector<uint8_t> inputPayload = {42, 0, 0, 0, 1, 0, 0x10};
+    runner.run("build_frame", 400000, [&](long) -> uint64_t {
+        return net::build_frame(net::MsgType::INPUT, inputPayload).size();
+    });
+
+    // 한 번에 INPUT 프레임 32개가 도착한 수신 버퍼를 푼다. op 하나 = 프레임 하나.
+    {
+        constexpr int kFramesPerChunk = 32;
+        std::vector<uint8_t> chunk;
+        for (int k = 0; k < kFramesPerChunk; ++k) {
+            const std::vector<uint8_t> fr = net::build_frame(net::MsgType::INPUT, inputPayload);
+            chunk.insert(chunk.end(), fr.begin(), fr.end());
+        }
+        std::vector<uint8_t> streamBuf;
+        streamBuf.reserve(chunk.size());
+        std::vector<net::Frame> frames;
+        frames.reserve(kFramesPerChunk);
+        runner.run("parse_frames", 400000, [&](long i) -> uint64_t {
+            if (i % kFramesPerChunk != 0) return 0;
+            streamBuf.assign(chunk.begin(), chunk.end());
+            frames.clear();
+            net::parse_frames(streamBuf, frames);
+            return frames.size();
+        });
+    }
+
+    if (outPath.empty()) {
+        write_json(stdout, runner);
+    } else {
+        std::FILE* f = std::fopen(outPath.c_str(), "w");
+        if (!f) { std::fprintf(stderr, "tetris_bench: cannot open %s\n", outPath.c_str()); return 1; }
+        write_json(f, runner);
+        std::fclose(f);
+    }
+    std::fprintf(stderr, "(sink %llu)\n", static_cast<unsigned long long>(runner.sink));
+    return 0;
+}
@@ -0,0 +1,110 @@
+// tetris_hash_bench — 프레임 체크섬·그리드 해시 마이크로벤치마크.
+//
+//   tetris_hash_bench                 # 기본 반복 수
+//   tetris_hash_bench --iters 2000000
+//
+// 두 가지 모양을 잰다.
+//   · INPUT 크기 프레임(7..30 바이트): fnv1a32 vs hash32_words — 프레임 CHECKSUM
+//   · 800 바이트 그리드(int32 20x10): fnv1a64 vs hash64_words — SimGame::StateHash 의 입력 크기
+// 결과는 bytes/ns 와 ns/op. 결과값을 누적해 출력하므로 컴파일러가 루프를 지우지 못한다.
+
+#include "../core/hash.h"
+#include "../net/framing.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+void printUsage()
+{
+    std::cout <<
+        "Usage: tetris_hash_bench [--iters N]\n"
+        "  --iters N   크기마다 해시 호출 수 (default 1000000)\n";
+}
+
+struct Sample {
+    double nsPerOp;
+    double bytesPerNs;
+    uint64_t sink;
+};
+
+// 입력마다 첫 바이트를 바꿔 같은 값 반복 계산을 최적화로 접지 못하게 한다.
+template <typename Fn>
+Sample measure(std::vector<uint8_t>& buf, long iters, Fn&& fn)
+{
+    uint64_t sink = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < iters; ++i) {
+        buf[0] = static_cast<uint8_t>(i);
+        sink += fn(buf.data(), buf.size());
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+    return {ns / iters, static_cast<double>(buf.size()) * iters / ns, sink};
+}
+
+void report(const char* name, size_t len, const Sample& s)
+{
+    std::printf("  %-14s %4zu B  %7.2f ns/op  %6.2f B/ns\n", name, len, s.nsPerOp, s.bytesPerNs);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    long iters = 1000000;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            iters = std::atol(argv[++i]);
+        } else {
+            printUsage();
+            return std::strcmp(argv[i], "--help") == 0 ? 0 : 2;
+        }
+    }
+    if (iters <= 0) { printUsage(); return 2; }
+
+    uint64_t sink = 0;
+
+    // INPUT 페이로드는 [tick:4][count:2][mask:count] — 1 틱이면 7 바이트, 재전송
+    // 묶음이면 길어진다. HASH 는 12, PING 은 8.
+    std::printf("frame checksum (32-bit)\n");
+    for (size_t len : {7u, 12u, 16u, 24u, 30u}) {
+        std::vector<uint8_t> buf(len);
+        for (size_t i = 0; i < len; ++i) buf[i] = static_cast<uint8_t>(i * 37 + 11);
+        const Sample fnv = measure(buf, iters, [](const uint8_t* p, size_t n) {
+            return static_cast<uint64_t>(net::fnv1a32(p, n));
+        });
+        const Sample word = measure(buf, iters, [](const uint8_t* p, size_t n) {
+            return static_cast<uint64_t>(hash32_words(p, n));
+        });
+        report("fnv1a32", len, fnv);
+        report("hash32_words", len, word);
+        sink += fnv.sink + word.sink;
+    }
+
+    std::printf("grid hash (64-bit)\n");
+    {
+        const size_t len = 20 * 10 * sizeof(int32_t);
+        std::vector<uint8_t> buf(len);
+        for (size_t i = 0; i < len; ++i) buf[i] = static_cast<uint8_t>((i % 40) < 4 ? i % 7 : 0);
+        const long gridIters = iters / 10 > 0 ? iters / 10 : 1;
+        const Sample fnv = measure(buf, gridIters, [](const uint8_t* p, size_t n) {
+            return fnv1a64(p, n);
+        });
+        const Sample word = measure(buf, gridIters, [](const uint8_t* p, size_t n) {
+            return hash64_words(p, n);
+        });
+        report("fnv1a64", len, fnv);
+        report("hash64_words", len, word);
+        sink += fnv.sink + word.sink;
+    }
+
+    std::printf("(sink %016llx)\n", static_cast<unsigned long long>(sink));
+    return 0;
+}
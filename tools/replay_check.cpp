@@ -0,0 +1,430 @@
+// tetris_replay_check — 리플레이 재생 검증과 빌드 간 desync 이분 탐색.
+//
+//   tetris_replay_check out/replay.trpl                 # keyframe 해시를 재시뮬레이션과 대조
+//   old/tetris_replay_check archive/ --emit-ref refs/   # 기준 빌드로 섹션별 해시 기록
+//   tetris_replay_check archive/ --ref refs/ --ref-bin old/tetris_replay_check
+//
+// 판마다 한 줄: OK / DIVERGED(처음 갈라진 틱·보드·섹션) / ERROR. 디렉터리는 *.trpl 을
+// 워커 스레드로 나눠 돈다. 해시는 SimGame::StateHashBreakdown 으로, DESYNC 로그와 같은
+// 단위다(src/sim_replay.h).
+//
+// 기준 해시 파일(<이름>.tref, 텍스트)은 --interval 틱마다(기본 600, main.cpp 의 해시 교환
+// 주기) 한 줄이다. 검사 빌드는 그 지점들을 대조해 처음 어긋난 구간을 찾고, --ref-bin 이
+// 있으면 기준 빌드를 --probe 로 불러 그 구간을 이분해 틱 하나까지 좁힌다(구간 600 이면
+// 탐침 10 번 남짓). 없으면 구간과 그 끝의 섹션까지만 알린다.
+// keyframe 이 있는 리플레이는 기준 파일 없이도 녹화한 빌드의 해시와 대조된다.
+
+#include "../core/replay.h"
+#include "../src/sim_replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <spawn.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+extern char** environ;
+#endif
+
+namespace {
+
+namespace fs = std::filesystem;
+
+void printUsage()
+{
+    std::cout <<
+        "Usage: tetris_replay_check PATH... [--threads N] [--emit-ref DIR] [--interval N]\n"
+        "                           [--ref DIR] [--ref-bin PATH]\n"
+        "       tetris_replay_check --probe FILE TICK\n"
+        "  PATH             .trpl 파일 또는 디렉터리(안의 *.trpl 전부, 이름순)\n"
+        "  --threads N      워커 스레드 수. 0 이면 하드웨어 스레드 수 (default 0)\n"
+        "  --emit-ref DIR   이 빌드의 섹션별 해시를 DIR/<이름>.tref 로 쓴다 (기준 빌드에서)\n"
+        "  --interval N     --emit-ref 의 기록 간격(틱) (default 600)\n"
+        "  --ref DIR        DIR/<이름>.tref 와 대조한다\n"
+        "  --ref-bin PATH   기준 빌드의 tetris_replay_check. 어긋난 구간을 --probe 로 이분한다\n"
+        "  --probe FILE T   시드부터 T 틱을 굴린 뒤 섹션별 해시 한 줄을 찍는다 (--ref-bin 이 부르는 모드)\n"
+        "종료 코드: 전부 OK 면 0, 하나라도 DIVERGED·ERROR 면 1, 인자 오류 2\n";
+}
+
+// "tick g0 c0 n0 r0 s0 x0 g1 c1 n1 r1 s1 x1" — 해시는 16진수.
+std::string formatHashes(const ReplayHashes& h)
+{
+    char buf[32 + 2 * kHashComponents * 18];
+    int n = std::snprintf(buf, sizeof(buf), "%" PRIu64, h.tick);
+    for (int p = 0; p < 2; ++p) {
+        const SimGame::HashBreakdown& b = h.board[p];
+        n += std::snprintf(buf + n, sizeof(buf) - n,
+                           " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64,
+                           b.grid, b.currentBlock, b.nextBlock, b.rng, b.scoreFlags, b.combat);
+    }
+    return buf;
+}
+
+bool parseHashes(const std::string& line, ReplayHashes& h)
+{
+    std::istringstream is(line);
+    is >> h.tick >> std::hex;
+    for (int p = 0; p < 2; ++p) {
+        SimGame::HashBreakdown& b = h.board[p];
+        is >> b.grid >> b.currentBlock >> b.nextBlock >> b.rng >> b.scoreFlags >> b.combat;
+    }
+    return static_cast<bool>(is);
+}
+
+struct Reference
+{
+    uint64_t seed = 0;
+    uint64_t ticks = 0;
+    std::vector<ReplayHashes> points;   // tick 오름차순
+};
+
+bool loadReference(const fs::path& path, Reference& ref)
+{
+    std::ifstream in(path);
+    std::string line;
+    if (!std::getline(in, line) || line.rfind("# tetris_replay_check reference v1", 0) != 0) return false;
+    uint32_t interval = 0;
+    if (!std::getline(in, line) ||
+        std::sscanf(line.c_str(), "seed %" SCNu64 " ticks %" SCNu64 " interval %" SCNu32,
+                    &ref.seed, &ref.ticks, &interval) != 3)
+        return false;
+    while (std::getline(in, line)) {
+        ReplayHashes h;
+        if (!parseHashes(line, h)) return false;
+        if (!ref.points.empty() && h.tick <= ref.points.back().tick) return false;
+        ref.points.push_back(h);
+    }
+    return !ref.points.empty();
+}
+
+bool writeReference(const fs::path& path, const ReplayData& rp, uint32_t interval)
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) return false;
+    out << "# tetris_replay_check reference v1\n"
+        << "seed " << rp.seed << " ticks " << rp.frames.size() << " interval " << interval << "\n";
+    ReplaySim sim(rp.seed);
+    for (size_t t = 0;; ++t) {
+        if (t % interval == 0 || t == rp.frames.size()) out << formatHashes(ReplayHashesOf(sim)) << "\n";
+        if (t == rp.frames.size()) break;
+        sim.Step(rp.frames[t]);
+    }
+    return static_cast<bool>(out);
+}
+
+// 파이프를 만들고 자식을 띄우는 구간은 한 번에 하나씩. 워커 스레드가 동시에 띄우면
+// 한 자식의 파이프 쓰기 끝이 다른 자식에게 상속돼, 읽는 쪽이 EOF 를 못 본다.
+std::mutex g_spawnMutex;
+
+#ifdef _WIN32
+// CommandLineToArgvW / MSVCRT 규칙으로 인자 하나를 따옴표로 감싼다.
+void appendQuoted(std::string& cmd, const std::string& arg)
+{
+    cmd += '"';
+    size_t slashes = 0;
+    for (char c : arg) {
+        if (c == '\\') { ++slashes; continue; }
+        if (c == '"') cmd.append(slashes * 2 + 1, '\\');
+        else cmd.append(slashes, '\\');
+        slashes = 0;
+        cmd += c;
+    }
+    cmd.append(slashes * 2, '\\');
+    cmd += '"';
+}
+#endif
+
+// argv[0] 을 셸 없이 실행하고 stdout 을 모은다. 종료 코드가 0 이면 true.
+// 경로는 인자 배열로 넘기므로 공백·따옴표·셸 메타문자가 있어도 그대로 전달된다.
+bool runCapture(const std::vector<std::string>& args, std::string& output)
+{
+    output.clear();
+#ifdef _WIN32
+    std::string cmd;
+    for (const std::string& a : args) {
+        if (!cmd.empty()) cmd += ' ';
+        appendQuoted(cmd, a);
+    }
+    SECURITY_ATTRIBUTES sa{sizeof(sa), nullptr, TRUE};
+    HANDLE readEnd = nullptr, writeEnd = nullptr;
+    PROCESS_INFORMATION pi{};
+    {
+        std::lock_guard<std::mutex> lock(g_spawnMutex);
+        if (!CreatePipe(&readEnd, &writeEnd, &sa, 0)) return false;
+        SetHandleInformation(readEnd, HANDLE_FLAG_INHERIT, 0);
+        STARTUPINFOA si{};
+        si.cb = sizeof(si);
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        si.hStdOutput = writeEnd;
+        si.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+        // 실행 파일 이름을 따로 주지 않아 PATH 검색은 예전 _popen 과 같다.
+        const BOOL ok = CreateProcessA(nullptr, &cmd[0], nullptr, nullptr, TRUE, 0, nullptr, nullptr, &si, &pi);
+        CloseHandle(writeEnd);
+        if (!ok) {
+            CloseHandle(readEnd);
+            return false;
+        }
+    }
+    char buf[512];
+    DWORD n = 0;
+    while (ReadFile(readEnd, buf, sizeof(buf), &n, nullptr) && n > 0) output.append(buf, n);
+    CloseHandle(readEnd);
+    WaitForSingleObject(pi.hProcess, INFINITE);
+    DWORD code = 1;
+    GetExitCodeProcess(pi.hProcess, &code);
+    CloseHandle(pi.hProcess);
+    CloseHandle(pi.hThread);
+    return code == 0;
+#else
+    std::vector<char*> argv;
+    for (const std::string& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+    int fds[2];
+    pid_t pid = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_spawnMutex);
+        if (pipe(fds) != 0) return false;
+        fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        // argv[0] 에 '/' 가 없으면 PATH 에서 찾는다(예전 popen 과 같다).
+        const int rc = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(fds[1]);
+        if (rc != 0) {
+            close(fds[0]);
+            return false;
+        }
+    }
+    char buf[512];
+    for (;;) {
+        const ssize_t n = read(fds[0], buf, sizeof(buf));
+        if (n > 0) output.append(buf, static_cast<size_t>(n));
+        else if (n == 0 || errno != EINTR) break;
+    }
+    close(fds[0]);
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+// 기준 빌드를 한 번 불러 tick 의 해시를 받는다.
+bool probeReference(const std::string& bin, const std::string& replay, uint64_t tick, ReplayHashes& out)
+{
+    std::string line;
+    return runCapture({bin, "--probe", replay, std::to_string(tick)}, line) && parseHashes(line, out) &&
+           out.tick == tick;
+}
+
+struct Options
+{
+    int threads = 0;
+    uint32_t interval = 600;
+    std::string emitDir;
+    std::string refDir;
+    std::string refBin;
+};
+
+std::string describe(const ReplayDivergence& d)
+{
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "tick=%" PRIu64 " board=%d component=%s", d.tick, d.board,
+                  d.component >= 0 ? kHashComponentNames[d.component] : "?");
+    return buf;
+}
+
+// 판 하나를 검사해 출력 한 줄을 만든다. 문제가 있으면 failed.
+std::string checkReplay(const fs::path& path, const Options& opt, bool& failed)
+{
+    failed = true;
+    const std::string name = path.string();
+    ReplayData rp;
+    if (!ReplayIO::Load(name, rp)) return "ERROR    " + name + ": cannot read replay";
+
+    if (!opt.emitDir.empty()) {
+        const fs::path out = fs::path(opt.emitDir) / (path.stem().string() + ".tref");
+        if (!writeReference(out, rp, opt.interval)) return "ERROR    " + name + ": cannot write " + out.string();
+        failed = false;
+        return "EMITTED  " + name + " -> " + out.string();
+    }
+
+    // keyframe 은 녹화한 빌드가 남긴 해시다. 어긋나면 그 keyframe 의 상태를 풀어 섹션을 본다.
+    std::string why;
+    const int bad = VerifyKeyframes(rp, &why);
+    if (bad >= 0) {
+        const ReplayKeyframe& k = rp.keyframes[bad];
+        const uint64_t from = bad > 0 ? rp.keyframes[bad - 1].tick : 0;
+        ReplayDivergence d;
+        if (!KeyframeDivergence(rp, static_cast<size_t>(bad), d)) d.tick = k.tick;
+        return "DIVERGED " + name + " keyframe " + std::to_string(bad) + " (" + why + ") " + describe(d) +
+               " window=(" + std::to_string(from) + "," + std::to_string(k.tick) + "]";
+    }
+
+    if (!opt.refDir.empty()) {
+        const fs::path refPath = fs::path(opt.refDir) / (path.stem().string() + ".tref");
+        Reference ref;
+        if (!loadReference(refPath, ref)) return "ERROR    " + name + ": cannot read " + refPath.string();
+        if (ref.seed != rp.seed || ref.ticks != rp.frames.size() || ref.points.back().tick > rp.frames.size())
+            return "ERROR    " + name + ": reference is for a different replay";
+
+        ReplaySim sim(rp.seed);
+        uint64_t good = 0;
+        for (size_t i = 0; i < ref.points.size(); ++i) {
+            const ReplayHashes& point = ref.points[i];
+            while (sim.Tick() < point.tick) sim.Step(rp.frames[sim.Tick()]);
+            ReplayDivergence d;
+            if (!FirstHashDifference(ReplayHashesOf(sim), point, d.board, d.component)) {
+                good = point.tick;
+                continue;
+            }
+            d.tick = point.tick;
+            d.local = ReplayHashesOf(sim);
+            d.reference = point;
+            std::string detail;
+            if (i > 0 && !opt.refBin.empty()) {
+                const std::string bin = opt.refBin;
+                const ReferenceHashes probe = [&](uint64_t tick, ReplayHashes& out) {
+                    return probeReference(bin, name, tick, out);
+                };
+                if (!BisectDivergence(rp, good, point.tick, probe, d))
+                    return "ERROR    " + name + ": reference probe failed (" + bin + ")";
+                if (d.board < 0)
+                    return "ERROR    " + name + ": " + bin + " does not reproduce " + refPath.string();
+                detail = " probes=" + std::to_string(d.probes);
+            } else if (i > 0) {
+                detail = " window=(" + std::to_string(good) + "," + std::to_string(point.tick) + "]";
+            }
+            return "DIVERGED " + name + " " + describe(d) + detail;
+        }
+    }
+
+    failed = false;
+    return "OK       " + name + " ticks=" + std::to_string(rp.frames.size()) +
+           " keyframes=" + std::to_string(rp.keyframes.size());
+}
+
+bool collect(const std::string& arg, std::vector<fs::path>& out)
+{
+    std::error_code ec;
+    if (!fs::is_directory(arg, ec)) {
+        out.push_back(arg);
+        return true;
+    }
+    std::vector<fs::path> found;
+    for (fs::directory_iterator it(arg, ec), end; it != end && !ec; it.increment(ec)) {
+        if (it->is_regular_file(ec) && it->path().extension() == ".trpl") found.push_back(it->path());
+    }
+    if (ec) {
+        std::cerr << "cannot read " << arg << ": " << ec.message() << "\n";
+        return false;
+    }
+    std::sort(found.begin(), found.end());
+    out.insert(out.end(), found.begin(), found.end());
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    std::vector<fs::path> files;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else if (arg == "--probe" && i + 2 < argc) {
+            // 기준 빌드의 해시를 내는 모드라 keyframe(녹화한 빌드의 상태)은 쓰지 않고,
+            // writeReference 처럼 시드에서 처음부터 굴린다.
+            ReplayData rp;
+            const uint64_t tick = std::strtoull(argv[i + 2], nullptr, 10);
+            if (!ReplayIO::Load(argv[i + 1], rp) || tick > rp.frames.size()) return 1;
+            ReplaySim sim(rp.seed);
+            while (sim.Tick() < tick) sim.Step(rp.frames[sim.Tick()]);
+            std::printf("%s\n", formatHashes(ReplayHashesOf(sim)).c_str());
+            return 0;
+        }
+        else if (arg == "--threads" && hasValue)  opt.threads = std::atoi(argv[++i]);
+        else if (arg == "--interval" && hasValue) opt.interval = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        else if (arg == "--emit-ref" && hasValue) opt.emitDir = argv[++i];
+        else if (arg == "--ref" && hasValue)      opt.refDir = argv[++i];
+        else if (arg == "--ref-bin" && hasValue)  opt.refBin = argv[++i];
+        else if (!arg.empty() && arg[0] != '-') {
+            if (!collect(arg, files)) return 2;
+        }
+        else {
+            std::cerr << "unknown argument: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+    if (files.empty()) {
+        printUsage();
+        return 2;
+    }
+    if (!opt.emitDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(opt.emitDir, ec);
+    }
+
+    const int count = static_cast<int>(files.size());
+    int threads = opt.threads > 0 ? opt.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::clamp(threads, 1, count);
+
+    // 판마다 길이가 달라 번호를 하나씩 집어 간다. 출력은 끝에 번호 순으로 찍는다.
+    std::vector<std::string> lines(count);
+    std::vector<char> failed(count, 0);
+    std::atomic<int> next{0};
+    auto worker = [&] {
+        for (;;) {
+            const int i = next.fetch_add(1);
+            if (i >= count) break;
+            bool bad = false;
+            lines[i] = checkReplay(files[i], opt, bad);
+            failed[i] = bad;
+        }
+    };
+    if (threads == 1) {
+        worker();
+    } else {
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (int w = 0; w < threads; ++w) pool.emplace_back(worker);
+        for (auto& t : pool) t.join();
+    }
+
+    int bad = 0;
+    for (int i = 0; i < count; ++i) {
+        std::printf("%s\n", lines[i].c_str());
+        bad += failed[i];
+    }
+    std::printf("%d replays, %d ok, %d failed\n", count, count - bad, bad);
+    return bad ? 1 : 0;
+}
@@ -0,0 +1,244 @@
+// tetris_selfplay — 헤드리스 self-play 데이터 생성기 겸 처리량 벤치마크.
+//
+//   tetris_selfplay --matches 256 --threads 8 --out selfplay.bin
+//   tetris_selfplay --matches 128 --sweep 16      # 1,2,4,8,16 스레드 placements/sec
+//
+// 엔진은 bot/selfplay.h. 기록 파일 형식은 아래 write_records 참고.
+
+#include "../bot/bot_onnx.h"
+#include "../bot/inference_server.h"
+#include "../bot/selfplay.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printUsage()
+{
+    std::cout <<
+        "Usage: tetris_selfplay [--matches N] [--threads N] [--seed S] [--max-pieces N]\n"
+        "                       [--policy heuristic|beam|mcts|random] [--beam-width N]\n"
+        "                       [--beam-depth N] [--tt-mb N] [--mcts-sims N] [--model PATH]\n"
+        "                       [--infer-batch N] [--infer-latency-us N]\n"
+        "                       [--out FILE] [--sweep MAX_THREADS]\n"
+        "  --matches N      대전 수 (default 64)\n"
+        "  --threads N      워커 스레드 수. 0 이면 하드웨어 스레드 수 (default 0)\n"
+        "  --seed S         매치 시드의 기준값 (default 1)\n"
+        "  --max-pieces N   양쪽 합 착수 상한. 넘으면 무승부 (default 2000)\n"
+        "  --policy P       양쪽 정책 (default heuristic)\n"
+        "  --beam-width N   beam 정책의 폭 (default 24)\n"
+        "  --beam-depth N   beam 정책이 둬 볼 블록 수, 지금 블록 포함 1..4 (default 4).\n"
+        "                   self-play 에서는 시간 예산 없이 깊이로만 자른다 (결정론)\n"
+        "  --tt-mb N        beam 정책이 워커 전부와 나눠 쓰는 전치표 크기(MB). 0 이면\n"
+        "                   끈다 (default 0). 끝에 적중률·교체 수를 찍어 크기를 고를 수 있다\n"
+        "  --mcts-sims N    mcts 정책의 수당 시뮬레이션 수 (default 64). 워커 안에서는\n"
+        "                   1 스레드·잎 1 개로 돌려 결정론을 지킨다\n"
+        "  --model PATH     .onnx 정책. 워커마다 세션을 하나씩 연다. 로드 실패 시\n"
+        "                   --policy 로 물러선다\n"
+        "  --infer-batch N  0 보다 크면 세션을 하나만 열고 워커 전부의 추론 요청을 최대 N 판씩\n"
+        "                   묶어 돌린다 (bot/inference_server.h, default 0)\n"
+        "  --infer-latency-us N  batch 를 채우려고 기다리는 상한 (default 1000)\n"
+        "  --out FILE       착수 기록을 바이너리로 쓴다\n"
+        "  --sweep MAX      1,2,4,.. MAX 스레드로 같은 매치를 돌려 처리량을 비교한다.\n"
+        "                   기록은 남기지 않는다\n";
+}
+
+// 파일 형식: "TSP1" | uint32 record_size | uint64 count | SelfPlayRecord * count.
+// 레코드는 호스트 엔디언 POD 그대로다. record_size 로 읽는 쪽이 구조체 버전을 확인한다.
+bool write_records(const std::string& path, const bot::SelfPlayResult& result)
+{
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const uint32_t recordSize = sizeof(bot::SelfPlayRecord);
+    const uint64_t count = result.records.size();
+    bool ok = std::fwrite("TSP1", 1, 4, f) == 4
+           && std::fwrite(&recordSize, sizeof(recordSize), 1, f) == 1
+           && std::fwrite(&count, sizeof(count), 1, f) == 1;
+    if (ok && count > 0)
+    {
+        ok = std::fwrite(result.records.data(), recordSize, count, f) == count;
+    }
+    return std::fclose(f) == 0 && ok;
+}
+
+void printSummary(const bot::SelfPlayResult& r)
+{
+    const double rate = r.seconds > 0.0 ? static_cast<double>(r.placements) / r.seconds : 0.0;
+    std::printf("threads=%d matches=%d placements=%lld seconds=%.3f placements/sec=%.0f "
+                "steals=%llu A=%d B=%d draw=%d\n",
+                r.threads, r.matches, static_cast<long long>(r.placements), r.seconds, rate,
+                static_cast<unsigned long long>(r.steals), r.winsA, r.winsB, r.draws);
+}
+
+void printServerStats(const bot::InferenceServer& server)
+{
+    const bot::InferenceServerStats s = server.Stats();
+    std::printf("infer: requests=%llu batches=%llu mean_batch=%.2f largest=%d full=%llu failed=%llu\n",
+                static_cast<unsigned long long>(s.requests), static_cast<unsigned long long>(s.batches),
+                s.meanBatch(), s.largestBatch, static_cast<unsigned long long>(s.fullBatches),
+                static_cast<unsigned long long>(s.failedBatches));
+}
+
+void printTableStats(const bot::TranspositionTable& table)
+{
+    const bot::TTStats s = table.Stats();
+    std::printf("tt: entries=%zu probes=%llu hit_rate=%.3f stores=%llu overwrites=%llu "
+                "occupancy=%.2f\n",
+                s.entries, static_cast<unsigned long long>(s.probes), s.hitRate(),
+                static_cast<unsigned long long>(s.stores),
+                static_cast<unsigned long long>(s.overwrites), s.occupancy);
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    bot::SelfPlayConfig config;
+    std::string policyName = "heuristic";
+    std::string modelPath;
+    std::string outPath;
+    int sweepMax = 0;
+    int tableMb = 0;
+    bot::InferenceServerConfig serverConfig;
+    serverConfig.maxBatch = 0;
+    bot::BeamConfig beam;
+    beam.budgetMs = 0.0;
+    bot::MctsConfig mcts;
+    mcts.simulations = 64;
+    mcts.leafBatch = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") { printUsage(); return 0; }
+        else if (arg == "--matches" && hasValue)    config.matches = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue)    config.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue)       config.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--max-pieces" && hasValue) config.maxPieces = std::atoi(argv[++i]);
+        else if (arg == "--policy" && hasValue)     policyName = argv[++i];
+        else if (arg == "--beam-width" && hasValue) beam.width = std::atoi(argv[++i]);
+        else if (arg == "--beam-depth" && hasValue) beam.depth = std::atoi(argv[++i]);
+        else if (arg == "--tt-mb" && hasValue)      tableMb = std::atoi(argv[++i]);
+        else if (arg == "--mcts-sims" && hasValue)  mcts.simulations = std::atoi(argv[++i]);
+        else if (arg == "--model" && hasValue)      modelPath = argv[++i];
+        else if (arg == "--infer-batch" && hasValue) serverConfig.maxBatch = std::atoi(argv[++i]);
+        else if (arg == "--infer-latency-us" && hasValue) serverConfig.maxLatencyUs = std::atoi(argv[++i]);
+        else if (arg == "--out" && hasValue)        outPath = argv[++i];
+        else if (arg == "--sweep" && hasValue)      sweepMax = std::atoi(argv[++i]);
+        else
+        {
+            std::cerr << "unknown argument: " << arg << "\n";
+            printUsage();
+            return 2;
+        }
+    }
+    if (policyName != "heuristic" && policyName != "random" && policyName != "beam"
+        && policyName != "mcts")
+    {
+        std::cerr << "unknown policy: " << policyName << "\n";
+        return 2;
+    }
+
+    // 전치표는 키로 정해지는 값만 담으므로 워커가 나눠 써도 결과는 표가 없을 때와 같다.
+    std::unique_ptr<bot::TranspositionTable> table;
+    if (tableMb > 0 && policyName == "beam")
+    {
+        table = std::make_unique<bot::TranspositionTable>(static_cast<size_t>(tableMb));
+        beam.table = table.get();
+    }
+
+    // 공유 추론 서버. 워커는 요청만 넣고 기다리므로 세션은 하나다.
+    bot::BotOnnx sharedModel;
+    std::unique_ptr<bot::InferenceServer> server;
+    if (!modelPath.empty() && serverConfig.maxBatch > 0)
+    {
+        std::string err;
+        if (sharedModel.Load(modelPath, &err))
+        {
+            if (!sharedModel.HasDynamicBatch())
+                std::cerr << "model has a fixed batch of 1; re-export it to batch requests\n";
+            server = std::make_unique<bot::InferenceServer>(sharedModel, serverConfig);
+        }
+        else
+        {
+            std::cerr << "model load failed: " << err << "\n";
+        }
+    }
+
+    const uint64_t seed = config.seed;
+    bot::PolicyFactory factory = [&](int worker, int player) -> bot::PlacementPolicy {
+        bot::PlacementPolicy base =
+            policyName == "random" ? bot::random_policy(seed + static_cast<uint64_t>(player))
+            : policyName == "beam" ? bot::beam_policy(beam)
+            : policyName == "mcts" ? bot::mcts_policy(mcts)
+                                   : bot::heuristic_policy();
+        if (modelPath.empty()) return base;
+        if (serverConfig.maxBatch > 0)
+        {
+            if (!server) return base;
+            bot::InferenceServer* srv = server.get();
+            return [srv, base](const SimGame& sim, int& col, int& rot) {
+                return bot::server_placement(*srv, sim, col, rot) || base(sim, col, rot);
+            };
+        }
+        // BotOnnx 는 복사할 수 없으니 shared_ptr 로 람다에 묶는다. 세션은 워커·보드마다
+        // 따로라 스레드 간 공유가 없다.
+        auto onnx = std::make_shared<bot::BotOnnx>();
+        std::string err;
+        if (!onnx->Load(modelPath, &err))
+        {
+            if (worker == 0 && player == 0) std::cerr << "model load failed: " << err << "\n";
+            return base;
+        }
+        return [onnx](const SimGame& sim, int& col, int& rot) { return onnx->Infer(sim, col, rot); };
+    };
+
+    if (sweepMax > 0)
+    {
+        // 스레드 수만 바꿔 같은 매치 집합을 돈다. 매치 시드가 스레드 수와 무관하므로
+        // 총 placements 도 같아야 한다 — 다르면 결정론이 깨진 것이다.
+        config.record = false;
+        int64_t expected = -1;
+        for (int t = 1; t <= sweepMax; t *= 2)
+        {
+            config.threads = t;
+            if (table) table->Clear();  // 실행마다 빈 표에서 시작해야 처리량을 나란히 비교한다
+            const bot::SelfPlayResult r = bot::run_selfplay(config, factory);
+            printSummary(r);
+            if (table) printTableStats(*table);
+            if (server) printServerStats(*server);
+            if (expected >= 0 && r.placements != expected)
+            {
+                std::cerr << "placements differ across thread counts (" << expected
+                          << " vs " << r.placements << ")\n";
+                return 1;
+            }
+            expected = r.placements;
+        }
+        return 0;
+    }
+
+    config.record = !outPath.empty();
+    const bot::SelfPlayResult result = bot::run_selfplay(config, factory);
+    printSummary(result);
+    if (table) printTableStats(*table);
+    if (server) printServerStats(*server);
+    if (!outPath.empty())
+    {
+        if (!write_records(outPath, result))
+        {
+            std::cerr << "failed to write " << outPath << "\n";
+            return 1;
+        }
+        std::printf("wrote %zu records to %s\n", result.records.size(), outPath.c_str());
+    }
+    return 0;
+}